@@ -0,0 +1,227 @@
+#include "Generator/GraphGenerator.h"
+#include "Generator/GraphWriter.h"
+#include "Importer/ImporterContext.h"
+#include "Importer/ImporterFactory.h"
+#include "Importer/ImportInfoHandlerEmpty.h"
+#include "Data/Graph.h"
+//-----------------------------------------------------------------------------
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStringList>
+#include <QTextStream>
+//-----------------------------------------------------------------------------
+#include <memory>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif !defined(Q_OS_LINUX)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+/**
+ * \brief Info handler printing the errors of the importers and writers to the standard error output.
+ */
+class PrintInfoHandler
+	: public Importer::ImportInfoHandlerEmpty {
+
+public:
+
+	/***/
+	virtual void reportError (
+		const QString &text
+	) {
+		QTextStream (stderr) << "error: " << text << endl;
+	};
+
+}; // class
+
+/**
+ * \brief Resets the peak resident set size of the process (only on Linux, elsewhere the peak of the whole run is measured).
+ */
+void resetPeakMemory (void) {
+#if defined(Q_OS_LINUX)
+	QFile clearRefs ("/proc/self/clear_refs");
+	if (clearRefs.open (QIODevice::WriteOnly))
+		clearRefs.write ("5");
+#endif
+}
+
+/**
+ * \brief Returns the peak resident set size of the process in MB (0 if it is not known).
+ */
+double peakMemory (void) {
+#if defined(Q_OS_LINUX)
+	QFile status ("/proc/self/status");
+	if (!status.open (QIODevice::ReadOnly))
+		return 0;
+
+	// riadok "VmHWM:   12345 kB"
+	QByteArray line;
+	while (!(line = status.readLine ()).isEmpty ()) {
+		if (line.startsWith ("VmHWM:"))
+			return line.mid (6).trimmed ().split (' ').first ().toDouble () / 1024;
+	}
+
+	return 0;
+#elif defined(Q_OS_WIN)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo (GetCurrentProcess (), &counters, sizeof (counters)))
+		return 0;
+
+	return (double) counters.PeakWorkingSetSize / (1024 * 1024);
+#else
+	struct rusage usage;
+	if (getrusage (RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+#if defined(Q_OS_MAC)
+	return (double) usage.ru_maxrss / (1024 * 1024);
+#else
+	return (double) usage.ru_maxrss / 1024;
+#endif
+#endif
+}
+
+/**
+ * \brief Prints one row of the results.
+ */
+void printResult (
+	QTextStream &out,
+	const QString &graphName,
+	const QString &operation,
+	qint64 elements,
+	qint64 bytes,
+	qint64 elapsed
+) {
+	double seconds = qMax (elapsed, (qint64) 1) / 1000.0;
+
+	out << graphName << "\t" << operation << "\t"
+		<< elements << "\t" << elapsed << "\t"
+		<< QString::number (elements / seconds, 'f', 0) << "\t"
+		<< (bytes > 0 ? QString::number (bytes / seconds / (1024 * 1024), 'f', 1) : QString ("-")) << "\t"
+		<< QString::number (peakMemory (), 'f', 1) << endl;
+}
+
+/**
+ * \brief Imports the file and prints the throughput of the importer.
+ */
+bool benchmarkImport (
+	QTextStream &out,
+	const QString &graphName,
+	const QString &format,
+	const QString &fileName
+) {
+	std::auto_ptr<Importer::StreamImporter> importer;
+	bool importerFound = false;
+	Importer::ImporterFactory::createByFileExtension (importer, importerFound, format);
+	if (!importerFound)
+		return false;
+
+	QFile file (fileName);
+	if (!file.open (QIODevice::ReadOnly))
+		return false;
+
+	resetPeakMemory ();
+
+	QElapsedTimer timer;
+	timer.start ();
+
+	// rovnako ako pri nacitani suboru v aplikacii (GraphManager::loadGraph)
+	std::auto_ptr<Data::Graph> graph (new Data::Graph (1, "simple", 0, 0, NULL));
+	graph->selectLayout (graph->addLayout ("new Layout"));
+	graph->beginBulkInsert ();
+
+	PrintInfoHandler infoHandler;
+	Importer::ImporterContext context (file, *graph, infoHandler);
+	bool ok = importer->import (context);
+
+	graph->commitBulkInsert ();
+
+	qint64 elapsed = timer.elapsed ();
+	qint64 elements = graph->getNodes ()->size () + graph->getEdges ()->size ();
+
+	printResult (out, graphName, "import " + format, elements, file.size (), elapsed);
+
+	return ok;
+}
+
+} // namespace
+
+/**
+ * \brief Generates synthetic graphs, writes them in all the formats and measures the throughput of the importers
+ * and of the bulk graph construction (elements/s, MB/s, peak RSS).
+ * Usage: 3DVisualBenchmark [nodes] [models] [formats] [directory] [seed]
+ * (models and formats are comma separated lists, by default all). It has to be started from the directory with config/config.
+ */
+int main (int argc, char *argv[]) {
+	QCoreApplication app (argc, argv);
+	QStringList args = app.arguments ();
+
+	int nodeCount = (args.size () > 1) ? args.at (1).toInt () : 100000;
+	QStringList models = (args.size () > 2) ? args.at (2).split (',') : (QStringList () << "er" << "ba" << "grid" << "tree" << "clusters");
+	QStringList formats = (args.size () > 3) ? args.at (3).split (',') : Generator::GraphWriter::getFormats ();
+	QString directory = (args.size () > 4) ? args.at (4) : QDir::tempPath ();
+	quint64 seed = (args.size () > 5) ? args.at (5).toULongLong () : 1;
+
+	QTextStream out (stdout);
+	out << "graph\toperation\telements\tms\telements/s\tMB/s\tpeak RSS MB" << endl;
+
+	bool ok = true;
+
+	foreach (const QString &model, models) {
+		Generator::GraphGenerator generator (seed);
+		Generator::GeneratedGraph generated;
+
+		QElapsedTimer timer;
+		timer.start ();
+
+		if (!generator.generate (model, nodeCount, generated)) {
+			QTextStream (stderr) << "unknown model: " << model << endl;
+			ok = false;
+			continue;
+		}
+
+		qint64 elements = generated.nodeCount + generated.edges.size ();
+		printResult (out, generated.name, "generate", elements, 0, timer.elapsed ());
+
+		Generator::GraphWriter writer (generated);
+
+		// hromadne vytvorenie grafu bez citania suboru
+		resetPeakMemory ();
+		timer.restart ();
+		Data::Graph *graph = writer.createGraph ();
+		printResult (out, generated.name, "bulk insert", elements, 0, timer.elapsed ());
+		delete graph;
+
+		foreach (const QString &format, formats) {
+			QString fileName = QDir (directory).filePath (generated.name + "." + format);
+			PrintInfoHandler infoHandler;
+
+			QFile file (fileName);
+			bool written = file.open (QIODevice::WriteOnly | QIODevice::Truncate);
+
+			timer.restart ();
+			written = written && writer.write (format, file, infoHandler);
+			file.close ();
+
+			if (!written) {
+				QTextStream (stderr) << "can not write " << fileName << endl;
+				ok = false;
+				continue;
+			}
+
+			printResult (out, generated.name, "write " + format, elements, file.size (), timer.elapsed ());
+
+			ok = benchmarkImport (out, generated.name, format, fileName) && ok;
+
+			QFile::remove (fileName);
+		}
+	}
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+/*!
+ * AdjacencyGraph.h
+ * Projekt 3DVisual
+ */
+
+#ifndef ANALYSIS_ADJACENCYGRAPH_DEF
+#define ANALYSIS_ADJACENCYGRAPH_DEF 1
+
+#include <QVector>
+#include <QHash>
+
+#include <osg/Vec3f>
+
+namespace Data
+{
+	class Graph;
+}
+
+namespace Analysis
+{
+	/**
+	*  \class AdjacencyGraph
+	*  \brief Compact adjacency of the Nodes of a Graph for the graph algorithms
+	*
+	*	Nodes are numbered 0..n-1, neighbours of all Nodes are stored in one array (compressed sparse rows), so the algorithms read
+	*	the adjacency sequentially instead of following the QMaps of the Nodes. Meta-Nodes, meta-Edges and loops are left out.
+	*	Adjacency is built from the snapshot of the Graph, so it can be used by other threads while the Graph is edited.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class AdjacencyGraph
+	{
+	public:
+
+		/**
+		*  \fn public constructor  AdjacencyGraph(Data::Graph * graph)
+		*  \brief Builds the adjacency of the Graph
+		*  \param  graph   analysed Graph
+		*/
+		AdjacencyGraph(Data::Graph * graph);
+
+		/**
+		*  \fn inline public constant  getNodeCount
+		*  \brief Returns count of the Nodes
+		*  \return int count of the Nodes
+		*/
+		int getNodeCount() const { return nodeIds.size(); }
+
+		/**
+		*  \fn inline public constant  getNodeId(int node)
+		*  \brief Returns id of the Node
+		*  \param  node   index of the Node
+		*  \return qlonglong id of the Node
+		*/
+		qlonglong getNodeId(int node) const { return nodeIds.at(node); }
+
+		/**
+		*  \fn inline public constant  getNodeIds
+		*  \brief Returns ids of all Nodes
+		*  \return const QVector<qlonglong> & id by index of the Node
+		*/
+		const QVector<qlonglong> & getNodeIds() const { return nodeIds; }
+
+		/**
+		*  \fn inline public constant  getNodeIndex(qlonglong id)
+		*  \brief Returns index of the Node
+		*  \param  id   id of the Node
+		*  \return int index of the Node, -1 if the Node is not in the adjacency
+		*/
+		int getNodeIndex(qlonglong id) const { return indexes.value(id, -1); }
+
+		/**
+		*  \fn inline public constant  degree(int node)
+		*  \brief Returns count of the neighbours of the Node (orientation of the Edges is ignored)
+		*  \param  node   index of the Node
+		*  \return int count of the neighbours
+		*/
+		int degree(int node) const { return offsets.at(node + 1) - offsets.at(node); }
+
+		/**
+		*  \fn inline public constant  getOffsets
+		*  \brief Returns start of the neighbours of each Node in getNeighbours (n+1 items)
+		*  \return const QVector<int> & offsets of the neighbours
+		*/
+		const QVector<int> & getOffsets() const { return offsets; }
+
+		/**
+		*  \fn inline public constant  getNeighbours
+		*  \brief Returns neighbours of all Nodes, orientation of the Edges is ignored
+		*  \return const QVector<int> & indexes of the neighbours
+		*/
+		const QVector<int> & getNeighbours() const { return neighbours; }
+
+		/**
+		*  \fn inline public constant  getNeighbourEdges
+		*  \brief Returns ids of the Edges to the neighbours, items correspond to the items of getNeighbours
+		*  \return const QVector<qlonglong> & ids of the Edges
+		*/
+		const QVector<qlonglong> & getNeighbourEdges() const { return neighbourEdges; }
+
+		/**
+		*  \fn inline public constant  getPositions
+		*  \brief Returns target positions of the Nodes at the time of creation of the adjacency
+		*  \return const QVector<osg::Vec3f> & positions by index of the Node
+		*/
+		const QVector<osg::Vec3f> & getPositions() const { return positions; }
+
+		/**
+		*  \fn inline public constant  getInOffsets
+		*  \brief Returns start of the predecessors of each Node in getPredecessors (n+1 items)
+		*  \return const QVector<int> & offsets of the predecessors
+		*/
+		const QVector<int> & getInOffsets() const { return inOffsets; }
+
+		/**
+		*  \fn inline public constant  getPredecessors
+		*  \brief Returns predecessors of all Nodes - sources of oriented Edges and both ends of not oriented Edges
+		*  \return const QVector<int> & indexes of the predecessors
+		*/
+		const QVector<int> & getPredecessors() const { return predecessors; }
+
+		/**
+		*  \fn inline public constant  getOutDegrees
+		*  \brief Returns count of the successors of each Node
+		*  \return const QVector<int> & counts of the successors
+		*/
+		const QVector<int> & getOutDegrees() const { return outDegrees; }
+
+	private:
+
+		/**
+		*  QVector<qlonglong> nodeIds
+		*  \brief Ids of the Nodes by index
+		*/
+		QVector<qlonglong> nodeIds;
+
+		/**
+		*  QHash<qlonglong,int> indexes
+		*  \brief Indexes of the Nodes by id
+		*/
+		QHash<qlonglong, int> indexes;
+
+		/**
+		*  QVector<int> offsets
+		*  \brief Start of the neighbours of each Node
+		*/
+		QVector<int> offsets;
+
+		/**
+		*  QVector<int> neighbours
+		*  \brief Neighbours of all Nodes
+		*/
+		QVector<int> neighbours;
+
+		/**
+		*  QVector<qlonglong> neighbourEdges
+		*  \brief Ids of the Edges to the neighbours
+		*/
+		QVector<qlonglong> neighbourEdges;
+
+		/**
+		*  QVector<osg::Vec3f> positions
+		*  \brief Target positions of the Nodes
+		*/
+		QVector<osg::Vec3f> positions;
+
+		/**
+		*  QVector<int> inOffsets
+		*  \brief Start of the predecessors of each Node
+		*/
+		QVector<int> inOffsets;
+
+		/**
+		*  QVector<int> predecessors
+		*  \brief Predecessors of all Nodes
+		*/
+		QVector<int> predecessors;
+
+		/**
+		*  QVector<int> outDegrees
+		*  \brief Count of the successors of each Node
+		*/
+		QVector<int> outDegrees;
+	};
+}
+
+#endif
@@ -0,0 +1,73 @@
+/*!
+ * CommunityDetection.h
+ * Projekt 3DVisual
+ */
+
+#ifndef ANALYSIS_COMMUNITYDETECTION_DEF
+#define ANALYSIS_COMMUNITYDETECTION_DEF 1
+
+#include "Analysis/AdjacencyGraph.h"
+
+#include <QList>
+#include <QVector>
+
+namespace Analysis
+{
+	/**
+	*  \class CommunityDetection
+	*  \brief Hierarchical community detection by the Louvain method
+	*
+	*	Each level moves the Nodes between the communities of their neighbours while modularity increases, then the communities are
+	*	aggregated into the Nodes of the next level. Best communities of blocks of the Nodes are chosen in parallel (QtConcurrent),
+	*	the moves are then checked and applied sequentially, so modularity never decreases. Aggregation of the communities is parallel too.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class CommunityDetection
+	{
+	public:
+
+		/**
+		*  int MAX_LEVELS
+		*  \brief Largest count of the levels of the hierarchy
+		*/
+		static const int MAX_LEVELS = 10;
+
+		/**
+		*  \fn public static  louvain(const Analysis::AdjacencyGraph &graph, double resolution = 1.0)
+		*  \brief Finds hierarchy of the communities
+		*  \param  graph   adjacency of the Graph
+		*  \param  resolution   resolution of the modularity, higher values give smaller communities
+		*  \return QList<QVector<int> > levels of the hierarchy from the finest, level 0 maps index of the Node to its community, level l maps community of level l-1 to community of level l
+		*/
+		static QList<QVector<int> > louvain(const Analysis::AdjacencyGraph &graph, double resolution = 1.0);
+
+		/**
+		*  \fn public static  flatten(const QList<QVector<int> > &levels, int level)
+		*  \brief Maps the Nodes directly to the communities of the level
+		*  \param  levels   levels of the hierarchy returned by louvain
+		*  \param  level   level of the hierarchy
+		*  \return QVector<int> community by index of the Node
+		*/
+		static QVector<int> flatten(const QList<QVector<int> > &levels, int level);
+
+		/**
+		*  \fn public static  communityCount(const QVector<int> &communities)
+		*  \brief Returns count of the communities
+		*  \param  communities   community by index of the Node (or community of the previous level)
+		*  \return int count of the communities
+		*/
+		static int communityCount(const QVector<int> &communities);
+
+		/**
+		*  \fn public static  modularity(const Analysis::AdjacencyGraph &graph, const QVector<int> &communities)
+		*  \brief Computes modularity of the division of the Nodes into the communities
+		*  \param  graph   adjacency of the Graph
+		*  \param  communities   community by index of the Node
+		*  \return double modularity
+		*/
+		static double modularity(const Analysis::AdjacencyGraph &graph, const QVector<int> &communities);
+	};
+}
+
+#endif
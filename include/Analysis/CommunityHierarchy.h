@@ -0,0 +1,181 @@
+/*!
+ * CommunityHierarchy.h
+ * Projekt 3DVisual
+ */
+
+#ifndef ANALYSIS_COMMUNITYHIERARCHY_DEF
+#define ANALYSIS_COMMUNITYHIERARCHY_DEF 1
+
+#include "Analysis/AdjacencyGraph.h"
+#include "Data/GraphCommand.h"
+
+#include <QList>
+#include <QSharedPointer>
+#include <QVector>
+
+#include <osg/ref_ptr>
+
+namespace Data
+{
+	class Graph;
+	class Node;
+}
+
+namespace Analysis
+{
+	/**
+	*  \class CommunityHierarchy
+	*  \brief Hierarchy of the communities of a Graph, levels of the hierarchy can be collapsed into merged meta-Nodes
+	*
+	*	Communities are found by Analysis::CommunityDetection when the hierarchy is created and stored as attributes community0, community1, ...
+	*	of the Nodes. Collapsing a level merges each community with more than one Node into a meta-Node (Graph::mergeNodes)
+	*	and connects the meta-Nodes of neighbouring communities, so only the macro-structure of the Graph is laid out and rendered.
+	*	Methods changing the Graph are called by the queued Analysis::CommunityCommand (Graph::enqueueCommand), so the communities are merged
+	*	or separated between two iterations of the layout like other structural changes of the Graph.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class CommunityHierarchy
+	{
+	public:
+
+		/**
+		*  \fn public constructor  CommunityHierarchy(Data::Graph * graph)
+		*  \brief Finds the communities of the Graph
+		*  \param  graph   Graph
+		*/
+		CommunityHierarchy(Data::Graph * graph);
+
+		/**
+		*  \fn inline public constant  getGraph
+		*  \brief Returns Graph of the hierarchy
+		*  \return Data::Graph * Graph
+		*/
+		Data::Graph * getGraph() const { return graph; }
+
+		/**
+		*  \fn inline public constant  getLevelCount
+		*  \brief Returns count of the levels of the hierarchy
+		*  \return int count of the levels
+		*/
+		int getLevelCount() const { return levels.size(); }
+
+		/**
+		*  \fn inline public constant  getLevel
+		*  \brief Returns collapsed level
+		*  \return int collapsed level, -1 if no level is collapsed
+		*/
+		int getLevel() const { return level; }
+
+		/**
+		*  \fn public constant  getCommunityCount(int level)
+		*  \brief Returns count of the communities of the level
+		*  \param  level   level of the hierarchy
+		*  \return int count of the communities
+		*/
+		int getCommunityCount(int level) const;
+
+		/**
+		*  \fn public constant  isCurrent(Data::Graph * graph)
+		*  \brief Returns true, if the hierarchy belongs to the Graph and the Graph was not changed by anything else since the last change by the hierarchy
+		*  \param  graph   Graph
+		*  \return bool true, if the hierarchy can be used
+		*/
+		bool isCurrent(Data::Graph * graph) const;
+
+		/**
+		*  \fn public  collapse(int level)
+		*  \brief Merges the communities of the level into meta-Nodes, previously collapsed level is expanded first
+		*  \param  level   level of the hierarchy
+		*/
+		void collapse(int level);
+
+		/**
+		*  \fn public  expand
+		*  \brief Separates all meta-Nodes created by collapse
+		*/
+		void expand();
+
+	private:
+
+		/**
+		*  Data::Graph * graph
+		*  \brief Graph of the hierarchy
+		*/
+		Data::Graph * graph;
+
+		/**
+		*  Analysis::AdjacencyGraph adjacency
+		*  \brief Adjacency of the Graph at the time of creation of the hierarchy
+		*/
+		Analysis::AdjacencyGraph adjacency;
+
+		/**
+		*  QList<QVector<int> > levels
+		*  \brief Levels of the hierarchy (see CommunityDetection::louvain)
+		*/
+		QList<QVector<int> > levels;
+
+		/**
+		*  int level
+		*  \brief Collapsed level, -1 if no level is collapsed
+		*/
+		int level;
+
+		/**
+		*  QList<osg::ref_ptr<Data::Node> > mergedNodes
+		*  \brief Meta-Nodes created by collapse
+		*/
+		QList<osg::ref_ptr<Data::Node> > mergedNodes;
+
+		/**
+		*  qlonglong version
+		*  \brief Version of the Graph after the last change by the hierarchy
+		*/
+		qlonglong version;
+	};
+
+	/**
+	*  \class CommunityCommand
+	*  \brief Collapses next coarser or finer level of the CommunityHierarchy
+	*
+	*	The level is chosen when the command is applied, so several queued commands move through the levels one by one.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class CommunityCommand : public Data::GraphCommand
+	{
+	public:
+
+		/**
+		*  \fn public constructor  CommunityCommand(QSharedPointer<Analysis::CommunityHierarchy> hierarchy, int step)
+		*  \brief Creates command changing the collapsed level
+		*  \param  hierarchy   communities of the Graph
+		*  \param  step   1 to collapse next coarser level, -1 to expand to next finer level
+		*/
+		CommunityCommand(QSharedPointer<Analysis::CommunityHierarchy> hierarchy, int step);
+
+		/**
+		*  \fn public virtual  apply(Data::Graph * graph)
+		*  \brief Collapses the level (CommunityHierarchy::collapse) or expands all communities (CommunityHierarchy::expand)
+		*  \param  graph   changed Graph
+		*/
+		virtual void apply(Data::Graph * graph);
+
+	private:
+
+		/**
+		*  QSharedPointer<Analysis::CommunityHierarchy> hierarchy
+		*  \brief Communities of the Graph
+		*/
+		QSharedPointer<Analysis::CommunityHierarchy> hierarchy;
+
+		/**
+		*  int step
+		*  \brief Change of the collapsed level
+		*/
+		int step;
+	};
+}
+
+#endif
@@ -0,0 +1,171 @@
+/*!
+ * GraphMetrics.h
+ * Projekt 3DVisual
+ */
+
+#ifndef ANALYSIS_GRAPHMETRICS_DEF
+#define ANALYSIS_GRAPHMETRICS_DEF 1
+
+#include "Analysis/AdjacencyGraph.h"
+
+#include <QString>
+#include <QVector>
+
+namespace Data
+{
+	class Graph;
+}
+
+namespace Analysis
+{
+	/**
+	*  \class GraphMetrics
+	*  \brief Structural metrics of the Nodes (degree, connected components, k-core, PageRank, betweenness)
+	*
+	*	Metrics are computed over Analysis::AdjacencyGraph. PageRank and betweenness are split into blocks computed on the global thread pool
+	*	(QtConcurrent), independent metrics are computed concurrently. Betweenness of large graphs is estimated from a sample of source Nodes.
+	*	computeAll stores the results as numeric attributes of the Nodes (Graph::getNodeAttributes), so they can be used by the queries.
+	*	The UI computes the metrics by compute on the thread pool (compute uses only the copied adjacency) and stores them by storeResult
+	*	on the thread owning the Graph, mapToNodes then shows the attributes as the size and the color of the Nodes.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class GraphMetrics
+	{
+	public:
+
+		/**
+		*  int EXACT_BETWEENNESS_LIMIT
+		*  \brief Largest count of the Nodes for which betweenness is computed exactly by computeAll
+		*/
+		static const int EXACT_BETWEENNESS_LIMIT = 5000;
+
+		/**
+		*  int BETWEENNESS_SAMPLES
+		*  \brief Count of the source Nodes used for the estimate of betweenness by computeAll
+		*/
+		static const int BETWEENNESS_SAMPLES = 256;
+
+		/**
+		*  \struct Result
+		*  \brief Metrics of all Nodes computed by compute, values are indexed by index of the Node
+		*/
+		struct Result
+		{
+			Result() : componentCount(0) {}
+
+			// id by index of the Node
+			QVector<qlonglong> nodeIds;
+			QVector<int> degrees;
+			QVector<int> components;
+			QVector<int> cores;
+			QVector<float> ranks;
+			QVector<float> centrality;
+			int componentCount;
+		};
+
+		/**
+		*  \fn public static  compute(const Analysis::AdjacencyGraph &adjacency)
+		*  \brief Computes all metrics, does not touch the Graph (can run on any thread)
+		*  \param  adjacency   adjacency of the Graph
+		*  \return Result metrics of the Nodes
+		*/
+		static Result compute(const Analysis::AdjacencyGraph &adjacency);
+
+		/**
+		*  \fn public static  storeResult(Data::Graph * graph, const Result &result)
+		*  \brief Stores the metrics as attributes degree, component, coreness, pagerank and betweenness of the Nodes
+		*  \param  graph   analysed Graph
+		*  \param  result   metrics computed by compute
+		*  \return int count of the connected components
+		*/
+		static int storeResult(Data::Graph * graph, const Result &result);
+
+		/**
+		*  \fn public static  computeAll(Data::Graph * graph)
+		*  \brief Computes all metrics and stores them as attributes degree, component, coreness, pagerank and betweenness of the Nodes
+		*  \param  graph   analysed Graph
+		*  \return int count of the connected components
+		*/
+		static int computeAll(Data::Graph * graph);
+
+		/**
+		*  \fn public static  degrees(const Analysis::AdjacencyGraph &graph)
+		*  \brief Returns degrees of the Nodes
+		*  \param  graph   adjacency of the Graph
+		*  \return QVector<int> degree by index of the Node
+		*/
+		static QVector<int> degrees(const Analysis::AdjacencyGraph &graph);
+
+		/**
+		*  \fn public static  components(const Analysis::AdjacencyGraph &graph)
+		*  \brief Finds connected components (orientation of the Edges is ignored)
+		*  \param  graph   adjacency of the Graph
+		*  \return QVector<int> number of the component (0..count-1) by index of the Node
+		*/
+		static QVector<int> components(const Analysis::AdjacencyGraph &graph);
+
+		/**
+		*  \fn public static  coreNumbers(const Analysis::AdjacencyGraph &graph)
+		*  \brief Computes k-core numbers of the Nodes (Batagelj-Zaversnik, linear time)
+		*  \param  graph   adjacency of the Graph
+		*  \return QVector<int> largest k, such that the Node is in the k-core, by index of the Node
+		*/
+		static QVector<int> coreNumbers(const Analysis::AdjacencyGraph &graph);
+
+		/**
+		*  \fn public static  pageRank(const Analysis::AdjacencyGraph &graph, float damping = 0.85f, int maxIterations = 100, double tolerance = 1e-6)
+		*  \brief Computes PageRank by power iteration
+		*  \param  graph   adjacency of the Graph
+		*  \param  damping   damping factor
+		*  \param  maxIterations   largest count of the iterations
+		*  \param  tolerance   iteration stops when sum of the changes of the ranks is lower
+		*  \return QVector<float> rank by index of the Node, ranks sum to 1
+		*/
+		static QVector<float> pageRank(const Analysis::AdjacencyGraph &graph, float damping = 0.85f, int maxIterations = 100, double tolerance = 1e-6);
+
+		/**
+		*  \fn public static  betweenness(const Analysis::AdjacencyGraph &graph, int samples = 0)
+		*  \brief Computes betweenness centrality (Brandes, orientation of the Edges is ignored)
+		*  \param  graph   adjacency of the Graph
+		*  \param  samples   count of the source Nodes used for the estimate, 0 or more than count of the Nodes for exact computation
+		*  \return QVector<float> betweenness by index of the Node (estimate scaled to the whole graph)
+		*/
+		static QVector<float> betweenness(const Analysis::AdjacencyGraph &graph, int samples = 0);
+
+		/**
+		*  \fn public static  storeAttribute(Data::Graph * graph, const QVector<qlonglong> &nodeIds, QString name, const QVector<int> &values)
+		*  \brief Stores values as INT attribute of the Nodes, previous values of the attribute are removed
+		*  \param  graph   analysed Graph
+		*  \param  nodeIds   id by index of the Node (Nodes removed from the Graph are skipped)
+		*  \param  name   name of the attribute
+		*  \param  values   values by index of the Node
+		*/
+		static void storeAttribute(Data::Graph * graph, const QVector<qlonglong> &nodeIds, QString name, const QVector<int> &values);
+
+		/**
+		*  \fn public static  storeAttribute(Data::Graph * graph, const QVector<qlonglong> &nodeIds, QString name, const QVector<float> &values)
+		*  \brief Stores values as FLOAT attribute of the Nodes, previous values of the attribute are removed
+		*  \param  graph   analysed Graph
+		*  \param  nodeIds   id by index of the Node (Nodes removed from the Graph are skipped)
+		*  \param  name   name of the attribute
+		*  \param  values   values by index of the Node
+		*/
+		static void storeAttribute(Data::Graph * graph, const QVector<qlonglong> &nodeIds, QString name, const QVector<float> &values);
+
+		/**
+		*  \fn public static  mapToNodes(Data::Graph * graph, QString sizeAttribute, QString colorAttribute)
+		*  \brief Sets scale and color of the Nodes by the numeric attributes (has to be called on the thread owning the Graph)
+		*
+		*	Scale goes from half to three times the default scale of the Nodes, color from blue (lowest value) to red (highest value).
+		*	Nodes without the value keep their scale and color.
+		*
+		*  \param  graph   Graph
+		*  \param  sizeAttribute   name of the attribute mapped to the scale, empty to keep the scales
+		*  \param  colorAttribute   name of the attribute mapped to the color, empty to keep the colors
+		*/
+		static void mapToNodes(Data::Graph * graph, QString sizeAttribute, QString colorAttribute);
+	};
+}
+
+#endif
@@ -0,0 +1,144 @@
+/*!
+ * GraphTraversal.h
+ * Projekt 3DVisual
+ */
+
+#ifndef ANALYSIS_GRAPHTRAVERSAL_DEF
+#define ANALYSIS_GRAPHTRAVERSAL_DEF 1
+
+#include "Analysis/AdjacencyGraph.h"
+
+#include <QList>
+#include <QString>
+#include <QVector>
+
+namespace Data
+{
+	class Graph;
+}
+
+namespace Analysis
+{
+	/**
+	*  \class GraphTraversal
+	*  \brief Shortest paths and k-hop neighbourhoods of the Nodes
+	*
+	*	Traversals run over Analysis::AdjacencyGraph with visited bitsets and flat frontier arrays, orientation of the Edges is ignored.
+	*	Unweighted paths are found by bidirectional BFS, weighted paths by Dijkstra and paths with the Edges weighted by their 3D length
+	*	by A* with the distance to the target Node as heuristic. The adjacency is built once and reused while the Graph does not change.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class GraphTraversal
+	{
+	public:
+
+		/**
+		*  \fn public constructor  GraphTraversal(Data::Graph * graph)
+		*  \brief Builds the adjacency of the Graph
+		*  \param  graph   Graph
+		*/
+		GraphTraversal(Data::Graph * graph);
+
+		/**
+		*  \fn inline public constant  getAdjacency
+		*  \brief Returns adjacency of the Graph
+		*  \return const Analysis::AdjacencyGraph & adjacency
+		*/
+		const Analysis::AdjacencyGraph & getAdjacency() const { return adjacency; }
+
+		/**
+		*  \fn public constant  isCurrent(Data::Graph * graph)
+		*  \brief Returns true, if the adjacency was built from the Graph and the Graph was not changed since
+		*  \param  graph   Graph
+		*  \return bool true, if the traversal can be used
+		*/
+		bool isCurrent(Data::Graph * graph) const;
+
+		/**
+		*  \fn public constant  shortestPath(int source, int target)
+		*  \brief Finds path with the lowest count of the Edges by bidirectional BFS
+		*  \param  source   index of the first Node
+		*  \param  target   index of the last Node
+		*  \return QVector<int> indexes of the Nodes of the path, empty if there is no path
+		*/
+		QVector<int> shortestPath(int source, int target) const;
+
+		/**
+		*  \fn public constant  weightedPath(int source, int target, const QVector<float> &weights)
+		*  \brief Finds path with the lowest sum of the weights of the Edges by Dijkstra
+		*  \param  source   index of the first Node
+		*  \param  target   index of the last Node
+		*  \param  weights   weights of the Edges corresponding to the items of AdjacencyGraph::getNeighbours (see getEdgeWeights)
+		*  \return QVector<int> indexes of the Nodes of the path, empty if there is no path
+		*/
+		QVector<int> weightedPath(int source, int target, const QVector<float> &weights) const;
+
+		/**
+		*  \fn public constant  geometricPath(int source, int target)
+		*  \brief Finds path with the lowest sum of the lengths of the Edges in 3D by A*
+		*  \param  source   index of the first Node
+		*  \param  target   index of the last Node
+		*  \return QVector<int> indexes of the Nodes of the path, empty if there is no path
+		*/
+		QVector<int> geometricPath(int source, int target) const;
+
+		/**
+		*  \fn public constant  neighbourhood(const QVector<int> &sources, int hops)
+		*  \brief Finds the Nodes at most hops Edges away from the source Nodes
+		*  \param  sources   indexes of the source Nodes
+		*  \param  hops   largest count of the Edges
+		*  \return QVector<int> indexes of the found Nodes including the source Nodes
+		*/
+		QVector<int> neighbourhood(const QVector<int> &sources, int hops) const;
+
+		/**
+		*  \fn public constant  getEdgeWeights(QString name)
+		*  \brief Reads weights of the Edges from the attribute of the Edges
+		*  \param  name   name of the attribute of the Edges
+		*  \return QVector<float> weights corresponding to the items of AdjacencyGraph::getNeighbours, empty if the Graph has no such numeric attribute
+		*/
+		QVector<float> getEdgeWeights(QString name) const;
+
+		/**
+		*  \fn public constant  getPathEdges(const QVector<int> &path, const QVector<float> &weights = QVector<float>())
+		*  \brief Returns the Edges between the consecutive Nodes of the path, the lightest one of parallel Edges
+		*  \param  path   indexes of the Nodes of the path
+		*  \param  weights   weights of the Edges, empty if the Edges are not weighted
+		*  \return QList<qlonglong> ids of the Edges
+		*/
+		QList<qlonglong> getPathEdges(const QVector<int> &path, const QVector<float> &weights = QVector<float>()) const;
+
+	private:
+
+		/**
+		*  \fn private constant  bestFirstPath(int source, int target, const QVector<float> * weights)
+		*  \brief Dijkstra (weights given) or A* with the lengths of the Edges in 3D (weights NULL)
+		*  \param  source   index of the first Node
+		*  \param  target   index of the last Node
+		*  \param  weights   weights of the Edges or NULL
+		*  \return QVector<int> indexes of the Nodes of the path, empty if there is no path
+		*/
+		QVector<int> bestFirstPath(int source, int target, const QVector<float> * weights) const;
+
+		/**
+		*  Data::Graph * graph
+		*  \brief Graph of the adjacency
+		*/
+		Data::Graph * graph;
+
+		/**
+		*  Analysis::AdjacencyGraph adjacency
+		*  \brief Adjacency of the Graph
+		*/
+		Analysis::AdjacencyGraph adjacency;
+
+		/**
+		*  qlonglong version
+		*  \brief Version of the Graph at the time of creation of the adjacency
+		*/
+		qlonglong version;
+	};
+}
+
+#endif
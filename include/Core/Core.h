@@ -42,8 +42,9 @@ namespace AppCore
         /**
          * \fn restartLayout
          * \brief Restarts layouting of graph.
+         * \param startImmediately if true, the layout starts without the delay Layout.Thread.StartSleepTime (e.g. on a graph which is being loaded)
          */
-        void restartLayout();
+        void restartLayout(bool startImmediately = false);
 
         /**
          * \fn getLayoutThread
@@ -51,6 +52,12 @@ namespace AppCore
          */
         Layout::LayoutThread* getLayoutThread(){return this->thr;}
 
+        /**
+         * \fn getLayoutAlgorithm
+         * \brief Returns Layout::FRAlgorithm
+         */
+        Layout::FRAlgorithm* getLayoutAlgorithm(){return this->alg;}
+
         /**
          * \fn getInstance
          * \brief Returns instance.
@@ -0,0 +1,502 @@
+/*!
+ * AttributeStore.h
+ * Projekt 3DVisual
+ */
+
+#ifndef DATA_ATTRIBUTESTORE_DEF
+#define DATA_ATTRIBUTESTORE_DEF 1
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+#include <QHash>
+#include <QList>
+#include <QBitArray>
+
+namespace Data
+{
+	/**
+	*  \class AttributeColumn
+	*  \brief Column of typed values of one attribute
+	*
+	*	Values are stored in a plain array of the column type, missing values are marked in the null bitmap. Strings are stored as indexes
+	*	to the dictionary of the column, so repeated values (categories, labels of types...) are stored only once.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class AttributeColumn
+	{
+	public:
+
+		/**
+		*  ValueType
+		*  \brief Type of the values of the column
+		*
+		*	INT values are 64 bit (GraphML long), DOUBLE keeps the full precision of GraphML double. New types are appended at the end,
+		*	the numbers of the types are written to the binary files.
+		*/
+		enum ValueType { INT, FLOAT, STRING, BOOL, DOUBLE };
+
+		/**
+		*  \fn public constructor  AttributeColumn(QString name, ValueType valueType)
+		*  \brief Creates new empty column
+		*  \param  name   name of the attribute
+		*  \param  valueType   type of the values
+		*/
+		AttributeColumn(QString name, ValueType valueType);
+
+		/**
+		*  \fn public static  valueTypeFromName(QString typeName)
+		*  \brief Returns type of the values for the name of the type used in the input files (int, long, float, double, boolean, string)
+		*  \param  typeName   name of the type
+		*  \return ValueType type of the values, STRING if the name is unknown
+		*/
+		static ValueType valueTypeFromName(QString typeName);
+
+		/**
+		*  \fn public static  valueTypeOfText(const QByteArray &text)
+		*  \brief Returns the narrowest type the text can be converted to (used by the importers to infer types of the columns)
+		*  \param  text   value in text form (UTF-8)
+		*  \return ValueType BOOL for true/false, INT, FLOAT or STRING
+		*/
+		static ValueType valueTypeOfText(const QByteArray &text);
+
+		/**
+		*  \fn public static  commonValueType(ValueType type1, ValueType type2)
+		*  \brief Returns type able to hold values of both types (the wider of two numeric types, different types otherwise give STRING)
+		*/
+		static ValueType commonValueType(ValueType type1, ValueType type2);
+
+		/**
+		*  \fn inline public constant  getName
+		*  \brief Returns name of the attribute
+		*  \return QString name of the attribute
+		*/
+		QString getName() const { return name; }
+
+		/**
+		*  \fn inline public constant  getValueType
+		*  \brief Returns type of the values
+		*  \return ValueType type of the values
+		*/
+		ValueType getValueType() const { return valueType; }
+
+		/**
+		*  \fn inline public constant  isNull(int row)
+		*  \brief Returns true, if the row has no value
+		*  \param  row   row of the column
+		*  \return bool true, if the row has no value
+		*/
+		bool isNull(int row) const { return row < 0 || row >= valid.size() || !valid.testBit(row); }
+
+		/**
+		*  \fn public  setNull(int row)
+		*  \brief Removes value of the row
+		*  \param  row   row of the column
+		*/
+		void setNull(int row);
+
+		/**
+		*  \fn public  setValue(int row, const QString &text)
+		*  \brief Converts the text to the type of the column and sets it as value of the row
+		*  \param  row   row of the column
+		*  \param  text   value in text form
+		*  \return bool true, if the text was converted, otherwise the row stays null
+		*/
+		bool setValue(int row, const QString &text);
+
+		/**
+		*  \fn public  setValue(int row, const QByteArray &text)
+		*  \brief Converts the UTF-8 text to the type of the column and sets it as value of the row
+		*
+		*	Numbers and booleans are converted directly from the bytes, QString is created only for STRING column.
+		*
+		*  \param  row   row of the column
+		*  \param  text   value in text form (UTF-8)
+		*  \return bool true, if the text was converted, otherwise the row stays null
+		*/
+		bool setValue(int row, const QByteArray &text);
+
+		/**
+		*  \fn public  setInt(int row, qlonglong value)
+		*  \brief Sets value of the row of INT column
+		*  \param  row   row of the column
+		*  \param  value   new value
+		*/
+		void setInt(int row, qlonglong value);
+
+		/**
+		*  \fn public  setFloat(int row, float value)
+		*  \brief Sets value of the row of FLOAT column
+		*  \param  row   row of the column
+		*  \param  value   new value
+		*/
+		void setFloat(int row, float value);
+
+		/**
+		*  \fn public  setDouble(int row, double value)
+		*  \brief Sets value of the row of DOUBLE column
+		*  \param  row   row of the column
+		*  \param  value   new value
+		*/
+		void setDouble(int row, double value);
+
+		/**
+		*  \fn public  setString(int row, const QString &value)
+		*  \brief Sets value of the row of STRING column
+		*  \param  row   row of the column
+		*  \param  value   new value
+		*/
+		void setString(int row, const QString &value);
+
+		/**
+		*  \fn public  setBool(int row, bool value)
+		*  \brief Sets value of the row of BOOL column
+		*  \param  row   row of the column
+		*  \param  value   new value
+		*/
+		void setBool(int row, bool value);
+
+		/**
+		*  \fn public  convertToString
+		*  \brief Changes the type of the column to STRING, the values are kept in their text form
+		*
+		*	Used by the importers, when the type of the column was inferred from the first values and a later value does not fit it.
+		*/
+		void convertToString();
+
+		/**
+		*  \fn public constant  getValue(int row)
+		*  \brief Returns value of the row
+		*  \param  row   row of the column
+		*  \return QVariant value of the row, invalid QVariant if the row is null
+		*/
+		QVariant getValue(int row) const;
+
+		/**
+		*  \fn public constant  getNumber(int row)
+		*  \brief Returns value of the row as number
+		*  \param  row   row of the column
+		*  \return double value of the row, 0 if the row is null, NaN for STRING column (text is not a number)
+		*/
+		double getNumber(int row) const;
+
+		/**
+		*  \fn inline public constant  isNumeric
+		*  \brief Returns true, if the values of the column are numbers (getNumber does not return NaN)
+		*/
+		bool isNumeric() const { return valueType != STRING; }
+
+		/**
+		*  \fn inline public constant  getStringIndex(int row)
+		*  \brief Returns index of the value of the row in the dictionary of STRING column
+		*  \param  row   row of the column
+		*  \return int index to the dictionary, -1 if the row is null
+		*/
+		int getStringIndex(int row) const { return (valueType == STRING && !isNull(row)) ? strings.at(row) : -1; }
+
+		/**
+		*  \fn public constant  selectEqual(const QVariant &value)
+		*  \brief Returns rows with the value
+		*  \param  value   searched value
+		*  \return QVector<int> rows with the value
+		*/
+		QVector<int> selectEqual(const QVariant &value) const;
+
+		/**
+		*  \fn public constant  selectRange(double min, double max)
+		*  \brief Returns rows with the numeric value in the interval <min, max>
+		*  \param  min   lower bound
+		*  \param  max   upper bound
+		*  \return QVector<int> rows with the value in the interval
+		*/
+		QVector<int> selectRange(double min, double max) const;
+
+		/**
+		*  \fn public constant  getRange(double &min, double &max)
+		*  \brief Finds the lowest and the highest numeric value of the column (e.g. for coloring by the attribute)
+		*  \param  min   lowest value
+		*  \param  max   highest value
+		*  \return bool false, if the column has no numeric values
+		*/
+		bool getRange(double &min, double &max) const;
+
+		/**
+		*  \fn inline public constant  getDictionary
+		*  \brief Returns different values of STRING column
+		*  \return const QVector<QString> & values indexed by the numbers returned by getStringIndex
+		*/
+		const QVector<QString> & getDictionary() const { return dictionary; }
+
+	private:
+
+		/**
+		*  \fn private  ensureRow(int row)
+		*  \brief Enlarges the column to contain the row
+		*  \param  row   row of the column
+		*/
+		void ensureRow(int row);
+
+		/**
+		*  QString name
+		*  \brief Name of the attribute
+		*/
+		QString name;
+
+		/**
+		*  ValueType valueType
+		*  \brief Type of the values
+		*/
+		ValueType valueType;
+
+		/**
+		*  QBitArray valid
+		*  \brief Null bitmap - bit is set, if the row has value
+		*/
+		QBitArray valid;
+
+		/**
+		*  QVector<qlonglong> ints
+		*  \brief Values of INT column
+		*/
+		QVector<qlonglong> ints;
+
+		/**
+		*  QVector<float> floats
+		*  \brief Values of FLOAT column
+		*/
+		QVector<float> floats;
+
+		/**
+		*  QVector<double> doubles
+		*  \brief Values of DOUBLE column
+		*/
+		QVector<double> doubles;
+
+		/**
+		*  QVector<int> strings
+		*  \brief Values of STRING column - indexes to the dictionary
+		*/
+		QVector<int> strings;
+
+		/**
+		*  QBitArray bools
+		*  \brief Values of BOOL column
+		*/
+		QBitArray bools;
+
+		/**
+		*  QVector<QString> dictionary
+		*  \brief Different values of STRING column
+		*/
+		QVector<QString> dictionary;
+
+		/**
+		*  QHash<QString,int> dictionaryIndex
+		*  \brief Indexes of the values in the dictionary
+		*/
+		QHash<QString, int> dictionaryIndex;
+	};
+
+	/**
+	*  \class AttributeStore
+	*  \brief Columnar store of the attributes of Nodes or Edges of a Graph
+	*
+	*	Each Node (Edge) gets one row identified by its id, each attribute is stored in one typed column. Store is filled by the importers
+	*	instead of concatenating the attributes into the names of the elements.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class AttributeStore
+	{
+	public:
+
+		/**
+		*  \fn public constructor  AttributeStore
+		*  \brief Creates empty store
+		*/
+		AttributeStore(void);
+
+		/**
+		*  \fn public constructor  AttributeStore(const AttributeStore &other)
+		*  \brief Creates copy of the store
+		*
+		*	Values of the columns are implicitly shared, so the copy costs only a few reference counter increments and the data are copied
+		*	only when the original or the copy is changed. Copy can be therefore used as a consistent view of the attributes on another thread
+		*	(e.g. by the exporters) while the original is being edited.
+		*  \param  other   copied store
+		*/
+		AttributeStore(const AttributeStore &other);
+
+		/**
+		*  \fn public  operator=(const AttributeStore &other)
+		*  \brief Replaces columns and rows of the store by the copies of the other store
+		*  \param  other   copied store
+		*  \return Data::AttributeStore & this store
+		*/
+		AttributeStore & operator=(const AttributeStore &other);
+
+		/**
+		*  \fn public destructor  ~AttributeStore
+		*  \brief Destroys the store and its columns
+		*/
+		~AttributeStore(void);
+
+		/**
+		*  \fn public  addColumn(QString name, AttributeColumn::ValueType valueType)
+		*  \brief Adds new column to the store
+		*  \param  name   name of the attribute
+		*  \param  valueType   type of the values
+		*  \return Data::AttributeColumn * new column, or existing column with the same name
+		*/
+		Data::AttributeColumn * addColumn(QString name, AttributeColumn::ValueType valueType);
+
+		/**
+		*  \fn public  removeColumn(QString name)
+		*  \brief Removes the column and all its values
+		*  \param  name   name of the attribute
+		*/
+		void removeColumn(QString name);
+
+		/**
+		*  \fn public constant  getColumn(QString name)
+		*  \brief Returns column of the attribute
+		*  \param  name   name of the attribute
+		*  \return Data::AttributeColumn * column of the attribute, NULL if the column does not exist
+		*/
+		Data::AttributeColumn * getColumn(QString name) const;
+
+		/**
+		*  \fn public constant  getColumnNames
+		*  \brief Returns names of all attributes
+		*  \return QStringList names of the attributes in the order they were added
+		*/
+		QStringList getColumnNames() const;
+
+		/**
+		*  \fn public  addRow(qlonglong id)
+		*  \brief Returns row of the element, adds new row (or reuses a removed one) if the element has none yet
+		*  \param  id   id of the Node (Edge)
+		*  \return int row of the element
+		*/
+		int addRow(qlonglong id);
+
+		/**
+		*  \fn inline public constant  getRow(qlonglong id)
+		*  \brief Returns row of the element
+		*  \param  id   id of the Node (Edge)
+		*  \return int row of the element, -1 if the element has no row
+		*/
+		int getRow(qlonglong id) const { return rows.value(id, -1); }
+
+		/**
+		*  \fn inline public constant  getId(int row)
+		*  \brief Returns id of the element stored in the row
+		*  \param  row   row of the store
+		*  \return qlonglong id of the Node (Edge), -1 if the row was removed
+		*/
+		qlonglong getId(int row) const { return ids.at(row); }
+
+		/**
+		*  \fn public  removeRow(qlonglong id)
+		*  \brief Removes values of the element from all columns, the row is reused by the next added element
+		*  \param  id   id of the Node (Edge)
+		*/
+		void removeRow(qlonglong id);
+
+		/**
+		*  \fn public  setValue(qlonglong id, QString name, const QString &text)
+		*  \brief Sets value of the attribute of the element, STRING column is created if the attribute does not exist
+		*  \param  id   id of the Node (Edge)
+		*  \param  name   name of the attribute
+		*  \param  text   value in text form
+		*  \return bool true, if the value was converted to the type of the column
+		*/
+		bool setValue(qlonglong id, QString name, const QString &text);
+
+		/**
+		*  \fn public constant  getValue(qlonglong id, QString name)
+		*  \brief Returns value of the attribute of the element
+		*  \param  id   id of the Node (Edge)
+		*  \param  name   name of the attribute
+		*  \return QVariant value of the attribute, invalid QVariant if the element has no value
+		*/
+		QVariant getValue(qlonglong id, QString name) const;
+
+		/**
+		*  \fn public constant  selectEqual(QString name, const QVariant &value)
+		*  \brief Returns ids of the elements with the value of the attribute
+		*  \param  name   name of the attribute
+		*  \param  value   searched value
+		*  \return QList<qlonglong> ids of the Nodes (Edges)
+		*/
+		QList<qlonglong> selectEqual(QString name, const QVariant &value) const;
+
+		/**
+		*  \fn public constant  selectRange(QString name, double min, double max)
+		*  \brief Returns ids of the elements with the numeric value of the attribute in the interval <min, max>
+		*  \param  name   name of the attribute
+		*  \param  min   lower bound
+		*  \param  max   upper bound
+		*  \return QList<qlonglong> ids of the Nodes (Edges)
+		*/
+		QList<qlonglong> selectRange(QString name, double min, double max) const;
+
+		/**
+		*  \fn inline public constant  rowCount
+		*  \brief Returns count of the rows (including removed rows, which were not reused yet)
+		*  \return int count of the rows
+		*/
+		int rowCount() const { return ids.size(); }
+
+		/**
+		*  \fn public  clear
+		*  \brief Removes all columns and rows
+		*/
+		void clear();
+
+	private:
+
+		/**
+		*  \fn private constant  rowsToIds(const QVector<int> &selectedRows)
+		*  \brief Converts rows to ids of the elements, skips removed rows
+		*  \param  selectedRows   rows of the store
+		*  \return QList<qlonglong> ids of the Nodes (Edges)
+		*/
+		QList<qlonglong> rowsToIds(const QVector<int> &selectedRows) const;
+
+		/**
+		*  QVector<Data::AttributeColumn *> columns
+		*  \brief Columns of the store
+		*/
+		QVector<Data::AttributeColumn *> columns;
+
+		/**
+		*  QHash<QString,int> columnsByName
+		*  \brief Indexes of the columns by the name of the attribute
+		*/
+		QHash<QString, int> columnsByName;
+
+		/**
+		*  QVector<qlonglong> ids
+		*  \brief Ids of the elements by rows
+		*/
+		QVector<qlonglong> ids;
+
+		/**
+		*  QHash<qlonglong,int> rows
+		*  \brief Rows by ids of the elements
+		*/
+		QHash<qlonglong, int> rows;
+
+		/**
+		*  QVector<int> freeRows
+		*  \brief Removed rows, which can be reused by new elements
+		*/
+		QVector<int> freeRows;
+	};
+}
+
+#endif
@@ -0,0 +1,170 @@
+/*!
+ * Bitmap.h
+ * Projekt 3DVisual
+ */
+
+#ifndef DATA_BITMAP_DEF
+#define DATA_BITMAP_DEF 1
+
+#include <QMap>
+#include <QVector>
+#include <QList>
+
+namespace Data
+{
+	/**
+	*  \class Bitmap
+	*  \brief Compressed set of ids of the elements of a Graph
+	*
+	*	Ids are split into chunks by their upper bits (65536 ids per chunk). Sparse chunk is stored as a sorted array of the lower 16 bits,
+	*	dense chunk (more than 4096 ids) as a plain bitset of 8 kB. Set operations are made chunk by chunk, so they are fast even for millions of ids.
+	*	Bitmap is implicitly shared, copying it is cheap.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class Bitmap
+	{
+	public:
+
+		/**
+		*  \fn public constructor  Bitmap
+		*  \brief Creates empty bitmap
+		*/
+		Bitmap(void);
+
+		/**
+		*  \fn public  add(qlonglong id)
+		*  \brief Adds the id to the bitmap
+		*  \param  id   added id
+		*/
+		void add(qlonglong id);
+
+		/**
+		*  \fn public  remove(qlonglong id)
+		*  \brief Removes the id from the bitmap
+		*  \param  id   removed id
+		*/
+		void remove(qlonglong id);
+
+		/**
+		*  \fn public  set(qlonglong id, bool value)
+		*  \brief Adds the id to the bitmap or removes it
+		*  \param  id   id
+		*  \param  value   true, if the id is added
+		*/
+		void set(qlonglong id, bool value) { if(value) add(id); else remove(id); }
+
+		/**
+		*  \fn public constant  contains(qlonglong id)
+		*  \brief Returns true, if the bitmap contains the id
+		*  \param  id   searched id
+		*  \return bool true, if the bitmap contains the id
+		*/
+		bool contains(qlonglong id) const;
+
+		/**
+		*  \fn public constant  count
+		*  \brief Returns count of the ids in the bitmap
+		*  \return int count of the ids
+		*/
+		int count() const;
+
+		/**
+		*  \fn inline public constant  isEmpty
+		*  \brief Returns true, if the bitmap contains no id
+		*  \return bool true, if the bitmap is empty
+		*/
+		bool isEmpty() const { return chunks.isEmpty(); }
+
+		/**
+		*  \fn inline public  clear
+		*  \brief Removes all ids
+		*/
+		void clear() { chunks.clear(); }
+
+		/**
+		*  \fn public constant  operator&(const Bitmap &other)
+		*  \brief Returns intersection of the bitmaps
+		*  \param  other   second bitmap
+		*  \return Bitmap ids contained in both bitmaps
+		*/
+		Bitmap operator&(const Bitmap &other) const;
+
+		/**
+		*  \fn public constant  operator|(const Bitmap &other)
+		*  \brief Returns union of the bitmaps
+		*  \param  other   second bitmap
+		*  \return Bitmap ids contained in any of the bitmaps
+		*/
+		Bitmap operator|(const Bitmap &other) const;
+
+		/**
+		*  \fn public constant  andNot(const Bitmap &other)
+		*  \brief Returns difference of the bitmaps
+		*  \param  other   second bitmap
+		*  \return Bitmap ids contained in this bitmap and not in the other
+		*/
+		Bitmap andNot(const Bitmap &other) const;
+
+		/**
+		*  \fn public constant  toList
+		*  \brief Returns all ids of the bitmap
+		*  \return QList<qlonglong> ids in ascending order
+		*/
+		QList<qlonglong> toList() const;
+
+	private:
+
+		/**
+		*  \class Chunk
+		*  \brief Ids with the same upper bits - sorted array of the lower bits or bitset
+		*/
+		class Chunk
+		{
+		public:
+
+			/**
+			*  QVector<quint16> values
+			*  \brief Sorted lower bits of the ids, if the chunk is sparse
+			*/
+			QVector<quint16> values;
+
+			/**
+			*  QVector<quint64> bits
+			*  \brief Bitset of the lower bits of the ids, if the chunk is dense (empty otherwise)
+			*/
+			QVector<quint64> bits;
+
+			/**
+			*  int cardinality
+			*  \brief Count of the ids in the chunk
+			*/
+			int cardinality;
+
+			Chunk() : cardinality(0) {}
+
+			bool isDense() const { return !bits.isEmpty(); }
+			bool contains(quint16 value) const;
+			void add(quint16 value);
+			void remove(quint16 value);
+			void toDense();
+			void toSparse();
+			void normalize();
+			QVector<quint64> denseBits() const;
+		};
+
+		/**
+		*  \fn private static  fromBits(const QVector<quint64> &bits)
+		*  \brief Creates chunk from bitset and chooses its representation by the count of the ids
+		*/
+		static Chunk fromBits(const QVector<quint64> &bits);
+
+		/**
+		*  QMap<qlonglong,Chunk> chunks
+		*  \brief Non-empty chunks by the upper bits of the ids
+		*/
+		QMap<qlonglong, Chunk> chunks;
+	};
+}
+
+#endif
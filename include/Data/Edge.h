@@ -66,11 +66,22 @@ namespace Data
 		qlonglong getId() const { return id; }
 
 		/**
-		*  \fn inline public  getName
+		*  \fn public constant  getName
 		*  \brief Returns the name of the Edge
+		*
+		*	If the Edge has been created with a null name (importers do so to save memory), the name is derived from the names of
+		*	its Nodes (source name + destination name) on each call.
+		*
 		*  \return QString name of the Edge
 		*/
-		QString getName() const { return name; }
+		QString getName() const;
+
+		/**
+		*  \fn inline public constant  hasOwnName
+		*  \brief Returns true, if the name of the Edge has been set, false if it is derived from the names of its Nodes
+		*  \return bool
+		*/
+		bool hasOwnName() const { return !name.isNull(); }
 
 		/**
 		*  \fn inline public  setName(QString val) 
@@ -169,6 +180,9 @@ namespace Data
 		/**
 		* \fn public unlinkNodes
 		* \brief Unlinks the Edge from the Nodes
+		*
+		*	The Edge is removed from the edge lists of the Nodes, but it keeps its Nodes until it is destroyed, so readers
+		*	of a snapshot holding the Edge (e.g. the layout thread) never see the Nodes changed.
 		*/
 		void unlinkNodes();
 
@@ -185,7 +199,7 @@ namespace Data
 		*/
 		QString toString() const {
 			QString str;
-			QTextStream(&str) << "edge id:" << id << " name:" << name;
+			QTextStream(&str) << "edge id:" << id << " name:" << getName();
 			return str;
 		}
 
@@ -345,7 +359,7 @@ namespace Data
 		//! Meno hrany. 
 		/**
 		*  QString name
-		*  \brief Name of the Edge
+		*  \brief Name of the Edge, null if the name is derived from the names of the Nodes
 		*/
 		QString name;
 
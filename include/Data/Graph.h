@@ -13,6 +13,10 @@
 #include "Data/Edge.h"
 #include "Data/MetaType.h"
 #include "Data/GraphLayout.h"
+#include "Data/GraphSnapshot.h"
+#include "Data/AttributeStore.h"
+#include "Data/StringTable.h"
+#include "Data/GraphIndex.h"
 #include "Model/GraphDAO.h"
 #include "Model/GraphLayoutDAO.h"
 #include "Model/TypeDAO.h"
@@ -23,6 +27,11 @@
 #include <QString>
 #include <QTextStream>
 #include <QList>
+#include <QVector>
+#include <QHash>
+#include <QPair>
+#include <QMutex>
+#include <QSharedPointer>
 #include <QDebug>
 #include <QtSql>
 #include <QMutableMapIterator>
@@ -38,6 +47,7 @@ namespace Data
     class Edge;
 	class MetaType;
     class GraphLayout;
+	class GraphCommand;
     
 	/**
 	*  \class Graph
@@ -152,7 +162,7 @@ namespace Data
 		*  \brief Returns current value of element ID counter
 		*  \return qlonglong current value of element ID counter
 		*/
-		qlonglong getEleIdCounter() { return ele_id_counter; } 
+		qlonglong getEleIdCounter() { QMutexLocker locker(&structureMutex); return ele_id_counter; } 
 
 		/**
 		*  \fn inline public  getLayoutIdCounter
@@ -228,6 +238,44 @@ namespace Data
 		*/
 		osg::ref_ptr<Data::Node> addNode(qlonglong id, QString name, Data::Type* type, osg::Vec3f position = osg::Vec3f(0,0,0)); 
 
+		/**
+		*  \fn public  beginBulkInsert(qlonglong expectedNodes = 0, qlonglong expectedEdges = 0)
+		*  \brief Starts bulk construction of the Graph
+		*
+		*	Until commitBulkInsert is called, addNode and addEdge only create the elements and append them to flat arrays.
+		*	Node and Edge lists of the Graph, lists sorted by Type and links between Nodes and Edges are built at commit time.
+		*	Parallel Edges are detected through a hash of Node pairs instead of scanning the Edges of the source Node.
+		*	Bulk construction may be nested, only the outermost commitBulkInsert builds the lists.
+		*	Name of the Graph set during bulk construction is stored to the DB at commit time.
+		*
+		*  \param   expectedNodes     expected count of added Nodes (used to reserve capacity, 0 if unknown)
+		*  \param   expectedEdges     expected count of added Edges (used to reserve capacity, 0 if unknown)
+		*/
+		void beginBulkInsert(qlonglong expectedNodes = 0, qlonglong expectedEdges = 0);
+
+		/**
+		*  \fn public  commitBulkInsert
+		*  \brief Finishes bulk construction of the Graph and builds all lists of the added Nodes and Edges
+		*/
+		void commitBulkInsert();
+
+		/**
+		*  \fn public  flushBulkInsert
+		*  \brief Builds the lists of the Nodes and Edges added so far, bulk construction of the Graph continues
+		*
+		*	Used to show already added Nodes and Edges while the rest of the Graph is still being constructed.
+		*
+		*  \return QList<osg::ref_ptr<Data::Node> > Nodes inserted to the lists of the Graph by this call
+		*/
+		QList<osg::ref_ptr<Data::Node> > flushBulkInsert();
+
+		/**
+		*  \fn inline public constant  isBulkInsert
+		*  \brief Returns true, if bulk construction of the Graph is in progress
+		*  \return bool true, if beginBulkInsert was called and commitBulkInsert was not called yet
+		*/
+		bool isBulkInsert() const { return bulkInsert; }
+
 		/**
 		*  \fn public  mergeNodes(QLinkedList<osg::ref_ptr<Data::Node> > * selectedNodes, osg::Vec3f position)
 		*  \brief Merge selected nodes to one (meta) node
@@ -244,6 +292,37 @@ namespace Data
 		*/
 		void separateNodes(QLinkedList<osg::ref_ptr<Data::Node> > * selectedNodes);
 
+		/**
+		*  \fn public  isMergedNode(qlonglong id)
+		*  \brief Returns true, if the Node was created by mergeNodes and was not separated yet
+		*  \param   id   id of the Node
+		*  \return bool true, if the Node is merged Node
+		*/
+		bool isMergedNode(qlonglong id);
+
+		/**
+		*  \fn public  getMergedNodes(qlonglong id)
+		*  \brief Returns Nodes merged into the merged Node
+		*  \param   id   id of the merged Node
+		*  \return QList<osg::ref_ptr<Data::Node> > merged Nodes, empty if the Node is not merged Node
+		*/
+		QList<osg::ref_ptr<Data::Node> > getMergedNodes(qlonglong id);
+
+		/**
+		*  \fn public  getMergedGroups
+		*  \brief Returns groups of all merged Nodes (saved with the layout, see Model::GraphLayoutWriter)
+		*  \return QHash<qlonglong, QList<osg::ref_ptr<Data::Node> > > merged Nodes by id of the merged Node
+		*/
+		QHash<qlonglong, QList<osg::ref_ptr<Data::Node> > > getMergedGroups();
+
+		/**
+		*  \fn public  restoreMergedGroup(qlonglong id, const QList<osg::ref_ptr<Data::Node> > &mergedNodes)
+		*  \brief Sets the group of the merged Node loaded from DB, so it can be separated again
+		*  \param   id   id of the merged (meta) Node
+		*  \param   mergedNodes   Nodes merged into the merged Node
+		*/
+		void restoreMergedGroup(qlonglong id, const QList<osg::ref_ptr<Data::Node> > &mergedNodes);
+
 		/**
 		*  \fn public  createNestedGraph(osg::ref_ptr<Data::Node> srcNode)
 		*  \brief creates nested graph where can be added nested nodes and edges
@@ -336,6 +415,17 @@ namespace Data
 		*/
 		void removeNode(osg::ref_ptr<Data::Node> node);
 
+		/**
+		*  \fn public  removeNodes(QList<osg::ref_ptr<Data::Node> > nodesToRemove)
+		*  \brief Removes set of Nodes and their Edges from the Graph
+		*
+		*	Nodes are removed from database in one transaction (their Edges are removed by ON DELETE CASCADE), if it fails, the stored Nodes
+		*	and their Edges are kept in the Graph. Restrictions are updated once and each list of the Graph is compacted once.
+		*
+		*  \param      nodesToRemove   the Nodes to be removed from the Graph
+		*/
+		void removeNodes(QList<osg::ref_ptr<Data::Node> > nodesToRemove);
+
 		/**
 		*  \fn public  isInSameGraph(osg::ref_ptr<Data::Node> nodeA, osg::ref_ptr<Data::Node> nodeB)
 		*  \brief recognize if nodes are in same graph
@@ -383,6 +473,16 @@ namespace Data
 		void removeEdge(osg::ref_ptr<Data::Edge> edge);
         
 
+		/**
+		*  \fn public  removeEdges(QList<osg::ref_ptr<Data::Edge> > edgesToRemove)
+		*  \brief Removes set of Edges from the Graph
+		*
+		*	Edges are removed from database in one transaction and each list of the Graph is compacted once.
+		*
+		*  \param       edgesToRemove the Edges to be removed from the Graph
+		*/
+		void removeEdges(QList<osg::ref_ptr<Data::Edge> > edgesToRemove);
+
 		/**
 		*  \fn public  removeType(Data::Type* type)
 		*  \brief Removes a Type from the Graph
@@ -425,11 +525,93 @@ namespace Data
 
 		/**
 		*  \fn inline public constant  getTypes
-		*  \brief Returns QMap of the Types assigned to the Graph
+		*  \brief Returns QMap of the Types assigned to the Graph (lock getStructureMutex while it is read during an import)
 		*  \return QMap<qlonglong,Data::Type*> * Tyeps assigned to the Graph
 		*/
 		QMap<qlonglong, Data::Type*>* getTypes() const { return types; }
 
+		/**
+		*  \fn inline public  getNodeAttributes
+		*  \brief Returns attributes of the Nodes of the Graph
+		*  \return Data::AttributeStore * columnar store of the attributes of the Nodes
+		*/
+		Data::AttributeStore * getNodeAttributes() { return &nodeAttributes; }
+
+		/**
+		*  \fn inline public  getEdgeAttributes
+		*  \brief Returns attributes of the Edges of the Graph
+		*  \return Data::AttributeStore * columnar store of the attributes of the Edges
+		*/
+		Data::AttributeStore * getEdgeAttributes() { return &edgeAttributes; }
+
+		/**
+		*  \fn inline public  getStructureMutex
+		*  \brief Returns the mutex guarding the structure of the Graph, the Types and the attributes (importers fill them on another thread)
+		*  \return QMutex * recursive mutex of the Graph
+		*/
+		QMutex * getStructureMutex() { return &structureMutex; }
+
+		/**
+		*  \fn inline public  getStringTable
+		*  \brief Returns interned strings of the Graph (names of the Nodes read by the importers)
+		*  \return Data::StringTable * table of the interned strings
+		*/
+		Data::StringTable * getStringTable() { return &stringTable; }
+
+		/**
+		*  \fn inline public  getNodeIndex
+		*  \brief Returns bitmap indexes of the Nodes of the Graph (used by Data::GraphQuery)
+		*  \return Data::GraphIndex * index of the Nodes
+		*/
+		Data::GraphIndex * getNodeIndex() { return &nodeIndex; }
+
+
+		/**
+		*  \fn public  getSnapshot
+		*  \brief Returns immutable snapshot of the Node and Edge lists of the Graph
+		*
+		*	Snapshot is created only if the structure of the Graph has changed since the last call, otherwise the last snapshot is returned.
+		*	Readers running in other threads (layout, viewer, database writers) should iterate the snapshot instead of the lists returned by getNodes, getEdges, ...
+		*
+		*  \return QSharedPointer<Data::GraphSnapshot> current snapshot of the Graph
+		*/
+		QSharedPointer<Data::GraphSnapshot> getSnapshot();
+
+		/**
+		*  \fn public  getVersion
+		*  \brief Returns version of the Graph structure, which is incremented by each addition or removal of Node or Edge
+		*  \return qlonglong version of the Graph structure
+		*/
+		qlonglong getVersion();
+
+		/**
+		*  \fn public  enqueueCommand(Data::GraphCommand * command)
+		*  \brief Adds change of the Graph structure to the queue, the Graph takes ownership of the command
+		*
+		*	Queued commands are applied once per frame by the viewer through Layout::FRAlgorithm::ApplyGraphCommands, which calls applyCommands
+		*	between two iterations of the layout. Layout algorithm iterates a snapshot of the Graph, so it sees all of them in its next iteration.
+		*
+		*  \param  command   queued command
+		*/
+		void enqueueCommand(Data::GraphCommand * command);
+
+		/**
+		*  \fn public  applyCommands
+		*  \brief Applies all queued commands as one change of the Graph structure
+		*
+		*	Consecutive commands of the same kind are merged (GraphCommand::merge), consecutive inserting commands are applied in one bulk insert.
+		*	Must be called by the thread owning the Graph (connection to the database) while the layout does not iterate the Graph.
+		*
+		*  \return bool true, if some command was applied
+		*/
+		bool applyCommands();
+
+		/**
+		*  \fn public  hasQueuedCommands
+		*  \brief Returns true, if some commands are waiting in the queue
+		*  \return bool true, if the queue is not empty
+		*/
+		bool hasQueuedCommands();
 
 		/**
 		*  \fn inline public constant  isFrozen
@@ -521,7 +703,7 @@ namespace Data
 		*  \fn inline public  setEleIdCounter
 		*  \brief Set element ID counter
 		*/
-		void setEleIdCounter(qlonglong number) { ele_id_counter = number; } 
+		void setEleIdCounter(qlonglong number) { QMutexLocker locker(&structureMutex); ele_id_counter = number; } 
 
     private:
 
@@ -539,6 +721,12 @@ namespace Data
 		*/
 		qlonglong incLayoutIdCounter() { return ++layout_id_counter; } 
 
+		/**
+		*  \fn inline private  structureChanged
+		*  \brief Increments version of the Graph structure (structureMutex must be locked)
+		*/
+		void structureChanged() { ++version; }
+
 		/**
 		* \fn	private removeAllEdgesOfType(Data::Type* type)
 		* \brief Removes all Edges that are of type
@@ -554,6 +742,57 @@ namespace Data
         void removeAllNodesOfType(Data::Type* type); 
        
 
+		/**
+		*  \fn private  getNestedNodeType
+		*  \brief Returns Type of the nested Nodes, creates it if not exists (cached during bulk construction)
+		*  \return Data::Type * Type of the nested Nodes
+		*/
+		Data::Type* getNestedNodeType();
+
+		/**
+		*  \fn private  addBulkMultiEdge(QString name, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type* type, bool isOriented)
+		*  \brief Adds MultiEdge instead of the Edge, if srcNode and dstNode are already connected (used during bulk construction)
+		*  \param   name     name of the Edge
+		*  \param   srcNode    starting Node of the Edge
+		*  \param   dstNode     ending Node of the Edge
+		*  \param   type    Type of the Edge
+		*  \param   isOriented   true, if the Edge is oriented
+		*  \return bool true, if the MultiEdge was added
+		*/
+		bool addBulkMultiEdge(QString name, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type* type, bool isOriented);
+
+		/**
+		*  \fn private  addBulkEdge(osg::ref_ptr<Data::Edge> edge)
+		*  \brief Appends the Edge to the edges added during bulk construction
+		*  \param   edge     the added Edge
+		*/
+		void addBulkEdge(osg::ref_ptr<Data::Edge> edge);
+
+		/**
+		*  \fn private  commitBulkNodes
+		*  \brief Inserts Nodes added during bulk construction to the lists of the Graph
+		*/
+		void commitBulkNodes();
+
+		/**
+		*  \fn private  commitBulkEdges
+		*  \brief Links Edges added during bulk construction with their Nodes and inserts them to the lists of the Graph
+		*/
+		void commitBulkEdges();
+
+		/**
+		*  \fn private  commitBulkElements
+		*  \brief Inserts Nodes and Edges added since the last commit to the lists of the Graph (structureMutex must be locked)
+		*/
+		void commitBulkElements();
+
+		/**
+		*  \fn private  removeEdgesFromLists(QList<osg::ref_ptr<Data::Edge> > edgesToRemove)
+		*  \brief Removes Edges from the lists of the Graph and unlinks them from their Nodes (database is not changed)
+		*  \param      edgesToRemove   the Edges to be removed
+		*/
+		void removeEdgesFromLists(QList<osg::ref_ptr<Data::Edge> > edgesToRemove);
+
 		/**
 		*  \fn private  getMaxEleIdFromElements
 		*  \brief Returns the maximum value of IDs of all elements of the Graph
@@ -714,6 +953,138 @@ namespace Data
 		*/
         QMultiMap<qlonglong, osg::ref_ptr<Data::Node> > metaNodesByType;
 
+		/**
+		*  qlonglong version
+		*  \brief Version of the Graph structure
+		*/
+		qlonglong version;
+
+		/**
+		*  QMutex structureMutex
+		*  \brief Recursive mutex guarding the Node and Edge lists, the Types, the nested graphs and the attributes while they are changed or a snapshot is taken
+		*/
+		QMutex structureMutex;
+
+		/**
+		*  QSharedPointer<Data::GraphSnapshot> snapshot
+		*  \brief Last snapshot of the Graph
+		*/
+		QSharedPointer<Data::GraphSnapshot> snapshot;
+
+		/**
+		*  QList<Data::GraphCommand *> commands
+		*  \brief Queued changes of the Graph structure
+		*/
+		QList<Data::GraphCommand *> commands;
+
+		/**
+		*  QMutex commandsMutex
+		*  \brief Mutex guarding the queue of commands
+		*/
+		QMutex commandsMutex;
+
+		/**
+		*  Data::AttributeStore nodeAttributes
+		*  \brief Attributes of the Nodes (imported data)
+		*/
+		Data::AttributeStore nodeAttributes;
+
+		/**
+		*  Data::AttributeStore edgeAttributes
+		*  \brief Attributes of the Edges (imported data)
+		*/
+		Data::AttributeStore edgeAttributes;
+
+		/**
+		*  Data::StringTable stringTable
+		*  \brief Interned strings of the Graph
+		*/
+		Data::StringTable stringTable;
+
+		/**
+		*  Data::GraphIndex nodeIndex
+		*  \brief Bitmap indexes of the Nodes by Type and flags
+		*/
+		Data::GraphIndex nodeIndex;
+
+		/**
+		*  QHash<qlonglong,QList<osg::ref_ptr<Data::Node> > > mergedGroups
+		*  \brief Nodes merged into each merged Node by id of the merged Node
+		*/
+		QHash<qlonglong, QList<osg::ref_ptr<Data::Node> > > mergedGroups;
+
+		/**
+		*  bool bulkInsert
+		*  \brief Flag if bulk construction of the Graph is in progress
+		*/
+		bool bulkInsert;
+
+		/**
+		*  int bulkInsertDepth
+		*  \brief Count of nested beginBulkInsert calls not yet committed
+		*/
+		int bulkInsertDepth;
+
+		/**
+		*  bool bulkNameChanged
+		*  \brief Flag if the name of the Graph was changed during bulk construction and is not yet stored to the DB
+		*/
+		bool bulkNameChanged;
+
+		/**
+		*  QVector<osg::ref_ptr<Data::Node> > bulkNodes
+		*  \brief Nodes added during bulk construction, not yet inserted to the lists of the Graph
+		*/
+		QVector<osg::ref_ptr<Data::Node> > bulkNodes;
+
+		/**
+		*  QVector<osg::ref_ptr<Data::Edge> > bulkEdges
+		*  \brief Edges added during bulk construction, not yet linked with their Nodes (NULL if replaced by MultiEdge)
+		*/
+		QVector<osg::ref_ptr<Data::Edge> > bulkEdges;
+
+		/**
+		*  QHash<QPair<qlonglong,qlonglong>,int> bulkEdgePairs
+		*  \brief Index of Edge in bulkEdges for each connected pair of Nodes (-1 if the pair is connected by MultiEdges)
+		*/
+		QHash<QPair<qlonglong, qlonglong>, int> bulkEdgePairs;
+
+		/**
+		*  int bulkNodesCommitted
+		*  \brief Count of Nodes from bulkNodes already inserted to the lists of the Graph by flushBulkInsert
+		*/
+		int bulkNodesCommitted;
+
+		/**
+		*  int bulkEdgesCommitted
+		*  \brief Count of Edges from bulkEdges already linked with their Nodes by flushBulkInsert
+		*/
+		int bulkEdgesCommitted;
+
+		/**
+		*  QList<osg::ref_ptr<Data::Edge> > bulkReplacedEdges
+		*  \brief Edges already linked by flushBulkInsert and later replaced by MultiEdge, removed at the next commit
+		*/
+		QList<osg::ref_ptr<Data::Edge> > bulkReplacedEdges;
+
+		/**
+		*  Data::Type * bulkNestedNodeType
+		*  \brief Type of the nested Nodes cached during bulk construction
+		*/
+		Data::Type* bulkNestedNodeType;
+
+		/**
+		*  float bulkNodeScale
+		*  \brief Default scale of the Nodes cached during bulk construction
+		*/
+		float bulkNodeScale;
+
+		/**
+		*  float bulkEdgeScale
+		*  \brief Default scale of the Edges cached during bulk construction
+		*/
+		float bulkEdgeScale;
+
         /**
 		 * \brief Restrictions manager of this graph (object storing restrictions and providing
 		 * interface for setting restrictions and getting restricted positions).
@@ -0,0 +1,377 @@
+/*!
+ * GraphCommand.h
+ * Projekt 3DVisual
+ */
+
+#ifndef DATA_GRAPHCOMMAND_DEF
+#define DATA_GRAPHCOMMAND_DEF 1
+
+#include <osg/ref_ptr>
+#include <osg/Vec3f>
+#include <osg/Camera>
+
+#include <QString>
+#include <QList>
+#include <QLinkedList>
+
+namespace Data
+{
+	class Graph;
+	class Node;
+	class Edge;
+	class Type;
+
+	/**
+	*  \class GraphCommand
+	*  \brief Deferred change of the Graph structure
+	*
+	*	Commands are queued by Graph::enqueueCommand and applied all at once by Graph::applyCommands between two iterations of the layout
+	*	(Layout::FRAlgorithm::ApplyGraphCommands), so a batch of edits is visible to the readers of the Graph (layout, viewer) as a single
+	*	structural change. Command copies everything it needs at the time it is created.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class GraphCommand
+	{
+	public:
+
+		/**
+		*  \fn public virtual destructor  ~GraphCommand
+		*  \brief Destroys the command
+		*/
+		virtual ~GraphCommand(void) {}
+
+		/**
+		*  \fn public abstract  apply(Data::Graph * graph)
+		*  \brief Applies the command to the Graph (Graph structure is locked by the caller)
+		*  \param  graph   changed Graph
+		*/
+		virtual void apply(Data::Graph * graph) = 0;
+
+		/**
+		*  \fn public virtual  merge(Data::GraphCommand * next)
+		*  \brief Tries to join the next queued command into this one
+		*  \param  next   command queued right after this command
+		*  \return bool true, if the next command was joined and must not be applied separately
+		*/
+		virtual bool merge(Data::GraphCommand * next) { return false; }
+
+		/**
+		*  \fn public virtual constant  isInsert
+		*  \brief Returns true, if the command only adds new elements to the Graph
+		*
+		*	Consecutive inserting commands are applied in one bulk insert of the Graph (Graph::beginBulkInsert).
+		*
+		*  \return bool true, if the command only adds elements
+		*/
+		virtual bool isInsert() const { return false; }
+	};
+
+	/**
+	*  \class AddNodeCommand
+	*  \brief Adds new Node to the Graph
+	*
+	*  \date 19. 10. 2026
+	*/
+	class AddNodeCommand : public GraphCommand
+	{
+	public:
+
+		/**
+		*  \fn public constructor  AddNodeCommand(QString name, Data::Type * type, osg::Vec3f position)
+		*  \brief Creates command adding new Node
+		*  \param  name   name of the Node
+		*  \param  type   Type of the Node
+		*  \param  position   position of the Node
+		*/
+		AddNodeCommand(QString name, Data::Type * type, osg::Vec3f position);
+
+		/**
+		*  \fn public virtual  apply(Data::Graph * graph)
+		*  \brief Adds the Node to the Graph
+		*  \param  graph   changed Graph
+		*/
+		virtual void apply(Data::Graph * graph);
+
+		/**
+		*  \fn public virtual constant  isInsert
+		*  \brief Returns true, the command only adds elements
+		*/
+		virtual bool isInsert() const { return true; }
+
+	private:
+
+		/**
+		*  QString name
+		*  \brief Name of the Node
+		*/
+		QString name;
+
+		/**
+		*  Data::Type * type
+		*  \brief Type of the Node
+		*/
+		Data::Type * type;
+
+		/**
+		*  osg::Vec3f position
+		*  \brief Position of the Node
+		*/
+		osg::Vec3f position;
+	};
+
+	/**
+	*  \class AddEdgeCommand
+	*  \brief Adds new Edge to the Graph
+	*
+	*  \date 19. 10. 2026
+	*/
+	class AddEdgeCommand : public GraphCommand
+	{
+	public:
+
+		/**
+		*  \fn public constructor  AddEdgeCommand(QString name, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type * type, bool isOriented)
+		*  \brief Creates command adding new Edge
+		*  \param  name   name of the Edge
+		*  \param  srcNode   starting Node of the Edge
+		*  \param  dstNode   ending Node of the Edge
+		*  \param  type   Type of the Edge
+		*  \param  isOriented   true, if the Edge is oriented
+		*/
+		AddEdgeCommand(QString name, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type * type, bool isOriented);
+
+		/**
+		*  \fn public virtual  apply(Data::Graph * graph)
+		*  \brief Adds the Edge to the Graph, if both its Nodes are still in the Graph
+		*  \param  graph   changed Graph
+		*/
+		virtual void apply(Data::Graph * graph);
+
+		/**
+		*  \fn public virtual constant  isInsert
+		*  \brief Returns true, the command only adds elements
+		*/
+		virtual bool isInsert() const { return true; }
+
+	private:
+
+		/**
+		*  QString name
+		*  \brief Name of the Edge
+		*/
+		QString name;
+
+		/**
+		*  osg::ref_ptr<Data::Node> srcNode
+		*  \brief Starting Node of the Edge
+		*/
+		osg::ref_ptr<Data::Node> srcNode;
+
+		/**
+		*  osg::ref_ptr<Data::Node> dstNode
+		*  \brief Ending Node of the Edge
+		*/
+		osg::ref_ptr<Data::Node> dstNode;
+
+		/**
+		*  Data::Type * type
+		*  \brief Type of the Edge
+		*/
+		Data::Type * type;
+
+		/**
+		*  bool isOriented
+		*  \brief Flag if the Edge is oriented
+		*/
+		bool isOriented;
+	};
+
+	/**
+	*  \class AddMetaNodeCommand
+	*  \brief Adds new meta-Node connected by meta-Edges with the given Nodes
+	*
+	*  \date 19. 10. 2026
+	*/
+	class AddMetaNodeCommand : public GraphCommand
+	{
+	public:
+
+		/**
+		*  \fn public constructor  AddMetaNodeCommand(QLinkedList<osg::ref_ptr<Data::Node> > nodes, osg::Vec3f position, osg::ref_ptr<osg::Camera> camera)
+		*  \brief Creates command adding new meta-Node
+		*  \param  nodes   Nodes connected with the meta-Node
+		*  \param  position   position of the meta-Node
+		*  \param  camera   camera of the viewer set to the meta-Edges
+		*/
+		AddMetaNodeCommand(QLinkedList<osg::ref_ptr<Data::Node> > nodes, osg::Vec3f position, osg::ref_ptr<osg::Camera> camera);
+
+		/**
+		*  \fn public virtual  apply(Data::Graph * graph)
+		*  \brief Adds the meta-Node and its meta-Edges to the Graph
+		*  \param  graph   changed Graph
+		*/
+		virtual void apply(Data::Graph * graph);
+
+		/**
+		*  \fn public virtual constant  isInsert
+		*  \brief Returns true, the command only adds elements
+		*/
+		virtual bool isInsert() const { return true; }
+
+	private:
+
+		/**
+		*  QLinkedList<osg::ref_ptr<Data::Node> > nodes
+		*  \brief Nodes connected with the meta-Node
+		*/
+		QLinkedList<osg::ref_ptr<Data::Node> > nodes;
+
+		/**
+		*  osg::Vec3f position
+		*  \brief Position of the meta-Node
+		*/
+		osg::Vec3f position;
+
+		/**
+		*  osg::ref_ptr<osg::Camera> camera
+		*  \brief Camera of the viewer
+		*/
+		osg::ref_ptr<osg::Camera> camera;
+	};
+
+	/**
+	*  \class MergeNodesCommand
+	*  \brief Merges Nodes into one Node (Graph::mergeNodes)
+	*
+	*  \date 19. 10. 2026
+	*/
+	class MergeNodesCommand : public GraphCommand
+	{
+	public:
+
+		/**
+		*  \fn public constructor  MergeNodesCommand(QLinkedList<osg::ref_ptr<Data::Node> > nodes, osg::Vec3f position)
+		*  \brief Creates command merging the Nodes
+		*  \param  nodes   merged Nodes
+		*  \param  position   position of the merged Node
+		*/
+		MergeNodesCommand(QLinkedList<osg::ref_ptr<Data::Node> > nodes, osg::Vec3f position);
+
+		/**
+		*  \fn public virtual  apply(Data::Graph * graph)
+		*  \brief Merges the Nodes
+		*  \param  graph   changed Graph
+		*/
+		virtual void apply(Data::Graph * graph);
+
+	private:
+
+		/**
+		*  QLinkedList<osg::ref_ptr<Data::Node> > nodes
+		*  \brief Merged Nodes
+		*/
+		QLinkedList<osg::ref_ptr<Data::Node> > nodes;
+
+		/**
+		*  osg::Vec3f position
+		*  \brief Position of the merged Node
+		*/
+		osg::Vec3f position;
+	};
+
+	/**
+	*  \class SeparateNodesCommand
+	*  \brief Separates merged Nodes (Graph::separateNodes)
+	*
+	*	Consecutive separate commands are merged, so the Nodes are separated by a single call of Graph::separateNodes.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class SeparateNodesCommand : public GraphCommand
+	{
+	public:
+
+		/**
+		*  \fn public constructor  SeparateNodesCommand(QLinkedList<osg::ref_ptr<Data::Node> > nodes)
+		*  \brief Creates command separating the Nodes
+		*  \param  nodes   selected Nodes
+		*/
+		SeparateNodesCommand(QLinkedList<osg::ref_ptr<Data::Node> > nodes);
+
+		/**
+		*  \fn public virtual  apply(Data::Graph * graph)
+		*  \brief Separates the Nodes
+		*  \param  graph   changed Graph
+		*/
+		virtual void apply(Data::Graph * graph);
+
+		/**
+		*  \fn public virtual  merge(Data::GraphCommand * next)
+		*  \brief Joins next separate command into this one
+		*  \param  next   command queued right after this command
+		*  \return bool true, if the next command is a separate command
+		*/
+		virtual bool merge(Data::GraphCommand * next);
+
+	private:
+
+		/**
+		*  QLinkedList<osg::ref_ptr<Data::Node> > nodes
+		*  \brief Selected Nodes
+		*/
+		QLinkedList<osg::ref_ptr<Data::Node> > nodes;
+	};
+
+	/**
+	*  \class RemoveCommand
+	*  \brief Removes Nodes and Edges from the Graph
+	*
+	*	Consecutive remove commands are merged, so they are removed by a single call of Graph::removeEdges and Graph::removeNodes.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class RemoveCommand : public GraphCommand
+	{
+	public:
+
+		/**
+		*  \fn public constructor  RemoveCommand(QList<osg::ref_ptr<Data::Node> > nodes, QList<osg::ref_ptr<Data::Edge> > edges)
+		*  \brief Creates command removing the Nodes and Edges
+		*  \param  nodes   removed Nodes
+		*  \param  edges   removed Edges
+		*/
+		RemoveCommand(QList<osg::ref_ptr<Data::Node> > nodes, QList<osg::ref_ptr<Data::Edge> > edges);
+
+		/**
+		*  \fn public virtual  apply(Data::Graph * graph)
+		*  \brief Removes the Edges and then the Nodes
+		*  \param  graph   changed Graph
+		*/
+		virtual void apply(Data::Graph * graph);
+
+		/**
+		*  \fn public virtual  merge(Data::GraphCommand * next)
+		*  \brief Joins next remove command into this one
+		*  \param  next   command queued right after this command
+		*  \return bool true, if the next command is a remove command
+		*/
+		virtual bool merge(Data::GraphCommand * next);
+
+	private:
+
+		/**
+		*  QList<osg::ref_ptr<Data::Node> > nodes
+		*  \brief Removed Nodes
+		*/
+		QList<osg::ref_ptr<Data::Node> > nodes;
+
+		/**
+		*  QList<osg::ref_ptr<Data::Edge> > edges
+		*  \brief Removed Edges
+		*/
+		QList<osg::ref_ptr<Data::Edge> > edges;
+	};
+}
+
+#endif
@@ -0,0 +1,170 @@
+/*!
+ * GraphIndex.h
+ * Projekt 3DVisual
+ */
+
+#ifndef DATA_GRAPHINDEX_DEF
+#define DATA_GRAPHINDEX_DEF 1
+
+#include "Data/Bitmap.h"
+
+#include <QHash>
+#include <QMutex>
+
+namespace Data
+{
+	class Node;
+
+	/**
+	*  \class GraphIndex
+	*  \brief Bitmap indexes of the Nodes of a Graph by Type and flags (meta, fixed, selected, ignored)
+	*
+	*	Index is updated by the Graph when a Node is added or removed and by the Node when its flags change, so it never has to be rebuilt.
+	*	Getters return copies of the bitmaps, which share data with the index until it is changed.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class GraphIndex
+	{
+	public:
+
+		/**
+		*  \fn public constructor  GraphIndex
+		*  \brief Creates empty index
+		*/
+		GraphIndex(void);
+
+		/**
+		*  \fn public  addNode(Data::Node * node)
+		*  \brief Adds the Node to the index
+		*  \param  node   added Node
+		*/
+		void addNode(Data::Node * node);
+
+		/**
+		*  \fn public  removeNode(Data::Node * node)
+		*  \brief Removes the Node from all bitmaps of the index
+		*  \param  node   removed Node
+		*/
+		void removeNode(Data::Node * node);
+
+		/**
+		*  \fn public  setFixed(qlonglong id, bool fixed)
+		*  \brief Updates fixed flag of the Node
+		*  \param  id   id of the Node
+		*  \param  fixed   fixed state of the Node
+		*/
+		void setFixed(qlonglong id, bool fixed);
+
+		/**
+		*  \fn public  setSelected(qlonglong id, bool selected)
+		*  \brief Updates selected flag of the Node
+		*  \param  id   id of the Node
+		*  \param  selected   selected state of the Node
+		*/
+		void setSelected(qlonglong id, bool selected);
+
+		/**
+		*  \fn public  setIgnored(qlonglong id, bool ignored)
+		*  \brief Updates ignored flag of the Node
+		*  \param  id   id of the Node
+		*  \param  ignored   ignored state of the Node
+		*/
+		void setIgnored(qlonglong id, bool ignored);
+
+		/**
+		*  \fn public constant  getNodes
+		*  \brief Returns all Nodes of the Graph
+		*  \return Data::Bitmap ids of the Nodes
+		*/
+		Data::Bitmap getNodes() const;
+
+		/**
+		*  \fn public constant  getNodesOfType(qlonglong typeId)
+		*  \brief Returns Nodes of the Type
+		*  \param  typeId   id of the Type
+		*  \return Data::Bitmap ids of the Nodes
+		*/
+		Data::Bitmap getNodesOfType(qlonglong typeId) const;
+
+		/**
+		*  \fn public constant  getMetaNodes
+		*  \brief Returns meta-Nodes of the Graph
+		*  \return Data::Bitmap ids of the meta-Nodes
+		*/
+		Data::Bitmap getMetaNodes() const;
+
+		/**
+		*  \fn public constant  getFixedNodes
+		*  \brief Returns fixed Nodes
+		*  \return Data::Bitmap ids of the fixed Nodes
+		*/
+		Data::Bitmap getFixedNodes() const;
+
+		/**
+		*  \fn public constant  getSelectedNodes
+		*  \brief Returns selected Nodes
+		*  \return Data::Bitmap ids of the selected Nodes
+		*/
+		Data::Bitmap getSelectedNodes() const;
+
+		/**
+		*  \fn public constant  getIgnoredNodes
+		*  \brief Returns Nodes ignored by the layout
+		*  \return Data::Bitmap ids of the ignored Nodes
+		*/
+		Data::Bitmap getIgnoredNodes() const;
+
+		/**
+		*  \fn public  clear
+		*  \brief Removes all Nodes from the index
+		*/
+		void clear();
+
+	private:
+
+		/**
+		*  QMutex mutex
+		*  \brief Mutex guarding the bitmaps (Nodes are committed to the index also from the import threads)
+		*/
+		mutable QMutex mutex;
+
+		/**
+		*  Data::Bitmap nodes
+		*  \brief All Nodes
+		*/
+		Data::Bitmap nodes;
+
+		/**
+		*  QHash<qlonglong,Data::Bitmap> nodesByType
+		*  \brief Nodes by id of their Type
+		*/
+		QHash<qlonglong, Data::Bitmap> nodesByType;
+
+		/**
+		*  Data::Bitmap metaNodes
+		*  \brief Meta-Nodes
+		*/
+		Data::Bitmap metaNodes;
+
+		/**
+		*  Data::Bitmap fixedNodes
+		*  \brief Fixed Nodes
+		*/
+		Data::Bitmap fixedNodes;
+
+		/**
+		*  Data::Bitmap selectedNodes
+		*  \brief Selected Nodes
+		*/
+		Data::Bitmap selectedNodes;
+
+		/**
+		*  Data::Bitmap ignoredNodes
+		*  \brief Ignored Nodes
+		*/
+		Data::Bitmap ignoredNodes;
+	};
+}
+
+#endif
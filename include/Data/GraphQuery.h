@@ -0,0 +1,177 @@
+/*!
+ * GraphQuery.h
+ * Projekt 3DVisual
+ */
+
+#ifndef DATA_GRAPHQUERY_DEF
+#define DATA_GRAPHQUERY_DEF 1
+
+#include "Data/Bitmap.h"
+
+#include <osg/ref_ptr>
+
+#include <QString>
+#include <QList>
+
+namespace Data
+{
+	class Graph;
+	class Node;
+
+	/**
+	*  \class GraphQuery
+	*  \brief In-memory query over the Nodes of a Graph
+	*
+	*	Query is a conjunction of conditions joined by "and", e.g. "type = person and fixed and degree > 10 and age >= 30".
+	*	Supported conditions:
+	*	- flags: fixed, selected, ignored, meta (negated by "not")
+	*	- attribute op value (attribute from Graph::getNodeAttributes, text attribute can be compared with a number only by = or !=)
+	*	- degree op number
+	*	- attribute op value (attribute from Graph::getNodeAttributes)
+	*	where op is one of =, !=, <, <=, >, >=.
+	*
+	*	Type and flag conditions are evaluated on the bitmap indexes of the Graph (Graph::getNodeIndex), the remaining conditions
+	*	are evaluated in parallel only for the Nodes which passed the bitmap conditions.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class GraphQuery
+	{
+	public:
+
+		/**
+		*  \fn public constructor  GraphQuery(Data::Graph * graph, QString query)
+		*  \brief Parses the query
+		*  \param  graph   queried Graph
+		*  \param  query   text of the query
+		*/
+		GraphQuery(Data::Graph * graph, QString query);
+
+		/**
+		*  \fn inline public constant  isValid
+		*  \brief Returns true, if the query was parsed successfully
+		*  \return bool true, if the query is valid
+		*/
+		bool isValid() const { return error.isEmpty(); }
+
+		/**
+		*  \fn inline public constant  getError
+		*  \brief Returns description of the parse error
+		*  \return QString description of the error, empty if the query is valid
+		*/
+		QString getError() const { return error; }
+
+		/**
+		*  \fn public  evaluate
+		*  \brief Evaluates the query
+		*  \return Data::Bitmap ids of the matching Nodes
+		*/
+		Data::Bitmap evaluate();
+
+		/**
+		*  \fn public  getNodes
+		*  \brief Evaluates the query and returns the matching Nodes
+		*  \return QList<osg::ref_ptr<Data::Node> > matching Nodes
+		*/
+		QList<osg::ref_ptr<Data::Node> > getNodes();
+
+		/**
+		*  Operator
+		*  \brief Comparison operator of the condition
+		*/
+		enum Operator { EQUAL, NOT_EQUAL, LESS, LESS_EQUAL, GREATER, GREATER_EQUAL };
+
+		/**
+		*  \class Condition
+		*  \brief One condition of the query
+		*/
+		class Condition
+		{
+		public:
+
+			/**
+			*  Kind
+			*  \brief Kind of the condition
+			*/
+			enum Kind { FIXED, SELECTED, IGNORED, META, TYPE, DEGREE, ATTRIBUTE };
+
+			/**
+			*  Kind kind
+			*  \brief Kind of the condition
+			*/
+			Kind kind;
+
+			/**
+			*  bool negated
+			*  \brief Flag if the condition is negated
+			*/
+			bool negated;
+
+			/**
+			*  Operator op
+			*  \brief Comparison operator
+			*/
+			Operator op;
+
+			/**
+			*  QString name
+			*  \brief Name of the attribute
+			*/
+			QString name;
+
+			/**
+			*  QString value
+			*  \brief Compared value
+			*/
+			QString value;
+
+			/**
+			*  double number
+			*  \brief Compared value as number
+			*/
+			double number;
+
+			/**
+			*  bool isNumber
+			*  \brief Flag if the compared value is a number
+			*/
+			bool isNumber;
+		};
+
+	private:
+
+		/**
+		*  \fn private  parseCondition(QString text)
+		*  \brief Parses one condition and adds it to the query
+		*  \param  text   text of the condition
+		*  \return bool false, if the condition is not valid
+		*/
+		bool parseCondition(QString text);
+
+		/**
+		*  Data::Graph * graph
+		*  \brief Queried Graph
+		*/
+		Data::Graph * graph;
+
+		/**
+		*  QList<Condition> indexConditions
+		*  \brief Conditions evaluated on the bitmap indexes
+		*/
+		QList<Condition> indexConditions;
+
+		/**
+		*  QList<Condition> valueConditions
+		*  \brief Conditions evaluated on the values of the Nodes
+		*/
+		QList<Condition> valueConditions;
+
+		/**
+		*  QString error
+		*  \brief Description of the parse error
+		*/
+		QString error;
+	};
+}
+
+#endif
@@ -0,0 +1,164 @@
+/*!
+ * GraphSnapshot.h
+ * Projekt 3DVisual
+ */
+
+#ifndef DATA_GRAPHSNAPSHOT_DEF
+#define DATA_GRAPHSNAPSHOT_DEF 1
+
+#include <osg/ref_ptr>
+
+#include <QMap>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+
+namespace Data
+{
+	class Node;
+	class Edge;
+
+	/**
+	*  \class GraphSnapshot
+	*  \brief Immutable version of the Node and Edge lists of a Graph
+	*
+	*	Snapshot is taken by Graph::getSnapshot. Lists are implicitly shared with the Graph, so taking a snapshot costs only a few reference counter increments.
+	*	The Graph copies a list only when it is changed while some snapshot still holds it (copy-on-write), therefore readers (layout, viewer, database writers)
+	*	can iterate the snapshot without locking while the Graph is being edited. Nodes and Edges are held by osg::ref_ptr, so they stay valid
+	*	even after they are removed from the Graph. Edges keep their Nodes until they are destroyed (see Edge::unlinkNodes) and the Edges
+	*	of each Node are taken from the snapshot (getNodeEdges), not from the edge list of the Node, which is changed with the Graph.
+	*	Only these lists are copy-on-write, state of the Nodes and Edges themselves is shared with the Graph and read live:
+	*	- edge lists of the Nodes (Node::getEdges) are changed with the Graph, readers in other threads use getNodeEdges instead,
+	*	- attributes of the Graph (Graph::getNodeAttributes, Graph::getEdgeAttributes) have to be read under Graph::getStructureMutex,
+	*	- positions are written by the layout thread, colors, scales and names by the thread owning the Graph, so a reader may see
+	*	  a value from before or after a concurrent change. Readers needing a consistent copy (e.g. Exporter::ExporterContext) copy them
+	*	  in the thread owning the Graph.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class GraphSnapshot
+	{
+	public:
+
+		/**
+		*  \fn public constructor  GraphSnapshot(qlonglong version, const QMap<qlonglong, osg::ref_ptr<Data::Node> > &nodes, const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &edges, const QMap<qlonglong, osg::ref_ptr<Data::Node> > &metaNodes, const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &metaEdges)
+		*  \brief Creates new snapshot from the lists of the Graph
+		*  \param   version     version of the Graph structure
+		*  \param   nodes     Nodes of the Graph
+		*  \param   edges     Edges of the Graph
+		*  \param   metaNodes     meta-Nodes of the Graph
+		*  \param   metaEdges     meta-Edges of the Graph
+		*/
+		GraphSnapshot(qlonglong version, const QMap<qlonglong, osg::ref_ptr<Data::Node> > &nodes, const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &edges, const QMap<qlonglong, osg::ref_ptr<Data::Node> > &metaNodes, const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &metaEdges);
+
+		/**
+		*  \fn public destructor  ~GraphSnapshot
+		*  \brief Releases the lists held by the snapshot
+		*/
+		~GraphSnapshot(void);
+
+		/**
+		*  \fn inline public constant  getVersion
+		*  \brief Returns version of the Graph structure at the time of the snapshot
+		*  \return qlonglong version of the Graph structure
+		*/
+		qlonglong getVersion() const { return version; }
+
+		/**
+		*  \fn inline public constant  getNodes
+		*  \brief Returns Nodes of the snapshot
+		*  \return const QMap<qlonglong,osg::ref_ptr<Data::Node> > & Nodes of the snapshot
+		*/
+		const QMap<qlonglong, osg::ref_ptr<Data::Node> > & getNodes() const { return nodes; }
+
+		/**
+		*  \fn inline public constant  getEdges
+		*  \brief Returns Edges of the snapshot
+		*  \return const QMap<qlonglong,osg::ref_ptr<Data::Edge> > & Edges of the snapshot
+		*/
+		const QMap<qlonglong, osg::ref_ptr<Data::Edge> > & getEdges() const { return edges; }
+
+		/**
+		*  \fn inline public constant  getMetaNodes
+		*  \brief Returns meta-Nodes of the snapshot
+		*  \return const QMap<qlonglong,osg::ref_ptr<Data::Node> > & meta-Nodes of the snapshot
+		*/
+		const QMap<qlonglong, osg::ref_ptr<Data::Node> > & getMetaNodes() const { return metaNodes; }
+
+		/**
+		*  \fn inline public constant  getMetaEdges
+		*  \brief Returns meta-Edges of the snapshot
+		*  \return const QMap<qlonglong,osg::ref_ptr<Data::Edge> > & meta-Edges of the snapshot
+		*/
+		const QMap<qlonglong, osg::ref_ptr<Data::Edge> > & getMetaEdges() const { return metaEdges; }
+
+		/**
+		*  \fn public constant  getNodeEdges(qlonglong nodeId)
+		*  \brief Returns Edges and meta-Edges of the snapshot connected to the Node
+		*
+		*	Lists of all the Nodes are built from the Edges of the snapshot on the first call (it can be called from any thread).
+		*
+		*  \param  nodeId  ID of the Node
+		*  \return const QList<osg::ref_ptr<Data::Edge> > & Edges of the Node, empty list if the Node has no Edges in the snapshot
+		*/
+		const QList<osg::ref_ptr<Data::Edge> > & getNodeEdges(qlonglong nodeId) const;
+
+	private:
+
+		/**
+		*  \fn private constant  addNodeEdges(const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &edges)
+		*  \brief Adds the Edges to the lists of their Nodes
+		*/
+		void addNodeEdges(const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &edges) const;
+
+		/**
+		*  qlonglong version
+		*  \brief Version of the Graph structure
+		*/
+		qlonglong version;
+
+		/**
+		*  QMap<qlonglong,osg::ref_ptr<Data::Node> > nodes
+		*  \brief Nodes of the snapshot
+		*/
+		QMap<qlonglong, osg::ref_ptr<Data::Node> > nodes;
+
+		/**
+		*  QMap<qlonglong,osg::ref_ptr<Data::Edge> > edges
+		*  \brief Edges of the snapshot
+		*/
+		QMap<qlonglong, osg::ref_ptr<Data::Edge> > edges;
+
+		/**
+		*  QMap<qlonglong,osg::ref_ptr<Data::Node> > metaNodes
+		*  \brief Meta-Nodes of the snapshot
+		*/
+		QMap<qlonglong, osg::ref_ptr<Data::Node> > metaNodes;
+
+		/**
+		*  QMap<qlonglong,osg::ref_ptr<Data::Edge> > metaEdges
+		*  \brief Meta-Edges of the snapshot
+		*/
+		QMap<qlonglong, osg::ref_ptr<Data::Edge> > metaEdges;
+
+		/**
+		*  QHash<qlonglong,QList<osg::ref_ptr<Data::Edge> > > nodeEdges
+		*  \brief Edges of the Nodes, built by the first call of getNodeEdges
+		*/
+		mutable QHash<qlonglong, QList<osg::ref_ptr<Data::Edge> > > nodeEdges;
+
+		/**
+		*  bool nodeEdgesBuilt
+		*  \brief True, if nodeEdges are built
+		*/
+		mutable bool nodeEdgesBuilt;
+
+		/**
+		*  QMutex nodeEdgesMutex
+		*  \brief Lock of building nodeEdges
+		*/
+		mutable QMutex nodeEdgesMutex;
+	};
+}
+
+#endif
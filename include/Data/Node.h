@@ -248,24 +248,11 @@ namespace Data
 
 
 		/**
-		*  \fn inline public  setFixed(bool fixed) 
+		*  \fn public  setFixed(bool fixed) 
 		*  \brief Sets node fixed state
 		*  \param     fixed     fixed state
 		*/
-		void setFixed(bool fixed) 
-		{ 
-			this->fixed = fixed;
-
-            if (fixed && !this->type->isMeta() && !this->containsDrawable(square))
-				this->addDrawable(square);
-            else if (!fixed && this->containsDrawable(square))
-				this->removeDrawable(square);
-
-			if(this->fixed || this->type->isMeta())
-				*this->gpuFlags = (float) (((unsigned int) *this->gpuFlags) | Node::FIXED_FLAG);
-			else
-				*this->gpuFlags = (float) (((unsigned int) *this->gpuFlags) & (Node::FIXED_FLAG ^ 3));
-		}
+		void setFixed(bool fixed);
 
 		/**
 		*  \fn inline public constant  isFixed
@@ -284,19 +271,11 @@ namespace Data
 		float getGpuFlags()	{ return *this->gpuFlags; }
 		
 		/**
-		*  \fn inline public  setSelected(bool selected) 
+		*  \fn public  setSelected(bool selected) 
 		*  \brief Sets node picked state
 		*  \param     selected     picked state
 		*/
-		void setSelected(bool selected) 
-		{ 
-			if (selected)
-				setDrawableColor(0, osg::Vec4(0.0f, 0.0f, 0.0f, 1.0f));
-			else
-				setDrawableColor(0, color);
-
-			this->selected = selected; 
-		}
+		void setSelected(bool selected);
 
 		/**
 		*  \fn inline public constant  isSelected
@@ -307,11 +286,11 @@ namespace Data
 	
 
 		/**
-		*  \fn inline public  setIgnored(bool b)
+		*  \fn public  setIgnored(bool b)
 		*  \brief Sets ignoring by layout algorithm.
 		*  \param       b  True, if node is ignored.   
 		*/
-		void setIgnored(bool b) { ignore = b; }
+		void setIgnored(bool b);
 
 		/**
 		*  \fn inline public constant  isIgnored
@@ -674,10 +653,11 @@ namespace Data
 		void setDrawableColor(int pos, osg::Vec4 color);
 
 		/**
-		*  QString labelText
-		*  \brief Text show in the label
+		*  \fn private constant  getLabelText
+		*  \brief Returns text shown in the label (name with every third space replaced by a line break), it is not stored in the Node
+		*  \return QString text of the label
 		*/
-		QString labelText;
+		QString getLabelText() const;
 
 
 		/**
@@ -0,0 +1,152 @@
+/*!
+ * StringTable.h
+ * Projekt 3DVisual
+ */
+
+#ifndef DATA_STRINGTABLE_DEF
+#define DATA_STRINGTABLE_DEF 1
+
+#include <QString>
+#include <QStringRef>
+#include <QVector>
+
+namespace Data
+{
+	/**
+	*  \class StringTable
+	*  \brief Table of interned strings of the Graph
+	*
+	*	Each distinct string is stored only once and gets a dense ID (0, 1, 2...) in the order of insertion, so the importers can
+	*	use the IDs instead of the strings (e.g. to find nodes by name) and the names of the elements share the data of the table.
+	*	The table is an open-addressing hash table, the hash of each string is computed once and kept with the entry, so growing
+	*	the table and comparing the entries do not touch the strings. Strings can be looked up directly in the buffers of the
+	*	reader (e.g. QStringRef of QXmlStreamReader), a QString is created only for a new string.
+	*
+	*	The table is not synchronized, it is used by one importer at a time.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class StringTable
+	{
+	public:
+
+		/**
+		*  \fn public constructor  StringTable
+		*  \brief Creates new empty table
+		*/
+		StringTable();
+
+		/**
+		*  \fn public  intern(const QChar *text, int length)
+		*  \brief Returns ID of the string, the string is added to the table if it is not there
+		*  \param  text   characters of the string
+		*  \param  length   count of the characters
+		*  \return int ID of the string
+		*/
+		int intern(const QChar *text, int length);
+
+		/**
+		*  \fn inline public  intern(const QString &text)
+		*  \brief Returns ID of the string, the string is added to the table (sharing its data) if it is not there
+		*  \param  text   string
+		*  \return int ID of the string
+		*/
+		int intern(const QString &text) { return intern(text.unicode(), text.size(), &text); }
+
+		/**
+		*  \fn inline public  intern(const QStringRef &text)
+		*  \brief Returns ID of the string, the string is added to the table if it is not there
+		*  \param  text   string
+		*  \return int ID of the string
+		*/
+		int intern(const QStringRef &text) { return intern(text.unicode(), text.size()); }
+
+		/**
+		*  \fn public constant  find(const QChar *text, int length)
+		*  \brief Returns ID of the string without adding it to the table
+		*  \param  text   characters of the string
+		*  \param  length   count of the characters
+		*  \return int ID of the string, -1 if the string is not in the table
+		*/
+		int find(const QChar *text, int length) const;
+
+		/**
+		*  \fn inline public constant  find(const QString &text)
+		*  \brief Returns ID of the string without adding it to the table
+		*  \param  text   string
+		*  \return int ID of the string, -1 if the string is not in the table
+		*/
+		int find(const QString &text) const { return find(text.unicode(), text.size()); }
+
+		/**
+		*  \fn inline public constant  getString(int id)
+		*  \brief Returns string with the ID
+		*  \param  id   ID of the string
+		*  \return const QString & interned string
+		*/
+		const QString & getString(int id) const { return strings.at(id); }
+
+		/**
+		*  \fn inline public constant  size
+		*  \brief Returns count of the strings in the table
+		*  \return int count of the strings
+		*/
+		int size() const { return strings.size(); }
+
+		/**
+		*  \fn public  clear
+		*  \brief Removes all strings
+		*/
+		void clear();
+
+	private:
+
+		/**
+		*  \fn private  intern(const QChar *text, int length, const QString *shared)
+		*  \brief Returns ID of the string, the string is added to the table if it is not there
+		*  \param  text   characters of the string
+		*  \param  length   count of the characters
+		*  \param  shared   string with the same characters to be stored (sharing its data), NULL if a new string has to be created
+		*  \return int ID of the string
+		*/
+		int intern(const QChar *text, int length, const QString *shared);
+
+		/**
+		*  \fn private static  hash(const QChar *text, int length)
+		*  \brief Computes hash of the string (FNV-1a over UTF-16 code units)
+		*/
+		static uint hash(const QChar *text, int length);
+
+		/**
+		*  \fn private constant  findBucket(const QChar *text, int length, uint textHash)
+		*  \brief Returns index of the bucket with the string or of the empty bucket where the string belongs
+		*/
+		int findBucket(const QChar *text, int length, uint textHash) const;
+
+		/**
+		*  \fn private  grow
+		*  \brief Doubles count of the buckets and reinserts the IDs using the stored hashes
+		*/
+		void grow();
+
+		/**
+		*  QVector<QString> strings
+		*  \brief Strings by ID
+		*/
+		QVector<QString> strings;
+
+		/**
+		*  QVector<uint> hashes
+		*  \brief Hashes of the strings by ID
+		*/
+		QVector<uint> hashes;
+
+		/**
+		*  QVector<int> buckets
+		*  \brief Open-addressing table of IDs (-1 = empty bucket), count of the buckets is a power of 2
+		*/
+		QVector<int> buckets;
+	};
+}
+
+#endif
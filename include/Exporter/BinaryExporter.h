@@ -0,0 +1,68 @@
+#ifndef Exporter_BinaryExporter_H
+#define Exporter_BinaryExporter_H
+//-----------------------------------------------------------------------------
+#include "Exporter/StreamExporter.h"
+//-----------------------------------------------------------------------------
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+//-----------------------------------------------------------------------------
+
+namespace Exporter {
+
+/**
+ * \brief Exports graph data to the native binary format (.3dv, see Importer::BinaryFormat).
+ * Writes the nodes (including meta nodes) and edges with their ids, types, positions, colors, scales, nesting and merging,
+ * the name of the selected layout and the attributes of the nodes and edges.
+ */
+class BinaryExporter
+	: public StreamExporter {
+
+public:
+
+	/***/
+	virtual ~BinaryExporter (void) {};
+
+	/***/
+	virtual bool exportGraph (
+		ExporterContext &context
+	);
+
+private:
+
+	/**
+	 * \brief Returns index of the text in the string table, adds the text if it is not there yet.
+	 */
+	quint32 addString (
+		const QString &text
+	);
+
+	/***/
+	QByteArray writeStrings (void) const;
+
+	/**
+	 * \brief Writes the types of the context (indexes of the types are the indexes of ExporterContext::getTypes).
+	 * \param[in] untyped Some element has no type, an empty type is written after the types of the context.
+	 */
+	QByteArray writeTypes (
+		const QVector<ExporterContext::TypeData> &types,
+		bool untyped
+	);
+
+	/***/
+	QByteArray writeAttributes (
+		const Data::AttributeStore &store
+	);
+
+	/**
+	 * \brief String table - UTF-8 texts by the index and indexes by the text.
+	 */
+	QVector<QByteArray> strings_;
+	QHash<QString, quint32> stringIndex_;
+
+}; // class
+
+} // namespace
+
+#endif // Exporter_BinaryExporter_H
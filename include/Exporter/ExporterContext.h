@@ -0,0 +1,215 @@
+#ifndef Exporter_ExporterContext_H
+#define Exporter_ExporterContext_H
+//-----------------------------------------------------------------------------
+#include "Data/Graph.h"
+#include "Data/AttributeStore.h"
+#include "Importer/ImportInfoHandler.h"
+//-----------------------------------------------------------------------------
+#include <osg/Vec3f>
+#include <osg/Vec4>
+#include <QHash>
+#include <QIODevice>
+#include <QMap>
+#include <QString>
+#include <QVector>
+//-----------------------------------------------------------------------------
+
+namespace Exporter {
+
+/**
+ * \brief Contains object for the exporter to work with.
+ * Data manipulated by the exporter during the export process:
+ * - input: copy of the graph taken when the context is created (nodes, edges, types, attributes)
+ * - output: output data (stream), progress info (info handler)
+ * The context has to be created on the thread owning the graph (GUI thread), the exporter can then run on another thread
+ * while the graph is being edited, the layout moves the nodes or the types are removed. The exporter reads only the copied
+ * data (the same way as Model::GraphLayoutWriter), the attribute stores share their values with the graph (copy-on-write).
+ */
+class ExporterContext {
+
+public:
+
+	/**
+	 * \brief Data of one type of the graph.
+	 */
+	struct TypeData {
+		QString name;
+		bool meta;
+		QMap<QString, QString> settings;
+	};
+
+	/**
+	 * \brief Data of one node or meta node.
+	 */
+	struct NodeData {
+		qlonglong id;
+		QString name;
+		// index to getTypes, -1 if the node has no type
+		int type;
+		// index of the parent node to getNodes, -1 if the node is not nested (or its parent is not in the graph)
+		int parent;
+		// index of the meta node the node is merged into to getNodes (Data::Graph::getMergedGroups), -1 if it is not merged
+		int mergedInto;
+		osg::Vec3f position;
+		osg::Vec4 color;
+		float scale;
+		bool meta;
+		bool fixed;
+		bool hidden;
+	};
+
+	/**
+	 * \brief Data of one edge or meta edge.
+	 */
+	struct EdgeData {
+		qlonglong id;
+		// null if the name is derived from the names of the nodes (Data::Edge::hasOwnName)
+		QString name;
+		// index to getTypes, -1 if the edge has no type
+		int type;
+		// indexes of the nodes to getNodes, -1 if the node is not in the graph
+		int src;
+		int dst;
+		osg::Vec4 color;
+		float scale;
+		bool meta;
+		bool oriented;
+	};
+
+	/**
+	 * \brief Creates new context object containing provided references and copies the data of the graph.
+	 * \param[in] stream Output stream.
+	 * \param[in] graph Graph root object.
+	 * \param[in] infoHandler Progress info handler (the same interface as used by the importers).
+	 */
+	ExporterContext (
+		QIODevice &stream,
+		Data::Graph &graph,
+		Importer::ImportInfoHandler &infoHandler
+	);
+
+	/***/
+	virtual ~ExporterContext (void) {};
+
+	/**
+	 * \brief \link ExporterContext::stream_ [getter] \endlink
+	 */
+	QIODevice &getStream (void);
+
+	/**
+	 * \brief \link ExporterContext::graph_ [getter] \endlink
+	 * Only the copied data of the context should be read from another thread.
+	 */
+	Data::Graph &getGraph (void);
+
+	/**
+	 * \brief \link ExporterContext::infoHandler_ [getter] \endlink
+	 */
+	Importer::ImportInfoHandler &getInfoHandler (void);
+
+	/**
+	 * \brief \link ExporterContext::nodes_ [getter] \endlink
+	 */
+	const QVector<NodeData> &getNodes (void) const;
+
+	/**
+	 * \brief \link ExporterContext::edges_ [getter] \endlink
+	 */
+	const QVector<EdgeData> &getEdges (void) const;
+
+	/**
+	 * \brief \link ExporterContext::nodeAttributes_ [getter] \endlink
+	 */
+	const Data::AttributeStore &getNodeAttributes (void) const;
+
+	/**
+	 * \brief \link ExporterContext::edgeAttributes_ [getter] \endlink
+	 */
+	const Data::AttributeStore &getEdgeAttributes (void) const;
+
+	/**
+	 * \brief \link ExporterContext::types_ [getter] \endlink
+	 */
+	const QVector<TypeData> &getTypes (void) const;
+
+	/**
+	 * \brief \link ExporterContext::graphName_ [getter] \endlink
+	 */
+	const QString &getGraphName (void) const;
+
+	/**
+	 * \brief \link ExporterContext::layoutName_ [getter] \endlink
+	 */
+	const QString &getLayoutName (void) const;
+
+	/**
+	 * \brief \link ExporterContext::eleIdCounter_ [getter] \endlink
+	 */
+	qlonglong getEleIdCounter (void) const;
+
+private:
+
+	/**
+	 * \brief Returns index of the copy of the type in types_, copies the type if it is not copied yet.
+	 */
+	int addType (
+		Data::Type *type,
+		QHash<Data::Type *, int> &typeIndex
+	);
+
+	/**
+	 * \brief Stream to write data to.
+	 */
+	QIODevice &stream_;
+
+	/**
+	 * \brief Graph to write to the stream.
+	 */
+	Data::Graph &graph_;
+
+	/**
+	 * \brief Used by the exporter to report status of the export (progress, messages, errors).
+	 */
+	Importer::ImportInfoHandler &infoHandler_;
+
+	/**
+	 * \brief Nodes of the graph ordered by id followed by the meta nodes ordered by id (with target positions of the nodes).
+	 */
+	QVector<NodeData> nodes_;
+
+	/**
+	 * \brief Edges of the graph ordered by id followed by the meta edges ordered by id.
+	 */
+	QVector<EdgeData> edges_;
+
+	/**
+	 * \brief Copies of the attribute stores of the graph (values are shared with the graph until it changes them).
+	 */
+	Data::AttributeStore nodeAttributes_;
+	Data::AttributeStore edgeAttributes_;
+
+	/**
+	 * \brief Types of the graph ordered by id.
+	 */
+	QVector<TypeData> types_;
+
+	/**
+	 * \brief Name of the graph.
+	 */
+	QString graphName_;
+
+	/**
+	 * \brief Name of the selected layout (empty if there is no layout).
+	 */
+	QString layoutName_;
+
+	/**
+	 * \brief Element id counter of the graph.
+	 */
+	qlonglong eleIdCounter_;
+
+}; // class
+
+} // namespace
+
+#endif // Exporter_ExporterContext_H
@@ -0,0 +1,45 @@
+#ifndef Exporter_ExporterFactory_H
+#define Exporter_ExporterFactory_H
+//-----------------------------------------------------------------------------
+#include "Exporter/StreamExporter.h"
+//-----------------------------------------------------------------------------
+#include <QString>
+//-----------------------------------------------------------------------------
+#include <memory>
+
+namespace Exporter {
+
+/**
+ * \brief Contains methods to create instances of exporter implementations according to specified criteria.
+ */
+class ExporterFactory {
+
+public:
+
+	/**
+	 * \brief Creates exporter according to provided file extension.
+	 * \param[out] exporter Created exporter.
+	 * \param[out] exporterFound If an appropriate exporter has been found.
+	 * \param[in] fileExtension File name extension.
+	 * \return ( = success)
+	 */
+	static bool createByFileExtension (
+		std::auto_ptr<StreamExporter> &exporter,
+		bool &exporterFound,
+		const QString &fileExtension
+	);
+
+private:
+
+	/***/
+	ExporterFactory (void) {};
+
+	/***/
+	virtual ~ExporterFactory (void) = 0;
+
+
+}; // class
+
+} // namespace
+
+#endif // Exporter_ExporterFactory_H
@@ -0,0 +1,107 @@
+#ifndef Exporter_GraphMLExporter_H
+#define Exporter_GraphMLExporter_H
+//-----------------------------------------------------------------------------
+#include "Exporter/StreamExporter.h"
+//-----------------------------------------------------------------------------
+#include <QtXml/QXmlStreamWriter>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QVector>
+//-----------------------------------------------------------------------------
+
+namespace Exporter {
+
+/**
+ * \brief Exports graph data to GraphML format.
+ * The document is written in one pass by QXmlStreamWriter directly to the stream, so only the current element is held in memory.
+ * Nodes and edges are written with their types (keys GraphMLParser.nodeTypeAttribute and GraphMLParser.edgeTypeAttribute, the same
+ * as read by GraphMLImporter), attributes and positions of the nodes (keys x, y, z). Names of the nodes are used as their ids
+ * (empty and repeated names are replaced by n<node id>, made unique among all names). Meta nodes and meta edges are not written,
+ * nested graphs are written flat.
+ */
+class GraphMLExporter
+	: public StreamExporter {
+
+public:
+
+	/***/
+	GraphMLExporter (void);
+
+	/***/
+	virtual ~GraphMLExporter (void) {};
+
+	/***/
+	virtual bool exportGraph (
+		ExporterContext &context
+	);
+
+private:
+
+	// attribute column -> key ID
+	typedef QList<QPair<Data::AttributeColumn *, QString> > KeysListType;
+
+	/**
+	 * \brief Returns GraphML ids of the nodes (in the order of ExporterContext::getNodes, empty for the meta nodes).
+	 */
+	QVector<QString> uniqueNodeIds (
+		const QVector<ExporterContext::NodeData> &nodes
+	);
+
+	/**
+	 * \brief Writes key declarations of the attribute columns of the store.
+	 * \param[in] prefix Prefix of the key IDs ('n' for nodes, 'e' for edges).
+	 * \param[in] keyFor Element the keys are declared for (node, edge).
+	 */
+	KeysListType writeKeys (
+		QXmlStreamWriter &writer,
+		const Data::AttributeStore &store,
+		const QString &prefix,
+		const QString &keyFor
+	);
+
+	/**
+	 * \brief Writes one key declaration.
+	 */
+	void writeKey (
+		QXmlStreamWriter &writer,
+		const QString &id,
+		const QString &keyFor,
+		const QString &name,
+		const QString &type
+	);
+
+	/**
+	 * \brief Writes data elements with the attributes of one node/edge.
+	 */
+	void writeAttributes (
+		QXmlStreamWriter &writer,
+		const Data::AttributeStore &store,
+		const KeysListType &keys,
+		qlonglong id
+	);
+
+	/**
+	 * \brief Writes one data element.
+	 */
+	void writeData (
+		QXmlStreamWriter &writer,
+		const QString &key,
+		const QString &value
+	);
+
+	/**
+	 * \brief Key of the type of the nodes.
+	 */
+	QString nodeTypeAttribute_;
+
+	/**
+	 * \brief Key of the type of the edges.
+	 */
+	QString edgeTypeAttribute_;
+
+}; // class
+
+} // namespace
+
+#endif // Exporter_GraphMLExporter_H
@@ -0,0 +1,46 @@
+#ifndef Exporter_PositionsExporter_H
+#define Exporter_PositionsExporter_H
+//-----------------------------------------------------------------------------
+#include "Exporter/StreamExporter.h"
+//-----------------------------------------------------------------------------
+
+namespace Exporter {
+
+/**
+ * \brief Exports current positions of the nodes (including meta nodes) to a compact binary file (.pos).
+ * The file starts with a 16 byte header - magic "3DVP", version (uint32) and count of the records (int64), followed by
+ * the records of the nodes - id of the node (int64) and its position x, y, z (float32). All numbers are little endian.
+ * The records are written in blocks of fixed size, so the memory used does not depend on the size of the graph.
+ */
+class PositionsExporter
+	: public StreamExporter {
+
+public:
+
+	/***/
+	virtual ~PositionsExporter (void) {};
+
+	/***/
+	virtual bool exportGraph (
+		ExporterContext &context
+	);
+
+	/**
+	 * \brief Identification of the format at the beginning of the file.
+	 */
+	static const char MAGIC[4];
+
+	/***/
+	static const quint32 VERSION = 1;
+
+	/***/
+	static const int HEADER_SIZE = 16;
+
+	/***/
+	static const int RECORD_SIZE = 20;
+
+}; // class
+
+} // namespace
+
+#endif // Exporter_PositionsExporter_H
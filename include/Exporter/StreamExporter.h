@@ -0,0 +1,39 @@
+#ifndef Exporter_StreamExporter_H
+#define Exporter_StreamExporter_H
+//-----------------------------------------------------------------------------
+#include "Exporter/ExporterContext.h"
+//-----------------------------------------------------------------------------
+
+namespace Exporter {
+
+/**
+ * \brief Exports graph data to stream.
+ * [interface]
+ * Implementations of this interface perform export of graph data to streams.
+ * Each implementation should handle one stream data format.
+ */
+class StreamExporter {
+
+public:
+
+	/***/
+	virtual ~StreamExporter (void) {};
+
+	/**
+	 * \brief Performs export.
+	 * \param[in,out] context Provides input (graph) and output (stream, info handler) objects for the method.
+	 * \return ( = success)
+	 * Operates over exporter context.
+	 * Reads graph data in the context.
+	 * Writes to stream specified in the context.
+	 * Uses info handler in the context to inform about the progress.
+	 */
+	virtual bool exportGraph (
+		ExporterContext &context
+	) = 0;
+
+}; // class
+
+} // namespace
+
+#endif // Exporter_StreamExporter_H
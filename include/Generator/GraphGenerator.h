@@ -0,0 +1,126 @@
+#ifndef Generator_GraphGenerator_H
+#define Generator_GraphGenerator_H
+//-----------------------------------------------------------------------------
+#include <QPair>
+#include <QString>
+#include <QVector>
+//-----------------------------------------------------------------------------
+
+namespace Generator {
+
+/**
+ * \brief Graph created by the generator.
+ * Nodes are only indexes 0..nodeCount-1 (named "n<index>" when written), edges are pairs of the indexes,
+ * so graphs of millions of elements can be generated and written without creating Data::Node objects.
+ */
+struct GeneratedGraph {
+	// name of the model and its parameters (used as the name of the graph)
+	QString name;
+	int nodeCount;
+	QVector<QPair<int, int> > edges;
+	// cluster of each node (empty if the model has no clusters)
+	QVector<int> clusters;
+};
+
+/**
+ * \brief Generates synthetic graphs of arbitrary size.
+ * Random models use own pseudo-random generator (splitmix64), so the same seed gives the same graph on every platform.
+ * Used to test and benchmark importers, layout and bulk graph construction with large graphs.
+ */
+class GraphGenerator {
+
+public:
+
+	/**
+	 * \param[in] seed Seed of the pseudo-random generator.
+	 */
+	GraphGenerator (
+		quint64 seed
+	);
+
+	/***/
+	virtual ~GraphGenerator (void) {};
+
+	/**
+	 * \brief Erdos-Renyi G(n, m) graph - edgeCount distinct edges between uniformly chosen nodes (no loops).
+	 */
+	GeneratedGraph erdosRenyi (
+		int nodeCount,
+		qint64 edgeCount
+	);
+
+	/**
+	 * \brief Barabasi-Albert graph - each new node is connected to edgesPerNode existing nodes chosen by preferential attachment.
+	 */
+	GeneratedGraph barabasiAlbert (
+		int nodeCount,
+		int edgesPerNode
+	);
+
+	/**
+	 * \brief Grid (depth = 1) or 3D mesh - each node is connected to its neighbours along the axes.
+	 */
+	GeneratedGraph grid (
+		int width,
+		int height,
+		int depth
+	);
+
+	/**
+	 * \brief Random recursive tree - parent of each node is chosen uniformly from the previous nodes.
+	 */
+	GeneratedGraph randomTree (
+		int nodeCount
+	);
+
+	/**
+	 * \brief Graph of nested clusters.
+	 * Nodes are divided into branching^levels leaf clusters of clusterSize nodes, the clusters form a tree with branching
+	 * children in each of the levels. Each node starts degree edges, an edge leaves the current cluster to the parent cluster
+	 * with probability 1 - locality (repeatedly), its other node is chosen uniformly from the reached cluster.
+	 */
+	GeneratedGraph nestedClusters (
+		int levels,
+		int branching,
+		int clusterSize,
+		int degree,
+		double locality
+	);
+
+	/**
+	 * \brief Generates the graph of the model with the name (er, ba, grid, tree, clusters) with approximately nodeCount nodes
+	 * and default parameters (average degree 4-10).
+	 * \return ( = the model is known)
+	 */
+	bool generate (
+		const QString &model,
+		int nodeCount,
+		GeneratedGraph &graph
+	);
+
+private:
+
+	/**
+	 * \brief Returns next pseudo-random number.
+	 */
+	quint64 next (void);
+
+	/**
+	 * \brief Returns pseudo-random number from the interval <0, bound).
+	 */
+	qint64 nextInt (
+		qint64 bound
+	);
+
+	/**
+	 * \brief Returns pseudo-random number from the interval <0, 1).
+	 */
+	double nextDouble (void);
+
+	quint64 state_;
+
+}; // class
+
+} // namespace
+
+#endif // Generator_GraphGenerator_H
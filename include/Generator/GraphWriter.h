@@ -0,0 +1,107 @@
+#ifndef Generator_GraphWriter_H
+#define Generator_GraphWriter_H
+//-----------------------------------------------------------------------------
+#include "Generator/GraphGenerator.h"
+#include "Data/Graph.h"
+#include "Importer/ImportInfoHandler.h"
+//-----------------------------------------------------------------------------
+#include <QByteArray>
+#include <QIODevice>
+#include <QStringList>
+//-----------------------------------------------------------------------------
+
+namespace Generator {
+
+/**
+ * \brief Writes generated graph in the formats readable by the importers.
+ * Text formats are written directly from the generated graph (nodes are named "n<index>", MTX uses 1-based indexes),
+ * the clusters are written as "cluster" node attribute to GraphML. The binary format (3dv) is written by
+ * Exporter::BinaryExporter from the Data::Graph built by createGraph.
+ */
+class GraphWriter {
+
+public:
+
+	/**
+	 * \param[in] graph Generated graph (it has to exist while the writer is used).
+	 */
+	GraphWriter (
+		const GeneratedGraph &graph
+	);
+
+	/***/
+	virtual ~GraphWriter (void) {};
+
+	/**
+	 * \brief Returns the formats (file extensions) the writer supports.
+	 */
+	static QStringList getFormats (void);
+
+	/**
+	 * \brief Writes the graph in the format to the stream.
+	 * \param[in] format File extension of the format (see getFormats).
+	 * \param[in] stream Opened stream to write to.
+	 * \param[in] infoHandler Handler of the progress, errors and cancel.
+	 * \return ( = success)
+	 */
+	bool write (
+		const QString &format,
+		QIODevice &stream,
+		Importer::ImportInfoHandler &infoHandler
+	);
+
+	/**
+	 * \brief Builds Data::Graph of the generated graph using bulk insert (with selected layout, positions in a cube lattice).
+	 * \return New graph (ownership is passed to the caller).
+	 */
+	Data::Graph *createGraph (void) const;
+
+private:
+
+	/**
+	 * \brief Parts of the text format.
+	 * Node line is nodePrefix, name, (clusterPrefix, cluster, clusterSuffix if the graph has clusters and clusterPrefix is not empty)
+	 * and nodeSuffix, nodes are not written if nodePrefix is empty. Edge line is edgePrefix, source name, edgeSeparator, target name
+	 * and edgeSuffix.
+	 */
+	struct TextFormat {
+		QByteArray header;
+		QByteArray nodePrefix;
+		QByteArray clusterPrefix;
+		QByteArray clusterSuffix;
+		QByteArray nodeSuffix;
+		QByteArray edgePrefix;
+		QByteArray edgeSeparator;
+		QByteArray edgeSuffix;
+		QByteArray footer;
+		// names are 1-based indexes instead of "n<index>"
+		bool numericNames;
+	};
+
+	/**
+	 * \brief Writes the graph in the text format.
+	 */
+	bool writeText (
+		QIODevice &stream,
+		Importer::ImportInfoHandler &infoHandler,
+		const TextFormat &format
+	);
+
+	/**
+	 * \brief Writes the binary format (3dv).
+	 */
+	bool writeBinary (
+		QIODevice &stream,
+		Importer::ImportInfoHandler &infoHandler
+	);
+
+	/**
+	 * \brief Generated graph.
+	 */
+	const GeneratedGraph &graph_;
+
+}; // class
+
+} // namespace
+
+#endif // Generator_GraphWriter_H
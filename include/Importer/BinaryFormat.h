@@ -0,0 +1,96 @@
+#ifndef Importer_BinaryFormat_H
+#define Importer_BinaryFormat_H
+//-----------------------------------------------------------------------------
+#include <QtGlobal>
+//-----------------------------------------------------------------------------
+
+namespace Importer {
+
+/**
+ * \brief Layout of the native binary graph format (.3dv).
+ * All numbers are little endian, the file can be memory mapped and the records read in place.
+ * - header: magic "3DVG", version, count of the sections, section table (id, offset, size); sections are aligned to 8 bytes
+ * - STRINGS: count, offsets of the strings (count + 1) relative to the start of the texts, UTF-8 texts; other sections refer to strings by index
+ * - GRAPH: name of the graph, name of the layout, element id counter
+ * - TYPES: count, then for each type its name, flags and settings (pairs of strings)
+ * - NODES: count, then records of fixed size; nested nodes follow their parent node, merged nodes refer to their meta node by index
+ * - EDGES: count, then records of fixed size referring to the nodes by index in NODES; edges with the empty name (index 0) have names derived from their nodes
+ * - NODE_ATTRIBUTES, EDGE_ATTRIBUTES: count of rows and columns, ids of the rows, then for each column its name, type, null bitmap and values
+ */
+namespace BinaryFormat {
+
+	/**
+	 * \brief Magic bytes at the start of the file.
+	 */
+	static const char MAGIC[4] = { '3', 'D', 'V', 'G' };
+
+	/**
+	 * \brief Version of the format, files of other versions are refused.
+	 */
+	static const quint32 VERSION = 1;
+
+	/**
+	 * \brief Identifiers of the sections.
+	 */
+	enum SectionId {
+		STRINGS = 1,
+		GRAPH = 2,
+		TYPES = 3,
+		NODES = 4,
+		EDGES = 5,
+		NODE_ATTRIBUTES = 6,
+		EDGE_ATTRIBUTES = 7
+	};
+
+	// magic, version, count of the sections, reserved
+	static const int HEADER_SIZE = 16;
+
+	// id, reserved, offset, size
+	static const int SECTION_ENTRY_SIZE = 24;
+
+	// id, name, type, position, color, scale, parent, flags, merged into (with NODE_MERGED), reserved
+	static const int NODE_RECORD_SIZE = 64;
+
+	// id, name, type, source, destination, color, scale, flags
+	static const int EDGE_RECORD_SIZE = 48;
+
+	/**
+	 * \brief Index of the parent of the nodes which are not nested.
+	 */
+	static const quint32 NO_PARENT = 0xffffffff;
+
+	/**
+	 * \brief Flags of the types.
+	 */
+	enum TypeFlags {
+		TYPE_META = 1
+	};
+
+	/**
+	 * \brief Flags of the nodes.
+	 */
+	enum NodeFlags {
+		NODE_FIXED = 1,
+		NODE_HIDDEN = 2,
+		NODE_MERGED = 4
+	};
+
+	/**
+	 * \brief Flags of the edges.
+	 */
+	enum EdgeFlags {
+		EDGE_ORIENTED = 1
+	};
+
+	/**
+	 * \brief Returns the size aligned to the alignment of the sections.
+	 */
+	inline qint64 align (
+		qint64 size
+	) { return (size + 7) & ~((qint64) 7); }
+
+} // namespace
+
+} // namespace
+
+#endif // Importer_BinaryFormat_H
@@ -0,0 +1,134 @@
+#ifndef Importer_BinaryImporter_H
+#define Importer_BinaryImporter_H
+//-----------------------------------------------------------------------------
+#include "Importer/StreamImporter.h"
+//-----------------------------------------------------------------------------
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QVector>
+//-----------------------------------------------------------------------------
+
+namespace Importer {
+
+/**
+ * \brief Imports graph data from the native binary format (.3dv, see BinaryFormat).
+ * File streams are memory mapped and the records of the nodes, edges and attributes are read in place,
+ * other streams are read at once. Ids, types, positions, colors, scales, nesting of the elements and groups of merged nodes are restored.
+ */
+class BinaryImporter
+	: public StreamImporter {
+
+public:
+
+	/***/
+	BinaryImporter (void);
+
+	/***/
+	virtual ~BinaryImporter (void);
+
+	/***/
+	virtual bool import (
+		ImporterContext &context
+	);
+
+private:
+
+	/**
+	 * \brief Maps or reads the stream and checks the header.
+	 * \return ( = success)
+	 */
+	bool open (
+		QIODevice &stream
+	);
+
+	/**
+	 * \brief Finds the section in the section table.
+	 * \param[in] id Identifier of the section.
+	 * \param[out] section Start of the section.
+	 * \param[out] size Size of the section.
+	 * \return False if the file has no such section.
+	 */
+	bool findSection (
+		quint32 id,
+		const uchar *&section,
+		qint64 &size
+	) const;
+
+	/**
+	 * \brief Returns the string with the index from the string table, empty string if the index is not valid.
+	 */
+	QString getString (
+		quint32 index
+	) const;
+
+	/***/
+	bool readStrings (void);
+
+	/***/
+	bool readTypes (
+		Data::Graph &graph
+	);
+
+	/***/
+	bool readNodes (
+		ImporterContext &context,
+		quint32 expectedEdges
+	);
+
+	/***/
+	bool readEdges (
+		ImporterContext &context
+	);
+
+	/**
+	 * \brief Fills the attribute store from the attribute section (if the file has one).
+	 */
+	bool readAttributes (
+		quint32 sectionId,
+		Data::AttributeStore &store
+	);
+
+	/**
+	 * \brief Memory mapped file, NULL if the stream has been read into the buffer.
+	 */
+	QFile *file_;
+	uchar *mapped_;
+	QByteArray buffer_;
+
+	// data of the file
+	const uchar *data_;
+	qint64 size_;
+
+	// table of the sections
+	const uchar *sections_;
+	quint32 sectionCount_;
+
+	// table of the strings - offsets and texts
+	const uchar *stringOffsets_;
+	const char *stringTexts_;
+	quint32 stringCount_;
+	qint64 stringTextsSize_;
+
+	/**
+	 * \brief Created types by their index in the file.
+	 */
+	QVector<Data::Type *> types_;
+
+	/**
+	 * \brief Created nodes by their index in the file.
+	 */
+	QVector<osg::ref_ptr<Data::Node> > nodes_;
+
+	/**
+	 * \brief Merged nodes by the index of their meta node in the file.
+	 */
+	QHash<quint32, QList<osg::ref_ptr<Data::Node> > > mergedGroups_;
+
+}; // class
+
+} // namespace
+
+#endif // Importer_BinaryImporter_H
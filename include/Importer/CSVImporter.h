@@ -0,0 +1,88 @@
+#ifndef Importer_CSVImporter_H
+#define Importer_CSVImporter_H
+//-----------------------------------------------------------------------------
+#include "Importer/StreamImporter.h"
+#include "Importer/EdgeListParser.h"
+#include "Data/AttributeStore.h"
+//-----------------------------------------------------------------------------
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QVector>
+//-----------------------------------------------------------------------------
+
+namespace Importer {
+
+/**
+ * \brief Imports graph data from edge lists in CSV or TSV format.
+ * The first line is a header with the names of the columns. The endpoints of the edges are read from the columns
+ * named source/target (or from/to, src/dst), the first two columns are used if there are no such columns. Column
+ * named directed sets orientation of the edge. All other columns are stored as typed attributes of the edges;
+ * type can be declared in the header as name:type (int, float, bool, string...), otherwise it is inferred from
+ * the values of the first lines (a value of a later line not matching the type changes the column to string).
+ * The lines are tokenized in parallel by EdgeListParser over the memory mapped file, the nodes and edges are
+ * inserted in bulk and the progress is reported by the bytes read.
+ */
+class CSVImporter
+	: public StreamImporter {
+
+public:
+
+	/**
+	 * \param[in] delimiter Delimiter of the columns (',' for CSV, '\t' for TSV).
+	 */
+	CSVImporter (
+		char delimiter
+	);
+
+	/***/
+	virtual ~CSVImporter (void) {};
+
+	/***/
+	virtual bool import (
+		ImporterContext &context
+	);
+
+private:
+
+	/**
+	 * \brief Attribute column of the file.
+	 */
+	struct AttributeInfo {
+		int textColumn;
+		QString name;
+		Data::AttributeColumn::ValueType type;
+		bool typeDeclared;
+		Data::AttributeColumn *column;
+	};
+
+	/**
+	 * \brief Reads the header and sets the columns of the parser.
+	 * \return ( = success)
+	 */
+	bool readHeader (
+		ImporterContext &context,
+		EdgeListParser &parser
+	);
+
+	/**
+	 * \brief Infers types of the attribute columns without declared type from the lines of the first window and creates the columns.
+	 */
+	void createAttributeColumns (
+		ImporterContext &context,
+		const EdgeListParser &parser
+	);
+
+	char delimiter_;
+
+	// columns of the file - indexes of the name/text columns of the parser
+	int sourceColumn_;
+	int targetColumn_;
+	int directedColumn_;
+	QList<AttributeInfo> attributes_;
+
+}; // class
+
+} // namespace
+
+#endif // Importer_CSVImporter_H
@@ -0,0 +1,250 @@
+#ifndef Importer_DOTImporter_H
+#define Importer_DOTImporter_H
+//-----------------------------------------------------------------------------
+#include "Importer/StreamImporter.h"
+#include "Data/AttributeStore.h"
+//-----------------------------------------------------------------------------
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QVector>
+//-----------------------------------------------------------------------------
+
+namespace Importer {
+
+/**
+ * \brief Imports graph data from Graphviz DOT format.
+ * File streams are memory mapped, other streams are read at once. The data are read in one pass by a hand-written
+ * tokenizer, identifiers refer directly to the data (only quoted strings with escapes are copied). Node, edge and
+ * subgraph statements, edge chains, subgraphs as endpoints and default attributes (node [...], edge [...]) are
+ * supported; graph attributes and ports are ignored. Attributes of nodes and edges are stored as typed attributes of
+ * the graph, type of the column is inferred from the first value. Nodes and edges are inserted in bulk and the
+ * progress is reported by the bytes read.
+ */
+class DOTImporter
+	: public StreamImporter {
+
+public:
+
+	/***/
+	DOTImporter (void);
+
+	/***/
+	virtual ~DOTImporter (void);
+
+	/***/
+	virtual bool import (
+		ImporterContext &context
+	);
+
+private:
+
+	// attribute name -> value pairs
+	typedef QList<QPair<QByteArray, QByteArray> > AttributeListType;
+	// attribute name -> attribute column
+	typedef QHash<QByteArray, Data::AttributeColumn *> ColumnsMapType;
+
+	enum TokenType {
+		ID_TOKEN,
+		EDGE_OP_TOKEN,
+		PUNCTUATION_TOKEN,
+		END_TOKEN,
+		ERROR_TOKEN
+	};
+
+	/**
+	 * \brief Token read by the tokenizer.
+	 */
+	struct Token {
+		TokenType type;
+		// text of the ID (refers to the data if it has not been unescaped)
+		QByteArray text;
+		// the ID has been quoted (keywords are not quoted)
+		bool quoted;
+		// character of the punctuation
+		char punctuation;
+	};
+
+	/**
+	 * \brief Maps or reads the stream.
+	 * \return ( = success)
+	 */
+	bool open (
+		QIODevice &stream
+	);
+
+	/**
+	 * \brief Releases the data and all references to them.
+	 */
+	void close (void);
+
+	/**
+	 * \brief Skips whitespace and comments.
+	 */
+	void skipSpace (void);
+
+	/**
+	 * \brief Reads the next token to token_.
+	 */
+	void nextToken (void);
+
+	/**
+	 * \brief Reads the quoted string starting at the current position.
+	 * \return False if the string is not terminated.
+	 */
+	bool readQuoted (
+		QByteArray &text
+	);
+
+	/**
+	 * \brief Checks if the current token is the keyword (case insensitive, not quoted).
+	 */
+	bool isKeyword (
+		const char *keyword
+	) const;
+
+	/**
+	 * \brief Checks if the current token is the punctuation character.
+	 */
+	bool isPunctuation (
+		char c
+	) const {
+		return token_.type == PUNCTUATION_TOKEN && token_.punctuation == c;
+	}
+
+	/**
+	 * \brief Reports syntax error at the current position.
+	 * \return false
+	 */
+	bool syntaxError (void);
+
+	/**
+	 * \brief Parses the whole graph.
+	 */
+	bool parseGraph (void);
+
+	/**
+	 * \brief Parses statements until '}' (not consumed).
+	 * \param[in,out] members Nodes referenced by the statements are appended to it (NULL if not needed).
+	 */
+	bool parseStatements (
+		QVector<int> *members
+	);
+
+	/**
+	 * \brief Parses one statement.
+	 * \param[in,out] members Nodes referenced by the statement are appended to it (NULL if not needed).
+	 */
+	bool parseStatement (
+		QVector<int> *members
+	);
+
+	/**
+	 * \brief Parses the rest of the edge statement (the current token is the edge operator) and adds the edges.
+	 * \param[in] first Nodes of the first endpoint.
+	 * \param[in,out] members Nodes referenced by the statement are appended to it (NULL if not needed).
+	 */
+	bool parseEdges (
+		const QVector<int> &first,
+		QVector<int> *members
+	);
+
+	/**
+	 * \brief Parses one endpoint of the edge (node or subgraph).
+	 * \param[out] endpoint Nodes of the endpoint.
+	 * \param[in,out] members Nodes referenced by the endpoint are appended to it (NULL if not needed).
+	 */
+	bool parseEndpoint (
+		QVector<int> &endpoint,
+		QVector<int> *members
+	);
+
+	/**
+	 * \brief Parses the subgraph (the current token is "subgraph" or '{'), default attributes are restored after it.
+	 * \param[out] subgraphMembers Nodes referenced in the subgraph.
+	 * \param[in,out] members Nodes referenced in the subgraph are appended to it (NULL if not needed).
+	 */
+	bool parseSubgraph (
+		QVector<int> &subgraphMembers,
+		QVector<int> *members
+	);
+
+	/**
+	 * \brief Parses attribute lists [a=b, ...][...] (the current token is '[').
+	 */
+	bool parseAttributes (
+		AttributeListType &attributes
+	);
+
+	/**
+	 * \brief Skips the port of the node (:port:compass).
+	 */
+	bool skipPort (void);
+
+	/**
+	 * \brief Returns index of the node with the name, creates the node with the default attributes if it does not exist.
+	 * \param[in,out] members The node is appended to it (NULL if not needed).
+	 */
+	int getNode (
+		const QByteArray &name,
+		QVector<int> *members
+	);
+
+	/**
+	 * \brief Stores attributes of one node/edge into the attribute store of the graph.
+	 * Type of a new column is inferred from its first value, a later value not matching it changes the column to string.
+	 */
+	void storeAttributes (
+		Data::AttributeStore &attributes,
+		ColumnsMapType &columns,
+		qlonglong id,
+		const AttributeListType &values
+	);
+
+	/**
+	 * \brief Reports progress according to the position in the data.
+	 * \return False if the import has been cancelled.
+	 */
+	bool reportProgress (void);
+
+	ImporterContext *context_;
+
+	/**
+	 * \brief Memory mapped file, NULL if the stream has been read into the buffer.
+	 */
+	QFile *file_;
+	uchar *mapped_;
+	QByteArray buffer_;
+
+	const char *data_;
+	qint64 size_;
+	qint64 position_;
+
+	Token token_;
+
+	bool directed_;
+	Data::Type *edgeType_;
+	Data::Type *nodeType_;
+
+	/**
+	 * \brief Nodes by name (keys refer to the data) and by index.
+	 */
+	QHash<QByteArray, int> nodeIndex_;
+	QVector<osg::ref_ptr<Data::Node> > nodes_;
+
+	// default attributes of the current subgraph
+	AttributeListType nodeDefaults_;
+	AttributeListType edgeDefaults_;
+
+	ColumnsMapType nodeColumns_;
+	ColumnsMapType edgeColumns_;
+
+	unsigned int progress_;
+
+}; // class
+
+} // namespace
+
+#endif // Importer_DOTImporter_H
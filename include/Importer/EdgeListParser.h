@@ -0,0 +1,219 @@
+#ifndef Importer_EdgeListParser_H
+#define Importer_EdgeListParser_H
+//-----------------------------------------------------------------------------
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QIODevice>
+#include <QList>
+#include <QString>
+#include <QVector>
+//-----------------------------------------------------------------------------
+
+namespace Importer {
+
+/**
+ * \brief Parses line based edge lists (MTX, RSF, CSV, TSV) with whitespace or delimiter separated columns in parallel.
+ * File streams are memory mapped, other streams are read at once. The data are split into chunks aligned to the line ends,
+ * the chunks of one window are tokenized in parallel by a hand-written scanner. Names in the name columns are
+ * interned in a table of each chunk; the tables are merged in the order of the chunks, so the names get their indexes in the
+ * order of their first occurrence, the same as with sequential reading. Text columns are not copied, only their positions
+ * in the data are stored.
+ * Empty lines are skipped.
+ */
+class EdgeListParser {
+
+public:
+
+	/**
+	 * \brief What is stored from the column.
+	 */
+	enum ColumnRole {
+		NAME_COLUMN,	// interned name (e.g. of a node)
+		VALUE_COLUMN,	// number
+		TEXT_COLUMN,	// text (position in the data)
+		IGNORED_COLUMN
+	};
+
+	/**
+	 * \brief Size of one chunk in bytes (the chunk is extended to the nearest line end).
+	 */
+	static const qint64 CHUNK_SIZE = 4 * 1024 * 1024;
+
+	/**
+	 * \brief Count of the chunks of one window for each thread.
+	 */
+	static const int CHUNKS_PER_THREAD = 4;
+
+	/**
+	 * \brief Creates parser of the stream.
+	 * \param[in] stream Input stream, reading starts at its current position.
+	 * \param[in] nameColumns Count of the leading columns containing names.
+	 * \param[in] valueColumns Count of the columns after the names containing numbers.
+	 */
+	EdgeListParser (
+		QIODevice &stream,
+		int nameColumns,
+		int valueColumns
+	);
+
+	/***/
+	virtual ~EdgeListParser (void);
+
+	/**
+	 * \brief Sets roles of the columns, columns after the last role are ignored. Must be called before parseNext.
+	 */
+	void setColumns (
+		const QVector<ColumnRole> &columns
+	);
+
+	/**
+	 * \brief Sets delimiter of the columns (0 = columns are separated by whitespace, the default).
+	 * With a delimiter, columns may be empty and quoted by '"' ("" inside quotes is a quote), spaces around the columns
+	 * are trimmed. Quoted columns can not contain line ends. Names are decoded as UTF-8.
+	 */
+	void setDelimiter (
+		char delimiter
+	);
+
+	/**
+	 * \brief Splits one line (e.g. header read by readLine) into columns the same way as the lines of the data.
+	 */
+	QList<QByteArray> splitLine (
+		const QByteArray &line
+	) const;
+
+	/**
+	 * \brief Maps or reads the stream.
+	 * \return ( = success)
+	 */
+	bool open (void);
+
+	/**
+	 * \brief Reads one line sequentially (used for headers).
+	 * \return Line without the line end.
+	 */
+	QByteArray readLine (void);
+
+	/**
+	 * \brief Checks if all data have been read.
+	 */
+	bool atEnd (void) const;
+
+	/**
+	 * \brief Parses the next window of chunks in parallel.
+	 * \return False if there are no more data.
+	 * Lines of the previous window are discarded, names are kept.
+	 */
+	bool parseNext (void);
+
+	/**
+	 * \brief Count of the lines of the current window.
+	 */
+	int getLineCount (void) const { return tokenCounts_.size (); }
+
+	/**
+	 * \brief Count of the columns of the line.
+	 */
+	int getTokenCount (
+		int line
+	) const { return tokenCounts_.at (line); }
+
+	/**
+	 * \brief Index of the name in the name column of the line, -1 if the line has no such column.
+	 */
+	int getName (
+		int line,
+		int column
+	) const { return lineNames_.at (line * nameColumns_ + column); }
+
+	/**
+	 * \brief Number in the value column of the line, 0 if the line has no such column.
+	 */
+	double getValue (
+		int line,
+		int column
+	) const { return lineValues_.at (line * valueColumns_ + column); }
+
+	/**
+	 * \brief Text in the text column of the line, null if the line has no such column.
+	 * Text of an unquoted column refers to the data of the parser, it is valid until the parser is destroyed.
+	 */
+	QByteArray getText (
+		int line,
+		int column
+	) const;
+
+	/**
+	 * \brief Count of the distinct names read so far.
+	 */
+	int getNameCount (void) const { return names_.size (); }
+
+	/**
+	 * \brief Text of the name with the index.
+	 */
+	const QString &getNameText (
+		int name
+	) const { return names_.at (name); }
+
+	/**
+	 * \brief Position of the parser in bytes.
+	 */
+	qint64 getPosition (void) const { return position_; }
+
+	/**
+	 * \brief Size of the data in bytes.
+	 */
+	qint64 getSize (void) const { return size_; }
+
+private:
+
+	QIODevice &stream_;
+
+	/**
+	 * \brief Memory mapped file, NULL if the stream has been read into the buffer.
+	 */
+	QFile *file_;
+	uchar *mapped_;
+	QByteArray buffer_;
+
+	// parsed data (start of the stream at the time of open)
+	const char *data_;
+	qint64 size_;
+	qint64 position_;
+
+	char delimiter_;
+
+	/**
+	 * \brief Roles of the columns and indexes of the columns among the columns of the same role.
+	 */
+	QVector<ColumnRole> columns_;
+	QVector<int> columnSlots_;
+	int nameColumns_;
+	int valueColumns_;
+	int textColumns_;
+
+	/**
+	 * \brief Interned names - index by the text in the data, texts by the index.
+	 */
+	QHash<QByteArray, int> index_;
+	QVector<QString> names_;
+
+	// lines of the current window
+	QVector<int> tokenCounts_;
+	QVector<int> lineNames_;
+	QVector<double> lineValues_;
+
+	/**
+	 * \brief Texts of the current window - offsets in the data and lengths (-1 if the line has no such column).
+	 * Texts of the quoted columns containing "" are copied to escapedTexts_, their offset is -1 - index of the copy.
+	 */
+	QVector<qint64> textOffsets_;
+	QVector<int> textLengths_;
+	QVector<QByteArray> escapedTexts_;
+
+}; // class
+
+} // namespace
+
+#endif // Importer_EdgeListParser_H
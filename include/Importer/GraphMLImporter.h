@@ -4,9 +4,12 @@
 #include "Importer/StreamImporter.h"
 #include "Importer/GraphOperations.h"
 #include "Importer/ReadNodesStore.h"
+#include "Util/CompressedInputDevice.h"
 //-----------------------------------------------------------------------------
-#include <QtXml/QDomElement>
+#include <QtXml/QXmlStreamReader>
 #include <QList>
+#include <QMap>
+#include <QPair>
 #include <osg/Vec4b>
 //-----------------------------------------------------------------------------
 
@@ -14,6 +17,7 @@ namespace Importer {
 
 /**
  * \brief Imports graph data from data in GraphML format.
+ * The document is read in one pass by QXmlStreamReader, no DOM tree is built.
  */
 class GraphMLImporter
 	: public StreamImporter {
@@ -30,35 +34,98 @@ public:
 
 private:
 
+	// key -> value pairs of one node/edge
+	typedef QList<QPair<QString, QString> > DataListType;
+	// key ID -> attribute column
+	typedef QMap<QString, Data::AttributeColumn *> ColumnsMapType;
+	// node name -> endpoint type of one hyperedge
+	typedef QList<QPair<QString, QString> > EndpointsListType;
+
+	/**
+	 * \brief Edge read from the stream, added when both of its nodes are known.
+	 */
+	struct PendingEdge {
+		// IDs of the node names in the string table of the graph
+		int source;
+		int target;
+		Data::Type *type;
+		bool directed;
+		DataListType data;
+	};
+
+	typedef QList<PendingEdge> PendingEdgesListType;
+	typedef QList<EndpointsListType> PendingHyperedgesListType;
+
+	/**
+	 * \brief Creates typed attribute column for key declared in the document.
+	 * <key> XML node must be the current node
+	 */
+	void processKey (void);
+
+	/**
+	 * \brief Stores data of one node/edge into the attribute store of the graph.
+	 */
+	void storeData (
+		Data::AttributeStore &attributes,
+		ColumnsMapType &columns,
+		qlonglong id,
+		const DataListType &data
+	);
+
 	/**
-	 * \brief Imports one graph (or subgraph).
+	 * \brief Parses one graph (or subgraph).
 	 * [recursive]
+	 * <graph> XML node must already have been processed
+	 * </graph> XML node is processed by this function
+	 * Edges referencing nodes declared later and hyperedges are added at the end of the graph.
 	 */
-	bool processGraph (
-		QDomElement &graphElement
+	bool parseGraph (void);
+
+	/**
+	 * \brief Returns node type with the name, creates it if it does not exist.
+	 */
+	Data::Type *getNodeType (
+		const QString &name
 	);
 
 	/**
-	 * \brief Imports nodes from a graph (or subgraph).
+	 * \brief Returns edge type with the name, creates it if it does not exist.
 	 */
-	bool processGraph_Nodes (
-		QDomElement &graphElement
+	Data::Type *getEdgeType (
+		const QString &name,
+		bool directed
 	);
 
 	/**
-	 * \brief Imports edges from a graph (or subgraph).
+	 * \brief Adds node with its data.
 	 */
-	bool processGraph_Edges (
-		QDomElement &graphElement
+	osg::ref_ptr<Data::Node> addNode (
+		int name,
+		Data::Type *type
 	);
 
 	/**
-	 * \brief Imports hyperedges from a graph (or subgraph).
+	 * \brief Adds edge with its data, both nodes must have been read.
+	 * Name of the edge is not stored, it is derived from the names of its nodes when needed.
 	 */
-	bool processGraph_Hyperedges (
-		QDomElement &graphElement
+	void addEdge (
+		const PendingEdge &edge
 	);
 
+	/**
+	 * \brief Adds hyperedge with its endpoints, all nodes must have been read.
+	 */
+	bool addHyperedge (
+		const QString &name,
+		const EndpointsListType &endpoints
+	);
+
+	/**
+	 * \brief Reports progress according to the position in the stream.
+	 * \return False if the import has been cancelled.
+	 */
+	bool reportProgress (void);
+
 private:
 
 	/**
@@ -67,6 +134,7 @@ private:
 	ImporterContext *context_;
 
 	// helpers
+	std::auto_ptr<QXmlStreamReader> xml_;
 	std::auto_ptr<GraphOperations> graphOp_;
 	std::auto_ptr<ReadNodesStore> readNodes_;
 
@@ -82,11 +150,17 @@ private:
 	typedef QList<ColorType> ColorsListType;
 
 	ColorsListType colors_;
-	int iColor_;
+	int iNodeColor_;
+	int iEdgeColor_;
+
+	// attribute columns of nodes/edges by key ID
+	ColumnsMapType nodeColumns_;
+	ColumnsMapType edgeColumns_;
 
-	// for progress reporting
-	int entitiesProcessed_;
-	int entitiesCount_;
+	// for progress reporting (stream size is 0 if it is unknown)
+	Util::CompressedInputDevice *compressedStream_;
+	qint64 streamSize_;
+	unsigned int progress_;
 
 }; // class
 
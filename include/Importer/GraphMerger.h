@@ -0,0 +1,150 @@
+#ifndef Importer_GraphMerger_H
+#define Importer_GraphMerger_H
+//-----------------------------------------------------------------------------
+#include "Data/Graph.h"
+#include "Importer/ReadNodesStore.h"
+//-----------------------------------------------------------------------------
+#include <osg/ref_ptr>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+//-----------------------------------------------------------------------------
+
+namespace Importer {
+
+/**
+ * \brief Merges graph imported from a delta file into an existing graph.
+ * Nodes of the delta are matched to the existing nodes by name (using ReadNodesStore over the string table of the graph) or by id,
+ * edges are matched by their endpoints. Matched elements get the attributes of the delta, elements not matched are added,
+ * elements having the "deleted" attribute set are removed. Positions of the existing nodes are kept, added nodes are placed
+ * next to an existing neighbour, so the layout only has to settle the changed part of the graph.
+ * Types of the delta are mapped to the types of the graph with the same name (missing types are added).
+ */
+class GraphMerger {
+
+public:
+
+	/**
+	 * \brief How the nodes of the delta are matched to the existing nodes.
+	 */
+	enum MatchMode {
+		MATCH_BY_NAME,
+		MATCH_BY_ID
+	};
+
+	/**
+	 * \param[in] graph Graph to merge to (it must not be in bulk insert).
+	 * \param[in] matchMode How the nodes are matched.
+	 * \param[in] deletedAttribute Name of the attribute marking nodes/edges to remove.
+	 */
+	GraphMerger (
+		Data::Graph &graph,
+		MatchMode matchMode,
+		const QString &deletedAttribute
+	);
+
+	/***/
+	virtual ~GraphMerger (void) {};
+
+	/**
+	 * \brief Merges the delta into the graph.
+	 * \param[in] delta Imported delta (it is not changed).
+	 * \return Added nodes without any existing neighbour (they have to be placed by the caller, e.g. randomly).
+	 */
+	QList<osg::ref_ptr<Data::Node> > merge (
+		Data::Graph &delta
+	);
+
+	/**
+	 * \brief Returns summary of the last merge (counts of added, updated and removed elements).
+	 */
+	QString getSummary (void) const;
+
+private:
+
+	// delta column -> column of the graph
+	typedef QList<QPair<Data::AttributeColumn *, Data::AttributeColumn *> > ColumnsListType;
+
+	/**
+	 * \brief Returns the existing node matching the node of the delta (NULL if there is no such node).
+	 */
+	osg::ref_ptr<Data::Node> findNode (
+		Data::Node *deltaNode
+	);
+
+	/**
+	 * \brief Returns the existing edge between the nodes (NULL if there is no such edge).
+	 */
+	osg::ref_ptr<Data::Edge> findEdge (
+		Data::Node *srcNode,
+		Data::Node *dstNode,
+		bool oriented
+	) const;
+
+	/**
+	 * \brief Returns the type of the graph with the name of the delta type, adds the type if there is none.
+	 */
+	Data::Type *mapType (
+		Data::Type *deltaType
+	);
+
+	/**
+	 * \brief Returns pairs of the columns of the delta store and the graph store (with the same names), adds missing columns.
+	 */
+	ColumnsListType mapColumns (
+		const Data::AttributeStore &from,
+		Data::AttributeStore &to
+	) const;
+
+	/**
+	 * \brief Checks if the element of the delta has the deleted attribute set.
+	 */
+	bool isDeleted (
+		const Data::AttributeStore &store,
+		qlonglong id
+	) const;
+
+	/**
+	 * \brief Copies non-empty attributes of the element of the delta to the element of the graph.
+	 * Column of the graph which can not hold a value of the delta is converted to strings.
+	 */
+	void copyAttributes (
+		const Data::AttributeStore &from,
+		qlonglong fromId,
+		Data::AttributeStore &to,
+		qlonglong toId,
+		const ColumnsListType &columns
+	) const;
+
+	/**
+	 * \brief Graph to merge to.
+	 */
+	Data::Graph &graph_;
+
+	MatchMode matchMode_;
+	QString deletedAttribute_;
+
+	/**
+	 * \brief Nodes of the graph by name.
+	 */
+	ReadNodesStore nodes_;
+
+	/**
+	 * \brief Types of the graph by the types of the delta.
+	 */
+	QHash<Data::Type *, Data::Type *> types_;
+
+	// counts of the changes made by the last merge
+	int addedNodes_;
+	int updatedNodes_;
+	int removedNodes_;
+	int addedEdges_;
+	int updatedEdges_;
+	int removedEdges_;
+
+}; // class
+
+} // namespace
+
+#endif // Importer_GraphMerger_H
@@ -13,6 +13,7 @@ namespace Importer {
  * - messages
  * - errors
  * - progress
+ * - cancellation
  */
 class ImportInfoHandler {
 
@@ -55,6 +56,12 @@ public:
 		const unsigned int value
 	) = 0;
 
+	/**
+	 * \brief Returns true if the import has been cancelled, importers should stop as soon as possible.
+	 * Importers ask for it when they report progress.
+	 */
+	virtual bool isCancelled (void) const { return false; }
+
 }; // class
 
 } // namespace
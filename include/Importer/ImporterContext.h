@@ -5,6 +5,7 @@
 #include "Importer/ImportInfoHandler.h"
 //-----------------------------------------------------------------------------
 #include <QIODevice>
+#include <QString>
 //-----------------------------------------------------------------------------
 
 namespace Importer {
@@ -13,7 +14,7 @@ namespace Importer {
  * \brief Contains object for the importer to work with.
  * Data manipulated by the importer during the import process:
  * - input: input data (stream)
- * - output: graph root object (graph), progress info (info handler)
+ * - output: graph root object (graph), progress info (info handler), name of the layout stored in the file (layout name)
  */
 class ImporterContext {
 
@@ -49,6 +50,18 @@ public:
 	 */
 	ImportInfoHandler &getInfoHandler (void);
 
+	/**
+	 * \brief \link ImporterContext::layoutName_ [getter] \endlink
+	 */
+	const QString &getLayoutName (void) const;
+
+	/**
+	 * \brief \link ImporterContext::layoutName_ [setter] \endlink
+	 */
+	void setLayoutName (
+		const QString &layoutName
+	);
+
 private:
 
 	/**
@@ -66,6 +79,12 @@ private:
 	 */
 	ImportInfoHandler &infoHandler_;
 
+	/**
+	 * \brief Name of the layout read from the stream, empty if the format does not store it.
+	 * The layout itself is created by the caller of the importer (with DB access), the importer only passes its name.
+	 */
+	QString layoutName_;
+
 }; // class
 
 } // namespace
@@ -2,26 +2,78 @@
 #define Importer_ReadNodesStore_H
 //-----------------------------------------------------------------------------
 #include "Data/Node.h"
+#include "Data/StringTable.h"
 //-----------------------------------------------------------------------------
 #include <osg/ref_ptr>
 #include <QString>
+#include <QStringRef>
+#include <QVector>
 //-----------------------------------------------------------------------------
-#include <map>
 
 namespace Importer {
 
 /**
  * \brief Stores a "node name" to "node" map.
  * Used by the importers to store imported nodes and search them by name when the
- * edges reference them.
+ * edges reference them. Names are interned in the string table of the graph, nodes
+ * are stored by the IDs of their names, so the importers can keep only the IDs
+ * (e.g. of the endpoints of the edges not yet added) and look the nodes up without
+ * hashing and comparing the names again.
  */
 class ReadNodesStore {
 
 public:
 
+	/**
+	 * \param[in] strings String table to intern the names in (usually the one of the imported graph).
+	 */
+	ReadNodesStore (
+		Data::StringTable &strings
+	);
+
 	/***/
 	virtual ~ReadNodesStore (void) {};
 
+	/**
+	 * \brief Returns ID of the name in the string table, adds the name to the table if it is not there.
+	 * \param[in] name Node name.
+	 */
+	int intern (
+		const QString &name
+	) {
+		return strings_.intern (name);
+	}
+
+	/**
+	 * \brief Returns ID of the name in the string table, adds the name to the table if it is not there.
+	 * \param[in] name Node name (e.g. attribute value of the XML reader, no string is created if the name is known).
+	 */
+	int intern (
+		const QStringRef &name
+	) {
+		return strings_.intern (name);
+	}
+
+	/**
+	 * \brief Returns the name with the ID.
+	 * \param[in] name ID of the name.
+	 */
+	const QString &getName (
+		int name
+	) const {
+		return strings_.getString (name);
+	}
+
+	/**
+	 * \brief Adds a new node.
+	 * \param[in] name ID of the node name.
+	 * \param[in] node Node to add.
+	 */
+	void addNode (
+		int name,
+		osg::ref_ptr<Data::Node> node
+	);
+
 	/**
 	 * \brief Adds a new node.
 	 * \param[in] name Node name.
@@ -30,7 +82,20 @@ public:
 	void addNode (
 		const QString &name,
 		osg::ref_ptr<Data::Node> node
-	);
+	) {
+		addNode (intern (name), node);
+	}
+
+	/**
+	 * \brief Checks if this store contains a node with the specified name.
+	 * \param[in] name ID of the node name.
+	 * \return True if there is a node with the name.
+	 */
+	bool contains (
+		int name
+	) const {
+		return name >= 0 && name < nodes_.size () && nodes_.at (name).valid ();
+	}
 
 	/**
 	 * \brief Checks if this store contains a node with the specified name.
@@ -39,7 +104,20 @@ public:
 	 */
 	bool contains (
 		const QString &name
-	);
+	) const {
+		return contains (strings_.find (name));
+	}
+
+	/**
+	 * \brief Gets the node with the specified name.
+	 * \param[in] name ID of the node name.
+	 * \return Node with the name or NULL, if it does not exist.
+	 */
+	osg::ref_ptr<Data::Node> get (
+		int name
+	) const {
+		return contains (name) ? nodes_.at (name) : osg::ref_ptr<Data::Node> (NULL);
+	}
 
 	/**
 	 * \brief Gets the node with the specified name.
@@ -48,16 +126,21 @@ public:
 	 */
 	osg::ref_ptr<Data::Node> get (
 		const QString &name
-	);
+	) const {
+		return get (strings_.find (name));
+	}
 
 private:
 
-	typedef std::map<QString, osg::ref_ptr<Data::Node> > NodesMapType;
+	/**
+	 * \brief Interned names.
+	 */
+	Data::StringTable &strings_;
 
 	/**
-	 * \brief Stored nodes.
+	 * \brief Stored nodes by the IDs of their names.
 	 */
-	NodesMapType nodes_;
+	QVector<osg::ref_ptr<Data::Node> > nodes_;
 
 }; // class
 
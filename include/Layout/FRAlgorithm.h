@@ -16,6 +16,8 @@
 #include <QMutex>
 #include <QThread>
 #include <QSharedPointer>
+#include <QVector>
+#include <QSet>
 
 #include "Viewer/DataHelper.h"
 #include "Data/Edge.h"
@@ -23,6 +25,7 @@
 #include "Data/Type.h"
 #include "Data/Graph.h"
 #include "Util/ApplicationConfig.h"
+#include "Layout/NodeOrdering.h"
 
 namespace Layout
 {
@@ -68,6 +71,17 @@ namespace Layout
 		*/
 		void Randomize();				
 
+		/**
+		*  \fn public  Randomize(const QList<osg::ref_ptr<Data::Node> > &nodes)
+		*  \brief Sets random position of given nodes (e.g. nodes added while the graph is being loaded)
+		*
+		*	The algorithm is paused until the current iteration ends and its previous state is restored, so it can be called
+		*	by the thread owning the graph while the layout runs.
+		*
+		*  \param  nodes  nodes to place
+		*/
+		void Randomize(const QList<osg::ref_ptr<Data::Node> > &nodes);
+
 		/**
 		*  \fn inline public  SetAlphaValue(float val)
 		*  \brief Sets multiplicity of forces
@@ -93,6 +107,18 @@ namespace Layout
 		*/
 		void WakeUpAlg();
 
+		/**
+		*  \fn public  ApplyGraphCommands(Data::Graph *changedGraph)
+		*  \brief Applies the queued changes of the graph structure (Data::Graph::applyCommands) between two iterations
+		*
+		*	If the algorithm lays out the changed graph, it is paused until the current iteration ends, the commands are applied
+		*	and the previous state of the algorithm is restored. Called by the thread owning the graph (viewer).
+		*
+		*  \param  changedGraph  graph with the queued commands
+		*  \return bool true, if some command was applied
+		*/
+		bool ApplyGraphCommands(Data::Graph *changedGraph);
+
 		/**
 		*  \fn public  IsRunning
 		*  \brief Returns if layout algorithm is running or not
@@ -209,6 +235,79 @@ namespace Layout
 		*/
 		QMutex isIterating_mutex;
 
+		/**
+		*  Layout::NodeOrdering::Method ordering
+		*  \brief method of the ordering of the nodes iterated by the algorithm (Layout.NodeOrdering)
+		*/
+		Layout::NodeOrdering::Method ordering;
+
+		/**
+		*  int orderingInterval
+		*  \brief count of the iterations after which the nodes are ordered again by their new positions (Layout.NodeOrdering.Interval)
+		*/
+		int orderingInterval;
+
+		/**
+		*  int orderingAge
+		*  \brief count of the iterations since the last ordering of the nodes
+		*/
+		int orderingAge;
+
+		/**
+		*  QSharedPointer<Data::GraphSnapshot> orderedSnapshot
+		*  \brief snapshot of the ordered nodes and edges, keeps them alive while they are iterated
+		*/
+		QSharedPointer<Data::GraphSnapshot> orderedSnapshot;
+
+		/**
+		*  QVector<Data::Node *> orderedNodes
+		*  \brief nodes of the snapshot, neighbouring nodes are next to each other
+		*/
+		QVector<Data::Node *> orderedNodes;
+
+		/**
+		*  QVector<Data::Edge *> orderedEdges
+		*  \brief edges of the snapshot ordered by their nodes in orderedNodes
+		*/
+		QVector<Data::Edge *> orderedEdges;
+
+		/**
+		*  QSet<Data::Node *> orderedNodeSet
+		*  \brief nodes in orderedNodes, used to find nodes added to the graph
+		*/
+		QSet<Data::Node *> orderedNodeSet;
+
+		/**
+		*  QSet<Data::Edge *> orderedEdgeSet
+		*  \brief edges in orderedEdges, used to find edges added to the graph
+		*/
+		QSet<Data::Edge *> orderedEdgeSet;
+
+		/**
+		*  \fn private  updateOrdering(QSharedPointer<Data::GraphSnapshot> snapshot)
+		*  \brief Orders the nodes and edges of the snapshot again, if the snapshot has changed or the interval of the ordering has passed
+		*  \param  snapshot  current snapshot of the graph
+		*/
+		void updateOrdering(QSharedPointer<Data::GraphSnapshot> snapshot);
+
+		/**
+		*  \fn private  appendOrdering(QSharedPointer<Data::GraphSnapshot> snapshot)
+		*  \brief Appends nodes and edges added to the graph since the ordered snapshot to the end of orderedNodes and orderedEdges
+		*
+		*	Used while the graph is being loaded and the layout runs on the partial graph, new nodes are only appended
+		*	until the interval of the ordering passes.
+		*
+		*  \param  snapshot  current snapshot of the graph
+		*  \return bool false, if some nodes or edges were removed and the snapshot has to be ordered again
+		*/
+		bool appendOrdering(QSharedPointer<Data::GraphSnapshot> snapshot);
+
+		/**
+		*  \fn private  loadOrderingConfig
+		*  \brief Reads the ordering of the nodes from the configuration
+		*/
+		void loadOrderingConfig();
+
 		/**
 		*  \fn private  computeCalm
 		*  \brief computes rest mass chord
@@ -294,12 +393,13 @@ namespace Layout
 		bool applyForces(Data::Node* node);
 
 		/**
-		*  \fn private  addAttractive(Data::Edge* edge, float factor)
-		*  \brief Adds attractive force to node
-		*  \param  edge  which associate two nodes on which effect attractive force
+		*  \fn private  addAttractive(Data::Node* u, Data::Node* v, float factor)
+		*  \brief Adds attractive force of the edge to its nodes
+		*  \param  u  starting node of the edge
+		*  \param  v  ending node of the edge
 		*  \param  factor  multiplicer of attaractive force
 		*/
-		void addAttractive(Data::Edge* edge, float factor);
+		void addAttractive(Data::Node* u, Data::Node* v, float factor);
 
 		/**
 		*  \fn private  addMetaAttractive(Data::Node* u, Data::Node* meta, float factor)
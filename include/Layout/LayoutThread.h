@@ -70,6 +70,13 @@ namespace Layout
 
 		void requestEnd();
 
+		/**
+		*  \fn public  setStartSleepTime(long seconds)
+		*  \brief Sets delay before the start of the layout algorithm (Layout.Thread.StartSleepTime by default), must be called before start
+		*  \param  seconds  delay in seconds
+		*/
+		void setStartSleepTime(long seconds);
+
 	protected:
 
 		/**
@@ -92,6 +99,12 @@ namespace Layout
 		*  \brief Object of application config
 		*/
 		Util::ApplicationConfig* appConf;
+
+		/**
+		*  long startSleepTime
+		*  \brief Delay before the start of the layout algorithm in seconds
+		*/
+		long startSleepTime;
 	};
 }
 
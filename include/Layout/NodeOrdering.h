@@ -0,0 +1,114 @@
+/*!
+ * NodeOrdering.h
+ * Projekt 3DVisual
+ */
+
+#ifndef LAYOUT_NODEORDERING_DEF
+#define LAYOUT_NODEORDERING_DEF 1
+
+#include <osg/ref_ptr>
+#include <osg/Vec3f>
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+namespace Data
+{
+	class Node;
+	class Edge;
+}
+
+namespace Layout
+{
+	/**
+	*  \class NodeOrdering
+	*  \brief Orders the Nodes for the dense arrays iterated by the layout and the viewer
+	*
+	*	The Nodes in the QMaps of the Graph are ordered by id, which is the import order. Nodes close in space (Hilbert or Morton curve
+	*	of the positions) or in the Graph (reverse Cuthill-McKee ordering of the adjacency) are placed next to each other instead,
+	*	so the loops over the Nodes and over the Edges ordered by their Nodes touch the memory of the neighbouring Nodes together.
+	*
+	*  \date 19. 10. 2026
+	*/
+	class NodeOrdering
+	{
+	public:
+
+		/**
+		*  \brief Method of the ordering
+		*/
+		enum Method {
+			NONE,
+			HILBERT,
+			MORTON,
+			CUTHILL_MCKEE
+		};
+
+		/**
+		*  int CURVE_BITS
+		*  \brief Count of the bits of each coordinate used for the keys of the space-filling curves
+		*/
+		static const int CURVE_BITS = 16;
+
+		/**
+		*  \fn public static  methodFromName(QString name)
+		*  \brief Returns method by its name in the configuration (hilbert, morton, rcm, none)
+		*  \param  name   name of the method
+		*  \return Layout::NodeOrdering::Method method, HILBERT for an empty name
+		*/
+		static Method methodFromName(QString name);
+
+		/**
+		*  \fn public static  spatialOrder(const QVector<osg::Vec3f> &positions, Method method)
+		*  \brief Returns permutation ordering the positions along the Hilbert or Morton curve
+		*  \param  positions   positions
+		*  \param  method   HILBERT or MORTON
+		*  \return QVector<int> indexes of the positions in the new order
+		*/
+		static QVector<int> spatialOrder(const QVector<osg::Vec3f> &positions, Method method);
+
+		/**
+		*  \fn public static  cuthillMcKeeOrder(const QVector<int> &offsets, const QVector<int> &neighbours)
+		*  \brief Returns reverse Cuthill-McKee permutation of the adjacency
+		*  \param  offsets   start of the neighbours of each Node (n+1 items)
+		*  \param  neighbours   neighbours of all Nodes
+		*  \return QVector<int> indexes of the Nodes in the new order
+		*/
+		static QVector<int> cuthillMcKeeOrder(const QVector<int> &offsets, const QVector<int> &neighbours);
+
+		/**
+		*  \fn public static  orderNodes(const QMap<qlonglong, osg::ref_ptr<Data::Node> > &nodes, const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &edges, Method method)
+		*  \brief Returns the Nodes in the order given by the method
+		*  \param  nodes   Nodes
+		*  \param  edges   Edges between the Nodes (used by CUTHILL_MCKEE)
+		*  \param  method   method of the ordering
+		*  \return QVector<Data::Node *> ordered Nodes
+		*/
+		static QVector<Data::Node *> orderNodes(const QMap<qlonglong, osg::ref_ptr<Data::Node> > &nodes, const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &edges, Method method);
+
+		/**
+		*  \fn public static  orderEdges(const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &edges, const QVector<Data::Node *> &nodes)
+		*  \brief Returns the Edges ordered by the position of their Nodes in the ordered Nodes
+		*  \param  edges   Edges
+		*  \param  nodes   ordered Nodes
+		*  \return QVector<Data::Edge *> ordered Edges
+		*/
+		static QVector<Data::Edge *> orderEdges(const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &edges, const QVector<Data::Node *> &nodes);
+
+	private:
+
+		/**
+		*  \fn private static  curveKey(quint32 x, quint32 y, quint32 z, bool hilbert)
+		*  \brief Returns position of the point on the Hilbert or Morton curve
+		*  \param  x   quantized x coordinate
+		*  \param  y   quantized y coordinate
+		*  \param  z   quantized z coordinate
+		*  \param  hilbert   true for Hilbert curve, false for Morton curve
+		*  \return quint64 key of the point
+		*/
+		static quint64 curveKey(quint32 x, quint32 y, quint32 z, bool hilbert);
+	};
+}
+
+#endif
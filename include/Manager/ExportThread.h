@@ -0,0 +1,133 @@
+#ifndef Manager_ExportThread_H
+#define Manager_ExportThread_H
+//-----------------------------------------------------------------------------
+#include "Importer/ImportInfoHandler.h"
+#include "Exporter/ExporterContext.h"
+#include "Exporter/StreamExporter.h"
+//-----------------------------------------------------------------------------
+#include <QAtomicInt>
+#include <QFile>
+#include <QMutex>
+#include <QStringList>
+#include <QThread>
+#include <QTimer>
+//-----------------------------------------------------------------------------
+#include <memory>
+
+namespace Manager {
+
+/**
+ * \brief Runs the exporter on a separate thread.
+ * The data of the graph are copied by the constructor (on the GUI thread), so the graph can be edited and laid out
+ * while it is being written. Progress, messages and errors of the exporter are only stored and shown by the timer
+ * on the GUI thread (Importer.ProgressInterval), the timer also checks the cancel button of the progress bar.
+ * When the export ends, GraphManager::finishExport is called.
+ */
+class ExportThread
+	: public QThread,
+	  public Importer::ImportInfoHandler {
+
+	Q_OBJECT
+
+public:
+
+	/**
+	 * \param[in] exporter Exporter of the file (ownership is taken).
+	 * \param[in] stream Opened stream of the file (ownership is taken).
+	 * \param[in] graph Exported graph.
+	 */
+	ExportThread (
+		std::auto_ptr<Exporter::StreamExporter> exporter,
+		std::auto_ptr<QFile> stream,
+		Data::Graph &graph
+	);
+
+	/***/
+	virtual ~ExportThread (void);
+
+	/**
+	 * \brief Starts the export and the timer.
+	 */
+	void startExport (void);
+
+	/**
+	 * \brief Requests the end of the export, the exporter stops as soon as it checks isCancelled.
+	 */
+	void cancel (void);
+
+	/**
+	 * \return ( = the exporter finished successfully and the export has not been cancelled)
+	 */
+	bool isExported (void) const;
+
+	/**
+	 * \brief Removes the incompletely written file (after failed or cancelled export).
+	 */
+	void removeFile (void);
+
+	/**
+	 * \brief Shows stored errors and messages of the exporter (on the GUI thread).
+	 */
+	void showMessages (void);
+
+	// ImportInfoHandler - volane z vlakna exportu
+
+	/***/
+	virtual void addMessage (
+		const QString &text
+	);
+
+	/***/
+	virtual void reportError (
+		const QString &text
+	);
+
+	/***/
+	virtual void setProgress (
+		const unsigned int value
+	);
+
+	/***/
+	virtual bool isCancelled (void) const;
+
+protected:
+
+	/***/
+	virtual void run (void);
+
+private slots:
+
+	/**
+	 * \brief Updates the progress bar.
+	 */
+	void update (void);
+
+	/**
+	 * \brief Passes the result of the export to the GraphManager.
+	 */
+	void finish (void);
+
+private:
+
+	std::auto_ptr<Exporter::StreamExporter> exporter_;
+	std::auto_ptr<QFile> stream_;
+	std::auto_ptr<Exporter::ExporterContext> context_;
+
+	QTimer timer_;
+
+	QAtomicInt progress_;
+	QAtomicInt cancelled_;
+	bool ok_;
+
+	/**
+	 * \brief Errors and messages of the exporter not yet shown.
+	 */
+	QMutex messagesMutex_;
+	QStringList errors_;
+	QStringList messages_;
+
+}; // class
+
+} // namespace
+
+#endif // Manager_ExportThread_H
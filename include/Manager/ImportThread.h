@@ -0,0 +1,137 @@
+#ifndef Manager_ImportThread_H
+#define Manager_ImportThread_H
+//-----------------------------------------------------------------------------
+#include "Importer/ImportInfoHandler.h"
+#include "Importer/ImporterContext.h"
+#include "Importer/StreamImporter.h"
+//-----------------------------------------------------------------------------
+#include <QAtomicInt>
+#include <QIODevice>
+#include <QMutex>
+#include <QStringList>
+#include <QThread>
+#include <QTimer>
+//-----------------------------------------------------------------------------
+#include <memory>
+
+namespace Manager {
+
+/**
+ * \brief Runs the importer on a separate thread.
+ * Progress, messages and errors of the importer are only stored and shown by the timer on the GUI thread,
+ * at most once per Importer.ProgressInterval milliseconds. The timer also inserts already imported nodes
+ * and edges to the lists of the graph (so they are shown while the rest of the file is imported) and checks
+ * the cancel button of the progress bar. When the import ends, GraphManager::finishImport is called.
+ */
+class ImportThread
+	: public QThread,
+	  public Importer::ImportInfoHandler {
+
+	Q_OBJECT
+
+public:
+
+	/**
+	 * \param[in] importer Importer of the file (ownership is taken).
+	 * \param[in] stream Opened stream of the file (ownership is taken).
+	 * \param[in] graph Graph to import to, bulk insert of the graph must be started.
+	 */
+	ImportThread (
+		std::auto_ptr<Importer::StreamImporter> importer,
+		std::auto_ptr<QIODevice> stream,
+		Data::Graph &graph
+	);
+
+	/***/
+	virtual ~ImportThread (void);
+
+	/**
+	 * \brief Starts the import and the timer.
+	 */
+	void startImport (void);
+
+	/**
+	 * \brief Requests the end of the import, the importer stops as soon as it checks isCancelled.
+	 */
+	void cancel (void);
+
+	/**
+	 * \return ( = the importer finished successfully and the import has not been cancelled)
+	 */
+	bool isImported (void) const;
+
+	/***/
+	Data::Graph &getGraph (void);
+
+	/**
+	 * \return Name of the layout read from the file, empty if the format does not store it.
+	 */
+	QString getLayoutName (void) const;
+
+	/**
+	 * \brief Shows stored errors and messages of the importer (on the GUI thread).
+	 */
+	void showMessages (void);
+
+	// ImportInfoHandler - volane z vlakna importu
+
+	/***/
+	virtual void addMessage (
+		const QString &text
+	);
+
+	/***/
+	virtual void reportError (
+		const QString &text
+	);
+
+	/***/
+	virtual void setProgress (
+		const unsigned int value
+	);
+
+	/***/
+	virtual bool isCancelled (void) const;
+
+protected:
+
+	/***/
+	virtual void run (void);
+
+private slots:
+
+	/**
+	 * \brief Updates the progress bar and shows already imported nodes and edges.
+	 */
+	void update (void);
+
+	/**
+	 * \brief Passes the result of the import to the GraphManager.
+	 */
+	void finish (void);
+
+private:
+
+	std::auto_ptr<Importer::StreamImporter> importer_;
+	std::auto_ptr<QIODevice> stream_;
+	std::auto_ptr<Importer::ImporterContext> context_;
+	Data::Graph &graph_;
+
+	QTimer timer_;
+
+	QAtomicInt progress_;
+	QAtomicInt cancelled_;
+	bool ok_;
+
+	/**
+	 * \brief Errors and messages of the importer not yet shown.
+	 */
+	QMutex messagesMutex_;
+	QStringList errors_;
+	QStringList messages_;
+
+}; // class
+
+} // namespace
+
+#endif // Manager_ImportThread_H
@@ -6,13 +6,16 @@
 #define Manager_MANAGER_DEF 1
 
 #include <vector>
+#include <memory>
 #include <QMap>
+#include <QQueue>
 #include <QString>
 #include <QFile>
 #include <qfileinfo.h>
 
 #include "Core/Core.h"
 #include "Model/DB.h"
+#include "Importer/StreamImporter.h"
 #include "Data/Graph.h"
 #include "Layout/FRAlgorithm.h"
 #include "Layout/LayoutThread.h"
@@ -22,6 +25,10 @@
 
 namespace Manager
 {
+    class ImportThread;
+    class ExportThread;
+    class SaveLayoutThread;
+
     /**
      * \class Manager
      * \brief Manager provides functionality to manage graphs (loading, creating, holding, editing and deleting).
@@ -50,9 +57,28 @@ namespace Manager
 
             /**
              * \fn loadGraph
-             * \brief Loads graph from GraphML file.
+             * \brief Starts loading of graph from file on a separate thread, the graph is active and shown while it is being loaded.
+             * If Importer.PipelinedLayout is set, the layout runs on the partial graph, otherwise it starts after loading.
+             * Returns NULL if the file can not be loaded or another file is still being loaded.
              */
             Data::Graph* loadGraph(QString filepath);
+
+            /**
+             * \fn finishImport
+             * \brief Finishes loading of graph started by loadGraph (called by the import thread on the GUI thread).
+             * Saves the loaded graph to DB and resumes the layout, if loading failed or was cancelled, the previous graph is restored.
+             * If another graph was opened during loading, it stays active and the loaded graph is deleted.
+             */
+            void finishImport(ImportThread* thread);
+
+            /**
+             * \fn mergeGraph
+             * \brief Starts loading of delta file on a separate thread, the delta is merged into the active graph when it is loaded.
+             * Nodes are matched by name (Importer.DeltaMatchBy=name) or id (Importer.DeltaMatchBy=id), new elements are added,
+             * elements with the attribute Importer.DeltaDeletedAttribute (default "deleted") set are removed and attributes are updated.
+             * Positions of the existing nodes are kept and the layout continues.
+             */
+            void mergeGraph(QString filepath);
 			
 			/**
              * \fn loadGraph
@@ -73,10 +99,34 @@ namespace Manager
 
             /**
              * \fn exportGraph
-             * \brief Exports graph into file (not yet implemented).
+             * \brief Starts export of graph into file on a separate thread, the format is chosen by the file extension.
+             * The snapshot of the graph (including positions of the nodes) is taken immediately, so the graph can be edited
+             * and laid out while it is being written.
              */
             void exportGraph(Data::Graph* graph, QString filepath);
 
+            /**
+             * \fn finishExport
+             * \brief Finishes export started by exportGraph (called by the export thread on the GUI thread).
+             * If the export failed or was cancelled, the incomplete file is removed.
+             */
+            void finishExport(ExportThread* thread);
+
+            /**
+             * \fn saveLayout
+             * \brief Starts saving of the selected layout of the graph to DB on a separate thread (with its own DB connection).
+             * The layout data are copied immediately, so the graph can be edited and laid out while the layout is being saved.
+             * If another layout is still being saved, the save is queued and started when the previous one ends.
+             * Returns false if there is no layout to save or no DB connection.
+             */
+            bool saveLayout(Data::Graph* graph);
+
+            /**
+             * \fn finishSaveLayout
+             * \brief Finishes saving started by saveLayout (called by the save thread on the GUI thread), reports failure and starts the next queued save.
+             */
+            void finishSaveLayout(SaveLayoutThread* thread);
+
             /**
              * \fn createGraph
              * \brief Creates empty graph, puts it into the working graphs and returns it.
@@ -114,6 +164,23 @@ namespace Manager
                 */
                 void runTestCase(qint32 action);
 
+                /**
+                *  \fn private  openImport(QString filepath, std::auto_ptr<Importer::StreamImporter> &importer, std::auto_ptr<QIODevice> &stream)
+                *  \brief Creates importer according to the extension of the file and opens the file (decompressed if needed), reports errors
+                *  \param  filepath  path of the file
+                *  \param  importer  created importer
+                *  \param  stream  opened stream of the file
+                *  \return bool true, if the file can be imported
+                */
+                bool openImport(QString filepath, std::auto_ptr<Importer::StreamImporter> &importer, std::auto_ptr<QIODevice> &stream);
+
+                /**
+                *  \fn private  finishMerge(ImportThread* thread)
+                *  \brief Merges the loaded delta into the target graph (called by finishImport)
+                *  \param  thread  finished import thread of the delta
+                */
+                void finishMerge(ImportThread* thread);
+
 
                 /**
                 *  \fn private  emptyGraph
@@ -155,6 +222,54 @@ namespace Manager
                 *  \brief active graph
                 */
                 Data::Graph *activeGraph;
+
+               /**
+                *  ImportThread * importThread
+                *  \brief thread of the file being loaded, NULL if no file is being loaded
+                */
+                ImportThread *importThread;
+
+               /**
+                *  ExportThread * exportThread
+                *  \brief thread of the file being written, NULL if no file is being written
+                */
+                ExportThread *exportThread;
+
+               /**
+                *  SaveLayoutThread * saveLayoutThread
+                *  \brief thread of the layout being saved to DB, NULL if no layout is being saved
+                */
+                SaveLayoutThread *saveLayoutThread;
+
+               /**
+                *  QQueue<SaveLayoutThread *> pendingSaveLayoutThreads
+                *  \brief saves of layouts (with already copied data) waiting for the end of saveLayoutThread
+                */
+                QQueue<SaveLayoutThread *> pendingSaveLayoutThreads;
+
+               /**
+                *  Data::Graph * mergeTarget
+                *  \brief graph the loaded delta file is merged into, NULL if the file being loaded is not a delta
+                */
+                Data::Graph *mergeTarget;
+
+               /**
+                *  Data::Graph * previousGraph
+                *  \brief active graph before loading of the file, restored if loading fails
+                */
+                Data::Graph *previousGraph;
+
+               /**
+                *  QString importFileName
+                *  \brief name of the file being loaded
+                */
+                QString importFileName;
+
+               /**
+                *  bool pipelinedLayout
+                *  \brief flag if the layout runs on the graph while it is being loaded (Importer.PipelinedLayout)
+                */
+                bool pipelinedLayout;
 	};
 }
 
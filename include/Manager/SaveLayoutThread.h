@@ -0,0 +1,78 @@
+#ifndef Manager_SaveLayoutThread_H
+#define Manager_SaveLayoutThread_H
+//-----------------------------------------------------------------------------
+#include "Model/GraphLayoutWriter.h"
+//-----------------------------------------------------------------------------
+#include <QSqlDatabase>
+#include <QString>
+#include <QThread>
+//-----------------------------------------------------------------------------
+#include <memory>
+
+namespace Manager {
+
+/**
+ * \brief Saves layout of the graph to DB on a separate thread.
+ * The layout data are copied by the constructor (on the GUI thread, see Model::GraphLayoutWriter), so the graph can be
+ * edited or closed while the layout is saved. The thread opens its own connection with the parameters of the connection
+ * of the application (a connection can only be used by the thread which opened it). When the save ends,
+ * GraphManager::finishSaveLayout is called.
+ */
+class SaveLayoutThread
+	: public QThread {
+
+	Q_OBJECT
+
+public:
+
+	/**
+	 * \param[in] graph Saved graph.
+	 * \param[in] layout Saved layout of the graph.
+	 * \param[in] conn Connection of the application (only its parameters are used).
+	 */
+	SaveLayoutThread (
+		Data::Graph *graph,
+		Data::GraphLayout *layout,
+		const QSqlDatabase &conn
+	);
+
+	/***/
+	virtual ~SaveLayoutThread (void);
+
+	/**
+	 * \return ( = the layout was saved)
+	 */
+	bool isSaved (void) const;
+
+protected:
+
+	/***/
+	virtual void run (void);
+
+private slots:
+
+	/**
+	 * \brief Passes the result of the save to the GraphManager.
+	 */
+	void finish (void);
+
+private:
+
+	std::auto_ptr<Model::GraphLayoutWriter> writer_;
+
+	// parameters of the connection of the application
+	QString driverName_;
+	QString hostName_;
+	QString databaseName_;
+	QString userName_;
+	QString password_;
+	int port_;
+	QString connectOptions_;
+
+	bool ok_;
+
+}; // class
+
+} // namespace
+
+#endif // Manager_SaveLayoutThread_H
@@ -0,0 +1,141 @@
+/*!
+ * BatchInsert.h
+ * Projekt 3DVisual
+ */
+#ifndef MODEL_BATCHINSERT_DEF
+#define MODEL_BATCHINSERT_DEF 1
+
+#include <QtSql>
+#include <QDebug>
+#include <QStringList>
+
+namespace Model
+{
+	/**
+	*  \class BatchInsert
+	*  \brief Inserts many rows into one table with few round trips to the database
+	*
+	*	Rows are collected and written by multi-row INSERT statements, each with rowsPerQuery rows. The statement is
+	*	prepared only once (the last shorter statement once more), so the database does not parse each row again.
+	*	The caller should wrap the inserts in a transaction, otherwise each statement is committed separately.
+	*/
+	class BatchInsert
+	{
+	public:
+
+		/**
+		*  \fn public constructor  BatchInsert(QSqlDatabase* conn, QString table, QStringList columns, int rowsPerQuery = 500)
+		*  \brief Creates inserter of the rows into the table
+		*  \param   conn   connection to the database
+		*  \param   table   name of the table
+		*  \param   columns   names of the columns, each row has the values in the same order
+		*  \param   rowsPerQuery   number of rows written by one statement
+		*/
+		BatchInsert(QSqlDatabase* conn, QString table, QStringList columns, int rowsPerQuery = 500);
+
+		/**
+		*  \fn public  addRow(const QVariantList& values)
+		*  \brief Adds row, writes the collected rows if there are rowsPerQuery of them
+		*  \param   values   values of the row (in the order of the columns)
+		*  \return	bool true, if the collected rows were successfully written (or they were not written yet)
+		*/
+		bool addRow(const QVariantList& values);
+
+		/**
+		*  \fn public  finish
+		*  \brief Writes the remaining rows
+		*  \return	bool true, if the rows were successfully written
+		*/
+		bool finish();
+
+		/**
+		*  \fn inline public  getRowCount
+		*  \brief Returns the number of rows added so far
+		*  \return qlonglong number of rows
+		*/
+		qlonglong getRowCount() const { return rowCount; }
+
+		/**
+		*  \fn inline public  lastError
+		*  \brief Returns text of the last database error
+		*  \return QString error text
+		*/
+		QString lastError() const { return error; }
+
+	private:
+
+		/**
+		*  \fn private  execPending
+		*  \brief Writes the collected rows by one statement
+		*  \return	bool true, if the rows were successfully written
+		*/
+		bool execPending();
+
+		/**
+		*  \fn private  insertStatement(int rows)
+		*  \brief Returns INSERT statement with placeholders for the number of rows
+		*/
+		QString insertStatement(int rows) const;
+
+		/**
+		*	QSqlDatabase* conn
+		*	\brief Connection to the database
+		*/
+		QSqlDatabase* conn;
+
+		/**
+		*	QString table
+		*	\brief Name of the table
+		*/
+		QString table;
+
+		/**
+		*	QStringList columns
+		*	\brief Names of the columns
+		*/
+		QStringList columns;
+
+		/**
+		*	int rowsPerQuery
+		*	\brief Number of rows written by one statement
+		*/
+		int rowsPerQuery;
+
+		/**
+		*	QSqlQuery fullQuery
+		*	\brief Prepared statement for rowsPerQuery rows
+		*/
+		QSqlQuery fullQuery;
+
+		/**
+		*	bool fullQueryPrepared
+		*	\brief True, if fullQuery was already prepared
+		*/
+		bool fullQueryPrepared;
+
+		/**
+		*	QVariantList pending
+		*	\brief Values of the rows not yet written
+		*/
+		QVariantList pending;
+
+		/**
+		*	int pendingRows
+		*	\brief Number of the rows not yet written
+		*/
+		int pendingRows;
+
+		/**
+		*	qlonglong rowCount
+		*	\brief Number of the added rows
+		*/
+		qlonglong rowCount;
+
+		/**
+		*	QString error
+		*	\brief Text of the last database error
+		*/
+		QString error;
+	};
+}
+#endif
@@ -6,9 +6,11 @@
 #define MODEL_EDGEDAO_DEF 1
 
 #include "Data/Edge.h"
+#include "Model/BatchInsert.h"
 
 #include <QtSql>
 #include <QDebug>
+#include <QSet>
 
 namespace Data {
 	class Edge;
@@ -29,6 +31,8 @@ namespace Model
 		/**
 		*  \fn public static  addEdgesToDB(QSqlDatabase* conn, QMap<qlonglong, osg::ref_ptr<Data::Edge> >* edges)
 		*  \brief	Add edges to DB
+		*
+		*	All add*ToDB methods write the rows by BatchInsert, the caller should run them in one transaction.
 		*  \param   conn   connection to the database 
 		*  \param   edges  edges from actual graph
 		*  \return	bool true, if edges were successfully added to DB
@@ -112,6 +116,16 @@ namespace Model
 		*/
 		static bool removeEdge(Data::Edge* edge, QSqlDatabase* conn);
         
+		/**
+		*  \fn public static  removeEdges(qlonglong graphID, QSet<qlonglong> edgeIDs, QSqlDatabase* conn)
+		*  \brief Removes set of Edges from the database in one transaction
+		*  \param   graphID    ID of graph
+		*  \param   edgeIDs    IDs of the removed Edges
+		*  \param   conn     connection to the database
+		*  \return bool true, if all the Edges were successfully removed from the database
+		*/
+		static bool removeEdges(qlonglong graphID, QSet<qlonglong> edgeIDs, QSqlDatabase* conn);
+
 		/**
 		*  \fn public static  removeEdges(qlonglong graphID, QSqlDatabase* conn)
 		*  \brief Removes the Edges from database
@@ -213,6 +227,23 @@ namespace Model
 
 	private:
 
+		/**
+		*  \fn private static  getEdgeID(osg::ref_ptr<Data::Edge> edge, const QMap<qlonglong, qlonglong>& newMetaEdgeID, bool meta, qlonglong* edgeID)
+		*  \brief	Return ID of the edge in DB (meta edges get new ID)
+		*  \param   edge  edge from actual graph
+		*  \param	newMetaEdgeID	new ID of meta edges
+		*  \param	meta	true, if edge is meta type
+		*  \param	edgeID	ID of the edge in DB, not changed if new ID of the meta edge is missing
+		*  \return	bool false, if new ID of the meta edge is missing
+		*/
+		static bool getEdgeID(osg::ref_ptr<Data::Edge> edge, const QMap<qlonglong, qlonglong>& newMetaEdgeID, bool meta, qlonglong* edgeID);
+
+		/**
+		*  \fn private static  settingsColumns
+		*  \brief	Return columns of the edge_settings table used by BatchInsert
+		*/
+		static QStringList settingsColumns();
+
 		/**
 		*  \fn private constructor  EdgeDAO
 		*  \brief Constructs EdgeDAO object
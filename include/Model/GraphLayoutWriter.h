@@ -0,0 +1,162 @@
+/*!
+ * GraphLayoutWriter.h
+ * Projekt 3DVisual
+ */
+#ifndef MODEL_GRAPHLAYOUTWRITER_DEF
+#define MODEL_GRAPHLAYOUTWRITER_DEF 1
+
+#include "Data/Graph.h"
+#include "Data/GraphLayout.h"
+#include "Model/BatchInsert.h"
+
+#include <QtSql>
+#include <QDebug>
+#include <QHash>
+#include <QVector>
+
+#include <osg/Vec3f>
+#include <osg/Vec4>
+
+namespace Model
+{
+	/**
+	*  \class GraphLayoutWriter
+	*  \brief Saves layout of the graph (meta nodes, meta edges, positions and settings of all elements) to DB
+	*
+	*	The constructor walks the snapshot of the graph once and copies everything the layout needs, so the graph can be
+	*	edited, laid out or closed while the layout is written and write can run on another thread (with its own connection).
+	*	Write emits the rows of all the layout tables by BatchInsert in one transaction: rows of the meta nodes and meta edges first
+	*	(the other rows refer to them), then one pass over all the elements writes positions, node settings and edge settings.
+	*/
+	class GraphLayoutWriter
+	{
+	public:
+
+		/**
+		*  \fn public constructor  GraphLayoutWriter(Data::Graph* graph, Data::GraphLayout* layout)
+		*  \brief Copies the layout data of the graph (has to be called on the thread owning the graph)
+		*  \param   graph   saved graph
+		*  \param   layout   saved layout of the graph
+		*/
+		GraphLayoutWriter(Data::Graph* graph, Data::GraphLayout* layout);
+
+		/**
+		*  \fn public  write(QSqlDatabase* conn)
+		*  \brief Writes the copied layout to DB in one transaction
+		*  \param   conn   connection to the database (owned by the calling thread, not in transaction)
+		*  \return	bool true, if the layout was successfully saved to DB
+		*/
+		bool write(QSqlDatabase* conn);
+
+		/**
+		*  \fn inline public  getLayoutId
+		*  \brief Returns ID of the saved layout
+		*/
+		qlonglong getLayoutId() const { return layoutId; }
+
+	private:
+
+		/**
+		*  \struct NodeRecord
+		*  \brief Layout data of one node
+		*/
+		struct NodeRecord
+		{
+			qlonglong id;
+			qlonglong typeId;
+			// ID of the parent node, -1 if there is none
+			qlonglong parentId;
+			// ID of the merged node the node is merged into (Data::Graph::getMergedGroups), -1 if there is none
+			qlonglong mergedInto;
+			// name is saved only for meta nodes
+			QString name;
+			osg::Vec3f position;
+			osg::Vec4 color;
+			float scale;
+			bool meta;
+			bool fixed;
+			bool masked;
+			bool parent;
+		};
+
+		/**
+		*  \struct EdgeRecord
+		*  \brief Layout data of one edge
+		*/
+		struct EdgeRecord
+		{
+			qlonglong id;
+			qlonglong typeId;
+			qlonglong srcId;
+			qlonglong dstId;
+			// name is saved only for meta edges
+			QString name;
+			osg::Vec4 color;
+			float scale;
+			bool meta;
+			bool oriented;
+			bool nested;
+		};
+
+		/**
+		*  \fn private  addNode(Data::Node* node, bool meta, const QHash<qlonglong, qlonglong>& mergedInto)
+		*  \brief Copies layout data of the node
+		*/
+		void addNode(Data::Node* node, bool meta, const QHash<qlonglong, qlonglong>& mergedInto);
+
+		/**
+		*  \fn private  addEdge(Data::Edge* edge, bool meta, Data::Type* nestedEdgeType)
+		*  \brief Copies layout data of the edge
+		*/
+		void addEdge(Data::Edge* edge, bool meta, Data::Type* nestedEdgeType);
+
+		/**
+		*  \fn private  writeRows(QSqlDatabase* conn)
+		*  \brief Writes all the rows (called in the transaction)
+		*/
+		bool writeRows(QSqlDatabase* conn);
+
+		/**
+		*  \fn private  maxId(QSqlDatabase* conn, QString table, QString column, bool* error)
+		*  \brief Returns the highest ID of the elements of the graph in the table
+		*/
+		qlonglong maxId(QSqlDatabase* conn, QString table, QString column, bool* error);
+
+		/**
+		*	qlonglong graphId
+		*	\brief ID of the graph
+		*/
+		qlonglong graphId;
+
+		/**
+		*	qlonglong layoutId
+		*	\brief ID of the layout
+		*/
+		qlonglong layoutId;
+
+		/**
+		*	float nodeScale
+		*	\brief Default scale of the nodes (only different scales are saved)
+		*/
+		float nodeScale;
+
+		/**
+		*	float edgeScale
+		*	\brief Default scale of the edges (only different scales are saved)
+		*/
+		float edgeScale;
+
+		/**
+		*	QVector<NodeRecord> nodes
+		*	\brief Nodes and meta nodes of the graph
+		*/
+		QVector<NodeRecord> nodes;
+
+		/**
+		*	QVector<EdgeRecord> edges
+		*	\brief Edges and meta edges of the graph
+		*/
+		QVector<EdgeRecord> edges;
+	};
+}
+#endif
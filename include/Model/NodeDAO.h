@@ -8,9 +8,11 @@
 #include "Data/GraphLayout.h"
 #include "Data/Graph.h"
 #include "Data/Node.h"
+#include "Model/BatchInsert.h"
 
 #include <QtSql>
 #include <QDebug>
+#include <QSet>
 
 namespace Data {
 	class Node;
@@ -31,6 +33,8 @@ namespace Model
 		/**
 		*  \fn public static  addNodesToDB(QSqlDatabase* conn, QMap<qlonglong, osg::ref_ptr<Data::Node> >* nodes)
 		*  \brief	Add nodes to DB
+		*
+		*	All add*ToDB methods write the rows by BatchInsert, the caller should run them in one transaction.
 		*  \param   conn   connection to the database 
 		*  \param   nodes  nodes from actual graph
 		*  \return	bool true, if nodes were successfully added to DB
@@ -160,6 +164,16 @@ namespace Model
 		*/
 		static bool removeNode(Data::Node* node, QSqlDatabase* conn);
 
+		/**
+		*  \fn public static  removeNodes(qlonglong graphID, QSet<qlonglong> nodeIDs, QSqlDatabase* conn)
+		*  \brief Removes set of Nodes from the database in one transaction (their Edges and settings are removed by ON DELETE CASCADE)
+		*  \param  graphID   ID of graph
+		*  \param  nodeIDs   IDs of the removed Nodes
+		*  \param  conn   connection to the database
+		*  \return bool true, if all the Nodes were successfully removed from the database
+		*/
+		static bool removeNodes(qlonglong graphID, QSet<qlonglong> nodeIDs, QSqlDatabase* conn);
+
 		/**
 		*  \fn public static  removeNodes(qlonglong graphID, QSqlDatabase* conn)
 		*  \brief Removes Nodes from the database
@@ -245,6 +259,17 @@ namespace Model
 		*/
 		static QList<qlonglong> getParents(QSqlDatabase* conn, bool* error, qlonglong graphID, qlonglong layoutID);
 
+		/**
+		*  \fn public static  getMergedInto(QSqlDatabase* conn, bool* error, qlonglong graphID, qlonglong layoutID)
+		*  \brief	Return IDs of the merged nodes the nodes are merged into (see Data::Graph::mergeNodes)
+		*  \param   conn   connection to the database 
+		*  \param   error  error flag, will be set to true, if the method encounters an error
+		*  \param   graphID  graph ID
+		*  \param   layoutID  layout ID
+		*  \return	QMap<qlonglong, qlonglong> ID of the merged node by ID of the node
+		*/
+		static QMap<qlonglong, qlonglong> getMergedInto(QSqlDatabase* conn, bool* error, qlonglong graphID, qlonglong layoutID);
+
 		/**
 		*  \fn public static  getNewMetaNodeId(QSqlDatabase* conn, qlonglong graphID, QMap<qlonglong, osg::ref_ptr<Data::Node> >* nodes)
 		*  \brief	Return map of new nodes ID
@@ -296,6 +321,23 @@ namespace Model
 
 	private:
 
+		/**
+		*  \fn private static  getNodeID(osg::ref_ptr<Data::Node> node, const QMap<qlonglong, qlonglong>& newMetaNodeID, bool meta, qlonglong* nodeID)
+		*  \brief	Return ID of the node in DB (meta nodes get new ID)
+		*  \param   node  node from actual graph
+		*  \param	newMetaNodeID	new ID of meta nodes
+		*  \param	meta	true, if node is meta type
+		*  \param	nodeID	ID of the node in DB, not changed if new ID of the meta node is missing
+		*  \return	bool false, if new ID of the meta node is missing
+		*/
+		static bool getNodeID(osg::ref_ptr<Data::Node> node, const QMap<qlonglong, qlonglong>& newMetaNodeID, bool meta, qlonglong* nodeID);
+
+		/**
+		*  \fn private static  settingsColumns
+		*  \brief	Return columns of the node_settings table used by BatchInsert
+		*/
+		static QStringList settingsColumns();
+
 		/**
 		*  \fn private constructor  NodeDAO
 		*  \brief Constructs NodeDAO object
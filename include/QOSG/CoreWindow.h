@@ -29,6 +29,12 @@
 #include "Layout/ShapeGetter.h"
 #include "Layout/RestrictionRemovalHandler.h"
 
+#include "Analysis/CommunityHierarchy.h"
+#include "Analysis/GraphMetrics.h"
+#include "Analysis/GraphTraversal.h"
+
+#include <QFutureWatcher>
+
 namespace QOSG
 {
 	/**
@@ -67,6 +73,48 @@ namespace QOSG
 				*/
 				void sqlQuery();
 
+				/**
+				*  \fn public  computeMetrics
+				*  \brief Start computation of structural metrics of current graph on the thread pool
+				*/
+				void computeMetrics();
+
+				/**
+				*  \fn public  metricsComputed
+				*  \brief Store computed metrics as attributes of the nodes and show them as size and color of the nodes
+				*/
+				void metricsComputed();
+
+				/**
+				*  \fn public  collapseCommunities
+				*  \brief Collapse next coarser level of communities of current graph into meta nodes
+				*/
+				void collapseCommunities();
+
+				/**
+				*  \fn public  expandCommunities
+				*  \brief Expand collapsed communities of current graph to next finer level
+				*/
+				void expandCommunities();
+
+				/**
+				*  \fn public  selectShortestPath
+				*  \brief Select shortest path between two selected nodes (weighted by edge attribute weight, if present)
+				*/
+				void selectShortestPath();
+
+				/**
+				*  \fn public  selectGeometricPath
+				*  \brief Select path with the shortest 3D length between two selected nodes
+				*/
+				void selectGeometricPath();
+
+				/**
+				*  \fn public  expandSelection
+				*  \brief Expand selection to the k-hop neighbourhood of selected nodes
+				*/
+				void expandSelection();
+
 				/**
 				*  \fn public  playPause
 				*  \brief Play or pause the layout algorithm
@@ -143,6 +191,18 @@ namespace QOSG
 				*/
 				void loadFile();
 
+				/**
+				*  \fn public  mergeFile
+				*  \brief Show dialog to select file with changes which will be merged into the active graph
+				*/
+				void mergeFile();
+
+				/**
+				*  \fn public  exportFile
+				*  \brief Show dialog to select file to which the active graph will be exported
+				*/
+				void exportFile();
+
 				/**
 				*  \fn public  labelOnOff(bool checked)
 				*  \brief Show / hide labels
@@ -269,6 +329,42 @@ namespace QOSG
 		*/
 		QAction * saveGraph;
 
+		/**
+		*  QAction * metrics
+		*  \brief Action to compute metrics of current graph
+		*/
+		QAction * metrics;
+
+		/**
+		*  QAction * collapse
+		*  \brief Action to collapse communities of current graph
+		*/
+		QAction * collapse;
+
+		/**
+		*  QAction * expand
+		*  \brief Action to expand communities of current graph
+		*/
+		QAction * expand;
+
+		/**
+		*  QAction * shortestPath
+		*  \brief Action to select shortest path
+		*/
+		QAction * shortestPath;
+
+		/**
+		*  QAction * geometricPath
+		*  \brief Action to select path with the shortest 3D length
+		*/
+		QAction * geometricPath;
+
+		/**
+		*  QAction * neighbourhood
+		*  \brief Action to expand selection to the k-hop neighbourhood
+		*/
+		QAction * neighbourhood;
+
 		/**
 		*  QPushButton * play
 		*  \brief Action for play/pause layout
@@ -388,6 +484,18 @@ namespace QOSG
 		*/
 		QAction * load;
 
+		/**
+		*  QAction * mergeFromFile
+		*  \brief Action for merging changes from file into the active graph
+		*/
+		QAction * mergeFromFile;
+
+		/**
+		*  QAction * exportToFile
+		*  \brief Action for exporting graph to file
+		*/
+		QAction * exportToFile;
+
 		/**
 		*  QPushButton * label
 		*  \brief Pointer to labelOn/labelOff button
@@ -436,6 +544,45 @@ namespace QOSG
 		*/
 		int isPlaying;
 
+		/**
+		*  QSharedPointer<Analysis::CommunityHierarchy> communities
+		*  \brief Communities of current graph, null if they were not computed yet (shared with the queued Analysis::CommunityCommand)
+		*/
+		QSharedPointer<Analysis::CommunityHierarchy> communities;
+
+		/**
+		*  Analysis::GraphTraversal * traversal
+		*  \brief Traversal of current graph, rebuilt when the graph changes
+		*/
+		Analysis::GraphTraversal * traversal;
+
+		/**
+		*  QFutureWatcher<Analysis::GraphMetrics::Result> * metricsWatcher
+		*  \brief Watcher of the computation of the metrics
+		*/
+		QFutureWatcher<Analysis::GraphMetrics::Result> * metricsWatcher;
+
+		/**
+		*  Data::Graph * metricsGraph
+		*  \brief Graph analysed by the running computation of the metrics, NULL if the result is not wanted any more
+		*/
+		Data::Graph * metricsGraph;
+
+		/**
+		*  \fn private  getTraversal(Data::Graph * graph)
+		*  \brief Returns traversal of the graph, builds it again if the graph was changed
+		*  \param  graph   current graph
+		*  \return Analysis::GraphTraversal * traversal of the graph
+		*/
+		Analysis::GraphTraversal * getTraversal(Data::Graph * graph);
+
+		/**
+		*  \fn private  selectPath(bool geometric)
+		*  \brief Select path between two selected nodes
+		*  \param  geometric   true for path with the shortest 3D length
+		*/
+		void selectPath(bool geometric);
+
 		/**
 		*  \fn private  createActions
 		*  \brief Initialize all actions of aplication
@@ -524,6 +671,12 @@ namespace QOSG
 		*/
 		void setLayoutThread(Layout::LayoutThread * val) { layout = val; }
 
+		/**
+		*  \fn public  activeGraphChanged
+		*  \brief Forget data computed for the previous active graph - metrics, communities and traversal (called when the active graph is replaced)
+		*/
+		void activeGraphChanged();
+
 	private:
 
 		/**
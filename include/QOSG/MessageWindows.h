@@ -33,10 +33,11 @@ namespace QOSG
 		~MessageWindows(void);
 
 		/**
-		*  \fn public  showProgressBar
+		*  \fn public  showProgressBar(bool cancelable = false)
 		*  \brief Show user the progress bar
+		*  \param  cancelable  if true, the progress bar is not modal and has a cancel button
 		*/
-		void showProgressBar();		
+		void showProgressBar(bool cancelable = false);		
 
 		/**
 		*  \fn public  closeProgressBar
@@ -51,6 +52,13 @@ namespace QOSG
 		*/
 		void setProgressBarValue(int value);		
 
+		/**
+		*  \fn public  isProgressBarCanceled
+		*  \brief Returns true, if user pressed the cancel button of the progress bar
+		*  \return bool true, if the progress bar was canceled
+		*/
+		bool isProgressBarCanceled();
+
 		/**
 		*  \fn public  showMessageBox(QString title, QString message, bool isError)
 		*  \brief Show user error or message dialog
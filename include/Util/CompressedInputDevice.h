@@ -0,0 +1,198 @@
+#ifndef Util_CompressedInputDevice_H
+#define Util_CompressedInputDevice_H
+//-----------------------------------------------------------------------------
+#include <QByteArray>
+#include <QFuture>
+#include <QIODevice>
+#include <QString>
+//-----------------------------------------------------------------------------
+#include <memory>
+//-----------------------------------------------------------------------------
+
+namespace Util {
+
+/**
+ * \brief Device decompressing data of another device (gzip or zstd file) while they are read.
+ * Only reading is implemented. Data are decompressed by blocks, the next block is decompressed
+ * on another thread while the previous one is being read (gzip and zstd streams can only be
+ * decompressed sequentially, so decompression runs in parallel with the reader, not with itself).
+ * Concatenated gzip members and zstd frames are read as one stream.
+ */
+class CompressedInputDevice
+	: public QIODevice {
+
+	Q_OBJECT
+
+public:
+
+	/**
+	 * \brief Compression formats.
+	 */
+	enum Format {
+		NONE,
+		GZIP,
+		ZSTD
+	};
+
+	/**
+	 * \brief Returns compression format according to the file extension (gz, zst), NONE if the file is not compressed.
+	 */
+	static Format formatFromSuffix (
+		const QString &suffix
+	);
+
+	/**
+	 * \brief Returns true if the application has been built with the library for the format.
+	 */
+	static bool isSupported (
+		Format format
+	);
+
+	/**
+	 * \brief Creates a new device over the specified compressed device.
+	 * \param[in] source Device with compressed data (ownership is taken, opened by open if it is not opened yet).
+	 * \param[in] format Compression format of the data.
+	 */
+	CompressedInputDevice (
+		std::auto_ptr<QIODevice> source,
+		Format format
+	);
+
+	/***/
+	virtual ~CompressedInputDevice (void);
+
+	/**
+	 * \brief Opens the source device and starts decompression, only ReadOnly mode is supported.
+	 */
+	virtual bool open (
+		OpenMode mode
+	);
+
+	/**
+	 * \brief Stops decompression and closes the source device.
+	 */
+	virtual void close (void);
+
+	/**
+	 * \brief Decompressed data can not be seeked.
+	 */
+	virtual bool isSequential (void) const {
+		return true;
+	}
+
+	/***/
+	virtual bool atEnd (void) const;
+
+	/***/
+	virtual qint64 bytesAvailable (void) const;
+
+	/**
+	 * \brief Returns position of the decompressed data in the source device (e.g. to report progress).
+	 */
+	qint64 getSourcePosition (void) const {
+		return sourcePosition_;
+	}
+
+	/**
+	 * \brief Returns size of the source device, 0 if it is not known.
+	 */
+	qint64 getSourceSize (void) const;
+
+protected:
+
+	/***/
+	virtual qint64 readData (
+		char *data,
+		qint64 maxSize
+	);
+
+	/**
+	 * \brief Writing is not supported.
+	 */
+	virtual qint64 writeData (
+		const char *data,
+		qint64 maxSize
+	);
+
+private:
+
+	/**
+	 * \brief Block of decompressed data and position in the source device after it.
+	 */
+	struct Block {
+		QByteArray data;
+		qint64 sourcePosition;
+
+		Block (void) : sourcePosition (0) {}
+	};
+
+	/**
+	 * \brief Size of the blocks of decompressed data.
+	 */
+	static const int BLOCK_SIZE = 1 << 20;
+
+	/**
+	 * \brief Size of the reads from the source device.
+	 */
+	static const int INPUT_SIZE = 1 << 18;
+
+	/**
+	 * \brief Decompresses the next block (on the thread of the thread pool).
+	 */
+	Block decompressBlock (void);
+
+	/**
+	 * \brief Decompresses data from the input into the output until one of them is exhausted.
+	 * \param[in] output Output buffer.
+	 * \param[in] size Size of the output buffer.
+	 * \param[in,out] produced Count of the bytes already in the output buffer.
+	 * \param[out] streamEnd Set if the end of the gzip member or zstd frame has been reached.
+	 * \return ( = the data are valid)
+	 */
+	bool decompressStep (
+		char *output,
+		int size,
+		int &produced,
+		bool &streamEnd
+	);
+
+	/**
+	 * \brief Reads next compressed data from the source device.
+	 * \return False if the source device has no more data.
+	 */
+	bool readInput (void);
+
+	/**
+	 * \brief Waits for the next non-empty decompressed block and starts decompression of the following one.
+	 * \return False if there are no more data.
+	 */
+	bool fetchBlock (void);
+
+	std::auto_ptr<QIODevice> source_;
+	Format format_;
+
+	/**
+	 * \brief State of the decompression (z_stream or ZSTD_DStream).
+	 */
+	void *stream_;
+
+	// komprimovane data nacitane zo zdroja - pouziva len decompressBlock
+	QByteArray input_;
+	int inputPosition_;
+	qint64 sourceRead_;
+	bool sourceEnd_;
+	bool end_;
+	bool error_;
+
+	// citany dekomprimovany blok a prave dekomprimovany blok
+	QByteArray block_;
+	int blockPosition_;
+	qint64 sourcePosition_;
+	QFuture<Block> next_;
+	bool pending_;
+
+}; // class
+
+} // namespace
+
+#endif // Util_CompressedInputDevice_H
@@ -231,15 +231,21 @@ namespace Vwr
 		*/
 		Data::Graph * graph;
 
+		/**
+		*  qlonglong graphVersion
+		*  \brief version of the graph structure the node and edge groups are synchronized with
+		*/
+		qlonglong graphVersion;
+
 		/**
 		*  QMap<qlonglong,osg::ref_ptr<Data::Node> > * in_nodes
-		*  \brief graph nodes map
+		*  \brief graph nodes map (copy of the last synchronized snapshot of the graph)
 		*/
 		QMap<qlonglong, osg::ref_ptr<Data::Node> > *in_nodes;
 
 		/**
 		*  QMap<qlonglong,osg::ref_ptr<Data::Edge> > * in_edges
-		*  \brief graph edges map
+		*  \brief graph edges map (copy of the last synchronized snapshot of the graph)
 		*/
 		QMap<qlonglong, osg::ref_ptr<Data::Edge> > *in_edges;
 
@@ -326,6 +332,13 @@ namespace Vwr
 		*/
 		void synchronize();
 
+		/**
+		*  \fn private  copySnapshot(QSharedPointer<Data::GraphSnapshot> snapshot)
+		*  \brief Copies the lists of the snapshot to the maps read by the node and edge groups
+		*  \param  snapshot  current snapshot of the graph
+		*/
+		void copySnapshot(QSharedPointer<Data::GraphSnapshot> snapshot);
+
 		/**
 		*  \fn private  cleanUp
 		*  \brief Cleans up memory
@@ -6,6 +6,7 @@
 #define VIEWER_NODEWRAPPER_DEF 1
 
 #include <QMap>
+#include <QVector>
 
 #include <osg/ref_ptr>
 #include <osg/AutoTransform>
@@ -13,6 +14,7 @@
 
 #include "Util/ApplicationConfig.h"
 #include "Data/Node.h"
+#include "Layout/NodeOrdering.h"
 #include <osg/ShapeDrawable>
 
 namespace Vwr
@@ -103,6 +105,42 @@ namespace Vwr
 		*/
 		Util::ApplicationConfig* appConf;
 
+		/**
+		*  QVector<osg::ref_ptr<Data::Node> > orderedNodes
+		*  \brief wrapped nodes ordered by their positions, neighbouring nodes are next to each other
+		*/
+		QVector<osg::ref_ptr<Data::Node> > orderedNodes;
+
+		/**
+		*  QVector<osg::ref_ptr<osg::AutoTransform> > orderedTransforms
+		*  \brief transforms of the nodes in orderedNodes
+		*/
+		QVector<osg::ref_ptr<osg::AutoTransform> > orderedTransforms;
+
+		/**
+		*  Layout::NodeOrdering::Method ordering
+		*  \brief method of the ordering of the nodes
+		*/
+		Layout::NodeOrdering::Method ordering;
+
+		/**
+		*  int orderingInterval
+		*  \brief count of the updates after which the nodes are ordered again
+		*/
+		int orderingInterval;
+
+		/**
+		*  int orderingAge
+		*  \brief count of the updates since the last ordering of the nodes
+		*/
+		int orderingAge;
+
+		/**
+		*  \fn private  updateOrdering
+		*  \brief Orders the nodes and their transforms by the positions of the nodes
+		*/
+		void updateOrdering();
+
 
 		/**
 		*  \fn private  initNodes
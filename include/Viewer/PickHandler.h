@@ -167,6 +167,20 @@ namespace Vwr
 		*/
 		QLinkedList<osg::ref_ptr<Data::Edge> > * getSelectedEdges() { return &pickedEdges; }
 		
+		/**
+		*  \fn public  selectNodes(QList<osg::ref_ptr<Data::Node> > nodes)
+		*  \brief Replaces current selection by the nodes (e.g. result of a query)
+		*  \param     nodes     selected nodes
+		*/
+		void selectNodes(QList<osg::ref_ptr<Data::Node> > nodes);
+
+		/**
+		*  \fn public  selectEdges(QList<osg::ref_ptr<Data::Edge> > edges)
+		*  \brief Adds the edges to current selection (e.g. edges of a found path)
+		*  \param     edges     selected edges
+		*/
+		void selectEdges(QList<osg::ref_ptr<Data::Edge> > edges);
+
 		/**
 		*  \fn private  unselectPickedNodes(osg::ref_ptr<Data::Node> node = 0)
 		*  \brief unselects picked nodes. If null, all nodes will be unselected.
@@ -0,0 +1,92 @@
+/*!
+ * AdjacencyGraph.cpp
+ * Projekt 3DVisual
+ */
+#include "Analysis/AdjacencyGraph.h"
+#include "Data/Graph.h"
+
+Analysis::AdjacencyGraph::AdjacencyGraph(Data::Graph * graph)
+{
+	QSharedPointer<Data::GraphSnapshot> snapshot = graph->getSnapshot();
+	const QMap<qlonglong, osg::ref_ptr<Data::Node> > & nodes = snapshot->getNodes();
+	const QMap<qlonglong, osg::ref_ptr<Data::Edge> > & edges = snapshot->getEdges();
+
+	//ocislujeme uzly
+	nodeIds.reserve(nodes.size());
+	positions.reserve(nodes.size());
+	indexes.reserve(nodes.size());
+	for(QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator it = nodes.constBegin(); it != nodes.constEnd(); ++it) {
+		indexes.insert(it.key(), nodeIds.size());
+		nodeIds.append(it.key());
+		positions.append(it.value()->getTargetPosition());
+	}
+
+	int n = nodeIds.size();
+
+	//hrany prevedieme na dvojice indexov, vynechame slucky a hrany do meta uzlov
+	QVector<int> sources;
+	QVector<int> targets;
+	QVector<bool> oriented;
+	QVector<qlonglong> edgeIds;
+	sources.reserve(edges.size());
+	edgeIds.reserve(edges.size());
+	targets.reserve(edges.size());
+	oriented.reserve(edges.size());
+
+	for(QMap<qlonglong, osg::ref_ptr<Data::Edge> >::const_iterator it = edges.constBegin(); it != edges.constEnd(); ++it) {
+		const osg::ref_ptr<Data::Edge> & edge = it.value();
+
+		int src = indexes.value(edge->getSrcNode()->getId(), -1);
+		int dst = indexes.value(edge->getDstNode()->getId(), -1);
+		if(src < 0 || dst < 0 || src == dst)
+			continue;
+
+		sources.append(src);
+		targets.append(dst);
+		oriented.append(edge->isOriented());
+		edgeIds.append(it.key());
+	}
+
+	//pocty susedov a predchodcov, z nich zaciatky v poliach
+	offsets.fill(0, n + 1);
+	inOffsets.fill(0, n + 1);
+	outDegrees.fill(0, n);
+
+	for(int e = 0; e < sources.size(); e++) {
+		offsets[sources.at(e) + 1]++;
+		offsets[targets.at(e) + 1]++;
+
+		inOffsets[targets.at(e) + 1]++;
+		outDegrees[sources.at(e)]++;
+		if(!oriented.at(e)) {
+			inOffsets[sources.at(e) + 1]++;
+			outDegrees[targets.at(e)]++;
+		}
+	}
+
+	for(int i = 0; i < n; i++) {
+		offsets[i + 1] += offsets.at(i);
+		inOffsets[i + 1] += inOffsets.at(i);
+	}
+
+	//naplnime polia susedov
+	neighbours.resize(offsets.at(n));
+	neighbourEdges.resize(offsets.at(n));
+	predecessors.resize(inOffsets.at(n));
+	QVector<int> position = offsets;
+	QVector<int> inPosition = inOffsets;
+
+	for(int e = 0; e < sources.size(); e++) {
+		int src = sources.at(e);
+		int dst = targets.at(e);
+
+		neighbourEdges[position[src]] = edgeIds.at(e);
+		neighbours[position[src]++] = dst;
+		neighbourEdges[position[dst]] = edgeIds.at(e);
+		neighbours[position[dst]++] = src;
+
+		predecessors[inPosition[dst]++] = src;
+		if(!oriented.at(e))
+			predecessors[inPosition[src]++] = dst;
+	}
+}
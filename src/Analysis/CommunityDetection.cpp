@@ -0,0 +1,366 @@
+/*!
+ * CommunityDetection.cpp
+ * Projekt 3DVisual
+ */
+#include "Analysis/CommunityDetection.h"
+
+#include <QHash>
+#include <QtConcurrentMap>
+
+namespace
+{
+	//velkost bloku uzlov spracovaneho jednym vlaknom
+	const int BLOCK_SIZE = 4096;
+
+	//najvacsi pocet prechodov presunov uzlov na jednej urovni
+	const int MAX_PASSES = 32;
+
+	//najmensi zisk modularity, pre ktory sa uzol presunie
+	const double MIN_GAIN = 1e-9;
+
+	QList<int> blockStarts(int count)
+	{
+		QList<int> starts;
+		for(int start = 0; start < count; start += BLOCK_SIZE)
+			starts.append(start);
+		return starts;
+	}
+
+	/**
+	*  \class WeightedGraph
+	*  \brief Weighted adjacency of one level of the hierarchy, Nodes of higher levels are the communities of the previous level
+	*/
+	class WeightedGraph
+	{
+	public:
+
+		int getNodeCount() const { return degrees.size(); }
+
+		QVector<int> offsets;
+		QVector<int> neighbours;
+		QVector<double> weights;
+
+		//vaha hran vo vnutri uzla (hrany vo vnutri komunity predchadzajucej urovne)
+		QVector<double> loops;
+
+		//vazeny stupen uzla, vnutorne hrany su zapocitane dvakrat
+		QVector<double> degrees;
+
+		//sucet stupnov vsetkych uzlov (dvojnasobok vahy hran)
+		double totalWeight;
+	};
+
+	/**
+	*  \class BestCommunity
+	*  \brief Chooses the community with the highest gain of modularity for each Node of a block
+	*/
+	class BestCommunity
+	{
+	public:
+
+		typedef void result_type;
+
+		BestCommunity(const WeightedGraph &graph, const int * communities, const double * totals, int * targets, double resolution)
+			: graph(graph), communities(communities), totals(totals), targets(targets), resolution(resolution)
+		{
+		}
+
+		void operator()(const int &start) const
+		{
+			int end = qMin(start + BLOCK_SIZE, graph.getNodeCount());
+			QHash<int, double> links;
+
+			for(int v = start; v < end; v++) {
+				links.clear();
+				for(int i = graph.offsets.at(v); i < graph.offsets.at(v + 1); i++)
+					links[communities[graph.neighbours.at(i)]] += graph.weights.at(i);
+
+				//zisk porovnavame s vlastnou komunitou bez tohto uzla
+				int own = communities[v];
+				double degree = graph.degrees.at(v);
+				double scale = resolution * degree / graph.totalWeight;
+
+				int target = own;
+				double best = links.value(own, 0) - (totals[own] - degree) * scale;
+
+				for(QHash<int, double>::const_iterator it = links.constBegin(); it != links.constEnd(); ++it) {
+					if(it.key() == own)
+						continue;
+
+					double gain = it.value() - totals[it.key()] * scale;
+					if(gain > best + MIN_GAIN) {
+						best = gain;
+						target = it.key();
+					}
+				}
+
+				targets[v] = target;
+			}
+		}
+
+	private:
+
+		const WeightedGraph &graph;
+		const int * communities;
+		const double * totals;
+		int * targets;
+		double resolution;
+	};
+
+	/**
+	*  \class AggregateCommunities
+	*  \brief Builds the adjacency of a block of the communities for the next level
+	*/
+	class AggregateCommunities
+	{
+	public:
+
+		typedef void result_type;
+
+		AggregateCommunities(const WeightedGraph &graph, const QVector<int> &communities, const QVector<int> &memberOffsets, const QVector<int> &members,
+			QVector<int> * neighbourLists, QVector<double> * weightLists, double * loops)
+			: graph(graph), communities(communities), memberOffsets(memberOffsets), members(members),
+			  neighbourLists(neighbourLists), weightLists(weightLists), loops(loops)
+		{
+		}
+
+		void operator()(const int &start) const
+		{
+			int end = qMin(start + BLOCK_SIZE, memberOffsets.size() - 1);
+			QHash<int, double> links;
+
+			for(int c = start; c < end; c++) {
+				links.clear();
+				double loop = 0;
+
+				for(int m = memberOffsets.at(c); m < memberOffsets.at(c + 1); m++) {
+					int v = members.at(m);
+					loop += graph.loops.at(v);
+
+					for(int i = graph.offsets.at(v); i < graph.offsets.at(v + 1); i++) {
+						int community = communities.at(graph.neighbours.at(i));
+
+						//hrana vo vnutri komunity je v susedoch zapisana z oboch koncov
+						if(community == c)
+							loop += graph.weights.at(i) / 2;
+						else
+							links[community] += graph.weights.at(i);
+					}
+				}
+
+				loops[c] = loop;
+				neighbourLists[c].reserve(links.size());
+				weightLists[c].reserve(links.size());
+				for(QHash<int, double>::const_iterator it = links.constBegin(); it != links.constEnd(); ++it) {
+					neighbourLists[c].append(it.key());
+					weightLists[c].append(it.value());
+				}
+			}
+		}
+
+	private:
+
+		const WeightedGraph &graph;
+		const QVector<int> &communities;
+		const QVector<int> &memberOffsets;
+		const QVector<int> &members;
+		QVector<int> * neighbourLists;
+		QVector<double> * weightLists;
+		double * loops;
+	};
+
+	//presuny uzlov medzi komunitami, vracia pocet komunit (komunity su precislovane od 0)
+	int moveNodes(const WeightedGraph &graph, QVector<int> &communities, double resolution)
+	{
+		int n = graph.getNodeCount();
+		QVector<double> totals = graph.degrees;
+		QVector<int> targets(n);
+		QList<int> blocks = blockStarts(n);
+
+		communities.resize(n);
+		for(int v = 0; v < n; v++)
+			communities[v] = v;
+
+		for(int pass = 0; pass < MAX_PASSES && graph.totalWeight > 0; pass++) {
+			QtConcurrent::blockingMap(blocks, BestCommunity(graph, communities.constData(), totals.constData(), targets.data(), resolution));
+
+			//zisk overime s aktualnymi komunitami, lebo susedia sa mohli medzitym presunut
+			int moved = 0;
+			for(int v = 0; v < n; v++) {
+				int own = communities.at(v);
+				int target = targets.at(v);
+				if(target == own)
+					continue;
+
+				double ownLinks = 0;
+				double targetLinks = 0;
+				for(int i = graph.offsets.at(v); i < graph.offsets.at(v + 1); i++) {
+					int community = communities.at(graph.neighbours.at(i));
+					if(community == own)
+						ownLinks += graph.weights.at(i);
+					else if(community == target)
+						targetLinks += graph.weights.at(i);
+				}
+
+				double degree = graph.degrees.at(v);
+				double scale = resolution * degree / graph.totalWeight;
+				double stayGain = ownLinks - (totals.at(own) - degree) * scale;
+				double moveGain = targetLinks - totals.at(target) * scale;
+
+				if(moveGain > stayGain + MIN_GAIN) {
+					totals[own] -= degree;
+					totals[target] += degree;
+					communities[v] = target;
+					moved++;
+				}
+			}
+
+			if(moved == 0)
+				break;
+		}
+
+		//precislovanie komunit v poradi uzlov
+		QVector<int> labels(n, -1);
+		int count = 0;
+		for(int v = 0; v < n; v++) {
+			int community = communities.at(v);
+			if(labels.at(community) < 0)
+				labels[community] = count++;
+			communities[v] = labels.at(community);
+		}
+
+		return count;
+	}
+
+	WeightedGraph aggregate(const WeightedGraph &graph, const QVector<int> &communities, int count)
+	{
+		int n = graph.getNodeCount();
+
+		//uzly zoradene podla komunit
+		QVector<int> memberOffsets(count + 1, 0);
+		for(int v = 0; v < n; v++)
+			memberOffsets[communities.at(v) + 1]++;
+		for(int c = 0; c < count; c++)
+			memberOffsets[c + 1] += memberOffsets.at(c);
+
+		QVector<int> members(n);
+		QVector<int> position = memberOffsets;
+		for(int v = 0; v < n; v++)
+			members[position[communities.at(v)]++] = v;
+
+		QVector<QVector<int> > neighbourLists(count);
+		QVector<QVector<double> > weightLists(count);
+		WeightedGraph result;
+		result.loops.fill(0, count);
+
+		QList<int> blocks = blockStarts(count);
+		QtConcurrent::blockingMap(blocks, AggregateCommunities(graph, communities, memberOffsets, members,
+			neighbourLists.data(), weightLists.data(), result.loops.data()));
+
+		//zoznamy susedov spojime do jedneho pola
+		result.offsets.fill(0, count + 1);
+		for(int c = 0; c < count; c++)
+			result.offsets[c + 1] = result.offsets.at(c) + neighbourLists.at(c).size();
+
+		result.neighbours.reserve(result.offsets.at(count));
+		result.weights.reserve(result.offsets.at(count));
+		result.degrees.fill(0, count);
+		for(int c = 0; c < count; c++) {
+			result.neighbours += neighbourLists.at(c);
+			result.weights += weightLists.at(c);
+		}
+
+		//stupne a celkova vaha sa agregaciou nemenia
+		for(int v = 0; v < n; v++)
+			result.degrees[communities.at(v)] += graph.degrees.at(v);
+		result.totalWeight = graph.totalWeight;
+
+		return result;
+	}
+}
+
+QList<QVector<int> > Analysis::CommunityDetection::louvain(const Analysis::AdjacencyGraph &graph, double resolution)
+{
+	QList<QVector<int> > levels;
+
+	WeightedGraph level;
+	level.offsets = graph.getOffsets();
+	level.neighbours = graph.getNeighbours();
+	level.weights.fill(1, level.neighbours.size());
+	level.loops.fill(0, graph.getNodeCount());
+	level.degrees.resize(graph.getNodeCount());
+	level.totalWeight = level.neighbours.size();
+
+	for(int v = 0; v < graph.getNodeCount(); v++)
+		level.degrees[v] = graph.degree(v);
+
+	while(levels.size() < MAX_LEVELS) {
+		QVector<int> communities;
+		int count = moveNodes(level, communities, resolution);
+
+		//ziadne uzly sa nezlucili, hierarchia je hotova
+		if(count == level.getNodeCount())
+			break;
+
+		levels.append(communities);
+		level = aggregate(level, communities, count);
+	}
+
+	return levels;
+}
+
+QVector<int> Analysis::CommunityDetection::flatten(const QList<QVector<int> > &levels, int level)
+{
+	if(levels.isEmpty())
+		return QVector<int>();
+
+	QVector<int> result = levels.at(0);
+
+	for(int l = 1; l <= level && l < levels.size(); l++) {
+		const QVector<int> & next = levels.at(l);
+		for(int v = 0; v < result.size(); v++)
+			result[v] = next.at(result.at(v));
+	}
+
+	return result;
+}
+
+int Analysis::CommunityDetection::communityCount(const QVector<int> &communities)
+{
+	int count = 0;
+
+	for(int v = 0; v < communities.size(); v++)
+		count = qMax(count, communities.at(v) + 1);
+
+	return count;
+}
+
+double Analysis::CommunityDetection::modularity(const Analysis::AdjacencyGraph &graph, const QVector<int> &communities)
+{
+	const QVector<int> & offsets = graph.getOffsets();
+	const QVector<int> & neighbours = graph.getNeighbours();
+	double totalWeight = neighbours.size();
+
+	if(totalWeight == 0)
+		return 0;
+
+	int count = communityCount(communities);
+	QVector<double> inside(count, 0);
+	QVector<double> totals(count, 0);
+
+	for(int v = 0; v < graph.getNodeCount(); v++) {
+		int community = communities.at(v);
+		totals[community] += graph.degree(v);
+
+		for(int i = offsets.at(v); i < offsets.at(v + 1); i++) {
+			if(communities.at(neighbours.at(i)) == community)
+				inside[community] += 1;
+		}
+	}
+
+	double result = 0;
+	for(int c = 0; c < count; c++)
+		result += inside.at(c) / totalWeight - (totals.at(c) / totalWeight) * (totals.at(c) / totalWeight);
+
+	return result;
+}
@@ -0,0 +1,152 @@
+/*!
+ * CommunityHierarchy.cpp
+ * Projekt 3DVisual
+ */
+#include "Analysis/CommunityHierarchy.h"
+#include "Analysis/CommunityDetection.h"
+#include "Analysis/GraphMetrics.h"
+#include "Data/Graph.h"
+
+#include <QLinkedList>
+#include <QSet>
+
+Analysis::CommunityHierarchy::CommunityHierarchy(Data::Graph * graph)
+	: graph(graph), adjacency(graph), level(-1)
+{
+	levels = Analysis::CommunityDetection::louvain(adjacency);
+
+	for(int l = 0; l < levels.size(); l++)
+		Analysis::GraphMetrics::storeAttribute(graph, adjacency.getNodeIds(), "community" + QString::number(l), Analysis::CommunityDetection::flatten(levels, l));
+
+	version = graph->getVersion();
+}
+
+int Analysis::CommunityHierarchy::getCommunityCount(int level) const
+{
+	if(level < 0 || level >= levels.size())
+		return adjacency.getNodeCount();
+
+	return Analysis::CommunityDetection::communityCount(levels.at(level));
+}
+
+bool Analysis::CommunityHierarchy::isCurrent(Data::Graph * graph) const
+{
+	return this->graph == graph && graph != NULL && graph->getVersion() == version;
+}
+
+void Analysis::CommunityHierarchy::collapse(int level)
+{
+	if(level < 0 || level >= levels.size())
+		return;
+
+	expand();
+
+	QVector<int> communities = Analysis::CommunityDetection::flatten(levels, level);
+	int count = getCommunityCount(level);
+	QVector<QLinkedList<osg::ref_ptr<Data::Node> > > groups(count);
+	QMap<qlonglong, osg::ref_ptr<Data::Node> > * nodes = graph->getNodes();
+
+	//uzly rozdelime podla komunit, uz skryte uzly (zlucene pouzivatelom) vynechame
+	for(int v = 0; v < communities.size(); v++) {
+		osg::ref_ptr<Data::Node> node = nodes->value(adjacency.getNodeId(v));
+		if(node == NULL || node->getNodeMask() == 0)
+			continue;
+
+		groups[communities.at(v)].append(node);
+	}
+
+	//vsetky zlucovane uzly skryjeme vopred, aby sa zlucene uzly spajali len s uzlami, ktore zostanu viditelne
+	for(int c = 0; c < count; c++) {
+		if(groups.at(c).size() < 2)
+			continue;
+
+		QLinkedList<osg::ref_ptr<Data::Node> >::const_iterator it = groups.at(c).constBegin();
+		for(; it != groups.at(c).constEnd(); ++it)
+			(*it)->setNodeMask(0);
+	}
+
+	QVector<osg::ref_ptr<Data::Node> > merged(count);
+	for(int c = 0; c < count; c++) {
+		if(groups.at(c).size() < 2)
+			continue;
+
+		//zluceny uzol umiestnime do taziska komunity
+		osg::Vec3f position;
+		QLinkedList<osg::ref_ptr<Data::Node> >::const_iterator it = groups.at(c).constBegin();
+		for(; it != groups.at(c).constEnd(); ++it)
+			position += (*it)->getTargetPosition();
+		position /= groups.at(c).size();
+
+		merged[c] = graph->mergeNodes(&groups[c], position);
+		mergedNodes.append(merged.at(c));
+	}
+
+	//zlucene uzly susednych komunit spojime hranou
+	QSet<qint64> connected;
+	const QVector<int> & offsets = adjacency.getOffsets();
+	const QVector<int> & neighbours = adjacency.getNeighbours();
+
+	for(int v = 0; v < adjacency.getNodeCount(); v++) {
+		int src = communities.at(v);
+		if(merged.at(src) == NULL)
+			continue;
+
+		for(int i = offsets.at(v); i < offsets.at(v + 1); i++) {
+			int dst = communities.at(neighbours.at(i));
+			if(dst <= src || merged.at(dst) == NULL)
+				continue;
+
+			qint64 key = (qint64) src * count + dst;
+			if(connected.contains(key))
+				continue;
+
+			connected.insert(key);
+			graph->addEdge("mergedEdge", merged.at(src), merged.at(dst), graph->getEdgeMetaType(), false);
+		}
+	}
+
+	this->level = level;
+	version = graph->getVersion();
+}
+
+void Analysis::CommunityHierarchy::expand()
+{
+	if(level < 0)
+		return;
+
+	//zlucene uzly, ktore medzitym nezmazal pouzivatel
+	QLinkedList<osg::ref_ptr<Data::Node> > existing;
+	for(int i = 0; i < mergedNodes.size(); i++) {
+		if(graph->getMetaNodes()->contains(mergedNodes.at(i)->getId()))
+			existing.append(mergedNodes.at(i));
+	}
+
+	graph->separateNodes(&existing);
+
+	mergedNodes.clear();
+	level = -1;
+	version = graph->getVersion();
+}
+
+Analysis::CommunityCommand::CommunityCommand(QSharedPointer<Analysis::CommunityHierarchy> hierarchy, int step)
+{
+	this->hierarchy = hierarchy;
+	this->step = step;
+}
+
+void Analysis::CommunityCommand::apply(Data::Graph * graph)
+{
+	//hierarchia mohla patrit grafu, ktory sa medzitym zmenil
+	if(this->hierarchy->getGraph() != graph)
+		return;
+
+	int level = this->hierarchy->getLevel() + this->step;
+
+	if(level >= this->hierarchy->getLevelCount())
+		return;
+
+	if(level >= 0)
+		this->hierarchy->collapse(level);
+	else
+		this->hierarchy->expand();
+}
@@ -0,0 +1,472 @@
+/*!
+ * GraphMetrics.cpp
+ * Projekt 3DVisual
+ */
+#include "Analysis/GraphMetrics.h"
+#include "Data/Graph.h"
+
+#include <QThread>
+#include <QtConcurrentRun>
+#include <QtConcurrentMap>
+
+namespace
+{
+	//velkost bloku uzlov spracovaneho jednym vlaknom
+	const int BLOCK_SIZE = 4096;
+
+	//rozsah mierky uzlov pri zobrazeni metriky (nasobok zakladnej mierky)
+	const float MIN_SCALE = 0.5f;
+	const float MAX_SCALE = 3.0f;
+
+	//hodnota prevedena na interval <0, 1>, pri jedinej hodnote stred intervalu
+	float normalize(double value, double min, double max)
+	{
+		return (max > min) ? (float) ((value - min) / (max - min)) : 0.5f;
+	}
+
+	QList<int> blockStarts(int count)
+	{
+		QList<int> starts;
+		for(int start = 0; start < count; start += BLOCK_SIZE)
+			starts.append(start);
+		return starts;
+	}
+
+	/**
+	*  \class PageRankBlock
+	*  \brief Computes new ranks of one block of the Nodes from the contributions of their predecessors
+	*/
+	class PageRankBlock
+	{
+	public:
+
+		typedef void result_type;
+
+		PageRankBlock(const Analysis::AdjacencyGraph &graph, const double * contributions, double * ranks, double base, double damping)
+			: offsets(graph.getInOffsets().constData()), predecessors(graph.getPredecessors().constData()), count(graph.getNodeCount()),
+			  contributions(contributions), ranks(ranks), base(base), damping(damping)
+		{
+		}
+
+		void operator()(const int &start) const
+		{
+			int end = qMin(start + BLOCK_SIZE, count);
+
+			for(int v = start; v < end; v++) {
+				double sum = 0;
+				for(int i = offsets[v]; i < offsets[v + 1]; i++)
+					sum += contributions[predecessors[i]];
+				ranks[v] = base + damping * sum;
+			}
+		}
+
+	private:
+
+		const int * offsets;
+		const int * predecessors;
+		int count;
+		const double * contributions;
+		double * ranks;
+		double base;
+		double damping;
+	};
+
+	/**
+	*  \class BetweennessPart
+	*  \brief Brandes accumulation of the dependencies from a group of source Nodes
+	*/
+	class BetweennessPart
+	{
+	public:
+
+		typedef QVector<double> result_type;
+
+		BetweennessPart(const Analysis::AdjacencyGraph &graph)
+			: graph(graph)
+		{
+		}
+
+		QVector<double> operator()(const QVector<int> &sources) const
+		{
+			int n = graph.getNodeCount();
+			const int * offsets = graph.getOffsets().constData();
+			const int * neighbours = graph.getNeighbours().constData();
+
+			QVector<double> centrality(n, 0);
+			QVector<int> distance(n, -1);
+			QVector<double> paths(n, 0);
+			QVector<double> dependency(n, 0);
+			QVector<int> order;
+			order.reserve(n);
+
+			for(int s = 0; s < sources.size(); s++) {
+				int source = sources.at(s);
+
+				//prehladavanie do sirky, poradie uzlov zaroven sluzi ako zasobnik
+				order.clear();
+				order.append(source);
+				distance[source] = 0;
+				paths[source] = 1;
+
+				for(int head = 0; head < order.size(); head++) {
+					int v = order.at(head);
+					for(int i = offsets[v]; i < offsets[v + 1]; i++) {
+						int w = neighbours[i];
+						if(distance.at(w) < 0) {
+							distance[w] = distance.at(v) + 1;
+							order.append(w);
+						}
+						if(distance.at(w) == distance.at(v) + 1)
+							paths[w] += paths.at(v);
+					}
+				}
+
+				//spatne scitanie zavislosti, predchodcov hladame podla vzdialenosti
+				for(int j = order.size() - 1; j >= 0; j--) {
+					int w = order.at(j);
+					for(int i = offsets[w]; i < offsets[w + 1]; i++) {
+						int v = neighbours[i];
+						if(distance.at(v) == distance.at(w) - 1)
+							dependency[v] += paths.at(v) / paths.at(w) * (1 + dependency.at(w));
+					}
+					if(w != source)
+						centrality[w] += dependency.at(w);
+				}
+
+				//vynulujeme len navstivene uzly
+				for(int j = 0; j < order.size(); j++) {
+					int v = order.at(j);
+					distance[v] = -1;
+					paths[v] = 0;
+					dependency[v] = 0;
+				}
+			}
+
+			return centrality;
+		}
+
+	private:
+
+		const Analysis::AdjacencyGraph &graph;
+	};
+
+	void sumCentrality(QVector<double> &result, const QVector<double> &part)
+	{
+		if(result.isEmpty()) {
+			result = part;
+			return;
+		}
+
+		for(int i = 0; i < part.size(); i++)
+			result[i] += part.at(i);
+	}
+}
+
+int Analysis::GraphMetrics::computeAll(Data::Graph * graph)
+{
+	return storeResult(graph, compute(Analysis::AdjacencyGraph(graph)));
+}
+
+Analysis::GraphMetrics::Result Analysis::GraphMetrics::compute(const Analysis::AdjacencyGraph &adjacency)
+{
+	Result result;
+	int n = adjacency.getNodeCount();
+
+	//komponenty a jadra su sekvencne algoritmy, pocitame ich sucasne s ostatnymi metrikami
+	QFuture<QVector<int> > componentsFuture = QtConcurrent::run(&Analysis::GraphMetrics::components, adjacency);
+	QFuture<QVector<int> > coresFuture = QtConcurrent::run(&Analysis::GraphMetrics::coreNumbers, adjacency);
+
+	result.nodeIds = adjacency.getNodeIds();
+	result.degrees = degrees(adjacency);
+	result.ranks = pageRank(adjacency);
+	result.centrality = betweenness(adjacency, (n > EXACT_BETWEENNESS_LIMIT) ? BETWEENNESS_SAMPLES : 0);
+
+	result.components = componentsFuture.result();
+	result.cores = coresFuture.result();
+
+	for(int i = 0; i < result.components.size(); i++)
+		result.componentCount = qMax(result.componentCount, result.components.at(i) + 1);
+
+	return result;
+}
+
+int Analysis::GraphMetrics::storeResult(Data::Graph * graph, const Result &result)
+{
+	storeAttribute(graph, result.nodeIds, "degree", result.degrees);
+	storeAttribute(graph, result.nodeIds, "component", result.components);
+	storeAttribute(graph, result.nodeIds, "coreness", result.cores);
+	storeAttribute(graph, result.nodeIds, "pagerank", result.ranks);
+	storeAttribute(graph, result.nodeIds, "betweenness", result.centrality);
+
+	return result.componentCount;
+}
+
+QVector<int> Analysis::GraphMetrics::degrees(const Analysis::AdjacencyGraph &graph)
+{
+	QVector<int> result(graph.getNodeCount());
+
+	for(int v = 0; v < result.size(); v++)
+		result[v] = graph.degree(v);
+
+	return result;
+}
+
+QVector<int> Analysis::GraphMetrics::components(const Analysis::AdjacencyGraph &graph)
+{
+	int n = graph.getNodeCount();
+	const int * offsets = graph.getOffsets().constData();
+	const int * neighbours = graph.getNeighbours().constData();
+
+	//union-find so skracovanim ciest a spajanim podla velkosti
+	QVector<int> parent(n);
+	QVector<int> size(n, 1);
+	for(int v = 0; v < n; v++)
+		parent[v] = v;
+
+	for(int v = 0; v < n; v++) {
+		for(int i = offsets[v]; i < offsets[v + 1]; i++) {
+			int a = v;
+			int b = neighbours[i];
+
+			while(parent.at(a) != a) { parent[a] = parent.at(parent.at(a)); a = parent.at(a); }
+			while(parent.at(b) != b) { parent[b] = parent.at(parent.at(b)); b = parent.at(b); }
+
+			if(a == b)
+				continue;
+			if(size.at(a) < size.at(b))
+				qSwap(a, b);
+
+			parent[b] = a;
+			size[a] += size.at(b);
+		}
+	}
+
+	//korene ocislujeme v poradi uzlov
+	QVector<int> labels(n, -1);
+	QVector<int> result(n);
+	int count = 0;
+
+	for(int v = 0; v < n; v++) {
+		int root = v;
+		while(parent.at(root) != root)
+			root = parent.at(root);
+
+		if(labels.at(root) < 0)
+			labels[root] = count++;
+		result[v] = labels.at(root);
+	}
+
+	return result;
+}
+
+QVector<int> Analysis::GraphMetrics::coreNumbers(const Analysis::AdjacencyGraph &graph)
+{
+	int n = graph.getNodeCount();
+	const int * offsets = graph.getOffsets().constData();
+	const int * neighbours = graph.getNeighbours().constData();
+
+	QVector<int> degree = degrees(graph);
+	int maxDegree = 0;
+	for(int v = 0; v < n; v++)
+		maxDegree = qMax(maxDegree, degree.at(v));
+
+	//uzly zoradene podla stupna (bucket sort), bin[d] je zaciatok uzlov so stupnom d
+	QVector<int> bin(maxDegree + 1, 0);
+	for(int v = 0; v < n; v++)
+		bin[degree.at(v)]++;
+
+	int start = 0;
+	for(int d = 0; d <= maxDegree; d++) {
+		int count = bin.at(d);
+		bin[d] = start;
+		start += count;
+	}
+
+	QVector<int> vertices(n);
+	QVector<int> position(n);
+	for(int v = 0; v < n; v++) {
+		position[v] = bin.at(degree.at(v));
+		vertices[position.at(v)] = v;
+		bin[degree.at(v)]++;
+	}
+
+	for(int d = maxDegree; d > 0; d--)
+		bin[d] = bin.at(d - 1);
+	bin[0] = 0;
+
+	//odoberame uzly s najmensim stupnom a znizujeme stupen ich susedom
+	for(int i = 0; i < n; i++) {
+		int v = vertices.at(i);
+
+		for(int j = offsets[v]; j < offsets[v + 1]; j++) {
+			int u = neighbours[j];
+
+			if(degree.at(u) > degree.at(v)) {
+				int du = degree.at(u);
+				int pu = position.at(u);
+				int pw = bin.at(du);
+				int w = vertices.at(pw);
+
+				if(u != w) {
+					position[u] = pw;
+					vertices[pu] = w;
+					position[w] = pu;
+					vertices[pw] = u;
+				}
+
+				bin[du]++;
+				degree[u]--;
+			}
+		}
+	}
+
+	return degree;
+}
+
+QVector<float> Analysis::GraphMetrics::pageRank(const Analysis::AdjacencyGraph &graph, float damping, int maxIterations, double tolerance)
+{
+	int n = graph.getNodeCount();
+	QVector<float> result(n);
+
+	if(n == 0)
+		return result;
+
+	const QVector<int> & outDegrees = graph.getOutDegrees();
+	QVector<double> ranks(n, 1.0 / n);
+	QVector<double> nextRanks(n, 0);
+	QVector<double> contributions(n, 0);
+	QList<int> blocks = blockStarts(n);
+
+	for(int iteration = 0; iteration < maxIterations; iteration++) {
+		//rank uzlov bez nasledovnikov sa rozdeli rovnomerne medzi vsetky uzly
+		double dangling = 0;
+		for(int v = 0; v < n; v++) {
+			if(outDegrees.at(v) > 0)
+				contributions[v] = ranks.at(v) / outDegrees.at(v);
+			else {
+				contributions[v] = 0;
+				dangling += ranks.at(v);
+			}
+		}
+
+		double base = (1.0 - damping) / n + damping * dangling / n;
+		QtConcurrent::blockingMap(blocks, PageRankBlock(graph, contributions.constData(), nextRanks.data(), base, damping));
+
+		double change = 0;
+		for(int v = 0; v < n; v++)
+			change += qAbs(nextRanks.at(v) - ranks.at(v));
+
+		qSwap(ranks, nextRanks);
+
+		if(change < tolerance)
+			break;
+	}
+
+	for(int v = 0; v < n; v++)
+		result[v] = (float) ranks.at(v);
+
+	return result;
+}
+
+QVector<float> Analysis::GraphMetrics::betweenness(const Analysis::AdjacencyGraph &graph, int samples)
+{
+	int n = graph.getNodeCount();
+	QVector<float> result(n, 0);
+
+	if(n == 0)
+		return result;
+
+	//pri odhade vyberame zdrojove uzly rovnomerne v celom rozsahu
+	bool exact = (samples <= 0 || samples >= n);
+	int sourceCount = exact ? n : samples;
+
+	//zdrojove uzly rozdelime do skupin pre vlakna, kazda skupina ma vlastne pracovne polia
+	int groupCount = qMin(sourceCount, qMax(1, QThread::idealThreadCount()) * 4);
+	QList<QVector<int> > groups;
+	for(int g = 0; g < groupCount; g++)
+		groups.append(QVector<int>());
+
+	for(int i = 0; i < sourceCount; i++) {
+		int source = exact ? i : (int) (((qint64) i * n) / sourceCount);
+		groups[i % groupCount].append(source);
+	}
+
+	QVector<double> centrality = QtConcurrent::blockingMappedReduced(groups, BetweennessPart(graph), sumCentrality);
+
+	//neorientovane cesty su zapocitane z oboch koncov, odhad skalujeme na vsetky zdroje
+	double scale = 0.5 * n / sourceCount;
+	for(int v = 0; v < n && v < centrality.size(); v++)
+		result[v] = (float) (centrality.at(v) * scale);
+
+	return result;
+}
+
+void Analysis::GraphMetrics::storeAttribute(Data::Graph * graph, const QVector<qlonglong> &nodeIds, QString name, const QVector<int> &values)
+{
+	Data::AttributeStore * attributes = graph->getNodeAttributes();
+	QSharedPointer<Data::GraphSnapshot> snapshot = graph->getSnapshot();
+
+	//atributy moze zaroven menit import
+	QMutexLocker locker(graph->getStructureMutex());
+
+	//stare hodnoty mohli patrit aj uz odstranenym uzlom
+	attributes->removeColumn(name);
+	Data::AttributeColumn * column = attributes->addColumn(name, Data::AttributeColumn::INT);
+
+	//uzly odstranene pocas vypoctu preskocime
+	for(int v = 0; v < values.size(); v++) {
+		if(snapshot->getNodes().contains(nodeIds.at(v)))
+			column->setInt(attributes->addRow(nodeIds.at(v)), values.at(v));
+	}
+}
+
+void Analysis::GraphMetrics::storeAttribute(Data::Graph * graph, const QVector<qlonglong> &nodeIds, QString name, const QVector<float> &values)
+{
+	Data::AttributeStore * attributes = graph->getNodeAttributes();
+	QSharedPointer<Data::GraphSnapshot> snapshot = graph->getSnapshot();
+	QMutexLocker locker(graph->getStructureMutex());
+
+	attributes->removeColumn(name);
+	Data::AttributeColumn * column = attributes->addColumn(name, Data::AttributeColumn::FLOAT);
+
+	for(int v = 0; v < values.size(); v++) {
+		if(snapshot->getNodes().contains(nodeIds.at(v)))
+			column->setFloat(attributes->addRow(nodeIds.at(v)), values.at(v));
+	}
+}
+
+void Analysis::GraphMetrics::mapToNodes(Data::Graph * graph, QString sizeAttribute, QString colorAttribute)
+{
+	QMutexLocker locker(graph->getStructureMutex());
+	Data::AttributeStore * attributes = graph->getNodeAttributes();
+	Data::AttributeColumn * sizeColumn = sizeAttribute.isEmpty() ? NULL : attributes->getColumn(sizeAttribute);
+	Data::AttributeColumn * colorColumn = colorAttribute.isEmpty() ? NULL : attributes->getColumn(colorAttribute);
+
+	double sizeMin = 0, sizeMax = 0, colorMin = 0, colorMax = 0;
+	bool sized = (sizeColumn != NULL && sizeColumn->getRange(sizeMin, sizeMax));
+	bool colored = (colorColumn != NULL && colorColumn->getRange(colorMin, colorMax));
+
+	if(!sized && !colored)
+		return;
+
+	float defaultScale = graph->getNodeScale();
+	QSharedPointer<Data::GraphSnapshot> snapshot = graph->getSnapshot();
+
+	for(QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator it = snapshot->getNodes().constBegin(); it != snapshot->getNodes().constEnd(); ++it) {
+		Data::Node * node = it.value().get();
+		int row = attributes->getRow(it.key());
+
+		if(sized && !sizeColumn->isNull(row)) {
+			float t = normalize(sizeColumn->getNumber(row), sizeMin, sizeMax);
+			node->setScale(defaultScale * (MIN_SCALE + (MAX_SCALE - MIN_SCALE) * t));
+
+			//vykreslenie uzla sa vytvara podla mierky
+			node->reloadConfig();
+		}
+
+		if(colored && !colorColumn->isNull(row)) {
+			float t = normalize(colorColumn->getNumber(row), colorMin, colorMax);
+			node->setColor(osg::Vec4(t, 0.2f, 1.0f - t, 1.0f));
+		}
+	}
+}
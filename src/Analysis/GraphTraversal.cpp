@@ -0,0 +1,310 @@
+/*!
+ * GraphTraversal.cpp
+ * Projekt 3DVisual
+ */
+#include "Analysis/GraphTraversal.h"
+#include "Data/Graph.h"
+
+#include <QBitArray>
+#include <QPair>
+
+namespace
+{
+	/**
+	*  \class FrontierHeap
+	*  \brief Binary min-heap of the Nodes by their key, used as frontier of Dijkstra and A*
+	*/
+	class FrontierHeap
+	{
+	public:
+
+		bool isEmpty() const { return items.isEmpty(); }
+
+		void push(double key, int node)
+		{
+			items.append(qMakePair(key, node));
+
+			int i = items.size() - 1;
+			while(i > 0) {
+				int parent = (i - 1) / 2;
+				if(items.at(parent).first <= items.at(i).first)
+					break;
+				qSwap(items[parent], items[i]);
+				i = parent;
+			}
+		}
+
+		QPair<double, int> pop()
+		{
+			QPair<double, int> top = items.first();
+			items[0] = items.last();
+			items.remove(items.size() - 1);
+
+			int i = 0;
+			while(true) {
+				int smallest = i;
+				int left = 2 * i + 1;
+				int right = left + 1;
+				if(left < items.size() && items.at(left).first < items.at(smallest).first)
+					smallest = left;
+				if(right < items.size() && items.at(right).first < items.at(smallest).first)
+					smallest = right;
+				if(smallest == i)
+					break;
+				qSwap(items[smallest], items[i]);
+				i = smallest;
+			}
+
+			return top;
+		}
+
+	private:
+
+		QVector<QPair<double, int> > items;
+	};
+
+	//cesta od ciela k zdroju podla predchodcov, vratena od zdroja
+	QVector<int> tracePath(const QVector<int> &parents, int target)
+	{
+		QVector<int> path;
+
+		for(int v = target; v >= 0; v = parents.at(v))
+			path.append(v);
+
+		for(int i = 0; i < path.size() / 2; i++)
+			qSwap(path[i], path[path.size() - 1 - i]);
+
+		return path;
+	}
+}
+
+Analysis::GraphTraversal::GraphTraversal(Data::Graph * graph)
+	: graph(graph), adjacency(graph)
+{
+	version = graph->getVersion();
+}
+
+bool Analysis::GraphTraversal::isCurrent(Data::Graph * graph) const
+{
+	return this->graph == graph && graph != NULL && graph->getVersion() == version;
+}
+
+QVector<int> Analysis::GraphTraversal::shortestPath(int source, int target) const
+{
+	int n = adjacency.getNodeCount();
+	if(source < 0 || target < 0 || source >= n || target >= n)
+		return QVector<int>();
+
+	if(source == target)
+		return QVector<int>(1, source);
+
+	const int * offsets = adjacency.getOffsets().constData();
+	const int * neighbours = adjacency.getNeighbours().constData();
+
+	//predchodcovia na ceste od zdroja a nasledovnici na ceste k cielu
+	QVector<int> parents(n, -1);
+	QVector<int> children(n, -1);
+	QBitArray forwardVisited(n);
+	QBitArray backwardVisited(n);
+	QVector<int> forwardFrontier(1, source);
+	QVector<int> backwardFrontier(1, target);
+	QVector<int> next;
+	int meeting = -1;
+
+	forwardVisited.setBit(source);
+	backwardVisited.setBit(target);
+
+	while(meeting < 0 && !forwardFrontier.isEmpty() && !backwardFrontier.isEmpty()) {
+		//rozsirujeme mensiu z oboch hranic
+		bool forward = forwardFrontier.size() <= backwardFrontier.size();
+		QVector<int> & frontier = forward ? forwardFrontier : backwardFrontier;
+		QBitArray & visited = forward ? forwardVisited : backwardVisited;
+		QBitArray & otherVisited = forward ? backwardVisited : forwardVisited;
+		QVector<int> & links = forward ? parents : children;
+
+		next.clear();
+		for(int f = 0; f < frontier.size() && meeting < 0; f++) {
+			int v = frontier.at(f);
+
+			for(int i = offsets[v]; i < offsets[v + 1]; i++) {
+				int w = neighbours[i];
+				if(visited.testBit(w))
+					continue;
+
+				visited.setBit(w);
+				links[w] = v;
+
+				//prve stretnutie hranic uz dava najkratsiu cestu
+				if(otherVisited.testBit(w)) {
+					meeting = w;
+					break;
+				}
+
+				next.append(w);
+			}
+		}
+
+		qSwap(frontier, next);
+	}
+
+	if(meeting < 0)
+		return QVector<int>();
+
+	QVector<int> path = tracePath(parents, meeting);
+	for(int v = children.at(meeting); v >= 0; v = children.at(v))
+		path.append(v);
+
+	return path;
+}
+
+QVector<int> Analysis::GraphTraversal::weightedPath(int source, int target, const QVector<float> &weights) const
+{
+	if(weights.size() != adjacency.getNeighbours().size())
+		return shortestPath(source, target);
+
+	return bestFirstPath(source, target, &weights);
+}
+
+QVector<int> Analysis::GraphTraversal::geometricPath(int source, int target) const
+{
+	return bestFirstPath(source, target, NULL);
+}
+
+QVector<int> Analysis::GraphTraversal::bestFirstPath(int source, int target, const QVector<float> * weights) const
+{
+	int n = adjacency.getNodeCount();
+	if(source < 0 || target < 0 || source >= n || target >= n)
+		return QVector<int>();
+
+	const int * offsets = adjacency.getOffsets().constData();
+	const int * neighbours = adjacency.getNeighbours().constData();
+	const QVector<osg::Vec3f> & positions = adjacency.getPositions();
+	osg::Vec3f goal = positions.at(target);
+
+	QVector<double> distances(n, -1);
+	QVector<int> parents(n, -1);
+	QBitArray settled(n);
+	FrontierHeap frontier;
+
+	distances[source] = 0;
+	frontier.push(0, source);
+
+	while(!frontier.isEmpty()) {
+		int v = frontier.pop().second;
+		if(settled.testBit(v))
+			continue;
+
+		settled.setBit(v);
+		if(v == target)
+			return tracePath(parents, target);
+
+		for(int i = offsets[v]; i < offsets[v + 1]; i++) {
+			int w = neighbours[i];
+			if(settled.testBit(w))
+				continue;
+
+			//A* pouziva dlzku hrany v priestore, vzdialenost k cielu ju nikdy neprecenuje
+			double length = (weights != NULL) ? weights->at(i) : (positions.at(w) - positions.at(v)).length();
+			double distance = distances.at(v) + length;
+
+			if(distances.at(w) < 0 || distance < distances.at(w)) {
+				distances[w] = distance;
+				parents[w] = v;
+
+				double estimate = (weights != NULL) ? 0 : (goal - positions.at(w)).length();
+				frontier.push(distance + estimate, w);
+			}
+		}
+	}
+
+	return QVector<int>();
+}
+
+QVector<int> Analysis::GraphTraversal::neighbourhood(const QVector<int> &sources, int hops) const
+{
+	int n = adjacency.getNodeCount();
+	const int * offsets = adjacency.getOffsets().constData();
+	const int * neighbours = adjacency.getNeighbours().constData();
+
+	QBitArray visited(n);
+	QVector<int> found;
+	QVector<int> frontier;
+	QVector<int> next;
+
+	for(int s = 0; s < sources.size(); s++) {
+		int source = sources.at(s);
+		if(source < 0 || source >= n || visited.testBit(source))
+			continue;
+
+		visited.setBit(source);
+		frontier.append(source);
+	}
+	found = frontier;
+
+	for(int hop = 0; hop < hops && !frontier.isEmpty(); hop++) {
+		next.clear();
+
+		for(int f = 0; f < frontier.size(); f++) {
+			int v = frontier.at(f);
+			for(int i = offsets[v]; i < offsets[v + 1]; i++) {
+				int w = neighbours[i];
+				if(!visited.testBit(w)) {
+					visited.setBit(w);
+					next.append(w);
+				}
+			}
+		}
+
+		found += next;
+		qSwap(frontier, next);
+	}
+
+	return found;
+}
+
+QVector<float> Analysis::GraphTraversal::getEdgeWeights(QString name) const
+{
+	//textovy atribut nie je vaha, cesta sa hlada bez vah
+	QMutexLocker locker(graph->getStructureMutex());
+	Data::AttributeColumn * column = graph->getEdgeAttributes()->getColumn(name);
+	if(column == NULL || !column->isNumeric())
+		return QVector<float>();
+
+	const QVector<qlonglong> & edgeIds = adjacency.getNeighbourEdges();
+	QVector<float> weights(edgeIds.size());
+
+	for(int i = 0; i < edgeIds.size(); i++) {
+		int row = graph->getEdgeAttributes()->getRow(edgeIds.at(i));
+
+		//hrany bez vahy maju vahu 1, zaporne vahy Dijkstra nepodporuje
+		weights[i] = column->isNull(row) ? 1.0f : (float) qMax(0.0, column->getNumber(row));
+	}
+
+	return weights;
+}
+
+QList<qlonglong> Analysis::GraphTraversal::getPathEdges(const QVector<int> &path, const QVector<float> &weights) const
+{
+	QList<qlonglong> edges;
+	const QVector<int> & offsets = adjacency.getOffsets();
+	const QVector<int> & neighbours = adjacency.getNeighbours();
+	const QVector<qlonglong> & edgeIds = adjacency.getNeighbourEdges();
+	bool weighted = (weights.size() == neighbours.size());
+
+	for(int p = 0; p + 1 < path.size(); p++) {
+		int v = path.at(p);
+		int best = -1;
+
+		for(int i = offsets.at(v); i < offsets.at(v + 1); i++) {
+			if(neighbours.at(i) != path.at(p + 1))
+				continue;
+			if(best < 0 || (weighted && weights.at(i) < weights.at(best)))
+				best = i;
+		}
+
+		if(best >= 0)
+			edges.append(edgeIds.at(best));
+	}
+
+	return edges;
+}
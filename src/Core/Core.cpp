@@ -47,7 +47,7 @@ AppCore::Core::~Core()
 {
 }
 
-void AppCore::Core::restartLayout()
+void AppCore::Core::restartLayout(bool startImmediately)
 {
 	// [GrafIT][!] the layout algorithm did not end correctly, what caused more instances
 	// to be running, fixed it here + made modifications in FRAlgorithm to make correct ending possible
@@ -58,7 +58,10 @@ void AppCore::Core::restartLayout()
     this->alg->SetGraph(Manager::GraphManager::getInstance()->getActiveGraph());
     this->alg->SetParameters(10,0.7,1,true);
     this->thr = new Layout::LayoutThread(this->alg);
+    if (startImmediately)
+        this->thr->setStartSleepTime(0);
     this->cw->setLayoutThread(thr);
+    this->cw->activeGraphChanged();
     this->cg->reload(Manager::GraphManager::getInstance()->getActiveGraph());
 
 	#ifndef HAVE_CUDA
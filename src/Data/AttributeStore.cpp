@@ -0,0 +1,550 @@
+/*!
+ * AttributeStore.cpp
+ * Projekt 3DVisual
+ */
+#include "Data/AttributeStore.h"
+
+#include <limits>
+
+//text nemusi byt ukonceny nulou (data namapovaneho suboru), porovnavame preto s dlzkou
+static bool equalsIgnoreCase(const QByteArray &text, const char *word)
+{
+	uint length = qstrlen(word);
+	return (uint) text.size() == length && qstrnicmp(text.constData(), word, length) == 0;
+}
+
+Data::AttributeColumn::AttributeColumn(QString name, ValueType valueType)
+{
+	this->name = name;
+	this->valueType = valueType;
+}
+
+Data::AttributeColumn::ValueType Data::AttributeColumn::valueTypeFromName(QString typeName)
+{
+	typeName = typeName.toLower();
+
+	if(typeName == "int" || typeName == "long" || typeName == "integer")
+		return INT;
+	if(typeName == "float")
+		return FLOAT;
+	if(typeName == "double" || typeName == "real")
+		return DOUBLE;
+	if(typeName == "boolean" || typeName == "bool")
+		return BOOL;
+
+	return STRING;
+}
+
+Data::AttributeColumn::ValueType Data::AttributeColumn::valueTypeOfText(const QByteArray &text)
+{
+	bool ok;
+
+	if(equalsIgnoreCase(text, "true") || equalsIgnoreCase(text, "false"))
+		return BOOL;
+
+	(void)text.toLongLong(&ok);
+	if(ok)
+		return INT;
+
+	(void)text.toDouble(&ok);
+	if(ok)
+		return FLOAT;
+
+	return STRING;
+}
+
+Data::AttributeColumn::ValueType Data::AttributeColumn::commonValueType(ValueType type1, ValueType type2)
+{
+	if(type1 == type2)
+		return type1;
+
+	if(type1 == STRING || type1 == BOOL || type2 == STRING || type2 == BOOL)
+		return STRING;
+
+	//DOUBLE udrzi hodnoty vsetkych ciselnych typov, INT a FLOAT dava FLOAT
+	if(type1 == DOUBLE || type2 == DOUBLE)
+		return DOUBLE;
+
+	return FLOAT;
+}
+
+void Data::AttributeColumn::ensureRow(int row)
+{
+	if(row < valid.size())
+		return;
+
+	//pole hodnot zvacsujeme len pre typ stlpca
+	valid.resize(row + 1);
+
+	switch(valueType) {
+		case INT: ints.resize(row + 1); break;
+		case FLOAT: floats.resize(row + 1); break;
+		case STRING: strings.resize(row + 1); break;
+		case BOOL: bools.resize(row + 1); break;
+		case DOUBLE: doubles.resize(row + 1); break;
+	}
+}
+
+void Data::AttributeColumn::setNull(int row)
+{
+	if(row >= 0 && row < valid.size())
+		valid.clearBit(row);
+}
+
+bool Data::AttributeColumn::setValue(int row, const QString &text)
+{
+	bool ok = true;
+
+	switch(valueType) {
+		case INT: {
+			qlonglong value = text.trimmed().toLongLong(&ok);
+			if(ok) setInt(row, value);
+			break;
+		}
+		case FLOAT: {
+			float value = text.trimmed().toFloat(&ok);
+			if(ok) setFloat(row, value);
+			break;
+		}
+		case DOUBLE: {
+			double value = text.trimmed().toDouble(&ok);
+			if(ok) setDouble(row, value);
+			break;
+		}
+		case STRING:
+			setString(row, text);
+			break;
+		case BOOL: {
+			QString value = text.trimmed().toLower();
+			ok = (value == "true" || value == "false" || value == "1" || value == "0");
+			if(ok) setBool(row, value == "true" || value == "1");
+			break;
+		}
+	}
+
+	return ok;
+}
+
+bool Data::AttributeColumn::setValue(int row, const QByteArray &text)
+{
+	bool ok = true;
+
+	switch(valueType) {
+		case INT: {
+			qlonglong value = text.trimmed().toLongLong(&ok);
+			if(ok) setInt(row, value);
+			break;
+		}
+		case FLOAT: {
+			float value = text.trimmed().toFloat(&ok);
+			if(ok) setFloat(row, value);
+			break;
+		}
+		case DOUBLE: {
+			double value = text.trimmed().toDouble(&ok);
+			if(ok) setDouble(row, value);
+			break;
+		}
+		case STRING:
+			setString(row, QString::fromUtf8(text.constData(), text.size()));
+			break;
+		case BOOL: {
+			QByteArray value = text.trimmed();
+			bool isTrue = (equalsIgnoreCase(value, "true") || equalsIgnoreCase(value, "1"));
+			ok = isTrue || equalsIgnoreCase(value, "false") || equalsIgnoreCase(value, "0");
+			if(ok) setBool(row, isTrue);
+			break;
+		}
+	}
+
+	return ok;
+}
+
+void Data::AttributeColumn::setInt(int row, qlonglong value)
+{
+	ensureRow(row);
+	ints[row] = value;
+	valid.setBit(row);
+}
+
+void Data::AttributeColumn::setFloat(int row, float value)
+{
+	ensureRow(row);
+	floats[row] = value;
+	valid.setBit(row);
+}
+
+void Data::AttributeColumn::setDouble(int row, double value)
+{
+	ensureRow(row);
+	doubles[row] = value;
+	valid.setBit(row);
+}
+
+void Data::AttributeColumn::setString(int row, const QString &value)
+{
+	ensureRow(row);
+
+	//rovnake retazce su ulozene v slovniku len raz
+	QHash<QString, int>::const_iterator it = dictionaryIndex.constFind(value);
+	int index;
+	if(it == dictionaryIndex.constEnd()) {
+		index = dictionary.size();
+		dictionary.append(value);
+		dictionaryIndex.insert(value, index);
+	} else {
+		index = it.value();
+	}
+
+	strings[row] = index;
+	valid.setBit(row);
+}
+
+void Data::AttributeColumn::setBool(int row, bool value)
+{
+	ensureRow(row);
+	bools.setBit(row, value);
+	valid.setBit(row);
+}
+
+void Data::AttributeColumn::convertToString()
+{
+	if(valueType == STRING)
+		return;
+
+	//hodnoty prevedieme na text este pred zmenou typu
+	int count = valid.size();
+	QVector<QString> texts(count);
+	for(int row = 0; row < count; row++) {
+		if(!valid.testBit(row))
+			continue;
+
+		switch(valueType) {
+			case INT: texts[row] = QString::number(ints.at(row)); break;
+			case FLOAT: texts[row] = QString::number(floats.at(row), 'g', 7); break;
+			case DOUBLE: texts[row] = QString::number(doubles.at(row), 'g', 15); break;
+			case BOOL: texts[row] = bools.testBit(row) ? "true" : "false"; break;
+			case STRING: break;
+		}
+	}
+
+	ints.clear();
+	floats.clear();
+	doubles.clear();
+	bools.clear();
+
+	valueType = STRING;
+	strings.resize(count);
+	for(int row = 0; row < count; row++) {
+		if(valid.testBit(row))
+			setString(row, texts.at(row));
+	}
+}
+
+QVariant Data::AttributeColumn::getValue(int row) const
+{
+	if(isNull(row))
+		return QVariant();
+
+	switch(valueType) {
+		case INT: return QVariant(ints.at(row));
+		case FLOAT: return QVariant(floats.at(row));
+		case STRING: return QVariant(dictionary.at(strings.at(row)));
+		case BOOL: return QVariant(bools.testBit(row));
+		case DOUBLE: return QVariant(doubles.at(row));
+	}
+
+	return QVariant();
+}
+
+double Data::AttributeColumn::getNumber(int row) const
+{
+	if(isNull(row))
+		return 0;
+
+	switch(valueType) {
+		case INT: return (double) ints.at(row);
+		case FLOAT: return floats.at(row);
+		case DOUBLE: return doubles.at(row);
+		//index do slovnika nie je cislo, porovnania s cislom su vzdy nepravdive
+		case STRING: return std::numeric_limits<double>::quiet_NaN();
+		case BOOL: return bools.testBit(row) ? 1 : 0;
+	}
+
+	return 0;
+}
+
+QVector<int> Data::AttributeColumn::selectEqual(const QVariant &value) const
+{
+	QVector<int> selected;
+	int count = valid.size();
+
+	switch(valueType) {
+		case INT: {
+			qlonglong searched = value.toLongLong();
+			const qlonglong * data = ints.constData();
+			for(int row = 0; row < count; row++)
+				if(data[row] == searched && valid.testBit(row)) selected.append(row);
+			break;
+		}
+		case FLOAT: {
+			float searched = value.toFloat();
+			const float * data = floats.constData();
+			for(int row = 0; row < count; row++)
+				if(data[row] == searched && valid.testBit(row)) selected.append(row);
+			break;
+		}
+		case DOUBLE: {
+			double searched = value.toDouble();
+			const double * data = doubles.constData();
+			for(int row = 0; row < count; row++)
+				if(data[row] == searched && valid.testBit(row)) selected.append(row);
+			break;
+		}
+		case STRING: {
+			//retazec porovnavame len raz so slovnikom, dalej sa porovnavaju indexy
+			QHash<QString, int>::const_iterator it = dictionaryIndex.constFind(value.toString());
+			if(it == dictionaryIndex.constEnd())
+				break;
+			int searched = it.value();
+			const int * data = strings.constData();
+			for(int row = 0; row < count; row++)
+				if(data[row] == searched && valid.testBit(row)) selected.append(row);
+			break;
+		}
+		case BOOL: {
+			bool searched = value.toBool();
+			for(int row = 0; row < count; row++)
+				if(valid.testBit(row) && bools.testBit(row) == searched) selected.append(row);
+			break;
+		}
+	}
+
+	return selected;
+}
+
+QVector<int> Data::AttributeColumn::selectRange(double min, double max) const
+{
+	QVector<int> selected;
+	int count = valid.size();
+
+	if(valueType == INT) {
+		const qlonglong * data = ints.constData();
+		for(int row = 0; row < count; row++)
+			if(data[row] >= min && data[row] <= max && valid.testBit(row)) selected.append(row);
+	} else if(valueType == FLOAT) {
+		const float * data = floats.constData();
+		for(int row = 0; row < count; row++)
+			if(data[row] >= min && data[row] <= max && valid.testBit(row)) selected.append(row);
+	} else if(valueType == DOUBLE) {
+		const double * data = doubles.constData();
+		for(int row = 0; row < count; row++)
+			if(data[row] >= min && data[row] <= max && valid.testBit(row)) selected.append(row);
+	} else if(valueType == BOOL) {
+		for(int row = 0; row < count; row++) {
+			double number = getNumber(row);
+			if(number >= min && number <= max && valid.testBit(row)) selected.append(row);
+		}
+	}
+
+	return selected;
+}
+
+bool Data::AttributeColumn::getRange(double &min, double &max) const
+{
+	bool found = false;
+
+	//retazce nemaju ciselny rozsah
+	if(valueType == STRING)
+		return false;
+
+	for(int row = 0; row < valid.size(); row++) {
+		if(!valid.testBit(row))
+			continue;
+
+		double number = getNumber(row);
+		if(!found || number < min) min = number;
+		if(!found || number > max) max = number;
+		found = true;
+	}
+
+	return found;
+}
+
+Data::AttributeStore::AttributeStore(void)
+{
+}
+
+Data::AttributeStore::AttributeStore(const AttributeStore &other)
+{
+	*this = other;
+}
+
+Data::AttributeStore & Data::AttributeStore::operator=(const AttributeStore &other)
+{
+	if(this == &other)
+		return *this;
+
+	clear();
+
+	//stlpce kopirujeme, ich hodnoty su zdielane az do zmeny
+	columns.reserve(other.columns.size());
+	for(int i = 0; i < other.columns.size(); i++)
+		columns.append(new Data::AttributeColumn(*other.columns.at(i)));
+
+	columnsByName = other.columnsByName;
+	ids = other.ids;
+	rows = other.rows;
+	freeRows = other.freeRows;
+
+	return *this;
+}
+
+Data::AttributeStore::~AttributeStore(void)
+{
+	clear();
+}
+
+Data::AttributeColumn * Data::AttributeStore::addColumn(QString name, AttributeColumn::ValueType valueType)
+{
+	Data::AttributeColumn * column = getColumn(name);
+
+	if(column == NULL) {
+		column = new Data::AttributeColumn(name, valueType);
+		columnsByName.insert(name, columns.size());
+		columns.append(column);
+	}
+
+	return column;
+}
+
+void Data::AttributeStore::removeColumn(QString name)
+{
+	int index = columnsByName.value(name, -1);
+
+	if(index < 0)
+		return;
+
+	delete columns.at(index);
+	columns.remove(index);
+
+	//indexy nasledujucich stlpcov sa posunuli
+	columnsByName.clear();
+	for(int i = 0; i < columns.size(); i++)
+		columnsByName.insert(columns.at(i)->getName(), i);
+}
+
+Data::AttributeColumn * Data::AttributeStore::getColumn(QString name) const
+{
+	int index = columnsByName.value(name, -1);
+
+	return (index < 0) ? NULL : columns.at(index);
+}
+
+QStringList Data::AttributeStore::getColumnNames() const
+{
+	QStringList names;
+
+	for(int i = 0; i < columns.size(); i++)
+		names.append(columns.at(i)->getName());
+
+	return names;
+}
+
+int Data::AttributeStore::addRow(qlonglong id)
+{
+	QHash<qlonglong, int>::const_iterator it = rows.constFind(id);
+
+	if(it != rows.constEnd())
+		return it.value();
+
+	//uvolneny riadok pouzijeme znovu, jeho hodnoty su uz vo vsetkych stlpcoch null
+	int row;
+	if(!freeRows.isEmpty()) {
+		row = freeRows.last();
+		freeRows.pop_back();
+		ids[row] = id;
+	} else {
+		row = ids.size();
+		ids.append(id);
+	}
+	rows.insert(id, row);
+
+	return row;
+}
+
+void Data::AttributeStore::removeRow(qlonglong id)
+{
+	int row = rows.value(id, -1);
+
+	if(row < 0)
+		return;
+
+	//riadok sa oznaci ako prazdny a pouzije ho dalsi pridany prvok
+	for(int i = 0; i < columns.size(); i++)
+		columns.at(i)->setNull(row);
+
+	ids[row] = -1;
+	rows.remove(id);
+	freeRows.append(row);
+}
+
+bool Data::AttributeStore::setValue(qlonglong id, QString name, const QString &text)
+{
+	Data::AttributeColumn * column = addColumn(name, Data::AttributeColumn::STRING);
+
+	return column->setValue(addRow(id), text);
+}
+
+QVariant Data::AttributeStore::getValue(qlonglong id, QString name) const
+{
+	Data::AttributeColumn * column = getColumn(name);
+
+	if(column == NULL)
+		return QVariant();
+
+	return column->getValue(getRow(id));
+}
+
+QList<qlonglong> Data::AttributeStore::selectEqual(QString name, const QVariant &value) const
+{
+	Data::AttributeColumn * column = getColumn(name);
+
+	if(column == NULL)
+		return QList<qlonglong>();
+
+	return rowsToIds(column->selectEqual(value));
+}
+
+QList<qlonglong> Data::AttributeStore::selectRange(QString name, double min, double max) const
+{
+	Data::AttributeColumn * column = getColumn(name);
+
+	if(column == NULL)
+		return QList<qlonglong>();
+
+	return rowsToIds(column->selectRange(min, max));
+}
+
+QList<qlonglong> Data::AttributeStore::rowsToIds(const QVector<int> &selectedRows) const
+{
+	QList<qlonglong> selectedIds;
+	selectedIds.reserve(selectedRows.size());
+
+	for(int i = 0; i < selectedRows.size(); i++) {
+		qlonglong id = ids.at(selectedRows.at(i));
+		if(id >= 0) selectedIds.append(id);
+	}
+
+	return selectedIds;
+}
+
+void Data::AttributeStore::clear()
+{
+	qDeleteAll(columns);
+	columns.clear();
+	columnsByName.clear();
+	ids.clear();
+	rows.clear();
+	freeRows.clear();
+}
@@ -0,0 +1,325 @@
+/*!
+ * Bitmap.cpp
+ * Projekt 3DVisual
+ */
+#include "Data/Bitmap.h"
+
+#include <QtAlgorithms>
+
+//pocet id v jednom bloku je 2^16, husty blok ma 1024 slov po 64 bitoch
+static const int CHUNK_BITS = 16;
+static const int CHUNK_WORDS = 1024;
+//blok s viac ako 4096 id zaberie v poli viac ako bitova mapa (8 kB)
+static const int SPARSE_LIMIT = 4096;
+
+static inline int bitCount(quint64 word)
+{
+#if defined(__GNUC__)
+	return __builtin_popcountll(word);
+#else
+	int count = 0;
+	while(word) {
+		word &= word - 1;
+		++count;
+	}
+	return count;
+#endif
+}
+
+static inline qlonglong chunkKey(qlonglong id)
+{
+	return id >> CHUNK_BITS;
+}
+
+static inline quint16 chunkValue(qlonglong id)
+{
+	return (quint16) (id & 0xFFFF);
+}
+
+bool Data::Bitmap::Chunk::contains(quint16 value) const
+{
+	if(isDense())
+		return (bits.at(value >> 6) >> (value & 63)) & 1;
+
+	return qBinaryFind(values.constBegin(), values.constEnd(), value) != values.constEnd();
+}
+
+void Data::Bitmap::Chunk::add(quint16 value)
+{
+	if(isDense()) {
+		quint64 mask = ((quint64) 1) << (value & 63);
+		if(!(bits[value >> 6] & mask)) {
+			bits[value >> 6] |= mask;
+			cardinality++;
+		}
+		return;
+	}
+
+	QVector<quint16>::iterator it = qLowerBound(values.begin(), values.end(), value);
+	if(it != values.end() && *it == value)
+		return;
+
+	values.insert(it, value);
+	cardinality++;
+
+	if(cardinality > SPARSE_LIMIT)
+		toDense();
+}
+
+void Data::Bitmap::Chunk::remove(quint16 value)
+{
+	if(isDense()) {
+		quint64 mask = ((quint64) 1) << (value & 63);
+		if(bits[value >> 6] & mask) {
+			bits[value >> 6] &= ~mask;
+			cardinality--;
+		}
+
+		if(cardinality <= SPARSE_LIMIT)
+			toSparse();
+		return;
+	}
+
+	QVector<quint16>::iterator it = qLowerBound(values.begin(), values.end(), value);
+	if(it != values.end() && *it == value) {
+		values.erase(it);
+		cardinality--;
+	}
+}
+
+void Data::Bitmap::Chunk::toDense()
+{
+	bits = denseBits();
+	values.clear();
+}
+
+void Data::Bitmap::Chunk::toSparse()
+{
+	QVector<quint16> sparse;
+	sparse.reserve(cardinality);
+
+	for(int word = 0; word < bits.size(); word++) {
+		quint64 w = bits.at(word);
+		for(int bit = 0; w != 0; bit++, w >>= 1) {
+			if(w & 1) sparse.append((quint16) ((word << 6) + bit));
+		}
+	}
+
+	values = sparse;
+	bits.clear();
+}
+
+void Data::Bitmap::Chunk::normalize()
+{
+	if(isDense() && cardinality <= SPARSE_LIMIT)
+		toSparse();
+	else if(!isDense() && cardinality > SPARSE_LIMIT)
+		toDense();
+}
+
+QVector<quint64> Data::Bitmap::Chunk::denseBits() const
+{
+	if(isDense())
+		return bits;
+
+	QVector<quint64> dense(CHUNK_WORDS, 0);
+	for(int i = 0; i < values.size(); i++) {
+		quint16 value = values.at(i);
+		dense[value >> 6] |= ((quint64) 1) << (value & 63);
+	}
+
+	return dense;
+}
+
+Data::Bitmap::Chunk Data::Bitmap::fromBits(const QVector<quint64> &bits)
+{
+	Chunk chunk;
+	chunk.bits = bits;
+
+	for(int i = 0; i < bits.size(); i++)
+		chunk.cardinality += bitCount(bits.at(i));
+
+	chunk.normalize();
+	return chunk;
+}
+
+Data::Bitmap::Bitmap(void)
+{
+}
+
+void Data::Bitmap::add(qlonglong id)
+{
+	chunks[chunkKey(id)].add(chunkValue(id));
+}
+
+void Data::Bitmap::remove(qlonglong id)
+{
+	QMap<qlonglong, Chunk>::iterator it = chunks.find(chunkKey(id));
+
+	if(it == chunks.end())
+		return;
+
+	it.value().remove(chunkValue(id));
+
+	//prazdne bloky neuchovavame
+	if(it.value().cardinality == 0)
+		chunks.erase(it);
+}
+
+bool Data::Bitmap::contains(qlonglong id) const
+{
+	QMap<qlonglong, Chunk>::const_iterator it = chunks.constFind(chunkKey(id));
+
+	return it != chunks.constEnd() && it.value().contains(chunkValue(id));
+}
+
+int Data::Bitmap::count() const
+{
+	int count = 0;
+
+	for(QMap<qlonglong, Chunk>::const_iterator it = chunks.constBegin(); it != chunks.constEnd(); ++it)
+		count += it.value().cardinality;
+
+	return count;
+}
+
+Data::Bitmap Data::Bitmap::operator&(const Bitmap &other) const
+{
+	Bitmap result;
+
+	for(QMap<qlonglong, Chunk>::const_iterator it = chunks.constBegin(); it != chunks.constEnd(); ++it) {
+		QMap<qlonglong, Chunk>::const_iterator otherIt = other.chunks.constFind(it.key());
+		if(otherIt == other.chunks.constEnd())
+			continue;
+
+		const Chunk &a = it.value();
+		const Chunk &b = otherIt.value();
+		Chunk chunk;
+
+		if(!a.isDense() && !b.isDense()) {
+			//dve zoradene polia prechadzame sucasne
+			int i = 0, j = 0;
+			while(i < a.values.size() && j < b.values.size()) {
+				if(a.values.at(i) < b.values.at(j)) i++;
+				else if(a.values.at(i) > b.values.at(j)) j++;
+				else { chunk.values.append(a.values.at(i)); i++; j++; }
+			}
+			chunk.cardinality = chunk.values.size();
+		} else if(!a.isDense() || !b.isDense()) {
+			//riedky blok filtrujeme podla husteho
+			const Chunk &sparse = a.isDense() ? b : a;
+			const Chunk &dense = a.isDense() ? a : b;
+			for(int i = 0; i < sparse.values.size(); i++)
+				if(dense.contains(sparse.values.at(i))) chunk.values.append(sparse.values.at(i));
+			chunk.cardinality = chunk.values.size();
+		} else {
+			QVector<quint64> bits(CHUNK_WORDS);
+			for(int i = 0; i < CHUNK_WORDS; i++)
+				bits[i] = a.bits.at(i) & b.bits.at(i);
+			chunk = fromBits(bits);
+		}
+
+		if(chunk.cardinality > 0)
+			result.chunks.insert(it.key(), chunk);
+	}
+
+	return result;
+}
+
+Data::Bitmap Data::Bitmap::operator|(const Bitmap &other) const
+{
+	Bitmap result = *this;
+
+	for(QMap<qlonglong, Chunk>::const_iterator otherIt = other.chunks.constBegin(); otherIt != other.chunks.constEnd(); ++otherIt) {
+		QMap<qlonglong, Chunk>::iterator it = result.chunks.find(otherIt.key());
+		if(it == result.chunks.end()) {
+			result.chunks.insert(otherIt.key(), otherIt.value());
+			continue;
+		}
+
+		const Chunk &a = it.value();
+		const Chunk &b = otherIt.value();
+		Chunk chunk;
+
+		if(!a.isDense() && !b.isDense()) {
+			int i = 0, j = 0;
+			chunk.values.reserve(a.values.size() + b.values.size());
+			while(i < a.values.size() || j < b.values.size()) {
+				if(j == b.values.size() || (i < a.values.size() && a.values.at(i) < b.values.at(j))) chunk.values.append(a.values.at(i++));
+				else if(i == a.values.size() || b.values.at(j) < a.values.at(i)) chunk.values.append(b.values.at(j++));
+				else { chunk.values.append(a.values.at(i)); i++; j++; }
+			}
+			chunk.cardinality = chunk.values.size();
+			chunk.normalize();
+		} else {
+			QVector<quint64> bits = a.denseBits();
+			QVector<quint64> otherBits = b.denseBits();
+			for(int i = 0; i < CHUNK_WORDS; i++)
+				bits[i] |= otherBits.at(i);
+			chunk = fromBits(bits);
+		}
+
+		it.value() = chunk;
+	}
+
+	return result;
+}
+
+Data::Bitmap Data::Bitmap::andNot(const Bitmap &other) const
+{
+	Bitmap result;
+
+	for(QMap<qlonglong, Chunk>::const_iterator it = chunks.constBegin(); it != chunks.constEnd(); ++it) {
+		QMap<qlonglong, Chunk>::const_iterator otherIt = other.chunks.constFind(it.key());
+		if(otherIt == other.chunks.constEnd()) {
+			result.chunks.insert(it.key(), it.value());
+			continue;
+		}
+
+		const Chunk &a = it.value();
+		const Chunk &b = otherIt.value();
+		Chunk chunk;
+
+		if(!a.isDense()) {
+			for(int i = 0; i < a.values.size(); i++)
+				if(!b.contains(a.values.at(i))) chunk.values.append(a.values.at(i));
+			chunk.cardinality = chunk.values.size();
+		} else {
+			QVector<quint64> bits = a.bits;
+			QVector<quint64> otherBits = b.denseBits();
+			for(int i = 0; i < CHUNK_WORDS; i++)
+				bits[i] &= ~otherBits.at(i);
+			chunk = fromBits(bits);
+		}
+
+		if(chunk.cardinality > 0)
+			result.chunks.insert(it.key(), chunk);
+	}
+
+	return result;
+}
+
+QList<qlonglong> Data::Bitmap::toList() const
+{
+	QList<qlonglong> ids;
+	ids.reserve(count());
+
+	for(QMap<qlonglong, Chunk>::const_iterator it = chunks.constBegin(); it != chunks.constEnd(); ++it) {
+		qlonglong base = it.key() << CHUNK_BITS;
+		const Chunk &chunk = it.value();
+
+		if(!chunk.isDense()) {
+			for(int i = 0; i < chunk.values.size(); i++)
+				ids.append(base + chunk.values.at(i));
+		} else {
+			for(int word = 0; word < CHUNK_WORDS; word++) {
+				quint64 w = chunk.bits.at(word);
+				for(int bit = 0; w != 0; bit++, w >>= 1) {
+					if(w & 1) ids.append(base + (word << 6) + bit);
+				}
+			}
+		}
+	}
+
+	return ids;
+}
@@ -35,20 +35,23 @@ Data::Edge::Edge(qlonglong id, QString name, Data::Graph* graph, osg::ref_ptr<Da
 Data::Edge::~Edge(void)
 {
     this->graph = NULL;
-	if(this->srcNode!=NULL) {
-		this->srcNode->removeEdge(this);
-		this->srcNode = NULL;
-	}
-	
-	if(this->dstNode!=NULL) {
-		this->dstNode->removeEdge(this);
-		this->dstNode = NULL;
-	}
+	//uzly hranu uz nedrzia (inak by nebola rusena), len uvolnime referencie na ne
+	this->srcNode = NULL;
+	this->dstNode = NULL;
 	
     this->type = NULL;
     this->appConf = NULL;
 }
 
+QString Data::Edge::getName() const
+{
+	//odvodene meno nedrzime v pamati, skladame ho az pri pouziti
+	if(name.isNull())
+		return srcNode->getName() + dstNode->getName();
+
+	return name;
+}
+
 void Data::Edge::linkNodes(QMap<qlonglong, osg::ref_ptr<Data::Edge> > *edges)
 {
     edges->insert(this->id, this);
@@ -58,10 +61,9 @@ void Data::Edge::linkNodes(QMap<qlonglong, osg::ref_ptr<Data::Edge> > *edges)
 
 void Data::Edge::unlinkNodes()
 {
+	//uzly hrany nemenime, snapshoty a vlakno layoutu ich mozu este citat - uvolnia sa az so zanikom hrany
 	this->dstNode->removeEdge(this);
 	this->srcNode->removeEdge(this);
-	this->srcNode = NULL;
-	this->dstNode = NULL;
 }
 
 void Data::Edge::unlinkNodesAndRemoveFromGraph() {
@@ -3,11 +3,16 @@
  * Projekt 3DVisual
  */
 #include "Data/Graph.h"
+#include "Data/GraphCommand.h"
 #include "Data/GraphLayout.h"
+#include "Model/GraphLayoutWriter.h"
 #include "Layout/ShapeGetter_Sphere_AroundNode.h"
+#include <QMutexLocker>
 #include <QSharedPointer>
+#include <QtConcurrentRun>
 
 Data::Graph::Graph(qlonglong graph_id, QString name, QSqlDatabase* conn, QMap<qlonglong,osg::ref_ptr<Data::Node> > *nodes, QMap<qlonglong,osg::ref_ptr<Data::Edge> > *edges,QMap<qlonglong,osg::ref_ptr<Data::Node> > *metaNodes, QMap<qlonglong,osg::ref_ptr<Data::Edge> > *metaEdges, QMap<qlonglong,Data::Type*> *types)
+	: structureMutex(QMutex::Recursive)
 {
     //tento konstruktor je uz zastaraly a neda sa realne pouzit - uzly musia mat priradeny graph, ktory sa prave vytvarat, rovnako edge, type, metatype (ten musi mat naviac aj layout, ktory opat musi mat graph)
     this->inDB = false;
@@ -43,6 +48,15 @@ Data::Graph::Graph(qlonglong graph_id, QString name, QSqlDatabase* conn, QMap<ql
 	this->layout_id_counter = 0; //POZOR toto asi treba inak poriesit, teraz to predpoklada ze ziadne layouty nemame co je spravne, lenze bacha na metatypy, ktore layout mat musia !
 
 	this->frozen = false;
+	this->version = 0;
+	this->bulkInsert = false;
+	this->bulkInsertDepth = 0;
+	this->bulkNameChanged = false;
+	this->bulkNodesCommitted = 0;
+	this->bulkEdgesCommitted = 0;
+	this->bulkNestedNodeType = NULL;
+	this->bulkNodeScale = 0;
+	this->bulkEdgeScale = 0;
 	
 	this->typesByName = new QMultiMap<QString, Data::Type*>();
 	
@@ -54,6 +68,7 @@ Data::Graph::Graph(qlonglong graph_id, QString name, QSqlDatabase* conn, QMap<ql
 }
 
 Data::Graph::Graph(qlonglong graph_id, QString name, qlonglong layout_id_counter, qlonglong ele_id_counter, QSqlDatabase* conn)
+	: structureMutex(QMutex::Recursive)
 {
     this->inDB = false;
 
@@ -70,11 +85,24 @@ Data::Graph::Graph(qlonglong graph_id, QString name, qlonglong layout_id_counter
     this->metaEdges = new QMap<qlonglong,osg::ref_ptr<Data::Edge> >();
     this->metaNodes = new QMap<qlonglong,osg::ref_ptr<Data::Node> >();
     this->frozen = false;
+    this->version = 0;
+    this->bulkInsert = false;
+    this->bulkInsertDepth = 0;
+    this->bulkNameChanged = false;
+    this->bulkNodesCommitted = 0;
+    this->bulkEdgesCommitted = 0;
+    this->bulkNestedNodeType = NULL;
+    this->bulkNodeScale = 0;
+    this->bulkEdgeScale = 0;
     this->typesByName = new QMultiMap<QString, Data::Type*>();
 }
 
 Data::Graph::~Graph(void)
 {
+	//neaplikovane prikazy zahodime
+	qDeleteAll(this->commands);
+	this->commands.clear();
+
 	//uvolnime vsetky Nodes, Edges, metaNodes, metaEdges... su cez osg::ref_ptr takze staci clearnut
 	this->nodes->clear();
 	delete this->nodes;
@@ -141,9 +169,21 @@ Data::Graph::~Graph(void)
 
 bool Data::Graph::saveGraphToDB(QSqlDatabase* conn, Data::Graph * graph)
 {
-	//ukladame cely graf do DB
-	if(Model::NodeDAO::addNodesToDB(conn, graph->nodes) 
-		&& Model::EdgeDAO::addEdgesToDB(conn, graph->edges))
+	//ukladame cely graf do DB (konzistentnu verziu, graf sa medzitym moze menit)
+	QSharedPointer<Data::GraphSnapshot> snapshot = graph->getSnapshot();
+	QMap<qlonglong, osg::ref_ptr<Data::Node> > nodes = snapshot->getNodes();
+	QMap<qlonglong, osg::ref_ptr<Data::Edge> > edges = snapshot->getEdges();
+
+	//cely graf ukladame v jednej transakcii, nie kazdy riadok zvlast
+	if(conn==NULL || !conn->isOpen() || !conn->transaction())
+	{
+		qDebug() << "[Data::Graph::saveGraphToDB] Could not start transaction.";
+		return false;
+	}
+
+	if(Model::NodeDAO::addNodesToDB(conn, &nodes) 
+		&& Model::EdgeDAO::addEdgesToDB(conn, &edges)
+		&& conn->commit())
 	{
 		//uspesne ulozenie do DB
 		qDebug() << "[Data::Graph::saveGraphToDB] Graph was saved to DB.";
@@ -152,6 +192,7 @@ bool Data::Graph::saveGraphToDB(QSqlDatabase* conn, Data::Graph * graph)
 	else
 	{
 		//neuspesne ulozenie do DB
+		conn->rollback();
 		qDebug() << "[Data::Graph::saveGraphToDB] Graph wasn't saved to DB.";
 		return false;
 	}
@@ -161,29 +202,16 @@ bool Data::Graph::saveGraphToDB(QSqlDatabase* conn, Data::Graph * graph)
 
 bool Data::Graph::saveLayoutToDB(QSqlDatabase* conn, Data::Graph * graph)
 {
-	//ukladame leyout do DB
-	QMap<qlonglong, qlonglong> newMetaNodeID;
-	QMap<qlonglong, qlonglong> newMetaEdgeID;
-
-	newMetaNodeID = Model::NodeDAO::getNewMetaNodesId(conn, graph->getId(), graph->metaNodes);
-	newMetaEdgeID = Model::EdgeDAO::getNewMetaEdgesId(conn, graph->getId(), graph->metaEdges);
-
-	if(Model::NodeDAO::addMetaNodesToDB(conn, graph->metaNodes, graph->selectedLayout, newMetaNodeID) 
-		&& Model::NodeDAO::addNodesPositionsToDB(conn, graph->metaNodes, graph->selectedLayout, newMetaNodeID, true)
-		&& Model::NodeDAO::addNodesColorToDB(conn, graph->metaNodes, graph->selectedLayout, newMetaNodeID, true)
-		&& Model::NodeDAO::addNodesPositionsToDB(conn, graph->nodes, graph->selectedLayout, newMetaNodeID, false)
-		&& Model::NodeDAO::addNodesColorToDB(conn, graph->nodes, graph->selectedLayout, newMetaNodeID, false)
-		&& Model::EdgeDAO::addMetaEdgesToDB(conn, graph->metaEdges, graph->selectedLayout, newMetaNodeID, newMetaEdgeID)
-		&& Model::EdgeDAO::addEdgesColorToDB(conn, graph->edges, graph->selectedLayout, newMetaNodeID, newMetaEdgeID, false)
-		&& Model::EdgeDAO::addEdgesColorToDB(conn, graph->metaEdges, graph->selectedLayout, newMetaNodeID, newMetaEdgeID, true)
-		&& Model::NodeDAO::addNodesScaleToDB(conn, graph->nodes, graph->selectedLayout, newMetaNodeID, false, graph->getNodeScale())
-		&& Model::NodeDAO::addNodesScaleToDB(conn, graph->metaNodes, graph->selectedLayout, newMetaNodeID, true, graph->getNodeScale())
-		&& Model::EdgeDAO::addEdgesScaleToDB(conn, graph->edges, graph->selectedLayout, newMetaNodeID, newMetaEdgeID, false, graph->getEdgeScale())
-		&& Model::EdgeDAO::addEdgesScaleToDB(conn, graph->metaEdges, graph->selectedLayout, newMetaNodeID, newMetaEdgeID, true, graph->getEdgeScale())
-		&& Model::NodeDAO::addNodesMaskToDB(conn, graph->nodes, graph->selectedLayout, newMetaNodeID, false)
-		&& Model::NodeDAO::addNodesMaskToDB(conn, graph->metaNodes, graph->selectedLayout, newMetaNodeID, true)
-		&& Model::NodeDAO::addNodesParentToDB(conn, graph->nodes, graph->selectedLayout, newMetaNodeID, false)
-		&& Model::NodeDAO::addNodesParentToDB(conn, graph->metaNodes, graph->selectedLayout, newMetaNodeID, true))
+	if(graph->selectedLayout == NULL)
+	{
+		qDebug() << "[Data::Graph::saveLayoutToDB] Graph has no selected layout.";
+		return false;
+	}
+
+	//ukladame leyout do DB - vsetky tabulky layoutu jednym prechodom cez graf v jednej transakcii
+	Model::GraphLayoutWriter writer(graph, graph->selectedLayout);
+
+	if(writer.write(conn))
 	{
 		//uspesne ulozenie do DB
 		qDebug() << "[Data::Graph::saveLayoutToDB] Layout was saved to DB.";
@@ -195,8 +223,6 @@ bool Data::Graph::saveLayoutToDB(QSqlDatabase* conn, Data::Graph * graph)
 		qDebug() << "[Data::Graph::saveLayoutToDB] Layout wasn't saved to DB.";
 		return false;
 	}
-		
-	return false;
 }
 
 Data::GraphLayout* Data::Graph::addLayout(QString layout_name)
@@ -257,6 +283,13 @@ bool Data::Graph::removeLayout(Data::GraphLayout* layout)
 
 QString Data::Graph::setName(QString name)
 {
+	//pocas hromadneho vkladania meno do DB ulozime az pri commitBulkInsert
+	if(this->bulkInsert) {
+		this->name = name;
+		this->bulkNameChanged = true;
+		return this->name;
+	}
+
 	//nastavyme nazov grafu
     QString newName = Model::GraphDAO::setName(name,this,this->conn);
     
@@ -279,33 +312,11 @@ bool Data::Graph::isInSameGraph(Data::Node * nodeA, Data::Node * nodeB)
 
 osg::ref_ptr<Data::Node> Data::Graph::addNode(QString name, Data::Type* type, osg::Vec3f position)
 {
-	Data::Type* metype;
-
-	QList<Data::Type*> mtypes = getTypesByName(Data::GraphLayout::NESTED_NODE_TYPE);
+	QMutexLocker locker(&this->structureMutex);
 
 	if(this->parent_id.count()>0)
 	{
-
-		if(mtypes.isEmpty())
-		{
-			//pridame metatype ak este nie je vytvoreny
-			QMap<QString, QString> *settings = new QMap<QString, QString>;
-
-				settings->insert("scale", Util::ApplicationConfig::get()->getValue("Viewer.Textures.DefaultNodeScale"));
-				settings->insert("textureFile", Util::ApplicationConfig::get()->getValue("Viewer.Textures.Node"));
-				settings->insert("color.R", "1");
-				settings->insert("color.G", "0");
-				settings->insert("color.B", "0");
-				settings->insert("color.A", "1");
-
-			metype = this->addType(Data::GraphLayout::NESTED_NODE_TYPE, settings);
-		}
-		else
-		{
-			metype = mtypes[0];
-		}
-
-		type = metype;
+		type = this->getNestedNodeType();
 	}
 
     osg::ref_ptr<Data::Node> node = new Data::Node(this->incEleIdCounter(), name, type, this->getNodeScale(), this, position);
@@ -322,6 +333,13 @@ osg::ref_ptr<Data::Node> Data::Graph::addNode(QString name, Data::Type* type, os
 	//pridame vnoreny uzol
 	this->addNestedNode(node);
 
+	if(this->bulkInsert)
+	{
+		//zoznamy uzlov doplnime az pri commitBulkInsert
+		this->bulkNodes.append(node);
+		return node;
+	}
+
     this->newNodes.insert(node->getId(),node);
     if(type!=NULL && type->isMeta()) {
 		//pridame meta uzol do zoznamu
@@ -332,6 +350,8 @@ osg::ref_ptr<Data::Node> Data::Graph::addNode(QString name, Data::Type* type, os
         this->nodes->insert(node->getId(),node);
         this->nodesByType.insert(type->getId(),node);
     }
+	this->nodeIndex.addNode(node);
+	this->structureChanged();
 
 	//pridame metatyp pre vnoreny graf
 	if(this->parent_id.count()>0)
@@ -344,19 +364,31 @@ osg::ref_ptr<Data::Node> Data::Graph::addNode(QString name, Data::Type* type, os
 
 osg::ref_ptr<Data::Node> Data::Graph::addNode(qlonglong id, QString name, Data::Type* type, osg::Vec3f position)
 {
+	QMutexLocker locker(&this->structureMutex);
+
 	//vytvorime novy objekt uzla
     osg::ref_ptr<Data::Node> node = new Data::Node(id, name, type, this->getNodeScale(), this, position);
 
-    this->newNodes.insert(node->getId(),node);
-	
-	//podla typu ho priradime danemu zoznamu
-    if(type!=NULL && type->isMeta()) {
-        this->metaNodes->insert(node->getId(),node);
-        this->metaNodesByType.insert(type->getId(),node);
-    } else { 
-        this->nodes->insert(node->getId(),node);
-        this->nodesByType.insert(type->getId(),node);
-    }
+	if(this->bulkInsert)
+	{
+		//zoznamy uzlov doplnime az pri commitBulkInsert
+		this->bulkNodes.append(node);
+	}
+	else
+	{
+		this->newNodes.insert(node->getId(),node);
+
+		//podla typu ho priradime danemu zoznamu
+		if(type!=NULL && type->isMeta()) {
+			this->metaNodes->insert(node->getId(),node);
+			this->metaNodesByType.insert(type->getId(),node);
+		} else { 
+			this->nodes->insert(node->getId(),node);
+			this->nodesByType.insert(type->getId(),node);
+		}
+		this->nodeIndex.addNode(node);
+		this->structureChanged();
+	}
 
 	//pridame vnoreny uzol do zoznamu
 	this->addNestedNode(node);
@@ -369,8 +401,229 @@ osg::ref_ptr<Data::Node> Data::Graph::addNode(qlonglong id, QString name, Data::
     return node;
 }
 
+void Data::Graph::beginBulkInsert(qlonglong expectedNodes, qlonglong expectedEdges)
+{
+	QMutexLocker locker(&this->structureMutex);
+
+	//vnorene hromadne vkladanie, zoznamy vytvori az vonkajsi commitBulkInsert
+	if(this->bulkInsert) {
+		this->bulkInsertDepth++;
+		this->bulkNodes.reserve(this->bulkNodes.size() + (int) expectedNodes);
+		this->bulkEdges.reserve(this->bulkEdges.size() + (int) expectedEdges);
+		this->bulkEdgePairs.reserve(this->bulkEdgePairs.size() + (int) expectedEdges);
+		return;
+	}
+
+	//zacneme hromadne vkladanie uzlov a hran, konfiguraciu a typ vnorenych uzlov nacitame len raz pre cele vkladanie
+	this->bulkNodeScale = Util::ApplicationConfig::get()->getValue("Viewer.Textures.DefaultNodeScale").toFloat();
+	this->bulkEdgeScale = Util::ApplicationConfig::get()->getValue("Viewer.Textures.EdgeScale").toFloat();
+	this->bulkNestedNodeType = NULL;
+
+	this->bulkNodes.reserve(this->bulkNodes.size() + (int) expectedNodes);
+	this->bulkEdges.reserve(this->bulkEdges.size() + (int) expectedEdges);
+	this->bulkEdgePairs.reserve((int) expectedEdges);
+	this->bulkNodesCommitted = 0;
+	this->bulkEdgesCommitted = 0;
+
+	this->bulkInsertDepth = 1;
+	this->bulkInsert = true;
+}
+
+void Data::Graph::commitBulkInsert()
+{
+	QMutexLocker locker(&this->structureMutex);
+
+	//ukoncime hromadne vkladanie a vytvorime vsetky zoznamy naraz
+	if(!this->bulkInsert || --this->bulkInsertDepth > 0) {
+		return;
+	}
+
+	this->bulkInsert = false;
+	this->commitBulkElements();
+
+	this->bulkNodes.clear();
+	this->bulkEdges.clear();
+	this->bulkEdgePairs.clear();
+	this->bulkNodesCommitted = 0;
+	this->bulkEdgesCommitted = 0;
+	this->bulkNestedNodeType = NULL;
+
+	//meno nastavene pocas hromadneho vkladania ulozime do DB
+	if(this->bulkNameChanged) {
+		this->bulkNameChanged = false;
+		this->setName(this->name);
+	}
+}
+
+QList<osg::ref_ptr<Data::Node> > Data::Graph::flushBulkInsert()
+{
+	QMutexLocker locker(&this->structureMutex);
+
+	QList<osg::ref_ptr<Data::Node> > committedNodes;
+
+	//do zoznamov zaradime uzly a hrany pridane od posledneho vytvarania zoznamov
+	if(!this->bulkInsert || (this->bulkNodesCommitted == this->bulkNodes.size() && this->bulkEdgesCommitted == this->bulkEdges.size() && this->bulkReplacedEdges.isEmpty())) {
+		return committedNodes;
+	}
+
+	for(int i = this->bulkNodesCommitted; i < this->bulkNodes.size(); i++) {
+		committedNodes.append(this->bulkNodes.at(i));
+	}
+
+	this->commitBulkElements();
+
+	return committedNodes;
+}
+
+void Data::Graph::commitBulkElements()
+{
+	//hrany zaradene do zoznamov, ktore boli medzitym nahradene multihranou, odstranime
+	if(!this->bulkReplacedEdges.isEmpty()) {
+		this->removeEdgesFromLists(this->bulkReplacedEdges);
+		this->bulkReplacedEdges.clear();
+	}
+
+	//zoznamy uzlov a hran su na sebe nezavisle, preto ich vytvarame paralelne
+	QFuture<void> nodesCommitted = QtConcurrent::run(this, &Data::Graph::commitBulkNodes);
+	this->commitBulkEdges();
+	nodesCommitted.waitForFinished();
+
+	this->bulkNodesCommitted = this->bulkNodes.size();
+	this->bulkEdgesCommitted = this->bulkEdges.size();
+	this->structureChanged();
+}
+
+void Data::Graph::commitBulkNodes()
+{
+	//uzly pridane pocas hromadneho vkladania priradime zoznamom podla typu
+	for(int i = this->bulkNodesCommitted; i < this->bulkNodes.size(); i++) {
+		const osg::ref_ptr<Data::Node> & node = this->bulkNodes.at(i);
+		Data::Type* type = node->getType();
+
+		this->newNodes.insert(node->getId(),node);
+		if(type!=NULL && type->isMeta()) {
+			this->metaNodes->insert(node->getId(),node);
+			this->metaNodesByType.insert(type->getId(),node);
+		} else {
+			this->nodes->insert(node->getId(),node);
+			this->nodesByType.insert(type->getId(),node);
+		}
+		this->nodeIndex.addNode(node);
+	}
+}
+
+void Data::Graph::commitBulkEdges()
+{
+	//hrany pridane pocas hromadneho vkladania prepojime s uzlami a priradime zoznamom
+	for(int i = this->bulkEdgesCommitted; i < this->bulkEdges.size(); i++) {
+		const osg::ref_ptr<Data::Edge> & edge = this->bulkEdges.at(i);
+
+		//hrana bola nahradena multihranou
+		if(edge == NULL) continue;
+
+		Data::Type* type = edge->getType();
+		Data::Type* srcType = edge->getSrcNode()->getType();
+		Data::Type* dstType = edge->getDstNode()->getType();
+
+		edge->linkNodes(&this->newEdges);
+		if((type!=NULL && type->isMeta()) || (srcType!=NULL && srcType->isMeta()) || (dstType!=NULL && dstType->isMeta())) {
+			//ak je type meta, alebo je meta jeden z uzlov (ma type meta)
+			this->metaEdges->insert(edge->getId(),edge);
+			this->metaEdgesByType.insert(type->getId(),edge);
+		} else {
+			this->edges->insert(edge->getId(),edge);
+			this->edgesByType.insert(type->getId(),edge);
+		}
+	}
+}
+
+bool Data::Graph::addBulkMultiEdge(QString name, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type* type, bool isOriented)
+{
+	//paralelne hrany hladame v indexe dvojic uzlov, nie prechadzanim hran uzla
+	QPair<qlonglong, qlonglong> pair = (srcNode->getId() < dstNode->getId()) ? qMakePair(srcNode->getId(), dstNode->getId()) : qMakePair(dstNode->getId(), srcNode->getId());
+	QHash<QPair<qlonglong, qlonglong>, int>::iterator it = this->bulkEdgePairs.find(pair);
+
+	if(it != this->bulkEdgePairs.end()) {
+		if(it.value() >= 0) {
+			//povodnu hranu medzi uzlami nahradime multihranou
+			osg::ref_ptr<Data::Edge> replacedEdge = this->bulkEdges.at(it.value());
+			this->bulkEdges[it.value()] = NULL;
+
+			//hrana uz mohla byt zaradena do zoznamov, odstranime ju pri ich dalsom vytvarani
+			if(it.value() < this->bulkEdgesCommitted) {
+				this->bulkReplacedEdges.append(replacedEdge);
+			}
+			it.value() = -1;
+
+			this->addMultiEdge(replacedEdge->getName(), replacedEdge->getSrcNode(), replacedEdge->getDstNode(), replacedEdge->getType(), replacedEdge->isOriented(), NULL);
+		}
+
+		this->addMultiEdge(name, srcNode, dstNode, type, isOriented, NULL);
+		return true;
+	}
+
+	//uzol mohol mat hrany este pred zacatim hromadneho vkladania
+	if(!srcNode->getEdges()->isEmpty() && this->isParralel(srcNode, dstNode)) {
+		this->bulkEdgePairs.insert(pair, -1);
+		this->addMultiEdge(name, srcNode, dstNode, type, isOriented, NULL);
+		return true;
+	}
+
+	return false;
+}
+
+void Data::Graph::addBulkEdge(osg::ref_ptr<Data::Edge> edge)
+{
+	//zapamatame si hranu a dvojicu uzlov, ktore spaja
+	qlonglong srcId = edge->getSrcNode()->getId();
+	qlonglong dstId = edge->getDstNode()->getId();
+
+	this->bulkEdgePairs.insert((srcId < dstId) ? qMakePair(srcId, dstId) : qMakePair(dstId, srcId), this->bulkEdges.size());
+	this->bulkEdges.append(edge);
+}
+
+Data::Type* Data::Graph::getNestedNodeType()
+{
+	QMutexLocker locker(&this->structureMutex);
+	//typ vnorenych uzlov pocas hromadneho vkladania nehladame pre kazdy uzol
+	if(this->bulkInsert && this->bulkNestedNodeType != NULL) {
+		return this->bulkNestedNodeType;
+	}
+
+	Data::Type* metype;
+
+	QList<Data::Type*> mtypes = getTypesByName(Data::GraphLayout::NESTED_NODE_TYPE);
+
+	if(mtypes.isEmpty())
+	{
+		//pridame metatype ak este nie je vytvoreny
+		QMap<QString, QString> *settings = new QMap<QString, QString>;
+
+			settings->insert("scale", Util::ApplicationConfig::get()->getValue("Viewer.Textures.DefaultNodeScale"));
+			settings->insert("textureFile", Util::ApplicationConfig::get()->getValue("Viewer.Textures.Node"));
+			settings->insert("color.R", "1");
+			settings->insert("color.G", "0");
+			settings->insert("color.B", "0");
+			settings->insert("color.A", "1");
+
+		metype = this->addType(Data::GraphLayout::NESTED_NODE_TYPE, settings);
+	}
+	else
+	{
+		metype = mtypes[0];
+	}
+
+	if(this->bulkInsert) {
+		this->bulkNestedNodeType = metype;
+	}
+
+	return metype;
+}
+
 osg::ref_ptr<Data::Node> Data::Graph::mergeNodes(QLinkedList<osg::ref_ptr<Data::Node> > * selectedNodes, osg::Vec3f position)
 {
+	QMutexLocker locker(&this->structureMutex);
+
 	//vyratame velkost zluceneho uzla podla velkosti zlucovanych uzlov
 	float scale = this->getNodeScale() + (selectedNodes->count() / 2);
 
@@ -378,128 +631,168 @@ osg::ref_ptr<Data::Node> Data::Graph::mergeNodes(QLinkedList<osg::ref_ptr<Data::
 	osg::ref_ptr<Data::Node> mergedNode = new Data::Node(this->incEleIdCounter(), "mergedNode", this->getNodeMetaType(), scale, this, position);
 	mergedNode->setColor(osg::Vec4(0, 0, 1, 1));
 
-	QList<qlonglong> connectedNodes;
+	//zlucovane uzly bez duplicit, zapamatame si ich v skupine zluceneho uzla
+	QList<osg::ref_ptr<Data::Node> > mergedNodes;
+	QSet<qlonglong> mergedIds;
 
 	QLinkedList<osg::ref_ptr<Data::Node> >::const_iterator iAdd = selectedNodes->constBegin();
-
-	//pridavame do zluceneho uzla zlucovane uzly
 	while (iAdd != selectedNodes->constEnd()) 
 	{
-		(*iAdd)->setCurrentPosition(mergedNode->getCurrentPosition());
-		(*iAdd)->setFixed(false);
-		(*iAdd)->setNodeMask(0);
-
-		Data::Edge * e = this->addEdge("mergedEdge", (*iAdd), mergedNode, this->getEdgeMetaType(), true);
-		e->setScale(0);
+		if(!mergedIds.contains((*iAdd)->getId()))
+		{
+			mergedIds.insert((*iAdd)->getId());
+			mergedNodes.append(*iAdd);
 
-		connectedNodes << (*iAdd)->getId();
+			(*iAdd)->setCurrentPosition(mergedNode->getCurrentPosition());
+			(*iAdd)->setFixed(false);
+			(*iAdd)->setNodeMask(0);
+		}
 
 		++iAdd;
 	}
 
-	//spajame povodne uzly s novovytvorenym zlucenym uzlom
-	QLinkedList<osg::ref_ptr<Data::Node> >::const_iterator i = selectedNodes->constBegin();
-	while (i != selectedNodes->constEnd()) 
+	//skryjeme hrany zlucovanych uzlov a najdeme ich viditelnych susedov, kazdeho len raz
+	QList<osg::ref_ptr<Data::Node> > connectedNodes;
+	QSet<qlonglong> connectedIds;
+
+	for(int i = 0; i < mergedNodes.size(); i++)
 	{
-		QMap< qlonglong,osg::ref_ptr<Data::Edge> >::const_iterator iedge = (*i)->getEdges()->constBegin();
-		while (iedge != (*i)->getEdges()->constEnd()) 
+		QMap< qlonglong,osg::ref_ptr<Data::Edge> >::const_iterator iedge = mergedNodes.at(i)->getEdges()->constBegin();
+		while (iedge != mergedNodes.at(i)->getEdges()->constEnd()) 
 		{
-			iedge.value().get()->setScale(0);
-			osg::ref_ptr<Data::Node> srcNode = iedge.value().get()->getSrcNode();
-			osg::ref_ptr<Data::Node> dstNode = iedge.value().get()->getDstNode();
-			osg::ref_ptr<Data::Node> connectNode;
+			iedge.value()->setScale(0);
 
-			if (dstNode->getId() == (*i)->getId()) {
-				connectNode = srcNode;
-			}
-			else {
-				connectNode = dstNode;
+			osg::ref_ptr<Data::Node> connectNode = iedge.value()->getSrcNode();
+			if (connectNode->getId() == mergedNodes.at(i)->getId()) {
+				connectNode = iedge.value()->getDstNode();
 			}
 
-			if(!connectedNodes.contains(connectNode->getId()) && connectNode->getNodeMask() != 0)
+			if(!mergedIds.contains(connectNode->getId()) && !connectedIds.contains(connectNode->getId()) && connectNode->getNodeMask() != 0)
 			{
-				Data::Edge * newEdgeSrc = this->addEdge("mergedEdge", connectNode, mergedNode, this->getEdgeMetaType(), true);
-				connectedNodes << connectNode->getId();
+				connectedIds.insert(connectNode->getId());
+				connectedNodes.append(connectNode);
 			}
 
 			++iedge;
 		}
+	}
 
-		++i;
+	//spajame susedov so zlucenym uzlom, zluceny uzol je novy, preto jeho hrany nemozu byt paralelne (netreba isParralel)
+	Data::Type * edgeType = this->getEdgeMetaType();
+	float edgeScale = this->getEdgeScale();
+
+	for(int i = 0; i < connectedNodes.size(); i++)
+	{
+		osg::ref_ptr<Data::Edge> edge = new Data::Edge(this->incEleIdCounter(), "mergedEdge", this, connectedNodes.at(i), mergedNode, edgeType, true, edgeScale);
+		edge->linkNodes(&this->newEdges);
+		edge->linkNodes(this->metaEdges);
+		this->metaEdgesByType.insert(edgeType->getId(), edge);
 	}
 
 	//pridame zluceny uzol medzi metauzly
 	this->metaNodes->insert(mergedNode->getId(), mergedNode);
-	this->metaNodesByType.insert(mergedNode->getId(), mergedNode);
+	this->metaNodesByType.insert(mergedNode->getType()->getId(), mergedNode);
+	this->nodeIndex.addNode(mergedNode);
+	this->mergedGroups.insert(mergedNode->getId(), mergedNodes);
+	this->structureChanged();
 
 	return mergedNode;
 }
 
 void Data::Graph::separateNodes(QLinkedList<osg::ref_ptr<Data::Node> > * selectedNodes)
 {
+	QMutexLocker locker(&this->structureMutex);
+
+	QList<osg::ref_ptr<Data::Node> > separatedNodes;
+	QList<osg::ref_ptr<Data::Node> > restoredNodes;
+
 	QLinkedList<osg::ref_ptr<Data::Node> >::const_iterator i = selectedNodes->constBegin();
 
-	//zo zluceneho uzla extrahujeme v nom zahrnute uzly
+	//zo zluceneho uzla extrahujeme v nom zahrnute uzly podla jeho skupiny
 	while (i != selectedNodes->constEnd()) 
 	{
-		//TODO zatial merged node identifikujeme len podla nazvu nodu - "mergedNode" - treba dokoncit
-		if ((*i)->getType()->isMeta() && (*i)->getName() == "mergedNode") 
+		QHash<qlonglong, QList<osg::ref_ptr<Data::Node> > >::iterator group = this->mergedGroups.find((*i)->getId());
+
+		if (group != this->mergedGroups.end()) 
 		{
-			//najdeme vsetky uzly a zrusime mask
-			//najdeme vsetky hrany spojene s tymto uzlom a nastavime im scale
-			//nastavime poziciu na mergeNode a zrusime tento uzol
 			osg::Vec3f position = (*i)->getCurrentPosition();
 
-			QMap< qlonglong,osg::ref_ptr<Data::Edge> >::const_iterator iedge = (*i)->getEdges()->constBegin();
-			while (iedge != (*i)->getEdges()->constEnd()) 
+			for(int j = 0; j < group.value().size(); j++)
 			{
-				osg::ref_ptr<Data::Node> connectedNode;
-				float scale = this->getEdgeScale();
+				osg::ref_ptr<Data::Node> node = group.value().at(j);
 
-				//mergedEdge ide vzdy z povodneho nodu do mergedNodu
-				connectedNode = iedge.value().get()->getSrcNode();
+				//uzly medzitym odstranene z grafu vynechame
+				if(node->getNodeMask() != 0 || (!this->nodes->contains(node->getId()) && !this->metaNodes->contains(node->getId())))
+					continue;
 
-				//ak je node zamaskovany, tak ho odmaskujeme
-				if(connectedNode->getNodeMask() == 0)
-				{
-					connectedNode->setCurrentPosition(position);
-					connectedNode->setFixed(false);
-					connectedNode->setNodeMask(~0);
-
-					QMap< qlonglong,osg::ref_ptr<Data::Edge> >::const_iterator iedgeIn = connectedNode->getEdges()->constBegin();
-
-					//nastavujeme velkost hranam
-					while (iedgeIn != connectedNode->getEdges()->constEnd()) 
-					{
-						osg::ref_ptr<Data::Node> srcNode = iedgeIn.value().get()->getSrcNode();
-						osg::ref_ptr<Data::Node> dstNode = iedgeIn.value().get()->getDstNode();
-
-						if(iedgeIn.value().get()->getScale() == 0 && (srcNode->getNodeMask() != 0 && dstNode->getNodeMask() != 0))
-						{
-							//TODO - nastavime velkost hranam - vsetkym default - treba prerobit ak budu mat hrany inu velkost
-							iedgeIn.value().get()->setScale(scale);
-						}
-
-						++iedgeIn;
-					}
-				}
+				node->setCurrentPosition(position);
+				node->setFixed(false);
+				node->setNodeMask(~0);
+				restoredNodes.append(node);
+			}
 
-				//TODO - nastavime velkost hranam - vsetkym default - treba prerobit ak budu mat hrany inu velkost
-				iedge.value().get()->setScale(scale);
+			separatedNodes.append(*i);
+			this->mergedGroups.erase(group);
+		}
+
+		++i;
+	}
+
+	//hrany, ktore maju oba uzly viditelne, dostanu zakladnu velkost hran grafu
+	float scale = this->getEdgeScale();
 
-				++iedge;
+	for(int j = 0; j < restoredNodes.size(); j++)
+	{
+		QMap< qlonglong,osg::ref_ptr<Data::Edge> >::const_iterator iedge = restoredNodes.at(j)->getEdges()->constBegin();
+		while (iedge != restoredNodes.at(j)->getEdges()->constEnd()) 
+		{
+			if(iedge.value()->getScale() == 0 && iedge.value()->getSrcNode()->getNodeMask() != 0 && iedge.value()->getDstNode()->getNodeMask() != 0)
+			{
+				iedge.value()->setScale(scale);
 			}
 
-			this->removeNode((*i)); //zmaze uzol aj jeho hrany
+			++iedge;
 		}
-		++i;
 	}
 
+	//zlucene uzly odstranime naraz aj s ich hranami
+	this->removeNodes(separatedNodes);
+}
+
+bool Data::Graph::isMergedNode(qlonglong id)
+{
+	QMutexLocker locker(&this->structureMutex);
+
+	return this->mergedGroups.contains(id);
+}
+
+QList<osg::ref_ptr<Data::Node> > Data::Graph::getMergedNodes(qlonglong id)
+{
+	QMutexLocker locker(&this->structureMutex);
+
+	return this->mergedGroups.value(id);
+}
+
+QHash<qlonglong, QList<osg::ref_ptr<Data::Node> > > Data::Graph::getMergedGroups()
+{
+	QMutexLocker locker(&this->structureMutex);
+
+	return this->mergedGroups;
+}
+
+void Data::Graph::restoreMergedGroup(qlonglong id, const QList<osg::ref_ptr<Data::Node> > &mergedNodes)
+{
+	QMutexLocker locker(&this->structureMutex);
+
+	//skupinu ma len existujuci meta uzol
+	if(this->metaNodes->contains(id) && !mergedNodes.isEmpty())
+		this->mergedGroups.insert(id, mergedNodes);
 }
 
 
 void Data::Graph::addNestedNode(Data::Node * node)
 {
+	QMutexLocker locker(&this->structureMutex);
 	if(this->parent_id.count()>0)
 	{
 		//pridame vnoerny uzol do posledneho nacitaneho uzla len pri importe
@@ -510,6 +803,7 @@ void Data::Graph::addNestedNode(Data::Node * node)
 
 void Data::Graph::createNestedGraph(osg::ref_ptr<Data::Node> srcNode)
 {
+	QMutexLocker locker(&this->structureMutex);
 	//vytvorime vnoreny graf do posledneho nacitaneho uzla pri importe
 	this->parent_id.append(srcNode);
 	srcNode->setAsParentNode();
@@ -519,6 +813,7 @@ void Data::Graph::createNestedGraph(osg::ref_ptr<Data::Node> srcNode)
 
 void Data::Graph::closeNestedGraph()
 {
+	QMutexLocker locker(&this->structureMutex);
 	//ukoncime vytvaranie daneho vnoreneho grafu pri importe
 	QSharedPointer<Layout::ShapeGetter> shapeGetter (
 		new Layout::ShapeGetter_Sphere_AroundNode (
@@ -538,6 +833,7 @@ void Data::Graph::closeNestedGraph()
 
 bool Data::Graph::isNestedGraph()
 {
+	QMutexLocker locker(&this->structureMutex);
 	//urcenie ci je dany graf (this) vnoreny
 	if (this->parent_id.size()==0)
 	{
@@ -548,6 +844,26 @@ bool Data::Graph::isNestedGraph()
 
 osg::ref_ptr<Data::Edge> Data::Graph::addEdge(QString name, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type* type, bool isOriented) 
 {
+	QMutexLocker locker(&this->structureMutex);
+
+	if(this->bulkInsert)
+	{
+		if(this->addBulkMultiEdge(name, srcNode, dstNode, type, isOriented))
+		{
+			return NULL;
+		}
+
+		if(this->nestetSubGraphs.count()>0)
+		{
+			type = getNestedEdgeType();
+		}
+
+		//hranu s uzlami prepojime az pri commitBulkInsert
+		osg::ref_ptr<Data::Edge> edge = new Data::Edge(this->incEleIdCounter(), name, this, srcNode, dstNode, type, isOriented, getEdgeScale());
+		this->addBulkEdge(edge);
+		return edge;
+	}
+
 	if(isParralel(srcNode, dstNode))
 	{
 		//pridame multihranu fo grafu
@@ -573,7 +889,9 @@ osg::ref_ptr<Data::Edge> Data::Graph::addEdge(QString name, osg::ref_ptr<Data::N
 		} else
 		{
 			edge->linkNodes(this->edges);
+			this->edgesByType.insert(type->getId(),edge);
 		}
+		this->structureChanged();
 		return edge;
 	}
 
@@ -582,6 +900,21 @@ osg::ref_ptr<Data::Edge> Data::Graph::addEdge(QString name, osg::ref_ptr<Data::N
 
 osg::ref_ptr<Data::Edge> Data::Graph::addEdge(qlonglong id, QString name, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type* type, bool isOriented) 
 {
+	QMutexLocker locker(&this->structureMutex);
+
+	if(this->bulkInsert)
+	{
+		if(this->addBulkMultiEdge(name, srcNode, dstNode, type, isOriented))
+		{
+			return NULL;
+		}
+
+		//hranu s uzlami prepojime az pri commitBulkInsert
+		osg::ref_ptr<Data::Edge> edge = new Data::Edge(id, name, this, srcNode, dstNode, type, isOriented, getEdgeScale());
+		this->addBulkEdge(edge);
+		return edge;
+	}
+
 	if(isParralel(srcNode, dstNode))
 	{
 		//pridame multihranu do grafu
@@ -602,7 +935,9 @@ osg::ref_ptr<Data::Edge> Data::Graph::addEdge(qlonglong id, QString name, osg::r
 		} else
 		{
 			edge->linkNodes(this->edges);
+			this->edgesByType.insert(type->getId(),edge);
 		}
+		this->structureChanged();
 
 		return edge;
 	}
@@ -612,6 +947,7 @@ osg::ref_ptr<Data::Edge> Data::Graph::addEdge(qlonglong id, QString name, osg::r
 
 Data::Type* Data::Graph::getNestedEdgeType()
 {
+	QMutexLocker locker(&this->structureMutex);
 	Data::Type* metype;
 
 	//vraciame typ vnorenej hrany s nastavenymi parametrami
@@ -641,6 +977,7 @@ Data::Type* Data::Graph::getNestedEdgeType()
 
 Data::Type* Data::Graph::getNestedMetaEdgeType()
 {
+	QMutexLocker locker(&this->structureMutex);
 	Data::Type* metype;
 
 	//vraciame typ vnorenej meta hrany s nastavenymi parametrami
@@ -670,6 +1007,8 @@ Data::Type* Data::Graph::getNestedMetaEdgeType()
 
 void Data::Graph::addMultiEdge(QString name, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type* type, bool isOriented, osg::ref_ptr<Data::Edge> replacedSingleEdge)
 {
+	QMutexLocker locker(&this->structureMutex);
+
 	Data::Type* mtype;
 
 	//pridavame multihranu
@@ -727,19 +1066,29 @@ void Data::Graph::addMultiEdge(QString name, osg::ref_ptr<Data::Node> srcNode, o
 			}
 
 			osg::ref_ptr<Data::Edge> edge1 = new Data::Edge(this->incEleIdCounter(), name, this, srcNode, parallelNode, metype, isOriented, this->getEdgeScale());
-			edge1->linkNodes(this->edges);
-
-			this->edgesByType.insert(type->getId(),edge1);
-
 			osg::ref_ptr<Data::Edge> edge2 = new Data::Edge(this->incEleIdCounter(), name, this, parallelNode, dstNode, metype, isOriented, this->getEdgeScale());
-			edge2->linkNodes(this->edges);
 
-			this->edgesByType.insert(type->getId(),edge2);
+			if(this->bulkInsert)
+			{
+				//pomocne hrany s uzlami prepojime az pri vytvarani zoznamov
+				this->bulkEdges.append(edge1);
+				this->bulkEdges.append(edge2);
+			}
+			else
+			{
+				//pomocne hrany su v zozname podla svojho typu, rovnako ako pri hromadnom vkladani
+				edge1->linkNodes(this->edges);
+				this->edgesByType.insert(metype->getId(),edge1);
+
+				edge2->linkNodes(this->edges);
+				this->edgesByType.insert(metype->getId(),edge2);
+			}
 
 			if(replacedSingleEdge!= NULL)
 			{
 				removeEdge(replacedSingleEdge);
 			}
+			this->structureChanged();
 }
 
 osg::ref_ptr<Data::Node> Data::Graph::getMultiEdgeNeighbour(osg::ref_ptr<Data::Edge> multiEdge)
@@ -838,6 +1187,7 @@ bool Data::Graph::isParralel(osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data
 
 Data::Type* Data::Graph::addType(QString name, QMap <QString, QString> *settings)
 {
+	QMutexLocker locker(&this->structureMutex);
 	//pridanie typu
     Data::Type* type = new Data::Type(this->incEleIdCounter(),name, this, settings);
 
@@ -850,6 +1200,7 @@ Data::Type* Data::Graph::addType(QString name, QMap <QString, QString> *settings
 
 Data::MetaType* Data::Graph::addMetaType(QString name, QMap <QString, QString> *settings) 
 {
+	QMutexLocker locker(&this->structureMutex);
 	//pridanie metatypu
     if(this->selectedLayout == NULL) {
         qDebug() << "[Data::Graph::addMetaType] Could not create MetaType. No GraphLayout selected.";
@@ -867,6 +1218,7 @@ Data::MetaType* Data::Graph::addMetaType(QString name, QMap <QString, QString> *
 
 Data::GraphLayout* Data::Graph::selectLayout( Data::GraphLayout* layout )
 {
+	QMutexLocker locker(&this->structureMutex);
 	//nastavime layout pre graf
     if(layout==NULL || (layout!=NULL && layout->getGraph()!=NULL && layout->getGraph()==this)) {
         if(this->selectedLayout!=layout) {
@@ -942,11 +1294,13 @@ QString Data::Graph::toString() const
 
 QList<Data::Type*> Data::Graph::getTypesByName(QString name)
 {
+	QMutexLocker locker(&this->structureMutex);
     return this->typesByName->values(name);
 }
 
 Data::Type* Data::Graph::getNodeMetaType()
 {
+	QMutexLocker locker(&this->structureMutex);
 	//vraciame typ meta uzla s nastavenymi hodnotami
     if(this->selectedLayout==NULL) return NULL;
     
@@ -973,6 +1327,7 @@ Data::Type* Data::Graph::getNodeMetaType()
 
 Data::Type* Data::Graph::getNodeMultiType()
 {
+	QMutexLocker locker(&this->structureMutex);
 	//vraciame typ multi uzla s nastavenymi hodnotami
 		QMap<QString, QString> *settings = new QMap<QString, QString>;
 
@@ -993,7 +1348,7 @@ float Data::Graph::getNodeScale()
 	//vraciame skalu grafu potrebnu pre vnorene grafy
 	int level;
 	level = this->parent_id.size();
-	float offset = Util::ApplicationConfig::get()->getValue("Viewer.Textures.DefaultNodeScale").toFloat();
+	float offset = this->bulkInsert ? this->bulkNodeScale : Util::ApplicationConfig::get()->getValue("Viewer.Textures.DefaultNodeScale").toFloat();
 
 	for(int i=0; i<level; i++)
 	{
@@ -1008,7 +1363,7 @@ float Data::Graph::getEdgeScale()
 	//vraciame skalu grafu potrebnu pre vnorene grafy
 	int level;
 	level = this->parent_id.size();
-	float offset = Util::ApplicationConfig::get()->getValue("Viewer.Textures.EdgeScale").toFloat();
+	float offset = this->bulkInsert ? this->bulkEdgeScale : Util::ApplicationConfig::get()->getValue("Viewer.Textures.EdgeScale").toFloat();
 
 	for(int i=0; i<level; i++)
 	{
@@ -1020,6 +1375,7 @@ float Data::Graph::getEdgeScale()
 
 Data::Type* Data::Graph::getEdgeMetaType()
 {
+	QMutexLocker locker(&this->structureMutex);
 	//vraciame typ pre meta hranu
     if(this->selectedLayout==NULL) return NULL;
 
@@ -1036,6 +1392,7 @@ Data::Type* Data::Graph::getEdgeMetaType()
 
 Data::Type* Data::Graph::getRestrictionNodeMetaType()
 {
+	QMutexLocker locker(&this->structureMutex);
 	//vraciame nastaveny typ pre restriction node (obmedzovac pre vnoreny graf) s nastavenymi hodnotami
     if(this->selectedLayout==NULL) return NULL;
 
@@ -1062,6 +1419,7 @@ Data::Type* Data::Graph::getRestrictionNodeMetaType()
 
 void Data::Graph::removeType( Data::Type* type )
 {
+	QMutexLocker locker(&this->structureMutex);
 	//odstranujeme typ
     if(type!=NULL && type->getGraph()==this) {
         if(!type->isInDB() || Model::TypeDAO::removeType(type, this->conn)) {
@@ -1069,6 +1427,10 @@ void Data::Graph::removeType( Data::Type* type )
             this->newTypes.remove(type->getId());
             this->typesByName->remove(type->getName());
 
+			if(this->bulkNestedNodeType==type) {
+				this->bulkNestedNodeType = NULL;
+			}
+
 			if(type->isMeta()) {
 				if(this->getNodeMetaType()==type) { //type je MetaTypom uzlov layoutu
 					this->selectedLayout->removeMetaSetting(Data::GraphLayout::META_NODE_TYPE);
@@ -1094,9 +1456,7 @@ void Data::Graph::removeAllEdgesOfType(Data::Type* type )
 	if(type->isMeta()) edgesToKill = this->metaEdgesByType.values(type->getId());
 	else edgesToKill = this->edgesByType.values(type->getId());
     if(!edgesToKill.isEmpty()) {
-        for(qlonglong i=0;i<edgesToKill.size();i++) {
-			this->removeEdge(edgesToKill.at(i));
-        }
+		this->removeEdges(edgesToKill);
 
         edgesToKill.clear();
     }
@@ -1110,32 +1470,204 @@ void Data::Graph::removeAllNodesOfType( Data::Type* type )
 	else nodesToKill = this->nodesByType.values(type->getId());
 
     if(!nodesToKill.isEmpty()) {
-        for(qlonglong i=0;i<nodesToKill.size();i++) { //prejdeme kazdy jeden uzol
-			this->removeNode(nodesToKill.at(i));
-        }
+		this->removeNodes(nodesToKill);
         
 		nodesToKill.clear();
     }
 }
 
+void Data::Graph::removeEdges(QList<osg::ref_ptr<Data::Edge> > edgesToRemove)
+{
+	QMutexLocker locker(&this->structureMutex);
+
+	//odstranenie mnoziny hran - vyberieme hrany grafu bez duplicit
+	QList<osg::ref_ptr<Data::Edge> > removedEdges;
+	QSet<qlonglong> removedIds;
+	QSet<qlonglong> dbEdgeIds;
+
+	for(int i = 0; i < edgesToRemove.size(); i++) {
+		osg::ref_ptr<Data::Edge> edge = edgesToRemove.at(i);
+		if(edge!=NULL && edge->getGraph()==this && !removedIds.contains(edge->getId())) {
+			removedIds.insert(edge->getId());
+			removedEdges.append(edge);
+			if(edge->isInDB()) dbEdgeIds.insert(edge->getId());
+		}
+	}
+
+	//hrany ulozene v DB odstranime jednym prikazom, ak sa to nepodari, ponechame ich v grafe
+	if(!dbEdgeIds.isEmpty() && !Model::EdgeDAO::removeEdges(this->graph_id, dbEdgeIds, this->conn)) {
+		QMutableListIterator<osg::ref_ptr<Data::Edge> > it(removedEdges);
+		while(it.hasNext()) {
+			if(it.next()->isInDB()) it.remove();
+		}
+	}
+
+	this->removeEdgesFromLists(removedEdges);
+}
+
+void Data::Graph::removeEdgesFromLists(QList<osg::ref_ptr<Data::Edge> > edgesToRemove)
+{
+	QSet<qlonglong> removedIds;
+	QSet<qlonglong> typeIds;
+
+	for(int i = 0; i < edgesToRemove.size(); i++) {
+		const osg::ref_ptr<Data::Edge> & edge = edgesToRemove.at(i);
+
+		removedIds.insert(edge->getId());
+		typeIds.insert(edge->getType()->getId());
+
+		this->edges->remove(edge->getId());
+		this->metaEdges->remove(edge->getId());
+		this->newEdges.remove(edge->getId());
+		this->edgeAttributes.removeRow(edge->getId());
+	}
+
+	//zoznamy podla typu prejdeme pre kazdy typ len raz
+	foreach(qlonglong typeId, typeIds) {
+		QMultiMap<qlonglong, osg::ref_ptr<Data::Edge> >::iterator it = this->edgesByType.find(typeId);
+		while(it != this->edgesByType.end() && it.key() == typeId) {
+			if(removedIds.contains(it.value()->getId())) it = this->edgesByType.erase(it);
+			else ++it;
+		}
+
+		it = this->metaEdgesByType.find(typeId);
+		while(it != this->metaEdgesByType.end() && it.key() == typeId) {
+			if(removedIds.contains(it.value()->getId())) it = this->metaEdgesByType.erase(it);
+			else ++it;
+		}
+	}
+
+	for(int i = 0; i < edgesToRemove.size(); i++) {
+		edgesToRemove.at(i)->unlinkNodes();
+	}
+
+	this->structureChanged();
+}
+
+void Data::Graph::removeNodes(QList<osg::ref_ptr<Data::Node> > nodesToRemove)
+{
+	QMutexLocker locker(&this->structureMutex);
+
+	//odstranenie mnoziny uzlov - vyberieme uzly grafu bez duplicit
+	QList<osg::ref_ptr<Data::Node> > removedNodes;
+	QSet<qlonglong> removedIds;
+	QSet<qlonglong> dbNodeIds;
+
+	for(int i = 0; i < nodesToRemove.size(); i++) {
+		osg::ref_ptr<Data::Node> node = nodesToRemove.at(i);
+		if(node!=NULL && node->getGraph()==this && !removedIds.contains(node->getId())) {
+			removedIds.insert(node->getId());
+			removedNodes.append(node);
+			if(node->isInDB()) dbNodeIds.insert(node->getId());
+		}
+	}
+
+	//uzly ulozene v DB odstranime jednym prikazom, ak sa to nepodari, ponechame ich v grafe
+	if(!dbNodeIds.isEmpty() && !Model::NodeDAO::removeNodes(this->graph_id, dbNodeIds, this->conn)) {
+		QMutableListIterator<osg::ref_ptr<Data::Node> > it(removedNodes);
+		while(it.hasNext()) {
+			osg::ref_ptr<Data::Node> node = it.next();
+			if(node->isInDB()) {
+				removedIds.remove(node->getId());
+				it.remove();
+			}
+		}
+	}
+
+	if(removedNodes.isEmpty()) {
+		return;
+	}
+
+	//vyberieme hrany napojene na odstranovane uzly (z DB ich odstranilo ON DELETE CASCADE spolu s uzlami, rovnako ako pri removeNode)
+	QList<osg::ref_ptr<Data::Edge> > removedEdges;
+	QSet<qlonglong> removedEdgeIds;
+	QSet<Data::Node *> restrictedNodes;
+	QSet<qlonglong> typeIds;
+
+	for(int i = 0; i < removedNodes.size(); i++) {
+		const osg::ref_ptr<Data::Node> & node = removedNodes.at(i);
+
+		restrictedNodes.insert(node.get());
+		typeIds.insert(node->getType()->getId());
+
+		QMap<qlonglong, osg::ref_ptr<Data::Edge> >::const_iterator iedge = node->getEdges()->constBegin();
+		while(iedge != node->getEdges()->constEnd()) {
+			if(!removedEdgeIds.contains(iedge.key())) {
+				removedEdgeIds.insert(iedge.key());
+				removedEdges.append(iedge.value());
+			}
+			++iedge;
+		}
+	}
+
+	this->removeEdgesFromLists(removedEdges);
+
+	// remove restrictions:
+	restrictionsManager_.setRestrictions (
+		restrictedNodes,
+		QSharedPointer<Layout::ShapeGetter> (NULL)
+	);
+
+	for(int i = 0; i < removedNodes.size(); i++) {
+		qlonglong id = removedNodes.at(i)->getId();
+
+		this->nodes->remove(id);
+		this->metaNodes->remove(id);
+		this->newNodes.remove(id);
+		this->nodeAttributes.removeRow(id);
+		this->nodeIndex.removeNode(removedNodes.at(i));
+		this->mergedGroups.remove(id);
+	}
+
+	//zoznamy podla typu prejdeme pre kazdy typ len raz
+	foreach(qlonglong typeId, typeIds) {
+		QMultiMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator it = this->nodesByType.find(typeId);
+		while(it != this->nodesByType.end() && it.key() == typeId) {
+			if(removedIds.contains(it.value()->getId())) it = this->nodesByType.erase(it);
+			else ++it;
+		}
+
+		it = this->metaNodesByType.find(typeId);
+		while(it != this->metaNodesByType.end() && it.key() == typeId) {
+			if(removedIds.contains(it.value()->getId())) it = this->metaNodesByType.erase(it);
+			else ++it;
+		}
+	}
+
+	this->structureChanged();
+
+	//zistime ci nahodou niektory z uzlov nie je aj typom (pozri removeNode)
+	for(int i = 0; i < removedNodes.size(); i++) {
+		if(this->types->contains(removedNodes.at(i)->getId())) {
+			this->removeType(this->types->value(removedNodes.at(i)->getId()));
+		}
+	}
+}
+
 void Data::Graph::removeEdge( osg::ref_ptr<Data::Edge> edge)
 {
+	QMutexLocker locker(&this->structureMutex);
+
 	//odstranenie danej hrany vratane relevantnych zoznamov
 	if(edge!=NULL && edge->getGraph()==this) {
 		if(!edge->isInDB() || Model::EdgeDAO::removeEdge(edge, this->conn)) {
 			this->edges->remove(edge->getId());
 			this->metaEdges->remove(edge->getId());
 			this->newEdges.remove(edge->getId());
+			this->edgeAttributes.removeRow(edge->getId());
 			this->edgesByType.remove(edge->getType()->getId(),edge);
 			this->metaEdgesByType.remove(edge->getType()->getId(),edge);
 
 			edge->unlinkNodes();
+			this->structureChanged();
 		}
 	}
 }
 
 void Data::Graph::removeNode( osg::ref_ptr<Data::Node> node )
 {
+	QMutexLocker locker(&this->structureMutex);
+
 	//odstranenie uzla vratane relevantnych zoznamov
 	if(node!=NULL && node->getGraph()==this) {
 		if(!node->isInDB() || Model::NodeDAO::removeNode(node, this->conn)) {
@@ -1153,10 +1685,14 @@ void Data::Graph::removeNode( osg::ref_ptr<Data::Node> node )
 			this->nodes->remove(node->getId());
 			this->metaNodes->remove(node->getId());
 			this->newNodes.remove(node->getId());
+			this->nodeAttributes.removeRow(node->getId());
+			this->nodeIndex.removeNode(node);
+			this->mergedGroups.remove(node->getId());
 			this->nodesByType.remove(node->getType()->getId(),node);
 			this->metaNodesByType.remove(node->getType()->getId(),node);
 
 			node->removeAllEdges();
+			this->structureChanged();
 
 			//zistime ci nahodou dany uzol nie je aj typom a osetrime specialny pripad ked uzol je sam sebe typom (v DB to znamena, ze uzol je ROOT uzlom/typom, teda uz nemoze mat ziaden iny typ)
 			if(this->types->contains(node->getId())) {
@@ -1166,6 +1702,84 @@ void Data::Graph::removeNode( osg::ref_ptr<Data::Node> node )
 	}
 }
 
+QSharedPointer<Data::GraphSnapshot> Data::Graph::getSnapshot()
+{
+	QMutexLocker locker(&this->structureMutex);
+
+	//snapshot vytvarame len ak sa od posledneho zmenila struktura grafu
+	if(this->snapshot.isNull() || this->snapshot->getVersion() != this->version) {
+		this->snapshot = QSharedPointer<Data::GraphSnapshot>(new Data::GraphSnapshot(this->version, *this->nodes, *this->edges, *this->metaNodes, *this->metaEdges));
+	}
+
+	return this->snapshot;
+}
+
+qlonglong Data::Graph::getVersion()
+{
+	QMutexLocker locker(&this->structureMutex);
+
+	return this->version;
+}
+
+void Data::Graph::enqueueCommand(Data::GraphCommand * command)
+{
+	QMutexLocker locker(&this->commandsMutex);
+
+	this->commands.append(command);
+}
+
+bool Data::Graph::applyCommands()
+{
+	QList<Data::GraphCommand *> queued;
+
+	//frontu vyberieme naraz, aby nove prikazy mohli pribudat pocas aplikovania
+	this->commandsMutex.lock();
+	queued = this->commands;
+	this->commands.clear();
+	this->commandsMutex.unlock();
+
+	if(queued.isEmpty())
+		return false;
+
+	//struktura je zamknuta pocas vsetkych prikazov, snapshot teda zachyti len stav pred nimi alebo po nich
+	QMutexLocker locker(&this->structureMutex);
+
+	//po sebe iduce prikazy, ktore len pridavaju prvky, aplikujeme v jednom hromadnom vkladani
+	bool bulk = false;
+
+	Data::GraphCommand * current = queued.first();
+	for(int i = 1; i <= queued.size(); i++) {
+		Data::GraphCommand * next = (i < queued.size()) ? queued.at(i) : NULL;
+
+		if(next != NULL && current->merge(next)) {
+			delete next;
+			continue;
+		}
+
+		if(current->isInsert() != bulk) {
+			if(bulk) this->commitBulkInsert();
+			else this->beginBulkInsert();
+			bulk = !bulk;
+		}
+
+		current->apply(this);
+		delete current;
+		current = next;
+	}
+
+	if(bulk)
+		this->commitBulkInsert();
+
+	return true;
+}
+
+bool Data::Graph::hasQueuedCommands()
+{
+	QMutexLocker locker(&this->commandsMutex);
+
+	return !this->commands.isEmpty();
+}
+
 Layout::RestrictionsManager & Data::Graph::getRestrictionsManager (void) {
 	return restrictionsManager_;
 }
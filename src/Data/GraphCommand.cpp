@@ -0,0 +1,147 @@
+/*!
+ * GraphCommand.cpp
+ * Projekt 3DVisual
+ */
+#include "Data/GraphCommand.h"
+#include "Data/Graph.h"
+
+//uzol mohol byt medzicasom odstraneny inym prikazom
+static bool containsNode(Data::Graph * graph, osg::ref_ptr<Data::Node> node)
+{
+	return node != NULL && (graph->getNodes()->contains(node->getId()) || graph->getMetaNodes()->contains(node->getId()));
+}
+
+Data::AddNodeCommand::AddNodeCommand(QString name, Data::Type * type, osg::Vec3f position)
+{
+	this->name = name;
+	this->type = type;
+	this->position = position;
+}
+
+void Data::AddNodeCommand::apply(Data::Graph * graph)
+{
+	graph->addNode(this->name, this->type, this->position);
+}
+
+Data::AddEdgeCommand::AddEdgeCommand(QString name, osg::ref_ptr<Data::Node> srcNode, osg::ref_ptr<Data::Node> dstNode, Data::Type * type, bool isOriented)
+{
+	this->name = name;
+	this->srcNode = srcNode;
+	this->dstNode = dstNode;
+	this->type = type;
+	this->isOriented = isOriented;
+}
+
+void Data::AddEdgeCommand::apply(Data::Graph * graph)
+{
+	if(containsNode(graph, this->srcNode) && containsNode(graph, this->dstNode))
+		graph->addEdge(this->name, this->srcNode, this->dstNode, this->type, this->isOriented);
+}
+
+Data::AddMetaNodeCommand::AddMetaNodeCommand(QLinkedList<osg::ref_ptr<Data::Node> > nodes, osg::Vec3f position, osg::ref_ptr<osg::Camera> camera)
+{
+	this->nodes = nodes;
+	this->position = position;
+	this->camera = camera;
+}
+
+void Data::AddMetaNodeCommand::apply(Data::Graph * graph)
+{
+	osg::ref_ptr<Data::Node> metaNode = graph->addNode("metaNode", graph->getNodeMetaType(), this->position);
+
+	QLinkedList<osg::ref_ptr<Data::Node> >::const_iterator i = this->nodes.constBegin();
+
+	while (i != this->nodes.constEnd())
+	{
+		if(containsNode(graph, (*i))) {
+			osg::ref_ptr<Data::Edge> e = graph->addEdge("metaEdge", (*i), metaNode, graph->getEdgeMetaType(), true);
+			//paralelna hrana sa prida ako multihrana a nevrati sa
+			if(e != NULL)
+				e->setCamera(this->camera);
+		}
+		++i;
+	}
+}
+
+Data::MergeNodesCommand::MergeNodesCommand(QLinkedList<osg::ref_ptr<Data::Node> > nodes, osg::Vec3f position)
+{
+	this->nodes = nodes;
+	this->position = position;
+}
+
+void Data::MergeNodesCommand::apply(Data::Graph * graph)
+{
+	QMutableLinkedListIterator<osg::ref_ptr<Data::Node> > i(this->nodes);
+	while(i.hasNext()) {
+		if(!containsNode(graph, i.next())) i.remove();
+	}
+
+	if(!this->nodes.isEmpty())
+		graph->mergeNodes(&this->nodes, this->position);
+}
+
+Data::SeparateNodesCommand::SeparateNodesCommand(QLinkedList<osg::ref_ptr<Data::Node> > nodes)
+{
+	this->nodes = nodes;
+}
+
+void Data::SeparateNodesCommand::apply(Data::Graph * graph)
+{
+	QMutableLinkedListIterator<osg::ref_ptr<Data::Node> > i(this->nodes);
+	while(i.hasNext()) {
+		if(!containsNode(graph, i.next())) i.remove();
+	}
+
+	if(!this->nodes.isEmpty())
+		graph->separateNodes(&this->nodes);
+}
+
+bool Data::SeparateNodesCommand::merge(Data::GraphCommand * next)
+{
+	Data::SeparateNodesCommand * separate = dynamic_cast<Data::SeparateNodesCommand *>(next);
+
+	if(separate == NULL)
+		return false;
+
+	this->nodes += separate->nodes;
+	return true;
+}
+
+Data::RemoveCommand::RemoveCommand(QList<osg::ref_ptr<Data::Node> > nodes, QList<osg::ref_ptr<Data::Edge> > edges)
+{
+	this->nodes = nodes;
+	this->edges = edges;
+}
+
+void Data::RemoveCommand::apply(Data::Graph * graph)
+{
+	//hrany mohli byt odstranene spolu s uzlom uz skor
+	QMutableListIterator<osg::ref_ptr<Data::Edge> > e(this->edges);
+	while(e.hasNext()) {
+		osg::ref_ptr<Data::Edge> edge = e.next();
+		if(edge == NULL || (!graph->getEdges()->contains(edge->getId()) && !graph->getMetaEdges()->contains(edge->getId()))) e.remove();
+	}
+
+	QMutableListIterator<osg::ref_ptr<Data::Node> > n(this->nodes);
+	while(n.hasNext()) {
+		if(!containsNode(graph, n.next())) n.remove();
+	}
+
+	if(!this->edges.isEmpty())
+		graph->removeEdges(this->edges);
+
+	if(!this->nodes.isEmpty())
+		graph->removeNodes(this->nodes);
+}
+
+bool Data::RemoveCommand::merge(Data::GraphCommand * next)
+{
+	Data::RemoveCommand * remove = dynamic_cast<Data::RemoveCommand *>(next);
+
+	if(remove == NULL)
+		return false;
+
+	this->nodes.append(remove->nodes);
+	this->edges.append(remove->edges);
+	return true;
+}
@@ -0,0 +1,128 @@
+/*!
+ * GraphIndex.cpp
+ * Projekt 3DVisual
+ */
+#include "Data/GraphIndex.h"
+#include "Data/Node.h"
+
+#include <QMutexLocker>
+
+Data::GraphIndex::GraphIndex(void)
+{
+}
+
+void Data::GraphIndex::addNode(Data::Node * node)
+{
+	QMutexLocker locker(&mutex);
+
+	qlonglong id = node->getId();
+	Data::Type * type = node->getType();
+
+	nodes.add(id);
+	if(type != NULL) {
+		nodesByType[type->getId()].add(id);
+		if(type->isMeta()) metaNodes.add(id);
+	}
+
+	//priznaky mohli byt nastavene este pred pridanim uzla do grafu
+	fixedNodes.set(id, node->isFixed());
+	selectedNodes.set(id, node->isSelected());
+	ignoredNodes.set(id, node->isIgnored());
+}
+
+void Data::GraphIndex::removeNode(Data::Node * node)
+{
+	QMutexLocker locker(&mutex);
+
+	qlonglong id = node->getId();
+	Data::Type * type = node->getType();
+
+	nodes.remove(id);
+	if(type != NULL) {
+		QHash<qlonglong, Data::Bitmap>::iterator it = nodesByType.find(type->getId());
+		if(it != nodesByType.end()) {
+			it.value().remove(id);
+			if(it.value().isEmpty()) nodesByType.erase(it);
+		}
+	}
+	metaNodes.remove(id);
+	fixedNodes.remove(id);
+	selectedNodes.remove(id);
+	ignoredNodes.remove(id);
+}
+
+void Data::GraphIndex::setFixed(qlonglong id, bool fixed)
+{
+	QMutexLocker locker(&mutex);
+
+	fixedNodes.set(id, fixed);
+}
+
+void Data::GraphIndex::setSelected(qlonglong id, bool selected)
+{
+	QMutexLocker locker(&mutex);
+
+	selectedNodes.set(id, selected);
+}
+
+void Data::GraphIndex::setIgnored(qlonglong id, bool ignored)
+{
+	QMutexLocker locker(&mutex);
+
+	ignoredNodes.set(id, ignored);
+}
+
+Data::Bitmap Data::GraphIndex::getNodes() const
+{
+	QMutexLocker locker(&mutex);
+
+	return nodes;
+}
+
+Data::Bitmap Data::GraphIndex::getNodesOfType(qlonglong typeId) const
+{
+	QMutexLocker locker(&mutex);
+
+	return nodesByType.value(typeId);
+}
+
+Data::Bitmap Data::GraphIndex::getMetaNodes() const
+{
+	QMutexLocker locker(&mutex);
+
+	return metaNodes;
+}
+
+Data::Bitmap Data::GraphIndex::getFixedNodes() const
+{
+	QMutexLocker locker(&mutex);
+
+	//priznak moze mat aj uzol, ktory uz nie je v grafe
+	return fixedNodes & nodes;
+}
+
+Data::Bitmap Data::GraphIndex::getSelectedNodes() const
+{
+	QMutexLocker locker(&mutex);
+
+	return selectedNodes & nodes;
+}
+
+Data::Bitmap Data::GraphIndex::getIgnoredNodes() const
+{
+	QMutexLocker locker(&mutex);
+
+	return ignoredNodes & nodes;
+}
+
+void Data::GraphIndex::clear()
+{
+	QMutexLocker locker(&mutex);
+
+	nodes.clear();
+	nodesByType.clear();
+	metaNodes.clear();
+	fixedNodes.clear();
+	selectedNodes.clear();
+	ignoredNodes.clear();
+}
@@ -0,0 +1,279 @@
+/*!
+ * GraphQuery.cpp
+ * Projekt 3DVisual
+ */
+#include "Data/GraphQuery.h"
+#include "Data/Graph.h"
+
+#include <QRegExp>
+#include <QStringList>
+#include <QtConcurrentFilter>
+
+namespace
+{
+	//porovnanie dvoch hodnot podla operatora
+	template<typename T>
+	bool compareValues(const T &lhs, Data::GraphQuery::Operator op, const T &rhs)
+	{
+		switch(op) {
+			case Data::GraphQuery::EQUAL: return lhs == rhs;
+			case Data::GraphQuery::NOT_EQUAL: return lhs != rhs;
+			case Data::GraphQuery::LESS: return lhs < rhs;
+			case Data::GraphQuery::LESS_EQUAL: return lhs <= rhs;
+			case Data::GraphQuery::GREATER: return lhs > rhs;
+			case Data::GraphQuery::GREATER_EQUAL: return lhs >= rhs;
+		}
+		return false;
+	}
+
+	/**
+	*  \class NodeFilter
+	*  \brief Evaluates the value conditions of the query for one Node, used by QtConcurrent::blockingFiltered
+	*/
+	class NodeFilter
+	{
+	public:
+
+		typedef bool result_type;
+
+		NodeFilter(QSharedPointer<Data::GraphSnapshot> snapshot, Data::AttributeStore * attributes, const QList<Data::GraphQuery::Condition> &conditions)
+			: snapshot(snapshot), attributes(attributes), conditions(conditions)
+		{
+			//stlpce a indexy retazcov v slovniku vyhladame len raz pre cely dotaz
+			for(int i = 0; i < conditions.size(); i++) {
+				const Data::GraphQuery::Condition &condition = conditions.at(i);
+				Data::AttributeColumn * column = NULL;
+				int dictionaryIndex = -1;
+
+				if(condition.kind == Data::GraphQuery::Condition::ATTRIBUTE) {
+					column = attributes->getColumn(condition.name);
+					if(column != NULL && column->getValueType() == Data::AttributeColumn::STRING)
+						dictionaryIndex = column->getDictionary().indexOf(condition.value);
+				}
+
+				columns.append(column);
+				dictionaryIndexes.append(dictionaryIndex);
+			}
+		}
+
+		bool operator()(const qlonglong &id) const
+		{
+			for(int i = 0; i < conditions.size(); i++) {
+				if(!matches(i, id))
+					return false;
+			}
+
+			return true;
+		}
+
+	private:
+
+		bool matches(int i, qlonglong id) const
+		{
+			const Data::GraphQuery::Condition &condition = conditions.at(i);
+
+			if(condition.kind == Data::GraphQuery::Condition::DEGREE) {
+				if(!snapshot->getNodes().contains(id) && !snapshot->getMetaNodes().contains(id))
+					return false;
+
+				//zoznam hran uzla sa meni spolu s grafom, stupen citame zo snapshotu
+				return compareValues<double>(snapshot->getNodeEdges(id).size(), condition.op, condition.number);
+			}
+
+			Data::AttributeColumn * column = columns.at(i);
+			int row = attributes->getRow(id);
+
+			//uzol bez hodnoty atributu podmienke nevyhovuje
+			if(column == NULL || column->isNull(row))
+				return false;
+
+			if(column->getValueType() == Data::AttributeColumn::STRING) {
+				if(condition.op == Data::GraphQuery::EQUAL || condition.op == Data::GraphQuery::NOT_EQUAL)
+					return compareValues<int>(column->getStringIndex(row), condition.op, dictionaryIndexes.at(i));
+
+				//poradie textov s cislom neporovnavame (napr. "100" < "30")
+				if(condition.isNumber)
+					return false;
+
+				return compareValues<QString>(column->getValue(row).toString(), condition.op, condition.value);
+			}
+
+			if(!condition.isNumber)
+				return false;
+
+			return compareValues<double>(column->getNumber(row), condition.op, condition.number);
+		}
+
+		QSharedPointer<Data::GraphSnapshot> snapshot;
+		Data::AttributeStore * attributes;
+		QList<Data::GraphQuery::Condition> conditions;
+		QList<Data::AttributeColumn *> columns;
+		QList<int> dictionaryIndexes;
+	};
+}
+
+Data::GraphQuery::GraphQuery(Data::Graph * graph, QString query)
+{
+	this->graph = graph;
+
+	if(graph == NULL) {
+		error = "No graph loaded.";
+		return;
+	}
+
+	QStringList conditions = query.trimmed().split(QRegExp("\\s+and\\s+", Qt::CaseInsensitive), QString::SkipEmptyParts);
+
+	if(conditions.isEmpty())
+		error = "Empty query.";
+
+	for(int i = 0; i < conditions.size() && isValid(); i++)
+		parseCondition(conditions.at(i).trimmed());
+}
+
+bool Data::GraphQuery::parseCondition(QString text)
+{
+	Condition condition;
+	condition.negated = false;
+	condition.op = EQUAL;
+	condition.number = 0;
+	condition.isNumber = false;
+
+	//priznaky uzla
+	QRegExp flag("^(not\\s+)?(fixed|selected|ignored|meta)$", Qt::CaseInsensitive);
+	if(flag.exactMatch(text)) {
+		QString name = flag.cap(2).toLower();
+		condition.negated = !flag.cap(1).isEmpty();
+		condition.kind = (name == "fixed") ? Condition::FIXED
+			: (name == "selected") ? Condition::SELECTED
+			: (name == "ignored") ? Condition::IGNORED
+			: Condition::META;
+		indexConditions.append(condition);
+		return true;
+	}
+
+	//porovnanie - nazov operator hodnota
+	QRegExp comparison("^([A-Za-z_][\\w.]*)\\s*(<=|>=|!=|=|<|>)\\s*(.+)$");
+	if(!comparison.exactMatch(text)) {
+		error = "Invalid condition: " + text;
+		return false;
+	}
+
+	condition.name = comparison.cap(1);
+	QString op = comparison.cap(2);
+	condition.op = (op == "=") ? EQUAL
+		: (op == "!=") ? NOT_EQUAL
+		: (op == "<") ? LESS
+		: (op == "<=") ? LESS_EQUAL
+		: (op == ">") ? GREATER
+		: GREATER_EQUAL;
+
+	condition.value = comparison.cap(3).trimmed();
+	if(condition.value.length() >= 2 && condition.value.startsWith('"') && condition.value.endsWith('"'))
+		condition.value = condition.value.mid(1, condition.value.length() - 2);
+
+	if(condition.value.toLower() == "true" || condition.value.toLower() == "false") {
+		condition.number = (condition.value.toLower() == "true") ? 1 : 0;
+		condition.isNumber = true;
+	} else {
+		condition.number = condition.value.toDouble(&condition.isNumber);
+	}
+
+	if(condition.name.toLower() == "type") {
+		if(condition.op != EQUAL && condition.op != NOT_EQUAL) {
+			error = "Type can be compared only by = or !=.";
+			return false;
+		}
+
+		condition.kind = Condition::TYPE;
+		condition.negated = (condition.op == NOT_EQUAL);
+		indexConditions.append(condition);
+	} else if(condition.name.toLower() == "degree") {
+		if(!condition.isNumber) {
+			error = "Degree must be compared with a number.";
+			return false;
+		}
+
+		condition.kind = Condition::DEGREE;
+		valueConditions.append(condition);
+	} else {
+		//textovy atribut s cislom vieme porovnat len na rovnost
+		QMutexLocker locker(graph->getStructureMutex());
+		Data::AttributeColumn * column = graph->getNodeAttributes()->getColumn(condition.name);
+		if(column != NULL && !column->isNumeric() && condition.isNumber && condition.op != EQUAL && condition.op != NOT_EQUAL) {
+			error = "Attribute " + condition.name + " is not a number, it can be compared with a number only by = or !=.";
+			return false;
+		}
+
+		condition.kind = Condition::ATTRIBUTE;
+		valueConditions.append(condition);
+	}
+
+	return true;
+}
+
+Data::Bitmap Data::GraphQuery::evaluate()
+{
+	if(!isValid())
+		return Data::Bitmap();
+
+	Data::GraphIndex * index = graph->getNodeIndex();
+	Data::Bitmap result = index->getNodes();
+
+	//podmienky nad indexami su len operacie s bitmapami
+	for(int i = 0; i < indexConditions.size() && !result.isEmpty(); i++) {
+		const Condition &condition = indexConditions.at(i);
+		Data::Bitmap matching;
+
+		switch(condition.kind) {
+			case Condition::FIXED: matching = index->getFixedNodes(); break;
+			case Condition::SELECTED: matching = index->getSelectedNodes(); break;
+			case Condition::IGNORED: matching = index->getIgnoredNodes(); break;
+			case Condition::META: matching = index->getMetaNodes(); break;
+			case Condition::TYPE: {
+				QList<Data::Type*> types = graph->getTypesByName(condition.value);
+				for(int j = 0; j < types.size(); j++)
+					matching = matching | index->getNodesOfType(types.at(j)->getId());
+				break;
+			}
+			default: break;
+		}
+
+		result = condition.negated ? result.andNot(matching) : (result & matching);
+	}
+
+	if(valueConditions.isEmpty() || result.isEmpty())
+		return result;
+
+	//ostatne podmienky vyhodnocujeme paralelne len pre uzly, ktore presli indexami, atributy medzitym moze menit import
+	QMutexLocker locker(graph->getStructureMutex());
+	NodeFilter filter(graph->getSnapshot(), graph->getNodeAttributes(), valueConditions);
+	QList<qlonglong> matchingIds = QtConcurrent::blockingFiltered(result.toList(), filter);
+
+	Data::Bitmap matching;
+	for(int i = 0; i < matchingIds.size(); i++)
+		matching.add(matchingIds.at(i));
+
+	return matching;
+}
+
+QList<osg::ref_ptr<Data::Node> > Data::GraphQuery::getNodes()
+{
+	QList<osg::ref_ptr<Data::Node> > matchingNodes;
+
+	if(!isValid())
+		return matchingNodes;
+
+	QList<qlonglong> ids = evaluate().toList();
+	QSharedPointer<Data::GraphSnapshot> snapshot = graph->getSnapshot();
+	matchingNodes.reserve(ids.size());
+
+	for(int i = 0; i < ids.size(); i++) {
+		osg::ref_ptr<Data::Node> node = snapshot->getNodes().value(ids.at(i));
+		if(node == NULL)
+			node = snapshot->getMetaNodes().value(ids.at(i));
+		if(node != NULL)
+			matchingNodes.append(node);
+	}
+
+	return matchingNodes;
+}
@@ -0,0 +1,56 @@
+/*!
+ * GraphSnapshot.cpp
+ * Projekt 3DVisual
+ */
+#include "Data/GraphSnapshot.h"
+#include "Data/Node.h"
+#include "Data/Edge.h"
+
+Data::GraphSnapshot::GraphSnapshot(qlonglong version, const QMap<qlonglong, osg::ref_ptr<Data::Node> > &nodes, const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &edges, const QMap<qlonglong, osg::ref_ptr<Data::Node> > &metaNodes, const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &metaEdges)
+{
+	//zoznamy su zdielane s grafom, graf si ich skopiruje az pri zmene
+	this->version = version;
+	this->nodes = nodes;
+	this->edges = edges;
+	this->metaNodes = metaNodes;
+	this->metaEdges = metaEdges;
+	this->nodeEdgesBuilt = false;
+}
+
+Data::GraphSnapshot::~GraphSnapshot(void)
+{
+	this->nodes.clear();
+	this->edges.clear();
+	this->metaNodes.clear();
+	this->metaEdges.clear();
+	this->nodeEdges.clear();
+}
+
+const QList<osg::ref_ptr<Data::Edge> > & Data::GraphSnapshot::getNodeEdges(qlonglong nodeId) const
+{
+	//zoznamy vytvorime naraz pri prvom pouziti, potom sa uz nemenia
+	QMutexLocker locker(&this->nodeEdgesMutex);
+	static const QList<osg::ref_ptr<Data::Edge> > noEdges;
+
+	if(!this->nodeEdgesBuilt) {
+		addNodeEdges(this->edges);
+		addNodeEdges(this->metaEdges);
+		this->nodeEdgesBuilt = true;
+	}
+
+	QHash<qlonglong, QList<osg::ref_ptr<Data::Edge> > >::const_iterator it = this->nodeEdges.constFind(nodeId);
+	return (it != this->nodeEdges.constEnd()) ? it.value() : noEdges;
+}
+
+void Data::GraphSnapshot::addNodeEdges(const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &edges) const
+{
+	for(QMap<qlonglong, osg::ref_ptr<Data::Edge> >::const_iterator it = edges.constBegin(); it != edges.constEnd(); ++it) {
+		qlonglong srcId = it.value()->getSrcNode()->getId();
+		qlonglong dstId = it.value()->getDstNode()->getId();
+
+		this->nodeEdges[srcId].append(it.value());
+		//slucka je v zozname uzla len raz, rovnako ako v Node::getEdges
+		if(dstId != srcId)
+			this->nodeEdges[dstId].append(it.value());
+	}
+}
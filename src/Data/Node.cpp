@@ -30,29 +30,14 @@ Data::Node::Node(qlonglong id, QString name, Data::Type* type, float scaling, Da
 	this->setParentBall(NULL);
 	this->hasNestedNodes = false;
 
+	//importovane data uzla su v atributoch grafu, nastavenia su na zaciatku prazdne
 	settings = new QMap<QString, QString>();
-	//APA
-
-	settings->insert("Velkost","4242");
-	settings->insert("Farba","ruzova");
-	//APA
-
-	int pos = 0;
-	int cnt = 0;
-
-	labelText = this->name;
-
-	while ((pos = labelText.indexOf(QString(" "), pos + 1)) != -1)
-	{
-		if (++cnt % 3 == 0)
-			labelText = labelText.replace(pos, 1, "\n");
-	}
 
 	this->addDrawable(createNode(this->scale, Node::createStateSet(this->type)));
 	
 	//vytvorenie grafickeho zobrazenia ako label
 	this->square = createSquare(this->type->getScale(), Node::createStateSet());
-	this->label = createLabel(this->type->getScale(), labelText);
+	this->label = createLabel(this->type->getScale(), getLabelText());
 
 	this->force = osg::Vec3f();
 	this->velocity = osg::Vec3f(0,0,0);
@@ -88,6 +73,23 @@ Data::Node::~Node(void)
 	delete edges;
 }
 
+QString Data::Node::getLabelText() const
+{
+	int pos = 0;
+	int cnt = 0;
+
+	//kazdu tretiu medzeru nahradime novym riadkom, meno bez medzier zdiela data
+	QString labelText = this->name;
+
+	while ((pos = labelText.indexOf(QString(" "), pos + 1)) != -1)
+	{
+		if (++cnt % 3 == 0)
+			labelText = labelText.replace(pos, 1, "\n");
+	}
+
+	return labelText;
+}
+
 void Data::Node::addEdge(osg::ref_ptr<Data::Edge> edge) { 
 	//pridanie napojenej hrany na uzol
 	edges->insert(edge->getId(), edge);
@@ -296,6 +298,46 @@ void Data::Node::setDrawableColor(int pos, osg::Vec4 color)
 	}
 }
 
+void Data::Node::setFixed(bool fixed)
+{
+	this->fixed = fixed;
+
+	if (fixed && !this->type->isMeta() && !this->containsDrawable(square))
+		this->addDrawable(square);
+	else if (!fixed && this->containsDrawable(square))
+		this->removeDrawable(square);
+
+	if(this->fixed || this->type->isMeta())
+		*this->gpuFlags = (float) (((unsigned int) *this->gpuFlags) | Node::FIXED_FLAG);
+	else
+		*this->gpuFlags = (float) (((unsigned int) *this->gpuFlags) & (Node::FIXED_FLAG ^ 3));
+
+	//zmenu priznaku premietneme do indexu grafu
+	if (this->graph != NULL)
+		this->graph->getNodeIndex()->setFixed(this->id, fixed);
+}
+
+void Data::Node::setSelected(bool selected)
+{
+	if (selected)
+		setDrawableColor(0, osg::Vec4(0.0f, 0.0f, 0.0f, 1.0f));
+	else
+		setDrawableColor(0, color);
+
+	this->selected = selected;
+
+	if (this->graph != NULL)
+		this->graph->getNodeIndex()->setSelected(this->id, selected);
+}
+
+void Data::Node::setIgnored(bool b)
+{
+	ignore = b;
+
+	if (this->graph != NULL)
+		this->graph->getNodeIndex()->setIgnored(this->id, b);
+}
+
 void Data::Node::showLabel(bool visible)
 {
 	//nastavenie zobrazenia popisku uzla
@@ -311,7 +353,7 @@ void Data::Node::reloadConfig()
 	setSelected(selected);
 
 	osg::ref_ptr<osg::Drawable> newRect = createSquare(this->type->getScale(), Node::createStateSet());
-	osg::ref_ptr<osg::Drawable> newLabel = createLabel(this->type->getScale(), labelText);
+	osg::ref_ptr<osg::Drawable> newLabel = createLabel(this->type->getScale(), getLabelText());
 
 	if (this->containsDrawable(label))
 	{
@@ -0,0 +1,93 @@
+/*!
+ * StringTable.cpp
+ * Projekt 3DVisual
+ */
+#include "Data/StringTable.h"
+
+#include <string.h>
+
+Data::StringTable::StringTable()
+{
+	buckets.fill(-1, 16);
+}
+
+int Data::StringTable::intern(const QChar *text, int length)
+{
+	return intern(text, length, NULL);
+}
+
+int Data::StringTable::intern(const QChar *text, int length, const QString *shared)
+{
+	uint textHash = hash(text, length);
+	int bucket = findBucket(text, length, textHash);
+
+	if(buckets[bucket] >= 0)
+		return buckets[bucket];
+
+	//novy retazec - tabulku udrziavame zaplnenu najviac do polovice
+	int id = strings.size();
+	strings.append(shared != NULL ? *shared : QString(text, length));
+	hashes.append(textHash);
+	buckets[bucket] = id;
+
+	if(strings.size() * 2 > buckets.size())
+		grow();
+
+	return id;
+}
+
+int Data::StringTable::find(const QChar *text, int length) const
+{
+	return buckets.at(findBucket(text, length, hash(text, length)));
+}
+
+void Data::StringTable::clear()
+{
+	strings.clear();
+	hashes.clear();
+	buckets.fill(-1, 16);
+}
+
+uint Data::StringTable::hash(const QChar *text, int length)
+{
+	uint h = 2166136261u;
+	for(int i = 0; i < length; i++) {
+		h ^= text[i].unicode();
+		h *= 16777619u;
+	}
+
+	return h;
+}
+
+int Data::StringTable::findBucket(const QChar *text, int length, uint textHash) const
+{
+	int mask = buckets.size() - 1;
+	const int *data = buckets.constData();
+
+	//linearne skusanie, retazce porovnavame len pri zhode hashu
+	for(int bucket = (int) (textHash & mask); ; bucket = (bucket + 1) & mask) {
+		int id = data[bucket];
+		if(id < 0)
+			return bucket;
+
+		if(hashes.at(id) == textHash) {
+			const QString &s = strings.at(id);
+			if(s.size() == length && memcmp(s.unicode(), text, length * sizeof(QChar)) == 0)
+				return bucket;
+		}
+	}
+}
+
+void Data::StringTable::grow()
+{
+	buckets.fill(-1, buckets.size() * 2);
+
+	int mask = buckets.size() - 1;
+	for(int id = 0; id < hashes.size(); id++) {
+		int bucket = (int) (hashes.at(id) & mask);
+		while(buckets.at(bucket) >= 0)
+			bucket = (bucket + 1) & mask;
+
+		buckets[bucket] = id;
+	}
+}
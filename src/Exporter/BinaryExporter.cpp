@@ -0,0 +1,381 @@
+#include "Exporter/BinaryExporter.h"
+//-----------------------------------------------------------------------------
+#include "Importer/BinaryFormat.h"
+//-----------------------------------------------------------------------------
+#include <QStringList>
+#include <QtEndian>
+//-----------------------------------------------------------------------------
+#include <string.h>
+
+namespace {
+
+inline void writeU32 (uchar *p, quint32 value) {
+	qToLittleEndian<quint32> (value, p);
+}
+
+inline void writeI64 (uchar *p, qint64 value) {
+	qToLittleEndian<qint64> (value, p);
+}
+
+inline void writeFloat (uchar *p, float value) {
+	quint32 bits;
+	memcpy (&bits, &value, sizeof (bits));
+	qToLittleEndian<quint32> (bits, p);
+}
+
+inline void writeDouble (uchar *p, double value) {
+	quint64 bits;
+	memcpy (&bits, &value, sizeof (bits));
+	qToLittleEndian<quint64> (bits, p);
+}
+
+inline void writeVec3 (uchar *p, const osg::Vec3f &value) {
+	for (int i = 0; i < 3; i++)
+		writeFloat (p + i * 4, value[i]);
+}
+
+inline void writeVec4 (uchar *p, const osg::Vec4 &value) {
+	for (int i = 0; i < 4; i++)
+		writeFloat (p + i * 4, value[i]);
+}
+
+/**
+ * \brief Returns indexes of the nodes (ExporterContext::getNodes), each parent node followed by its nested nodes.
+ */
+QVector<int> nestedOrder (const QVector<Exporter::ExporterContext::NodeData> &nodes) {
+	// vnorene uzly podla rodica, uzly bez rodica v grafe su korene
+	QHash<int, QVector<int> > children;
+	QVector<int> roots;
+
+	for (int i = 0; i < nodes.size (); i++) {
+		int parent = nodes.at (i).parent;
+		if (parent >= 0 && parent != i)
+			children[parent].append (i);
+		else
+			roots.append (i);
+	}
+
+	// prehladavanie do hlbky, deti na zasobnik vkladame odzadu, aby zostalo poradie podla id
+	QVector<int> order;
+	order.reserve (nodes.size ());
+
+	QVector<int> stack;
+	for (int i = roots.size () - 1; i >= 0; i--)
+		stack.append (roots.at (i));
+
+	while (!stack.isEmpty ()) {
+		int node = stack.last ();
+		stack.pop_back ();
+		order.append (node);
+
+		QHash<int, QVector<int> >::const_iterator it = children.constFind (node);
+		if (it != children.constEnd ()) {
+			for (int i = it.value ().size () - 1; i >= 0; i--)
+				stack.append (it.value ().at (i));
+		}
+	}
+
+	return order;
+}
+
+// pocet zaznamov, po ktorych sa aktualizuje priebeh
+const int PROGRESS_STEP = 65536;
+
+} // namespace
+
+namespace Exporter {
+
+bool BinaryExporter::exportGraph (
+	ExporterContext &context
+) {
+	const QVector<ExporterContext::NodeData> &nodes = context.getNodes ();
+	const QVector<ExporterContext::EdgeData> &edges = context.getEdges ();
+	const QVector<ExporterContext::TypeData> &types = context.getTypes ();
+
+	strings_.clear ();
+	stringIndex_.clear ();
+
+	// prazdny retazec ma vzdy index 0
+	(void)addString (QString ());
+
+	// prvky bez typu dostanu prazdny typ za typmi grafu
+	quint32 noType = types.size ();
+	bool untyped = false;
+
+	QByteArray graphSection (16, 0);
+	{
+		uchar *p = (uchar *) graphSection.data ();
+		writeU32 (p, addString (context.getGraphName ()));
+		writeU32 (p + 4, addString (context.getLayoutName ()));
+		writeI64 (p + 8, context.getEleIdCounter ());
+	}
+
+	// uzly - rodic je vzdy pred svojimi vnorenymi uzlami
+	QVector<int> order = nestedOrder (nodes);
+	QVector<quint32> nodeIndex (nodes.size (), Importer::BinaryFormat::NO_PARENT);
+
+	QByteArray nodesSection (8 + nodes.size () * Importer::BinaryFormat::NODE_RECORD_SIZE, 0);
+	writeU32 ((uchar *) nodesSection.data (), nodes.size ());
+
+	for (int i = 0; i < nodes.size (); i++) {
+		const ExporterContext::NodeData &node = nodes.at (order.at (i));
+		uchar *record = (uchar *) nodesSection.data () + 8 + i * Importer::BinaryFormat::NODE_RECORD_SIZE;
+
+		quint32 flags = 0;
+		if (node.fixed)
+			flags |= Importer::BinaryFormat::NODE_FIXED;
+		if (node.hidden)
+			flags |= Importer::BinaryFormat::NODE_HIDDEN;
+		if (node.mergedInto >= 0)
+			flags |= Importer::BinaryFormat::NODE_MERGED;
+
+		untyped = untyped || (node.type < 0);
+
+		writeI64 (record, node.id);
+		writeU32 (record + 8, addString (node.name));
+		writeU32 (record + 12, (node.type >= 0) ? (quint32) node.type : noType);
+		writeVec3 (record + 16, node.position);
+		writeVec4 (record + 28, node.color);
+		writeFloat (record + 44, node.scale);
+		writeU32 (record + 48, (node.parent >= 0) ? nodeIndex.at (node.parent) : Importer::BinaryFormat::NO_PARENT);
+		writeU32 (record + 52, flags);
+
+		nodeIndex[order.at (i)] = i;
+
+		if ((i + 1) % PROGRESS_STEP == 0)
+			context.getInfoHandler ().setProgress ((unsigned int) ((qint64) (i + 1) * 40 / nodes.size ()));
+	}
+
+	// meta uzol moze byt zapisany az za svojimi zlucenymi uzlami, indexy dopiseme ked su zname vsetky
+	for (int i = 0; i < nodes.size (); i++) {
+		const ExporterContext::NodeData &node = nodes.at (order.at (i));
+		uchar *record = (uchar *) nodesSection.data () + 8 + i * Importer::BinaryFormat::NODE_RECORD_SIZE;
+
+		if (node.mergedInto >= 0)
+			writeU32 (record + 56, nodeIndex.at (node.mergedInto));
+	}
+
+	// hrany - aj meta hrany, odkazuju na uzly indexom
+	QByteArray edgesSection (8 + edges.size () * Importer::BinaryFormat::EDGE_RECORD_SIZE, 0);
+	int edgeCount = 0;
+
+	for (int i = 0; i < edges.size (); i++) {
+		const ExporterContext::EdgeData &edge = edges.at (i);
+
+		// hrana k uzlu mimo grafu sa neda obnovit
+		if (edge.src < 0 || edge.dst < 0)
+			continue;
+
+		uchar *record = (uchar *) edgesSection.data () + 8 + edgeCount * Importer::BinaryFormat::EDGE_RECORD_SIZE;
+
+		untyped = untyped || (edge.type < 0);
+
+		writeI64 (record, edge.id);
+		writeU32 (record + 8, addString (edge.name));
+		writeU32 (record + 12, (edge.type >= 0) ? (quint32) edge.type : noType);
+		writeU32 (record + 16, nodeIndex.at (edge.src));
+		writeU32 (record + 20, nodeIndex.at (edge.dst));
+		writeVec4 (record + 24, edge.color);
+		writeFloat (record + 40, edge.scale);
+		writeU32 (record + 44, edge.oriented ? Importer::BinaryFormat::EDGE_ORIENTED : 0);
+
+		edgeCount++;
+
+		if ((i + 1) % PROGRESS_STEP == 0)
+			context.getInfoHandler ().setProgress ((unsigned int) (40 + (qint64) (i + 1) * 40 / edges.size ()));
+	}
+
+	edgesSection.truncate (8 + edgeCount * Importer::BinaryFormat::EDGE_RECORD_SIZE);
+	writeU32 ((uchar *) edgesSection.data (), edgeCount);
+
+	QByteArray nodeAttributesSection = writeAttributes (context.getNodeAttributes ());
+	QByteArray edgeAttributesSection = writeAttributes (context.getEdgeAttributes ());
+
+	// typy a retazce az nakoniec, ked su zname vsetky
+	QByteArray typesSection = writeTypes (types, untyped);
+	QByteArray stringsSection = writeStrings ();
+
+	QVector<quint32> ids;
+	QVector<const QByteArray *> sections;
+	ids << Importer::BinaryFormat::STRINGS << Importer::BinaryFormat::GRAPH << Importer::BinaryFormat::TYPES << Importer::BinaryFormat::NODES << Importer::BinaryFormat::EDGES << Importer::BinaryFormat::NODE_ATTRIBUTES << Importer::BinaryFormat::EDGE_ATTRIBUTES;
+	sections << &stringsSection << &graphSection << &typesSection << &nodesSection << &edgesSection << &nodeAttributesSection << &edgeAttributesSection;
+
+	// hlavicka s tabulkou sekcii
+	QByteArray header (Importer::BinaryFormat::HEADER_SIZE + sections.size () * Importer::BinaryFormat::SECTION_ENTRY_SIZE, 0);
+	uchar *p = (uchar *) header.data ();
+
+	memcpy (p, Importer::BinaryFormat::MAGIC, sizeof (Importer::BinaryFormat::MAGIC));
+	writeU32 (p + 4, Importer::BinaryFormat::VERSION);
+	writeU32 (p + 8, sections.size ());
+
+	QVector<qint64> offsets (sections.size ());
+	qint64 offset = Importer::BinaryFormat::align (header.size ());
+
+	for (int i = 0; i < sections.size (); i++) {
+		uchar *entry = p + Importer::BinaryFormat::HEADER_SIZE + i * Importer::BinaryFormat::SECTION_ENTRY_SIZE;
+
+		offsets[i] = offset;
+		writeU32 (entry, ids.at (i));
+		writeI64 (entry + 8, offset);
+		writeI64 (entry + 16, sections.at (i)->size ());
+
+		offset = Importer::BinaryFormat::align (offset + sections.at (i)->size ());
+	}
+
+	QIODevice &stream = context.getStream ();
+	bool ok = (stream.write (header) == header.size ());
+	qint64 written = header.size ();
+
+	// zapis mohol byt zruseny
+	for (int i = 0; ok && !context.getInfoHandler ().isCancelled () && i < sections.size (); i++) {
+		// zarovnanie sekcie
+		if (offsets.at (i) > written)
+			ok = (stream.write (QByteArray ((int) (offsets.at (i) - written), 0)) == offsets.at (i) - written);
+
+		ok = ok && (stream.write (*sections.at (i)) == sections.at (i)->size ());
+		written = offsets.at (i) + sections.at (i)->size ();
+
+		context.getInfoHandler ().setProgress ((unsigned int) (80 + (i + 1) * 20 / sections.size ()));
+	}
+
+	context.getInfoHandler ().reportError (ok, "Subor nie je mozne zapisat.");
+
+	return ok && !context.getInfoHandler ().isCancelled ();
+}
+
+quint32 BinaryExporter::addString (
+	const QString &text
+) {
+	QHash<QString, quint32>::const_iterator it = stringIndex_.constFind (text);
+	if (it != stringIndex_.constEnd ())
+		return it.value ();
+
+	quint32 index = strings_.size ();
+	stringIndex_.insert (text, index);
+	strings_.append (text.toUtf8 ());
+
+	return index;
+}
+
+QByteArray BinaryExporter::writeStrings (void) const {
+	qint64 textsSize = 0;
+	for (int i = 0; i < strings_.size (); i++)
+		textsSize += strings_.at (i).size ();
+
+	qint64 offsetsSize = ((qint64) strings_.size () + 1) * 8;
+	QByteArray section ((int) (8 + offsetsSize + textsSize), 0);
+	uchar *p = (uchar *) section.data ();
+
+	writeU32 (p, strings_.size ());
+
+	uchar *offsets = p + 8;
+	char *texts = section.data () + 8 + offsetsSize;
+	qint64 offset = 0;
+
+	for (int i = 0; i < strings_.size (); i++) {
+		writeI64 (offsets + (qint64) i * 8, offset);
+		memcpy (texts + offset, strings_.at (i).constData (), strings_.at (i).size ());
+		offset += strings_.at (i).size ();
+	}
+	writeI64 (offsets + (qint64) strings_.size () * 8, offset);
+
+	return section;
+}
+
+QByteArray BinaryExporter::writeTypes (
+	const QVector<ExporterContext::TypeData> &types,
+	bool untyped
+) {
+	QByteArray section (8, 0);
+	writeU32 ((uchar *) section.data (), types.size () + (untyped ? 1 : 0));
+
+	for (int i = 0; i < types.size (); i++) {
+		const ExporterContext::TypeData &type = types.at (i);
+
+		QByteArray record (16 + type.settings.size () * 8, 0);
+		uchar *p = (uchar *) record.data ();
+
+		writeU32 (p, addString (type.name));
+		writeU32 (p + 4, type.meta ? Importer::BinaryFormat::TYPE_META : 0);
+		writeU32 (p + 8, type.settings.size ());
+		p += 16;
+
+		for (QMap<QString, QString>::const_iterator it = type.settings.constBegin (); it != type.settings.constEnd (); ++it, p += 8) {
+			writeU32 (p, addString (it.key ()));
+			writeU32 (p + 4, addString (it.value ()));
+		}
+
+		section += record;
+	}
+
+	// prazdny typ pre prvky bez typu (nazov ma index 0)
+	if (untyped)
+		section += QByteArray (16, 0);
+
+	return section;
+}
+
+QByteArray BinaryExporter::writeAttributes (
+	const Data::AttributeStore &store
+) {
+	int rowCount = store.rowCount ();
+	QStringList names = store.getColumnNames ();
+
+	qint64 bitmapSize = Importer::BinaryFormat::align ((rowCount + 7) / 8);
+
+	QByteArray section (8 + rowCount * 8, 0);
+	uchar *p = (uchar *) section.data ();
+
+	writeU32 (p, rowCount);
+	writeU32 (p + 4, names.size ());
+	for (int r = 0; r < rowCount; r++)
+		writeI64 (p + 8 + (qint64) r * 8, store.getId (r));
+
+	for (int c = 0; c < names.size (); c++) {
+		Data::AttributeColumn *column = store.getColumn (names.at (c));
+		Data::AttributeColumn::ValueType valueType = column->getValueType ();
+
+		qint64 valueSize = (valueType == Data::AttributeColumn::INT || valueType == Data::AttributeColumn::DOUBLE) ? 8 : (valueType == Data::AttributeColumn::BOOL) ? 1 : 4;
+		qint64 valuesSize = Importer::BinaryFormat::align (valueSize * rowCount);
+
+		QByteArray data ((int) (8 + bitmapSize + valuesSize), 0);
+		uchar *header = (uchar *) data.data ();
+		uchar *valid = header + 8;
+		uchar *values = valid + bitmapSize;
+
+		writeU32 (header, addString (names.at (c)));
+		writeU32 (header + 4, valueType);
+
+		for (int r = 0; r < rowCount; r++) {
+			if (column->isNull (r))
+				continue;
+
+			valid[r / 8] |= (uchar) (1 << (r % 8));
+
+			QVariant value = column->getValue (r);
+			switch (valueType) {
+				case Data::AttributeColumn::INT:
+					writeI64 (values + (qint64) r * 8, value.toLongLong ());
+					break;
+				case Data::AttributeColumn::FLOAT:
+					writeFloat (values + (qint64) r * 4, value.toFloat ());
+					break;
+				case Data::AttributeColumn::STRING:
+					writeU32 (values + (qint64) r * 4, addString (value.toString ()));
+					break;
+				case Data::AttributeColumn::BOOL:
+					values[r] = value.toBool () ? 1 : 0;
+					break;
+				case Data::AttributeColumn::DOUBLE:
+					writeDouble (values + (qint64) r * 8, value.toDouble ());
+					break;
+			}
+		}
+
+		section += data;
+	}
+
+	return section;
+}
+
+} // namespace
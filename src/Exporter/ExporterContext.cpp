@@ -0,0 +1,178 @@
+#include "Exporter/ExporterContext.h"
+//-----------------------------------------------------------------------------
+#include "Data/Edge.h"
+#include "Data/GraphLayout.h"
+#include "Data/Node.h"
+#include "Data/Type.h"
+//-----------------------------------------------------------------------------
+
+namespace Exporter {
+
+ExporterContext::ExporterContext (
+	QIODevice &stream,
+	Data::Graph &graph,
+	Importer::ImportInfoHandler &infoHandler
+) : stream_ (stream),
+	graph_ (graph),
+	infoHandler_ (infoHandler),
+	graphName_ (graph.getName ()),
+	layoutName_ (graph.getSelectedLayout () != NULL ? graph.getSelectedLayout ()->getName () : QString ()),
+	eleIdCounter_ (graph.getEleIdCounter ())
+{
+	QSharedPointer<Data::GraphSnapshot> snapshot = graph.getSnapshot ();
+	QHash<Data::Type *, int> typeIndex;
+
+	// atributy a typy moze zaroven menit import, kopirujeme ich pod zamkom grafu
+	QMutexLocker locker (graph.getStructureMutex ());
+	nodeAttributes_ = *graph.getNodeAttributes ();
+	edgeAttributes_ = *graph.getEdgeAttributes ();
+
+	// vsetky typy grafu, aj ked ich nepouziva ziadny uzol
+	for (QMap<qlonglong, Data::Type *>::const_iterator it = graph.getTypes ()->constBegin (); it != graph.getTypes ()->constEnd (); ++it)
+		(void)addType (it.value (), typeIndex);
+
+	// uzly, hrany a typy meni vlakno GUI a pozicie vlakno layoutu, vlakno exportu cita len ich kopie
+	nodes_.reserve (snapshot->getNodes ().size () + snapshot->getMetaNodes ().size ());
+	QVector<Data::Node *> nodes;
+	nodes.reserve (nodes_.capacity ());
+	QHash<Data::Node *, int> nodeIndex;
+	nodeIndex.reserve (nodes_.capacity ());
+
+	const QMap<qlonglong, osg::ref_ptr<Data::Node> > *nodeLists[] = {&snapshot->getNodes (), &snapshot->getMetaNodes ()};
+	for (int l = 0; l < 2; l++) {
+		for (QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator it = nodeLists[l]->constBegin (); it != nodeLists[l]->constEnd (); ++it) {
+			Data::Node *node = it.value ().get ();
+
+			NodeData data;
+			data.id = node->getId ();
+			data.name = node->getName ();
+			data.type = addType (node->getType (), typeIndex);
+			data.parent = -1;
+			data.mergedInto = -1;
+			data.position = node->getTargetPosition ();
+			data.color = node->getColor ();
+			data.scale = node->getScale ();
+			data.meta = (l == 1);
+			data.fixed = node->isFixed ();
+			data.hidden = (node->getNodeMask () == 0);
+
+			nodeIndex.insert (node, nodes_.size ());
+			nodes.append (node);
+			nodes_.append (data);
+		}
+	}
+
+	// rodica urcime az ked su zname indexy vsetkych uzlov
+	for (int i = 0; i < nodes.size (); i++) {
+		Data::Node *parent = nodes.at (i)->getParentNode ();
+		if (parent != nodes.at (i))
+			nodes_[i].parent = nodeIndex.value (parent, -1);
+	}
+
+	// zlucene uzly si pamataju svoj meta uzol, aby sa dali po nacitani znovu oddelit
+	QHash<qlonglong, QList<osg::ref_ptr<Data::Node> > > mergedGroups = graph.getMergedGroups ();
+	for (QHash<qlonglong, QList<osg::ref_ptr<Data::Node> > >::const_iterator it = mergedGroups.constBegin (); it != mergedGroups.constEnd (); ++it) {
+		int metaNode = nodeIndex.value (snapshot->getMetaNodes ().value (it.key ()).get (), -1);
+		if (metaNode < 0)
+			continue;
+
+		for (int i = 0; i < it.value ().size (); i++) {
+			int node = nodeIndex.value (it.value ().at (i).get (), -1);
+			if (node >= 0)
+				nodes_[node].mergedInto = metaNode;
+		}
+	}
+
+	edges_.reserve (snapshot->getEdges ().size () + snapshot->getMetaEdges ().size ());
+
+	const QMap<qlonglong, osg::ref_ptr<Data::Edge> > *edgeLists[] = {&snapshot->getEdges (), &snapshot->getMetaEdges ()};
+	for (int l = 0; l < 2; l++) {
+		for (QMap<qlonglong, osg::ref_ptr<Data::Edge> >::const_iterator it = edgeLists[l]->constBegin (); it != edgeLists[l]->constEnd (); ++it) {
+			Data::Edge *edge = it.value ().get ();
+
+			EdgeData data;
+			data.id = edge->getId ();
+			// odvodene meno neskladame, zostane prazdne a pri nacitani sa znovu odvodi
+			if (edge->hasOwnName ())
+				data.name = edge->getName ();
+			data.type = addType (edge->getType (), typeIndex);
+			data.src = nodeIndex.value (edge->getSrcNode ().get (), -1);
+			data.dst = nodeIndex.value (edge->getDstNode ().get (), -1);
+			data.color = edge->getEdgeColor ();
+			data.scale = edge->getScale ();
+			data.meta = (l == 1);
+			data.oriented = edge->isOriented ();
+
+			edges_.append (data);
+		}
+	}
+}
+
+int ExporterContext::addType (
+	Data::Type *type,
+	QHash<Data::Type *, int> &typeIndex
+) {
+	if (type == NULL)
+		return -1;
+
+	QHash<Data::Type *, int>::const_iterator it = typeIndex.constFind (type);
+	if (it != typeIndex.constEnd ())
+		return it.value ();
+
+	TypeData data;
+	data.name = type->getName ();
+	data.meta = type->isMeta ();
+	if (type->getSettings () != NULL)
+		data.settings = *type->getSettings ();
+
+	typeIndex.insert (type, types_.size ());
+	types_.append (data);
+
+	return types_.size () - 1;
+}
+
+QIODevice &ExporterContext::getStream (void) {
+	return stream_;
+}
+
+Data::Graph &ExporterContext::getGraph (void) {
+	return graph_;
+}
+
+Importer::ImportInfoHandler &ExporterContext::getInfoHandler (void) {
+	return infoHandler_;
+}
+
+const QVector<ExporterContext::NodeData> &ExporterContext::getNodes (void) const {
+	return nodes_;
+}
+
+const QVector<ExporterContext::EdgeData> &ExporterContext::getEdges (void) const {
+	return edges_;
+}
+
+const Data::AttributeStore &ExporterContext::getNodeAttributes (void) const {
+	return nodeAttributes_;
+}
+
+const Data::AttributeStore &ExporterContext::getEdgeAttributes (void) const {
+	return edgeAttributes_;
+}
+
+const QVector<ExporterContext::TypeData> &ExporterContext::getTypes (void) const {
+	return types_;
+}
+
+const QString &ExporterContext::getGraphName (void) const {
+	return graphName_;
+}
+
+const QString &ExporterContext::getLayoutName (void) const {
+	return layoutName_;
+}
+
+qlonglong ExporterContext::getEleIdCounter (void) const {
+	return eleIdCounter_;
+}
+
+} // namespace
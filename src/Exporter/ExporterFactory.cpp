@@ -0,0 +1,37 @@
+#include "Exporter/ExporterFactory.h"
+//-----------------------------------------------------------------------------
+#include "Exporter/BinaryExporter.h"
+#include "Exporter/GraphMLExporter.h"
+#include "Exporter/PositionsExporter.h"
+//-----------------------------------------------------------------------------
+
+namespace Exporter {
+
+bool ExporterFactory::createByFileExtension (
+	std::auto_ptr<StreamExporter> &exporter,
+	bool &exporterFound,
+	const QString &fileExtension
+) {
+	bool ok = true;
+
+	exporterFound = false;
+
+	if (0 == fileExtension.compare ("3dv", Qt::CaseInsensitive)) {
+		exporter.reset (new BinaryExporter);
+		exporterFound = true;
+	}
+
+	if (0 == fileExtension.compare ("graphml", Qt::CaseInsensitive)) {
+		exporter.reset (new GraphMLExporter);
+		exporterFound = true;
+	}
+
+	if (0 == fileExtension.compare ("pos", Qt::CaseInsensitive)) {
+		exporter.reset (new PositionsExporter);
+		exporterFound = true;
+	}
+
+	return ok;
+}
+
+} // namespace
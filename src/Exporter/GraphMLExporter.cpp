@@ -0,0 +1,256 @@
+#include "Exporter/GraphMLExporter.h"
+//-----------------------------------------------------------------------------
+#include "Util/ApplicationConfig.h"
+//-----------------------------------------------------------------------------
+#include <QSet>
+#include <QStringList>
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/**
+ * \brief Returns name of the GraphML type (attr.type) of the column.
+ */
+QString graphMLTypeName (Data::AttributeColumn::ValueType valueType) {
+	switch (valueType) {
+		case Data::AttributeColumn::INT:
+			return "long";
+		case Data::AttributeColumn::FLOAT:
+			return "float";
+		case Data::AttributeColumn::DOUBLE:
+			return "double";
+		case Data::AttributeColumn::BOOL:
+			return "boolean";
+		default:
+			return "string";
+	}
+}
+
+// pocet elementov, po ktorych sa aktualizuje priebeh
+const int PROGRESS_STEP = 4096;
+
+} // namespace
+
+namespace Exporter {
+
+GraphMLExporter::GraphMLExporter (void) {
+	Util::ApplicationConfig *appConf = Util::ApplicationConfig::get ();
+
+	// typy zapisujeme pod klucmi, podla ktorych ich rozpozna GraphMLImporter
+	nodeTypeAttribute_ = appConf->getValue ("GraphMLParser.nodeTypeAttribute");
+	edgeTypeAttribute_ = appConf->getValue ("GraphMLParser.edgeTypeAttribute");
+
+	if (nodeTypeAttribute_.isEmpty ())
+		nodeTypeAttribute_ = "type";
+	if (edgeTypeAttribute_.isEmpty ())
+		edgeTypeAttribute_ = "relation";
+}
+
+bool GraphMLExporter::exportGraph (
+	ExporterContext &context
+) {
+	const QVector<ExporterContext::NodeData> &nodes = context.getNodes ();
+	const QVector<ExporterContext::EdgeData> &edges = context.getEdges ();
+	const QVector<ExporterContext::TypeData> &types = context.getTypes ();
+
+	qint64 total = nodes.size () + edges.size ();
+	qint64 written = 0;
+	bool ok = true;
+
+	QXmlStreamWriter writer (&context.getStream ());
+	writer.setAutoFormatting (true);
+
+	writer.writeStartDocument ();
+	writer.writeStartElement ("graphml");
+	writer.writeDefaultNamespace ("http://graphml.graphdrawing.org/xmlns");
+
+	// deklaracie klucov - typy, pozicie a atributy
+	writeKey (writer, nodeTypeAttribute_, "node", nodeTypeAttribute_, "string");
+	writeKey (writer, edgeTypeAttribute_, "edge", edgeTypeAttribute_, "string");
+	writeKey (writer, "x", "node", "x", "float");
+	writeKey (writer, "y", "node", "y", "float");
+	writeKey (writer, "z", "node", "z", "float");
+
+	KeysListType nodeKeys = writeKeys (writer, context.getNodeAttributes (), "n", "node");
+	KeysListType edgeKeys = writeKeys (writer, context.getEdgeAttributes (), "e", "edge");
+
+	writer.writeStartElement ("graph");
+	writer.writeAttribute ("id", context.getGraphName ());
+	writer.writeAttribute ("edgedefault", "undirected");
+
+	// mena uzlov su ich id, meta uzly sa nezapisuju (prazdne id)
+	QVector<QString> nodeIds = uniqueNodeIds (nodes);
+
+	for (int i = 0; ok && i < nodes.size (); i++) {
+		const ExporterContext::NodeData &node = nodes.at (i);
+		if (node.meta)
+			continue;
+
+		writer.writeStartElement ("node");
+		writer.writeAttribute ("id", nodeIds.at (i));
+
+		if (node.type >= 0)
+			writeData (writer, nodeTypeAttribute_, types.at (node.type).name);
+
+		writeData (writer, "x", QString::number (node.position.x ()));
+		writeData (writer, "y", QString::number (node.position.y ()));
+		writeData (writer, "z", QString::number (node.position.z ()));
+
+		writeAttributes (writer, context.getNodeAttributes (), nodeKeys, node.id);
+
+		writer.writeEndElement ();
+
+		if (++written % PROGRESS_STEP == 0) {
+			context.getInfoHandler ().setProgress ((unsigned int) (written * 100 / total));
+
+			// zapis mohol byt zruseny
+			ok = !context.getInfoHandler ().isCancelled () && !writer.hasError ();
+		}
+	}
+
+	for (int i = 0; ok && i < edges.size (); i++) {
+		const ExporterContext::EdgeData &edge = edges.at (i);
+
+		// hrana k uzlu mimo grafu alebo k meta uzlu by sa nedala nacitat
+		if (edge.meta || edge.src < 0 || edge.dst < 0 || nodeIds.at (edge.src).isEmpty () || nodeIds.at (edge.dst).isEmpty ())
+			continue;
+
+		writer.writeStartElement ("edge");
+		writer.writeAttribute ("source", nodeIds.at (edge.src));
+		writer.writeAttribute ("target", nodeIds.at (edge.dst));
+
+		if (edge.oriented)
+			writer.writeAttribute ("directed", "true");
+
+		if (edge.type >= 0)
+			writeData (writer, edgeTypeAttribute_, types.at (edge.type).name);
+
+		writeAttributes (writer, context.getEdgeAttributes (), edgeKeys, edge.id);
+
+		writer.writeEndElement ();
+
+		if (++written % PROGRESS_STEP == 0) {
+			context.getInfoHandler ().setProgress ((unsigned int) (written * 100 / total));
+
+			// zapis mohol byt zruseny
+			ok = !context.getInfoHandler ().isCancelled () && !writer.hasError ();
+		}
+	}
+
+	if (ok) {
+		writer.writeEndDocument ();
+		ok = !writer.hasError ();
+
+		context.getInfoHandler ().reportError (ok, "Subor nie je mozne zapisat.");
+	}
+
+	return ok && !context.getInfoHandler ().isCancelled ();
+}
+
+QVector<QString> GraphMLExporter::uniqueNodeIds (
+	const QVector<ExporterContext::NodeData> &nodes
+) {
+	QVector<QString> ids (nodes.size ());
+
+	// vsetky mena uzlov, nahradne id nesmie byt zhodne so ziadnym z nich
+	QSet<QString> names;
+	names.reserve (nodes.size ());
+	for (int i = 0; i < nodes.size (); i++) {
+		if (!nodes.at (i).meta)
+			names.insert (nodes.at (i).name);
+	}
+
+	QSet<QString> usedIds;
+	usedIds.reserve (nodes.size ());
+
+	for (int i = 0; i < nodes.size (); i++) {
+		const ExporterContext::NodeData &node = nodes.at (i);
+		if (node.meta)
+			continue;
+
+		// uzly s prazdnym alebo opakovanym menom maju id podla id uzla
+		QString id = node.name;
+		if (id.isEmpty () || usedIds.contains (id)) {
+			QString base = "n" + QString::number (node.id);
+			id = base;
+			for (int suffix = 1; names.contains (id) || usedIds.contains (id); suffix++)
+				id = base + "_" + QString::number (suffix);
+		}
+
+		usedIds.insert (id);
+		ids[i] = id;
+	}
+
+	return ids;
+}
+
+GraphMLExporter::KeysListType GraphMLExporter::writeKeys (
+	QXmlStreamWriter &writer,
+	const Data::AttributeStore &store,
+	const QString &prefix,
+	const QString &keyFor
+) {
+	KeysListType keys;
+	QStringList names = store.getColumnNames ();
+
+	for (int i = 0; i < names.size (); i++) {
+		Data::AttributeColumn *column = store.getColumn (names.at (i));
+		QString id = prefix + QString::number (i);
+
+		writeKey (writer, id, keyFor, names.at (i), graphMLTypeName (column->getValueType ()));
+		keys.append (qMakePair (column, id));
+	}
+
+	return keys;
+}
+
+void GraphMLExporter::writeKey (
+	QXmlStreamWriter &writer,
+	const QString &id,
+	const QString &keyFor,
+	const QString &name,
+	const QString &type
+) {
+	writer.writeEmptyElement ("key");
+	writer.writeAttribute ("id", id);
+	writer.writeAttribute ("for", keyFor);
+	writer.writeAttribute ("attr.name", name);
+	writer.writeAttribute ("attr.type", type);
+}
+
+void GraphMLExporter::writeAttributes (
+	QXmlStreamWriter &writer,
+	const Data::AttributeStore &store,
+	const KeysListType &keys,
+	qlonglong id
+) {
+	int row = store.getRow (id);
+	if (row < 0)
+		return;
+
+	for (KeysListType::const_iterator it = keys.constBegin (); it != keys.constEnd (); ++it) {
+		Data::AttributeColumn *column = it->first;
+		if (column->isNull (row))
+			continue;
+
+		QVariant value = column->getValue (row);
+
+		if (column->getValueType () == Data::AttributeColumn::BOOL)
+			writeData (writer, it->second, value.toBool () ? "true" : "false");
+		else
+			writeData (writer, it->second, value.toString ());
+	}
+}
+
+void GraphMLExporter::writeData (
+	QXmlStreamWriter &writer,
+	const QString &key,
+	const QString &value
+) {
+	writer.writeStartElement ("data");
+	writer.writeAttribute ("key", key);
+	writer.writeCharacters (value);
+	writer.writeEndElement ();
+}
+
+} // namespace
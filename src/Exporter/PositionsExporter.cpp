@@ -0,0 +1,72 @@
+#include "Exporter/PositionsExporter.h"
+//-----------------------------------------------------------------------------
+#include <QByteArray>
+#include <QtEndian>
+//-----------------------------------------------------------------------------
+#include <string.h>
+
+namespace {
+
+inline void writeFloat (uchar *p, float value) {
+	quint32 bits;
+	memcpy (&bits, &value, sizeof (bits));
+	qToLittleEndian<quint32> (bits, p);
+}
+
+// pocet zaznamov zapisanych naraz
+const int BLOCK_RECORDS = 4096;
+
+} // namespace
+
+namespace Exporter {
+
+const char PositionsExporter::MAGIC[4] = {'3', 'D', 'V', 'P'};
+
+bool PositionsExporter::exportGraph (
+	ExporterContext &context
+) {
+	const QVector<ExporterContext::NodeData> &nodes = context.getNodes ();
+	QIODevice &stream = context.getStream ();
+
+	QByteArray header (HEADER_SIZE, 0);
+	uchar *p = (uchar *) header.data ();
+	memcpy (p, MAGIC, sizeof (MAGIC));
+	qToLittleEndian<quint32> (VERSION, p + 4);
+	qToLittleEndian<qint64> (nodes.size (), p + 8);
+
+	bool ok = (stream.write (header) == header.size ());
+
+	// zaznamy zapisujeme po blokoch, uzly aj meta uzly v poradi kontextu
+	QByteArray block (BLOCK_RECORDS * RECORD_SIZE, 0);
+	int blockRecords = 0;
+
+	for (int index = 0; ok && index < nodes.size (); index++) {
+		uchar *record = (uchar *) block.data () + blockRecords * RECORD_SIZE;
+		const osg::Vec3f &position = nodes.at (index).position;
+
+		qToLittleEndian<qint64> (nodes.at (index).id, record);
+		writeFloat (record + 8, position.x ());
+		writeFloat (record + 12, position.y ());
+		writeFloat (record + 16, position.z ());
+
+		if (++blockRecords == BLOCK_RECORDS) {
+			ok = (stream.write (block) == block.size ());
+			blockRecords = 0;
+
+			context.getInfoHandler ().setProgress ((unsigned int) ((qint64) (index + 1) * 100 / nodes.size ()));
+
+			// zapis mohol byt zruseny
+			ok = ok && !context.getInfoHandler ().isCancelled ();
+		}
+	}
+
+	if (ok && blockRecords > 0)
+		ok = (stream.write (block.constData (), blockRecords * RECORD_SIZE) == blockRecords * RECORD_SIZE);
+
+	if (!context.getInfoHandler ().isCancelled ())
+		context.getInfoHandler ().reportError (ok, "Subor nie je mozne zapisat.");
+
+	return ok;
+}
+
+} // namespace
@@ -0,0 +1,228 @@
+#include "Generator/GraphGenerator.h"
+//-----------------------------------------------------------------------------
+#include <QSet>
+//-----------------------------------------------------------------------------
+#include <cmath>
+
+namespace Generator {
+
+GraphGenerator::GraphGenerator (
+	quint64 seed
+) : state_ (seed)
+{
+}
+
+GeneratedGraph GraphGenerator::erdosRenyi (
+	int nodeCount,
+	qint64 edgeCount
+) {
+	GeneratedGraph graph;
+	graph.name = QString ("er-%1-%2").arg (nodeCount).arg (edgeCount);
+	graph.nodeCount = nodeCount;
+
+	// viac roznych hran graf nemoze mat
+	qint64 maxEdges = (qint64) nodeCount * (nodeCount - 1) / 2;
+	if (edgeCount > maxEdges)
+		edgeCount = maxEdges;
+
+	graph.edges.reserve ((int) edgeCount);
+
+	QSet<qint64> used;
+	used.reserve ((int) edgeCount);
+
+	while (graph.edges.size () < edgeCount) {
+		int src = (int) nextInt (nodeCount);
+		int dst = (int) nextInt (nodeCount);
+		if (src == dst)
+			continue;
+
+		// neorientovana hrana - kluc nezavisi od poradia uzlov
+		qint64 key = (qint64) qMin (src, dst) * nodeCount + qMax (src, dst);
+		if (used.contains (key))
+			continue;
+
+		used.insert (key);
+		graph.edges.append (qMakePair (src, dst));
+	}
+
+	return graph;
+}
+
+GeneratedGraph GraphGenerator::barabasiAlbert (
+	int nodeCount,
+	int edgesPerNode
+) {
+	GeneratedGraph graph;
+	graph.name = QString ("ba-%1-%2").arg (nodeCount).arg (edgesPerNode);
+	graph.nodeCount = nodeCount;
+
+	if (edgesPerNode < 1 || nodeCount <= edgesPerNode)
+		return graph;
+
+	graph.edges.reserve ((nodeCount - edgesPerNode) * edgesPerNode);
+
+	// kazdy uzol je v zozname tolkokrat, kolko ma hran - nahodny prvok zoznamu je vybrany umerne stupnu
+	QVector<int> repeated;
+	repeated.reserve (2 * (nodeCount - edgesPerNode) * edgesPerNode);
+
+	QVector<int> targets;
+	targets.reserve (edgesPerNode);
+
+	// prvy pridany uzol spojime so vsetkymi pociatocnymi uzlami
+	for (int i = 0; i < edgesPerNode; i++)
+		targets.append (i);
+
+	for (int node = edgesPerNode; node < nodeCount; node++) {
+		for (int i = 0; i < targets.size (); i++) {
+			graph.edges.append (qMakePair (node, targets.at (i)));
+			repeated.append (node);
+			repeated.append (targets.at (i));
+		}
+
+		// ciele dalsieho uzla - rozne uzly
+		targets.clear ();
+		while (targets.size () < edgesPerNode) {
+			int target = repeated.at ((int) nextInt (repeated.size ()));
+			if (!targets.contains (target))
+				targets.append (target);
+		}
+	}
+
+	return graph;
+}
+
+GeneratedGraph GraphGenerator::grid (
+	int width,
+	int height,
+	int depth
+) {
+	GeneratedGraph graph;
+	graph.name = QString ("grid-%1x%2x%3").arg (width).arg (height).arg (depth);
+	graph.nodeCount = width * height * depth;
+	graph.edges.reserve (3 * graph.nodeCount);
+
+	for (int z = 0; z < depth; z++) {
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				int node = (z * height + y) * width + x;
+
+				if (x + 1 < width)
+					graph.edges.append (qMakePair (node, node + 1));
+				if (y + 1 < height)
+					graph.edges.append (qMakePair (node, node + width));
+				if (z + 1 < depth)
+					graph.edges.append (qMakePair (node, node + width * height));
+			}
+		}
+	}
+
+	return graph;
+}
+
+GeneratedGraph GraphGenerator::randomTree (
+	int nodeCount
+) {
+	GeneratedGraph graph;
+	graph.name = QString ("tree-%1").arg (nodeCount);
+	graph.nodeCount = nodeCount;
+	graph.edges.reserve (qMax (nodeCount - 1, 0));
+
+	for (int node = 1; node < nodeCount; node++)
+		graph.edges.append (qMakePair ((int) nextInt (node), node));
+
+	return graph;
+}
+
+GeneratedGraph GraphGenerator::nestedClusters (
+	int levels,
+	int branching,
+	int clusterSize,
+	int degree,
+	double locality
+) {
+	GeneratedGraph graph;
+	graph.name = QString ("clusters-%1-%2-%3-%4").arg (levels).arg (branching).arg (clusterSize).arg (degree);
+
+	int clusterCount = 1;
+	for (int i = 0; i < levels; i++)
+		clusterCount *= branching;
+
+	graph.nodeCount = clusterCount * clusterSize;
+	if (graph.nodeCount < 2)
+		return graph;
+
+	graph.edges.reserve (graph.nodeCount * degree);
+	graph.clusters.reserve (graph.nodeCount);
+
+	for (int node = 0; node < graph.nodeCount; node++)
+		graph.clusters.append (node / clusterSize);
+
+	for (int node = 0; node < graph.nodeCount; node++) {
+		for (int i = 0; i < degree; i++) {
+			// kazdy krok vyssie zvacsi blok uzlov, v ktorom je druhy uzol hrany, branching krat
+			int blockSize = clusterSize;
+			for (int level = 0; level < levels && nextDouble () >= locality; level++)
+				blockSize *= branching;
+
+			// zhluk s jednym uzlom - hrana musi ist aspon o uroven vyssie
+			if (blockSize < 2)
+				blockSize = qMin (branching, graph.nodeCount);
+
+			int blockStart = node / blockSize * blockSize;
+			int target;
+			do {
+				target = blockStart + (int) nextInt (blockSize);
+			} while (target == node);
+
+			graph.edges.append (qMakePair (node, target));
+		}
+	}
+
+	return graph;
+}
+
+bool GraphGenerator::generate (
+	const QString &model,
+	int nodeCount,
+	GeneratedGraph &graph
+) {
+	if (model == "er") {
+		graph = erdosRenyi (nodeCount, (qint64) nodeCount * 4);
+	} else if (model == "ba") {
+		graph = barabasiAlbert (nodeCount, 4);
+	} else if (model == "grid") {
+		int side = (int) std::ceil (std::sqrt ((double) nodeCount));
+		graph = grid (side, side, 1);
+	} else if (model == "tree") {
+		graph = randomTree (nodeCount);
+	} else if (model == "clusters") {
+		// 64 zhlukov v troch urovniach
+		graph = nestedClusters (3, 4, qMax (nodeCount / 64, 1), 4, 0.8);
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+quint64 GraphGenerator::next (void) {
+	// splitmix64
+	quint64 z = (state_ += Q_UINT64_C (0x9E3779B97F4A7C15));
+	z = (z ^ (z >> 30)) * Q_UINT64_C (0xBF58476D1CE4E5B9);
+	z = (z ^ (z >> 27)) * Q_UINT64_C (0x94D049BB133111EB);
+	return z ^ (z >> 31);
+}
+
+qint64 GraphGenerator::nextInt (
+	qint64 bound
+) {
+	// odchylka modula je pri 64-bitovych cislach zanedbatelna
+	return (qint64) (next () % (quint64) bound);
+}
+
+double GraphGenerator::nextDouble (void) {
+	// 53 bitov - presnost double
+	return (double) (next () >> 11) / (double) (Q_UINT64_C (1) << 53);
+}
+
+} // namespace
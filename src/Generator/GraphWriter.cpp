@@ -0,0 +1,239 @@
+#include "Generator/GraphWriter.h"
+//-----------------------------------------------------------------------------
+#include "Exporter/BinaryExporter.h"
+#include "Exporter/ExporterContext.h"
+#include "Data/Node.h"
+//-----------------------------------------------------------------------------
+#include <QVector>
+//-----------------------------------------------------------------------------
+#include <cmath>
+#include <memory>
+
+namespace {
+
+/**
+ * \brief Writes the buffer to the stream if it is full (or always if force is set) and clears it.
+ */
+bool flushBuffer (QIODevice &stream, QByteArray &buffer, bool force) {
+	if (!force && buffer.size () < (1 << 20))
+		return true;
+
+	bool ok = (stream.write (buffer) == buffer.size ());
+	buffer.clear ();
+
+	return ok;
+}
+
+// pocet elementov, po ktorych sa aktualizuje priebeh
+const int PROGRESS_STEP = 4096;
+
+} // namespace
+
+namespace Generator {
+
+GraphWriter::GraphWriter (
+	const GeneratedGraph &graph
+) : graph_ (graph)
+{
+}
+
+QStringList GraphWriter::getFormats (void) {
+	return QStringList () << "graphml" << "gxl" << "rsf" << "mtx" << "csv" << "tsv" << "dot" << "3dv";
+}
+
+bool GraphWriter::write (
+	const QString &format,
+	QIODevice &stream,
+	Importer::ImportInfoHandler &infoHandler
+) {
+	if (format == "3dv")
+		return writeBinary (stream, infoHandler);
+
+	QByteArray name = graph_.name.toUtf8 ();
+
+	TextFormat text;
+	text.numericNames = false;
+
+	if (format == "graphml") {
+		text.header =
+			"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+			"<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n"
+			"<key id=\"cluster\" for=\"node\" attr.name=\"cluster\" attr.type=\"int\"/>\n"
+			"<graph id=\"" + name + "\" edgedefault=\"undirected\">\n";
+		text.nodePrefix = "<node id=\"";
+		text.clusterPrefix = "\"><data key=\"cluster\">";
+		text.clusterSuffix = "</data></node>\n";
+		text.nodeSuffix = "\"/>\n";
+		text.edgePrefix = "<edge source=\"";
+		text.edgeSeparator = "\" target=\"";
+		text.edgeSuffix = "\"/>\n";
+		text.footer = "</graph>\n</graphml>\n";
+	} else if (format == "gxl") {
+		text.header =
+			"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+			"<gxl>\n"
+			"<graph id=\"" + name + "\" edgemode=\"undirected\">\n";
+		text.nodePrefix = "<node id=\"";
+		text.nodeSuffix = "\"/>\n";
+		text.edgePrefix = "<edge from=\"";
+		text.edgeSeparator = "\" to=\"";
+		text.edgeSuffix = "\"/>\n";
+		text.footer = "</graph>\n</gxl>\n";
+	} else if (format == "rsf") {
+		// uzly su len v hranach, relacia nesmie byt "tagged"
+		text.edgePrefix = "edge ";
+		text.edgeSeparator = " ";
+		text.edgeSuffix = "\n";
+	} else if (format == "mtx") {
+		text.header =
+			"%%MatrixMarket matrix coordinate pattern general\n"
+			"% " + name + "\n"
+			+ QByteArray::number (graph_.nodeCount) + " " + QByteArray::number (graph_.nodeCount) + " "
+			+ QByteArray::number (graph_.edges.size ()) + "\n";
+		text.edgeSeparator = " ";
+		text.edgeSuffix = "\n";
+		text.numericNames = true;
+	} else if (format == "csv" || format == "tsv") {
+		QByteArray separator = (format == "csv") ? "," : "\t";
+
+		text.header = "source" + separator + "target\n";
+		text.edgeSeparator = separator;
+		text.edgeSuffix = "\n";
+	} else if (format == "dot") {
+		text.header = "graph \"" + name + "\" {\n";
+		text.edgeSeparator = " -- ";
+		text.edgeSuffix = ";\n";
+		text.footer = "}\n";
+	} else {
+		infoHandler.reportError ("Format " + format + " nie je podporovany.");
+		return false;
+	}
+
+	return writeText (stream, infoHandler, text);
+}
+
+Data::Graph *GraphWriter::createGraph (void) const {
+	Data::Graph *graph = new Data::Graph (1, graph_.name, 0, 0, NULL);
+	graph->selectLayout (graph->addLayout ("new Layout"));
+
+	graph->beginBulkInsert (graph_.nodeCount, graph_.edges.size ());
+
+	Data::Type *nodeType = graph->addType ("node");
+	Data::Type *edgeType = graph->addType ("edge");
+
+	Data::AttributeStore *nodeAttributes = graph->getNodeAttributes ();
+	Data::AttributeColumn *clusterColumn = NULL;
+	if (!graph_.clusters.isEmpty ())
+		clusterColumn = nodeAttributes->addColumn ("cluster", Data::AttributeColumn::INT);
+
+	// uzly rozmiestnime do mriezky v kocke, aby sa neprekryvali
+	int side = qMax ((int) std::ceil (std::pow ((double) graph_.nodeCount, 1.0 / 3.0)), 1);
+
+	QVector<osg::ref_ptr<Data::Node> > nodes;
+	nodes.reserve (graph_.nodeCount);
+
+	for (int i = 0; i < graph_.nodeCount; i++) {
+		osg::Vec3f position (
+			(float) (i % side * 10),
+			(float) (i / side % side * 10),
+			(float) (i / side / side * 10)
+		);
+
+		nodes.append (graph->addNode ("n" + QString::number (i), nodeType, position));
+
+		if (clusterColumn != NULL)
+			clusterColumn->setInt (nodeAttributes->addRow (nodes.last ()->getId ()), graph_.clusters.at (i));
+	}
+
+	for (int i = 0; i < graph_.edges.size (); i++) {
+		const QPair<int, int> &edge = graph_.edges.at (i);
+		graph->addEdge (QString (), nodes.at (edge.first), nodes.at (edge.second), edgeType, false);
+	}
+
+	graph->commitBulkInsert ();
+
+	return graph;
+}
+
+bool GraphWriter::writeText (
+	QIODevice &stream,
+	Importer::ImportInfoHandler &infoHandler,
+	const TextFormat &format
+) {
+	qint64 total = (format.nodePrefix.isEmpty () ? 0 : graph_.nodeCount) + graph_.edges.size ();
+	qint64 written = 0;
+
+	// mena uzlov pripravime raz, pouzivaju sa v kazdej hrane
+	QVector<QByteArray> names;
+	names.reserve (graph_.nodeCount);
+	for (int i = 0; i < graph_.nodeCount; i++)
+		names.append (format.numericNames ? QByteArray::number (i + 1) : "n" + QByteArray::number (i));
+
+	bool writeClusters = !graph_.clusters.isEmpty () && !format.clusterPrefix.isEmpty ();
+
+	QByteArray buffer;
+	buffer.reserve ((1 << 20) + 256);
+	buffer.append (format.header);
+
+	bool ok = true;
+
+	for (int i = 0; ok && !format.nodePrefix.isEmpty () && i < graph_.nodeCount; i++) {
+		buffer.append (format.nodePrefix);
+		buffer.append (names.at (i));
+
+		if (writeClusters) {
+			buffer.append (format.clusterPrefix);
+			buffer.append (QByteArray::number (graph_.clusters.at (i)));
+			buffer.append (format.clusterSuffix);
+		} else {
+			buffer.append (format.nodeSuffix);
+		}
+
+		ok = flushBuffer (stream, buffer, false);
+
+		if (++written % PROGRESS_STEP == 0) {
+			infoHandler.setProgress ((unsigned int) (written * 100 / total));
+			ok = ok && !infoHandler.isCancelled ();
+		}
+	}
+
+	for (int i = 0; ok && i < graph_.edges.size (); i++) {
+		const QPair<int, int> &edge = graph_.edges.at (i);
+
+		buffer.append (format.edgePrefix);
+		buffer.append (names.at (edge.first));
+		buffer.append (format.edgeSeparator);
+		buffer.append (names.at (edge.second));
+		buffer.append (format.edgeSuffix);
+
+		ok = flushBuffer (stream, buffer, false);
+
+		if (++written % PROGRESS_STEP == 0) {
+			infoHandler.setProgress ((unsigned int) (written * 100 / total));
+			ok = ok && !infoHandler.isCancelled ();
+		}
+	}
+
+	if (ok) {
+		buffer.append (format.footer);
+		ok = flushBuffer (stream, buffer, true);
+	}
+
+	infoHandler.reportError (ok || infoHandler.isCancelled (), "Subor nie je mozne zapisat.");
+
+	return ok;
+}
+
+bool GraphWriter::writeBinary (
+	QIODevice &stream,
+	Importer::ImportInfoHandler &infoHandler
+) {
+	std::auto_ptr<Data::Graph> graph (createGraph ());
+
+	Exporter::ExporterContext context (stream, *graph, infoHandler);
+	Exporter::BinaryExporter exporter;
+
+	return exporter.exportGraph (context);
+}
+
+} // namespace
@@ -0,0 +1,558 @@
+#include "Importer/BinaryImporter.h"
+//-----------------------------------------------------------------------------
+#include "Importer/BinaryFormat.h"
+//-----------------------------------------------------------------------------
+#include <QtEndian>
+//-----------------------------------------------------------------------------
+#include <string.h>
+
+namespace {
+
+inline quint32 readU32 (const uchar *p) {
+	return qFromLittleEndian<quint32> (p);
+}
+
+inline qint64 readI64 (const uchar *p) {
+	return qFromLittleEndian<qint64> (p);
+}
+
+inline float readFloat (const uchar *p) {
+	quint32 bits = qFromLittleEndian<quint32> (p);
+	float value;
+	memcpy (&value, &bits, sizeof (value));
+	return value;
+}
+
+inline double readDouble (const uchar *p) {
+	quint64 bits = qFromLittleEndian<quint64> (p);
+	double value;
+	memcpy (&value, &bits, sizeof (value));
+	return value;
+}
+
+inline osg::Vec3f readVec3 (const uchar *p) {
+	return osg::Vec3f (readFloat (p), readFloat (p + 4), readFloat (p + 8));
+}
+
+inline osg::Vec4 readVec4 (const uchar *p) {
+	return osg::Vec4 (readFloat (p), readFloat (p + 4), readFloat (p + 8), readFloat (p + 12));
+}
+
+// pocet zaznamov, po ktorych sa aktualizuje priebeh
+const quint32 PROGRESS_STEP = 65536;
+
+} // namespace
+
+namespace Importer {
+
+BinaryImporter::BinaryImporter (void)
+	: file_ (NULL),
+	mapped_ (NULL),
+	data_ (NULL),
+	size_ (0),
+	sections_ (NULL),
+	sectionCount_ (0),
+	stringOffsets_ (NULL),
+	stringTexts_ (NULL),
+	stringCount_ (0),
+	stringTextsSize_ (0)
+{
+}
+
+BinaryImporter::~BinaryImporter (void) {
+	if (mapped_ != NULL)
+		(void)file_->unmap (mapped_);
+}
+
+bool BinaryImporter::import (
+	ImporterContext &context
+) {
+	Data::Graph &graph = context.getGraph ();
+
+	bool ok = open (context.getStream ());
+	context.getInfoHandler ().reportError (ok, "Zvoleny subor nie je platny binarny subor grafu.");
+
+	if (ok) {
+		ok = readStrings ();
+		context.getInfoHandler ().reportError (ok, "Binarny subor grafu neobsahuje platnu tabulku retazcov.");
+	}
+
+	// meno grafu, rozlozenie a pocitadlo identifikatorov
+	qint64 eleIdCounter = 0;
+	if (ok) {
+		const uchar *section;
+		qint64 sectionSize;
+
+		if (findSection (BinaryFormat::GRAPH, section, sectionSize) && sectionSize >= 16) {
+			QString name = getString (readU32 (section));
+			if (!name.isEmpty ())
+				graph.setName (name);
+
+			// meta typy patria rozlozeniu, preto ho vytvorime pred typmi; rozlozenie vytvorene volajucim len pomenujeme
+			QString layoutName = getString (readU32 (section + 4));
+			context.setLayoutName (layoutName);
+			if (graph.getSelectedLayout () == NULL) {
+				graph.selectLayout (graph.addLayout (layoutName.isEmpty () ? QString ("new Layout") : layoutName));
+			}
+
+			eleIdCounter = readI64 (section + 8);
+		}
+
+		// nove typy dostanu identifikatory za identifikatormi uzlov a hran zo suboru
+		if (graph.getEleIdCounter () < eleIdCounter)
+			graph.setEleIdCounter (eleIdCounter);
+	}
+
+	if (ok) {
+		ok = readTypes (graph);
+		context.getInfoHandler ().reportError (ok, "Binarny subor grafu obsahuje neplatne typy.");
+	}
+
+	// uzly a hrany vkladame hromadne, zoznamy grafu sa vytvoria az na konci
+	if (ok) {
+		const uchar *section;
+		qint64 sectionSize;
+		quint32 expectedEdges = 0;
+
+		if (findSection (BinaryFormat::EDGES, section, sectionSize) && sectionSize >= 8)
+			expectedEdges = readU32 (section);
+
+		ok = readNodes (context, expectedEdges);
+		context.getInfoHandler ().reportError (ok, "Binarny subor grafu obsahuje neplatne uzly.");
+
+		if (ok) {
+			ok = readEdges (context);
+			context.getInfoHandler ().reportError (ok, "Binarny subor grafu obsahuje neplatne hrany.");
+		}
+
+		graph.commitBulkInsert ();
+
+		// skupiny zlucenych uzlov, aby sa zlucene uzly dali znovu oddelit
+		if (ok) {
+			for (QHash<quint32, QList<osg::ref_ptr<Data::Node> > >::const_iterator it = mergedGroups_.constBegin (); it != mergedGroups_.constEnd (); ++it)
+				graph.restoreMergedGroup (nodes_.at (it.key ())->getId (), it.value ());
+		}
+	}
+
+	if (ok) {
+		// atributy cita aj vlakno GUI (dopyty), zapisujeme ich pod zamkom grafu
+		QMutexLocker locker (graph.getStructureMutex ());
+		ok =
+			readAttributes (BinaryFormat::NODE_ATTRIBUTES, *graph.getNodeAttributes ())
+			&&
+			readAttributes (BinaryFormat::EDGE_ATTRIBUTES, *graph.getEdgeAttributes ())
+		;
+		context.getInfoHandler ().reportError (ok, "Binarny subor grafu obsahuje neplatne atributy.");
+	}
+
+	if (ok && graph.getEleIdCounter () < eleIdCounter)
+		graph.setEleIdCounter (eleIdCounter);
+
+	// data suboru uz nepotrebujeme, stream sa po importe zatvara
+	if (mapped_ != NULL) {
+		(void)file_->unmap (mapped_);
+		mapped_ = NULL;
+	}
+	buffer_.clear ();
+	mergedGroups_.clear ();
+
+	return ok;
+}
+
+bool BinaryImporter::open (
+	QIODevice &stream
+) {
+	qint64 start = stream.pos ();
+
+	// subor namapujeme do pamate, ostatne zariadenia precitame naraz
+	file_ = qobject_cast<QFile *> (&stream);
+	if (file_ != NULL && !file_->isSequential () && file_->size () > start) {
+		mapped_ = file_->map (0, file_->size ());
+	}
+
+	if (mapped_ != NULL) {
+		data_ = mapped_ + start;
+		size_ = file_->size () - start;
+	} else {
+		buffer_ = stream.readAll ();
+		data_ = (const uchar *) buffer_.constData ();
+		size_ = buffer_.size ();
+	}
+
+	if (data_ == NULL || size_ < BinaryFormat::HEADER_SIZE)
+		return false;
+
+	if (memcmp (data_, BinaryFormat::MAGIC, sizeof (BinaryFormat::MAGIC)) != 0 || readU32 (data_ + 4) != BinaryFormat::VERSION)
+		return false;
+
+	sectionCount_ = readU32 (data_ + 8);
+	sections_ = data_ + BinaryFormat::HEADER_SIZE;
+
+	if ((qint64) sectionCount_ * BinaryFormat::SECTION_ENTRY_SIZE > size_ - BinaryFormat::HEADER_SIZE)
+		return false;
+
+	// vsetky sekcie musia lezat v subore
+	for (quint32 i = 0; i < sectionCount_; i++) {
+		const uchar *entry = sections_ + i * BinaryFormat::SECTION_ENTRY_SIZE;
+		qint64 offset = readI64 (entry + 8);
+		qint64 size = readI64 (entry + 16);
+
+		if (offset < 0 || size < 0 || offset > size_ || size > size_ - offset)
+			return false;
+	}
+
+	return true;
+}
+
+bool BinaryImporter::findSection (
+	quint32 id,
+	const uchar *&section,
+	qint64 &size
+) const {
+	for (quint32 i = 0; i < sectionCount_; i++) {
+		const uchar *entry = sections_ + i * BinaryFormat::SECTION_ENTRY_SIZE;
+
+		if (readU32 (entry) == id) {
+			section = data_ + readI64 (entry + 8);
+			size = readI64 (entry + 16);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+QString BinaryImporter::getString (
+	quint32 index
+) const {
+	if (index >= stringCount_)
+		return QString ();
+
+	qint64 begin = readI64 (stringOffsets_ + (qint64) index * 8);
+	qint64 end = readI64 (stringOffsets_ + (qint64) index * 8 + 8);
+
+	if (begin < 0 || begin > end || end > stringTextsSize_)
+		return QString ();
+
+	return QString::fromUtf8 (stringTexts_ + begin, (int) (end - begin));
+}
+
+bool BinaryImporter::readStrings (void) {
+	const uchar *section;
+	qint64 sectionSize;
+
+	if (!findSection (BinaryFormat::STRINGS, section, sectionSize) || sectionSize < 8)
+		return false;
+
+	stringCount_ = readU32 (section);
+
+	qint64 offsetsSize = ((qint64) stringCount_ + 1) * 8;
+	if (offsetsSize > sectionSize - 8)
+		return false;
+
+	stringOffsets_ = section + 8;
+	stringTexts_ = (const char *) (section + 8 + offsetsSize);
+	stringTextsSize_ = sectionSize - 8 - offsetsSize;
+
+	return true;
+}
+
+bool BinaryImporter::readTypes (
+	Data::Graph &graph
+) {
+	const uchar *section;
+	qint64 sectionSize;
+
+	if (!findSection (BinaryFormat::TYPES, section, sectionSize) || sectionSize < 8)
+		return false;
+
+	const uchar *p = section + 8;
+	const uchar *end = section + sectionSize;
+	quint32 count = readU32 (section);
+
+	if ((qint64) count * 16 > sectionSize - 8)
+		return false;
+
+	types_.resize (count);
+
+	for (quint32 i = 0; i < count; i++) {
+		if (end - p < 16)
+			return false;
+
+		QString name = getString (readU32 (p));
+		quint32 flags = readU32 (p + 4);
+		quint32 settingCount = readU32 (p + 8);
+		p += 16;
+
+		if ((qint64) settingCount * 8 > end - p)
+			return false;
+
+		// nastavenia typu (textura, farba...) ako dvojice retazcov
+		QMap<QString, QString> *settings = new QMap<QString, QString>;
+		for (quint32 s = 0; s < settingCount; s++, p += 8)
+			settings->insert (getString (readU32 (p)), getString (readU32 (p + 4)));
+
+		if (flags & BinaryFormat::TYPE_META) {
+			Data::MetaType *type = graph.addMetaType (name, settings);
+			if (type == NULL)
+				return false;
+
+			// meta typy uzlov a hran rozlozenia su urcene nastavenim rozlozenia
+			if (
+				name == Data::GraphLayout::META_NODE_TYPE
+				||
+				name == Data::GraphLayout::META_EDGE_TYPE
+				||
+				name == Data::GraphLayout::RESTRICTION_NODE_TYPE
+			) {
+				graph.getSelectedLayout ()->setMetaSetting (name, QString::number (type->getId ()));
+			}
+
+			types_[i] = type;
+		} else {
+			types_[i] = graph.addType (name, settings);
+		}
+	}
+
+	return true;
+}
+
+bool BinaryImporter::readNodes (
+	ImporterContext &context,
+	quint32 expectedEdges
+) {
+	Data::Graph &graph = context.getGraph ();
+	const uchar *section;
+	qint64 sectionSize;
+
+	quint32 count = 0;
+	if (findSection (BinaryFormat::NODES, section, sectionSize)) {
+		if (sectionSize < 8)
+			return false;
+
+		count = readU32 (section);
+		if ((qint64) count * BinaryFormat::NODE_RECORD_SIZE > sectionSize - 8)
+			return false;
+	}
+
+	graph.beginBulkInsert (count, expectedEdges);
+
+	nodes_.resize (count);
+
+	// rodicia uzlov a otvorene vnorene grafy (rodic je vzdy pred svojimi vnorenymi uzlami)
+	QVector<quint32> parents (count);
+	QVector<quint32> nested;
+
+	bool ok = true;
+	for (quint32 i = 0; ok && i < count; i++) {
+		const uchar *record = section + 8 + (qint64) i * BinaryFormat::NODE_RECORD_SIZE;
+
+		quint32 type = readU32 (record + 12);
+		quint32 parent = readU32 (record + 48);
+		quint32 flags = readU32 (record + 52);
+
+		if (type >= (quint32) types_.size () || (parent != BinaryFormat::NO_PARENT && parent >= i)) {
+			ok = false;
+			break;
+		}
+
+		// otvoreny ostane len vnoreny graf rodica, rodic bez otvoreneho grafu je predchadzajuci uzol
+		quint32 top = (parent == BinaryFormat::NO_PARENT || nested.contains (parent)) ? parent : parents.at (parent);
+
+		while (!nested.isEmpty () && nested.last () != top) {
+			graph.closeNestedGraph ();
+			nested.removeLast ();
+		}
+
+		if (top != parent) {
+			graph.createNestedGraph (nodes_.at (parent));
+			nested.append (parent);
+		}
+
+		parents[i] = parent;
+
+		osg::ref_ptr<Data::Node> node = graph.addNode (
+			readI64 (record),
+			getString (readU32 (record + 8)),
+			types_.at (type),
+			readVec3 (record + 16)
+		);
+
+		node->setColor (readVec4 (record + 28));
+		node->setScale (readFloat (record + 44));
+		node->setFixed ((flags & BinaryFormat::NODE_FIXED) != 0);
+
+		if (flags & BinaryFormat::NODE_HIDDEN)
+			node->setNodeMask (0);
+
+		// meta uzol moze byt v subore az za zlucenym uzlom, skupiny obnovime po vlozeni vsetkych uzlov
+		if (flags & BinaryFormat::NODE_MERGED) {
+			quint32 mergedInto = readU32 (record + 56);
+			if (mergedInto >= count) {
+				ok = false;
+				break;
+			}
+
+			mergedGroups_[mergedInto].append (node);
+		}
+
+		nodes_[i] = node;
+
+		if ((i + 1) % PROGRESS_STEP == 0) {
+			context.getInfoHandler ().setProgress ((unsigned int) ((qint64) (i + 1) * 50 / count));
+			ok = !context.getInfoHandler ().isCancelled ();
+		}
+	}
+
+	while (!nested.isEmpty ()) {
+		graph.closeNestedGraph ();
+		nested.removeLast ();
+	}
+
+	return ok;
+}
+
+bool BinaryImporter::readEdges (
+	ImporterContext &context
+) {
+	Data::Graph &graph = context.getGraph ();
+	const uchar *section;
+	qint64 sectionSize;
+
+	if (!findSection (BinaryFormat::EDGES, section, sectionSize))
+		return true;
+
+	if (sectionSize < 8)
+		return false;
+
+	quint32 count = readU32 (section);
+	if ((qint64) count * BinaryFormat::EDGE_RECORD_SIZE > sectionSize - 8)
+		return false;
+
+	for (quint32 i = 0; i < count; i++) {
+		const uchar *record = section + 8 + (qint64) i * BinaryFormat::EDGE_RECORD_SIZE;
+
+		quint32 name = readU32 (record + 8);
+		quint32 type = readU32 (record + 12);
+		quint32 src = readU32 (record + 16);
+		quint32 dst = readU32 (record + 20);
+
+		if (type >= (quint32) types_.size () || src >= (quint32) nodes_.size () || dst >= (quint32) nodes_.size ())
+			return false;
+
+		// hrana bez mena (prazdny retazec) ma meno odvodene z mien uzlov
+		osg::ref_ptr<Data::Edge> edge = graph.addEdge (
+			readI64 (record),
+			(name != 0) ? getString (name) : QString (),
+			nodes_.at (src),
+			nodes_.at (dst),
+			types_.at (type),
+			(readU32 (record + 44) & BinaryFormat::EDGE_ORIENTED) != 0
+		);
+
+		//paralelna hrana bola nahradena multihranou
+		if (edge.valid ()) {
+			edge->setEdgeColor (readVec4 (record + 24));
+			edge->setScale (readFloat (record + 40));
+		}
+
+		if ((i + 1) % PROGRESS_STEP == 0) {
+			context.getInfoHandler ().setProgress ((unsigned int) (50 + (qint64) (i + 1) * 50 / count));
+			if (context.getInfoHandler ().isCancelled ())
+				return false;
+		}
+	}
+
+	return true;
+}
+
+bool BinaryImporter::readAttributes (
+	quint32 sectionId,
+	Data::AttributeStore &store
+) {
+	const uchar *section;
+	qint64 sectionSize;
+
+	if (!findSection (sectionId, section, sectionSize))
+		return true;
+
+	if (sectionSize < 8)
+		return false;
+
+	quint32 rowCount = readU32 (section);
+	quint32 columnCount = readU32 (section + 4);
+
+	const uchar *p = section + 8;
+	const uchar *end = section + sectionSize;
+	const uchar *ids = p;
+
+	if ((qint64) rowCount * 8 > end - p)
+		return false;
+	p += (qint64) rowCount * 8;
+
+	// riadky v ulozisku grafu (odstranene riadky maju id -1)
+	QVector<int> rows (rowCount, -1);
+	for (quint32 r = 0; r < rowCount; r++) {
+		qint64 id = readI64 (ids + (qint64) r * 8);
+		if (id >= 0)
+			rows[r] = store.addRow (id);
+	}
+
+	qint64 bitmapSize = BinaryFormat::align ((rowCount + 7) / 8);
+
+	for (quint32 c = 0; c < columnCount; c++) {
+		if (end - p < 8)
+			return false;
+
+		QString name = getString (readU32 (p));
+		quint32 valueType = readU32 (p + 4);
+		p += 8;
+
+		qint64 valueSize;
+		switch (valueType) {
+			case Data::AttributeColumn::INT: valueSize = 8; break;
+			case Data::AttributeColumn::FLOAT: valueSize = 4; break;
+			case Data::AttributeColumn::STRING: valueSize = 4; break;
+			case Data::AttributeColumn::BOOL: valueSize = 1; break;
+			case Data::AttributeColumn::DOUBLE: valueSize = 8; break;
+			default: return false;
+		}
+
+		qint64 valuesSize = BinaryFormat::align (valueSize * rowCount);
+		if (bitmapSize + valuesSize > end - p)
+			return false;
+
+		const uchar *valid = p;
+		const uchar *values = p + bitmapSize;
+		p += bitmapSize + valuesSize;
+
+		Data::AttributeColumn *column = store.addColumn (name, (Data::AttributeColumn::ValueType) valueType);
+
+		for (quint32 r = 0; r < rowCount; r++) {
+			if (rows.at (r) < 0 || !(valid[r / 8] & (1 << (r % 8))))
+				continue;
+
+			switch (valueType) {
+				case Data::AttributeColumn::INT:
+					column->setInt (rows.at (r), readI64 (values + (qint64) r * 8));
+					break;
+				case Data::AttributeColumn::FLOAT:
+					column->setFloat (rows.at (r), readFloat (values + (qint64) r * 4));
+					break;
+				case Data::AttributeColumn::STRING:
+					column->setString (rows.at (r), getString (readU32 (values + (qint64) r * 4)));
+					break;
+				case Data::AttributeColumn::BOOL:
+					column->setBool (rows.at (r), values[r] != 0);
+					break;
+				case Data::AttributeColumn::DOUBLE:
+					column->setDouble (rows.at (r), readDouble (values + (qint64) r * 8));
+					break;
+			}
+		}
+	}
+
+	return true;
+}
+
+} // namespace
@@ -0,0 +1,260 @@
+#include "Importer/CSVImporter.h"
+//-----------------------------------------------------------------------------
+#include "Importer/GraphOperations.h"
+//-----------------------------------------------------------------------------
+#include <QStringList>
+//-----------------------------------------------------------------------------
+
+namespace Importer {
+
+CSVImporter::CSVImporter (
+	char delimiter
+) : delimiter_ (delimiter),
+	sourceColumn_ (0),
+	targetColumn_ (1),
+	directedColumn_ (-1)
+{
+}
+
+bool CSVImporter::import (
+	ImporterContext &context
+) {
+	QString graphname="Graph";
+
+	GraphOperations graphOp (context.getGraph ());
+	Data::Type *edgeType = NULL;
+	Data::Type *nodeType = NULL;
+	context.getGraph ().setName (graphname);
+	(void)graphOp.addDefaultTypes (edgeType, nodeType);
+
+	// riadky citame paralelne po castiach, stlpce nastavime podla hlavicky
+	EdgeListParser parser (context.getStream (), 0, 0);
+	parser.setDelimiter (delimiter_);
+	bool ok = parser.open ();
+
+	context.getInfoHandler ().reportError (ok, "Zvoleny subor nie je mozne precitat.");
+
+	if (ok) {
+		ok = readHeader (context, parser);
+	}
+
+	Data::AttributeStore *edgeAttributes = context.getGraph ().getEdgeAttributes ();
+
+	// uzly podla indexu mena, vytvarame ich pri prvom vyskyte
+	QVector<osg::ref_ptr<Data::Node> > nodes;
+	bool bulkInsert = false;
+
+	while (ok && parser.parseNext ()) {
+		if (!bulkInsert) {
+			// typy atributov a odhad poctu hran urcime podla prveho okna
+			createAttributeColumns (context, parser);
+
+			qlonglong expectedEdges = 0;
+			if (parser.getPosition () > 0)
+				expectedEdges = (qlonglong) ((double) parser.getLineCount () * parser.getSize () / parser.getPosition ());
+
+			//uzly a hrany vkladame hromadne, zoznamy grafu sa vytvoria az na konci
+			context.getGraph ().beginBulkInsert (0, expectedEdges);
+			bulkInsert = true;
+		}
+
+		nodes.resize (parser.getNameCount ());
+
+		for (int i = 0; ok && i < parser.getLineCount (); i++) {
+			int srcNode = parser.getName (i, sourceColumn_);
+			int dstNode = parser.getName (i, targetColumn_);
+
+			ok = srcNode >= 0 && dstNode >= 0 && !parser.getNameText (srcNode).isEmpty () && !parser.getNameText (dstNode).isEmpty ();
+
+			context.getInfoHandler ().reportError (ok, "Riadok suboru nema zdrojovy alebo cielovy uzol.");
+
+			if (ok) {
+				// vytvorenie pociatocneho a koncoveho uzla
+				if (!nodes[srcNode].valid ())
+					nodes[srcNode] = context.getGraph ().addNode (parser.getNameText (srcNode), nodeType);
+				if (!nodes[dstNode].valid ())
+					nodes[dstNode] = context.getGraph ().addNode (parser.getNameText (dstNode), nodeType);
+
+				bool directed = false;
+				if (directedColumn_ >= 0) {
+					QByteArray value = parser.getText (i, directedColumn_).trimmed ().toLower ();
+					directed = (value == "true" || value == "1");
+				}
+
+				//vytvorenie hrany, jej meno sa odvodi z mien uzlov az ked bude potrebne
+				osg::ref_ptr<Data::Edge> edge = context.getGraph ().addEdge (
+					QString (),
+					nodes[srcNode],
+					nodes[dstNode],
+					edgeType,
+					directed
+				);
+
+				// multihrana nie je vratena, jej data sa neukladaju
+				if (edge.valid () && !attributes_.isEmpty ()) {
+					// atributy cita aj vlakno GUI (dopyty), zapisujeme ich pod zamkom grafu
+					QMutexLocker locker (context.getGraph ().getStructureMutex ());
+					int row = -1;
+					for (QList<AttributeInfo>::const_iterator it = attributes_.constBegin (); it != attributes_.constEnd (); ++it) {
+						QByteArray value = parser.getText (i, it->textColumn);
+						if (value.isEmpty ())
+							continue;
+
+						if (row < 0)
+							row = edgeAttributes->addRow (edge->getId ());
+
+						// typ stlpca je urceny z prveho okna, hodnotu, ktora mu nezodpoveda, ulozime po rozsireni stlpca na retazce
+						if (!it->column->setValue (row, value)) {
+							it->column->convertToString ();
+							(void)it->column->setValue (row, value);
+						}
+					}
+				}
+			}
+		}
+
+		if (parser.getSize () > 0)
+			context.getInfoHandler ().setProgress ((unsigned int) (parser.getPosition () * 100 / parser.getSize ()));
+
+		//import mohol byt zruseny
+		ok = ok && !context.getInfoHandler ().isCancelled ();
+	}
+
+	if (bulkInsert)
+		context.getGraph ().commitBulkInsert ();
+
+	return ok;
+}
+
+bool CSVImporter::readHeader (
+	ImporterContext &context,
+	EdgeListParser &parser
+) {
+	QByteArray header = parser.readLine ();
+
+	// znacka UTF-8 na zaciatku suboru
+	if (header.startsWith ("\xEF\xBB\xBF"))
+		header = header.mid (3);
+
+	QList<QByteArray> fields = parser.splitLine (header);
+
+	bool ok = (fields.size () >= 2);
+
+	context.getInfoHandler ().reportError (ok, "Subor musi mat hlavicku s menami aspon dvoch stlpcov.");
+
+	if (!ok)
+		return false;
+
+	// mena a deklarovane typy stlpcov
+	QStringList names;
+	QList<int> types;
+	int sourceIndex = -1;
+	int targetIndex = -1;
+	int directedIndex = -1;
+
+	for (int i = 0; i < fields.size (); i++) {
+		QString name = QString::fromUtf8 (fields.at (i).constData (), fields.at (i).size ()).trimmed ();
+		int type = -1;
+
+		int colon = name.lastIndexOf (':');
+		if (colon > 0) {
+			QString typeName = name.mid (colon + 1).trimmed ().toLower ();
+			Data::AttributeColumn::ValueType valueType = Data::AttributeColumn::valueTypeFromName (typeName);
+
+			// neznamy typ je sucastou mena stlpca
+			if (valueType != Data::AttributeColumn::STRING || typeName == "string") {
+				type = valueType;
+				name = name.left (colon).trimmed ();
+			}
+		}
+
+		QString key = name.toLower ();
+		if (sourceIndex < 0 && (key == "source" || key == "from" || key == "src")) {
+			sourceIndex = i;
+		} else if (targetIndex < 0 && (key == "target" || key == "to" || key == "dst")) {
+			targetIndex = i;
+		} else if (directedIndex < 0 && key == "directed") {
+			directedIndex = i;
+		}
+
+		names.append (name);
+		types.append (type);
+	}
+
+	// bez pomenovanych stlpcov su uzly v prvych dvoch stlpcoch
+	if (sourceIndex < 0 || targetIndex < 0) {
+		sourceIndex = 0;
+		targetIndex = 1;
+
+		if (directedIndex <= 1)
+			directedIndex = -1;
+	}
+
+	QVector<EdgeListParser::ColumnRole> columns (fields.size (), EdgeListParser::TEXT_COLUMN);
+	columns[sourceIndex] = EdgeListParser::NAME_COLUMN;
+	columns[targetIndex] = EdgeListParser::NAME_COLUMN;
+
+	// mena su v poradi stlpcov, texty tiez
+	sourceColumn_ = (sourceIndex < targetIndex) ? 0 : 1;
+	targetColumn_ = 1 - sourceColumn_;
+	directedColumn_ = -1;
+	attributes_.clear ();
+
+	int textColumn = 0;
+	for (int i = 0; i < columns.size (); i++) {
+		if (columns.at (i) != EdgeListParser::TEXT_COLUMN)
+			continue;
+
+		if (i == directedIndex) {
+			directedColumn_ = textColumn;
+		} else {
+			AttributeInfo attribute;
+			attribute.textColumn = textColumn;
+			attribute.name = names.at (i);
+			attribute.typeDeclared = (types.at (i) >= 0);
+			attribute.type = attribute.typeDeclared ? (Data::AttributeColumn::ValueType) types.at (i) : Data::AttributeColumn::STRING;
+			attribute.column = NULL;
+
+			// stlpce bez mena nepotrebujeme
+			if (!attribute.name.isEmpty ())
+				attributes_.append (attribute);
+		}
+
+		textColumn++;
+	}
+
+	parser.setColumns (columns);
+
+	return true;
+}
+
+void CSVImporter::createAttributeColumns (
+	ImporterContext &context,
+	const EdgeListParser &parser
+) {
+	Data::AttributeStore *edgeAttributes = context.getGraph ().getEdgeAttributes ();
+	QMutexLocker locker (context.getGraph ().getStructureMutex ());
+
+	for (QList<AttributeInfo>::iterator it = attributes_.begin (); it != attributes_.end (); ++it) {
+		if (!it->typeDeclared) {
+			// najuzsi typ, do ktoreho sa daju previest vsetky hodnoty prveho okna
+			bool found = false;
+			for (int i = 0; i < parser.getLineCount (); i++) {
+				QByteArray value = parser.getText (i, it->textColumn).trimmed ();
+				if (value.isEmpty ())
+					continue;
+
+				Data::AttributeColumn::ValueType type = Data::AttributeColumn::valueTypeOfText (value);
+				it->type = found ? Data::AttributeColumn::commonValueType (it->type, type) : type;
+				found = true;
+
+				if (it->type == Data::AttributeColumn::STRING)
+					break;
+			}
+		}
+
+		it->column = edgeAttributes->addColumn (it->name, it->type);
+	}
+}
+
+} // namespace
@@ -0,0 +1,658 @@
+#include "Importer/DOTImporter.h"
+//-----------------------------------------------------------------------------
+#include "Importer/GraphOperations.h"
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <string.h>
+
+namespace {
+
+inline bool isSpace (char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+inline bool isIdStart (char c) {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || (uchar) c >= 0x80;
+}
+
+inline bool isDigit (char c) {
+	return c >= '0' && c <= '9';
+}
+
+} // namespace
+
+namespace Importer {
+
+DOTImporter::DOTImporter (void)
+	: context_ (NULL),
+	file_ (NULL),
+	mapped_ (NULL),
+	data_ (NULL),
+	size_ (0),
+	position_ (0),
+	directed_ (false),
+	edgeType_ (NULL),
+	nodeType_ (NULL),
+	progress_ (0)
+{
+	token_.type = END_TOKEN;
+	token_.quoted = false;
+	token_.punctuation = 0;
+}
+
+DOTImporter::~DOTImporter (void) {
+	close ();
+}
+
+bool DOTImporter::import (
+	ImporterContext &context
+) {
+	context_ = &context;
+
+	QString graphname="Graph";
+
+	GraphOperations graphOp (context.getGraph ());
+	edgeType_ = NULL;
+	nodeType_ = NULL;
+	context.getGraph ().setName (graphname);
+	(void)graphOp.addDefaultTypes (edgeType_, nodeType_);
+
+	bool ok = open (context.getStream ());
+
+	context.getInfoHandler ().reportError (ok, "Zvoleny subor nie je mozne precitat.");
+
+	if (ok) {
+		//uzly a hrany vkladame hromadne, zoznamy grafu sa vytvoria az na konci
+		context.getGraph ().beginBulkInsert ();
+
+		ok = parseGraph ();
+
+		context.getGraph ().commitBulkInsert ();
+	}
+
+	close ();
+
+	return ok;
+}
+
+bool DOTImporter::open (
+	QIODevice &stream
+) {
+	qint64 start = stream.pos ();
+
+	// subor namapujeme do pamate, ostatne zariadenia precitame naraz
+	file_ = qobject_cast<QFile *> (&stream);
+	if (file_ != NULL && !file_->isSequential () && file_->size () > start) {
+		mapped_ = file_->map (0, file_->size ());
+	}
+
+	if (mapped_ != NULL) {
+		data_ = (const char *) mapped_ + start;
+		size_ = file_->size () - start;
+	} else {
+		buffer_ = stream.readAll ();
+		data_ = buffer_.constData ();
+		size_ = buffer_.size ();
+	}
+
+	position_ = 0;
+	progress_ = 0;
+
+	return data_ != NULL;
+}
+
+void DOTImporter::close (void) {
+	// kluce a texty odkazuju do dat, uvolnime ich pred nimi
+	token_.text.clear ();
+	nodeIndex_.clear ();
+	nodes_.clear ();
+	nodeDefaults_.clear ();
+	edgeDefaults_.clear ();
+	nodeColumns_.clear ();
+	edgeColumns_.clear ();
+
+	if (mapped_ != NULL) {
+		(void)file_->unmap (mapped_);
+		mapped_ = NULL;
+	}
+	buffer_.clear ();
+
+	data_ = NULL;
+	size_ = 0;
+}
+
+void DOTImporter::skipSpace (void) {
+	while (position_ < size_) {
+		const char *p = data_ + position_;
+		qint64 rest = size_ - position_;
+
+		if (isSpace (*p)) {
+			position_++;
+		} else if (*p == '#' && (position_ == 0 || data_[position_ - 1] == '\n')) {
+			// riadok preprocesora
+			const char *lineEnd = (const char *) memchr (p, '\n', (size_t) rest);
+			position_ = (lineEnd != NULL) ? lineEnd - data_ : size_;
+		} else if (*p == '/' && rest > 1 && p[1] == '/') {
+			const char *lineEnd = (const char *) memchr (p, '\n', (size_t) rest);
+			position_ = (lineEnd != NULL) ? lineEnd - data_ : size_;
+		} else if (*p == '/' && rest > 1 && p[1] == '*') {
+			position_ += 2;
+			while (position_ + 1 < size_ && !(data_[position_] == '*' && data_[position_ + 1] == '/'))
+				position_++;
+			position_ = qMin (position_ + 2, size_);
+		} else {
+			break;
+		}
+	}
+}
+
+void DOTImporter::nextToken (void) {
+	token_.type = END_TOKEN;
+	token_.text = QByteArray ();
+	token_.quoted = false;
+	token_.punctuation = 0;
+
+	skipSpace ();
+
+	if (position_ >= size_)
+		return;
+
+	const char *p = data_ + position_;
+	const char *end = data_ + size_;
+	char c = *p;
+
+	if (c == '-' && p + 1 < end && (p[1] == '-' || p[1] == '>')) {
+		token_.type = EDGE_OP_TOKEN;
+		position_ += 2;
+	} else if (isIdStart (c)) {
+		const char *start = p;
+		while (p < end && (isIdStart (*p) || isDigit (*p)))
+			p++;
+
+		token_.type = ID_TOKEN;
+		token_.text = QByteArray::fromRawData (start, (int) (p - start));
+		position_ = p - data_;
+	} else if (isDigit (c) || c == '.' || c == '-') {
+		// cislo [-](.[0-9]+ | [0-9]+(.[0-9]*)?)
+		const char *start = p;
+		if (*p == '-')
+			p++;
+		const char *digits = p;
+		while (p < end && isDigit (*p))
+			p++;
+		if (p < end && *p == '.') {
+			p++;
+			while (p < end && isDigit (*p))
+				p++;
+		}
+
+		token_.type = (p - digits > 0 && !(p - digits == 1 && *digits == '.')) ? ID_TOKEN : ERROR_TOKEN;
+		token_.text = QByteArray::fromRawData (start, (int) (p - start));
+		position_ = p - data_;
+	} else if (c == '"') {
+		token_.type = readQuoted (token_.text) ? ID_TOKEN : ERROR_TOKEN;
+		token_.quoted = true;
+
+		// spajanie retazcov "a" + "b"
+		while (token_.type == ID_TOKEN) {
+			qint64 position = position_;
+			skipSpace ();
+			if (position_ < size_ && data_[position_] == '+') {
+				position_++;
+				skipSpace ();
+				if (position_ < size_ && data_[position_] == '"') {
+					QByteArray next;
+					if (!readQuoted (next)) {
+						token_.type = ERROR_TOKEN;
+						break;
+					}
+
+					// text uz nemoze odkazovat do dat
+					token_.text = QByteArray (token_.text.constData (), token_.text.size ()) + next;
+					continue;
+				}
+			}
+
+			position_ = position;
+			break;
+		}
+	} else if (c == '<') {
+		// HTML retazec s vnorenymi <...>
+		const char *start = ++p;
+		int depth = 1;
+		while (p < end && depth > 0) {
+			if (*p == '<')
+				depth++;
+			else if (*p == '>')
+				depth--;
+			p++;
+		}
+
+		token_.type = (depth == 0) ? ID_TOKEN : ERROR_TOKEN;
+		token_.text = QByteArray::fromRawData (start, (int) (p - start - 1));
+		token_.quoted = true;
+		position_ = p - data_;
+	} else if (c != 0 && strchr ("{}[]=;,:", c) != NULL) {
+		token_.type = PUNCTUATION_TOKEN;
+		token_.punctuation = c;
+		position_++;
+	} else {
+		token_.type = ERROR_TOKEN;
+	}
+}
+
+bool DOTImporter::readQuoted (
+	QByteArray &text
+) {
+	const char *p = data_ + position_ + 1;
+	const char *end = data_ + size_;
+	const char *start = p;
+	bool escaped = false;
+
+	while (p < end && *p != '"') {
+		if (*p == '\\' && p + 1 < end && (p[1] == '"' || p[1] == '\n' || p[1] == '\r')) {
+			escaped = true;
+			p++;
+		}
+		p++;
+	}
+
+	if (p == end)
+		return false;
+
+	if (escaped) {
+		// \" je uvodzovka, \ na konci riadku pokracuje dalsim riadkom, ostatne \ ponechame (\n, \l v popiskoch)
+		text.clear ();
+		text.reserve ((int) (p - start));
+		for (const char *q = start; q < p; q++) {
+			if (*q == '\\' && q + 1 < p && q[1] == '"') {
+				text.append ('"');
+				q++;
+			} else if (*q == '\\' && q + 1 < p && (q[1] == '\n' || q[1] == '\r')) {
+				q++;
+				if (*q == '\r' && q + 1 < p && q[1] == '\n')
+					q++;
+			} else {
+				text.append (*q);
+			}
+		}
+	} else {
+		text = QByteArray::fromRawData (start, (int) (p - start));
+	}
+
+	position_ = p + 1 - data_;
+
+	return true;
+}
+
+bool DOTImporter::isKeyword (
+	const char *keyword
+) const {
+	uint length = qstrlen (keyword);
+
+	return
+		token_.type == ID_TOKEN
+		&&
+		!token_.quoted
+		&&
+		(uint) token_.text.size () == length
+		&&
+		qstrnicmp (token_.text.constData (), keyword, length) == 0
+	;
+}
+
+bool DOTImporter::syntaxError (void) {
+	context_->getInfoHandler ().reportError (QString ("DOT syntax error at byte %1.").arg (position_));
+
+	return false;
+}
+
+bool DOTImporter::parseGraph (void) {
+	nextToken ();
+
+	if (isKeyword ("strict"))
+		nextToken ();
+
+	if (isKeyword ("digraph")) {
+		directed_ = true;
+	} else if (isKeyword ("graph")) {
+		directed_ = false;
+	} else {
+		return syntaxError ();
+	}
+
+	nextToken ();
+
+	if (token_.type == ID_TOKEN) {
+		context_->getGraph ().setName (QString::fromUtf8 (token_.text.constData (), token_.text.size ()));
+		nextToken ();
+	}
+
+	if (!isPunctuation ('{'))
+		return syntaxError ();
+
+	nextToken ();
+
+	if (!parseStatements (NULL))
+		return false;
+
+	// dalsie grafy v subore ignorujeme
+	return true;
+}
+
+bool DOTImporter::parseStatements (
+	QVector<int> *members
+) {
+	while (!isPunctuation ('}')) {
+		if (token_.type == END_TOKEN || token_.type == ERROR_TOKEN)
+			return syntaxError ();
+
+		if (!parseStatement (members))
+			return false;
+
+		if (!reportProgress ())
+			return false;
+	}
+
+	return true;
+}
+
+bool DOTImporter::parseStatement (
+	QVector<int> *members
+) {
+	if (isPunctuation (';')) {
+		nextToken ();
+		return true;
+	}
+
+	// predvolene atributy dalsich prvkov
+	if (isKeyword ("graph") || isKeyword ("node") || isKeyword ("edge")) {
+		AttributeListType *defaults = NULL;
+		if (isKeyword ("node"))
+			defaults = &nodeDefaults_;
+		else if (isKeyword ("edge"))
+			defaults = &edgeDefaults_;
+
+		nextToken ();
+
+		if (!isPunctuation ('['))
+			return syntaxError ();
+
+		AttributeListType attributes;
+		if (!parseAttributes (attributes))
+			return false;
+
+		// atributy grafu ignorujeme
+		if (defaults != NULL)
+			*defaults += attributes;
+
+		return true;
+	}
+
+	QVector<int> endpoint;
+	bool node = false;
+
+	if (token_.type == ID_TOKEN && !isKeyword ("subgraph")) {
+		QByteArray name = token_.text;
+		nextToken ();
+
+		// atribut grafu ID = ID ignorujeme
+		if (isPunctuation ('=')) {
+			nextToken ();
+			if (token_.type != ID_TOKEN)
+				return syntaxError ();
+
+			nextToken ();
+			return true;
+		}
+
+		if (!skipPort ())
+			return false;
+
+		endpoint.append (getNode (name, members));
+		node = true;
+	} else if (!parseEndpoint (endpoint, members)) {
+		return false;
+	}
+
+	if (token_.type == EDGE_OP_TOKEN)
+		return parseEdges (endpoint, members);
+
+	// atributy uzla
+	if (isPunctuation ('[')) {
+		AttributeListType attributes;
+		if (!parseAttributes (attributes))
+			return false;
+
+		if (node && !attributes.isEmpty ())
+			storeAttributes (*context_->getGraph ().getNodeAttributes (), nodeColumns_, nodes_.at (endpoint.first ())->getId (), attributes);
+	}
+
+	return true;
+}
+
+bool DOTImporter::parseEdges (
+	const QVector<int> &first,
+	QVector<int> *members
+) {
+	// retaz a -> b -> c
+	QList<QVector<int> > chain;
+	chain.append (first);
+
+	while (token_.type == EDGE_OP_TOKEN) {
+		nextToken ();
+
+		QVector<int> endpoint;
+		if (!parseEndpoint (endpoint, members))
+			return false;
+
+		chain.append (endpoint);
+	}
+
+	AttributeListType attributes = edgeDefaults_;
+	if (isPunctuation ('[') && !parseAttributes (attributes))
+		return false;
+
+	Data::AttributeStore *edgeAttributes = context_->getGraph ().getEdgeAttributes ();
+
+	// hrany medzi vsetkymi uzlami susednych koncov retaze
+	for (int i = 0; i + 1 < chain.size (); i++) {
+		const QVector<int> &sources = chain.at (i);
+		const QVector<int> &targets = chain.at (i + 1);
+
+		for (QVector<int>::const_iterator src = sources.constBegin (); src != sources.constEnd (); ++src) {
+			for (QVector<int>::const_iterator dst = targets.constBegin (); dst != targets.constEnd (); ++dst) {
+				// meno hrany sa odvodi z mien uzlov az ked bude potrebne
+				osg::ref_ptr<Data::Edge> edge = context_->getGraph ().addEdge (
+					QString (),
+					nodes_.at (*src),
+					nodes_.at (*dst),
+					edgeType_,
+					directed_
+				);
+
+				// multihrana nie je vratena, jej data sa neukladaju
+				if (edge.valid () && !attributes.isEmpty ())
+					storeAttributes (*edgeAttributes, edgeColumns_, edge->getId (), attributes);
+			}
+		}
+	}
+
+	return true;
+}
+
+bool DOTImporter::parseEndpoint (
+	QVector<int> &endpoint,
+	QVector<int> *members
+) {
+	if (isPunctuation ('{') || isKeyword ("subgraph"))
+		return parseSubgraph (endpoint, members);
+
+	if (token_.type != ID_TOKEN)
+		return syntaxError ();
+
+	QByteArray name = token_.text;
+	nextToken ();
+
+	if (!skipPort ())
+		return false;
+
+	endpoint.append (getNode (name, members));
+
+	return true;
+}
+
+bool DOTImporter::parseSubgraph (
+	QVector<int> &subgraphMembers,
+	QVector<int> *members
+) {
+	if (isKeyword ("subgraph")) {
+		nextToken ();
+
+		if (token_.type == ID_TOKEN)
+			nextToken ();
+	}
+
+	if (!isPunctuation ('{'))
+		return syntaxError ();
+
+	nextToken ();
+
+	// predvolene atributy plati len v podgrafe
+	AttributeListType nodeDefaults = nodeDefaults_;
+	AttributeListType edgeDefaults = edgeDefaults_;
+
+	bool ok = parseStatements (&subgraphMembers);
+
+	nodeDefaults_ = nodeDefaults;
+	edgeDefaults_ = edgeDefaults;
+
+	if (!ok)
+		return false;
+
+	nextToken ();
+
+	// uzol moze byt v podgrafe spomenuty viackrat
+	std::sort (subgraphMembers.begin (), subgraphMembers.end ());
+	subgraphMembers.erase (std::unique (subgraphMembers.begin (), subgraphMembers.end ()), subgraphMembers.end ());
+
+	if (members != NULL)
+		*members += subgraphMembers;
+
+	return true;
+}
+
+bool DOTImporter::parseAttributes (
+	AttributeListType &attributes
+) {
+	while (isPunctuation ('[')) {
+		nextToken ();
+
+		while (token_.type == ID_TOKEN) {
+			QByteArray name = token_.text;
+			QByteArray value ("true");
+			nextToken ();
+
+			if (isPunctuation ('=')) {
+				nextToken ();
+				if (token_.type != ID_TOKEN)
+					return syntaxError ();
+
+				value = token_.text;
+				nextToken ();
+			}
+
+			attributes.append (qMakePair (name, value));
+
+			if (isPunctuation (';') || isPunctuation (','))
+				nextToken ();
+		}
+
+		if (!isPunctuation (']'))
+			return syntaxError ();
+
+		nextToken ();
+	}
+
+	return true;
+}
+
+bool DOTImporter::skipPort (void) {
+	while (isPunctuation (':')) {
+		nextToken ();
+		if (token_.type != ID_TOKEN)
+			return syntaxError ();
+
+		nextToken ();
+	}
+
+	return true;
+}
+
+int DOTImporter::getNode (
+	const QByteArray &name,
+	QVector<int> *members
+) {
+	int index;
+
+	QHash<QByteArray, int>::const_iterator it = nodeIndex_.constFind (name);
+	if (it != nodeIndex_.constEnd ()) {
+		index = it.value ();
+	} else {
+		index = nodes_.size ();
+		nodes_.append (context_->getGraph ().addNode (QString::fromUtf8 (name.constData (), name.size ()), nodeType_));
+		nodeIndex_.insert (name, index);
+
+		if (!nodeDefaults_.isEmpty ())
+			storeAttributes (*context_->getGraph ().getNodeAttributes (), nodeColumns_, nodes_.last ()->getId (), nodeDefaults_);
+	}
+
+	if (members != NULL)
+		members->append (index);
+
+	return index;
+}
+
+void DOTImporter::storeAttributes (
+	Data::AttributeStore &attributes,
+	ColumnsMapType &columns,
+	qlonglong id,
+	const AttributeListType &values
+) {
+	// atributy cita aj vlakno GUI (dopyty), zapisujeme ich pod zamkom grafu
+	QMutexLocker locker (context_->getGraph ().getStructureMutex ());
+	int row = attributes.addRow (id);
+
+	for (AttributeListType::const_iterator it = values.constBegin (); it != values.constEnd (); ++it) {
+		// typ stlpca urcime podla prvej hodnoty
+		Data::AttributeColumn *column = columns.value (it->first, NULL);
+		if (column == NULL) {
+			column = attributes.addColumn (
+				QString::fromUtf8 (it->first.constData (), it->first.size ()),
+				Data::AttributeColumn::valueTypeOfText (it->second)
+			);
+			columns.insert (it->first, column);
+		}
+
+		// hodnotu, ktora nezodpoveda typu prvej hodnoty, ulozime po rozsireni stlpca na retazce
+		if (!column->setValue (row, it->second)) {
+			column->convertToString ();
+			(void)column->setValue (row, it->second);
+		}
+	}
+}
+
+bool DOTImporter::reportProgress (void) {
+	if (size_ > 0) {
+		// progress hlasime len pri zmene percenta
+		unsigned int progress = (unsigned int) (position_ * 100 / size_);
+		if (progress != progress_) {
+			progress_ = progress;
+			context_->getInfoHandler ().setProgress (progress_);
+		}
+	}
+
+	return !context_->getInfoHandler ().isCancelled ();
+}
+
+} // namespace
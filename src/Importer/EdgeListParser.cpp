@@ -0,0 +1,461 @@
+#include "Importer/EdgeListParser.h"
+//-----------------------------------------------------------------------------
+#include <QThread>
+#include <QtConcurrentMap>
+//-----------------------------------------------------------------------------
+#include <string.h>
+
+namespace {
+
+/**
+ * \brief Part of the data aligned to the line ends and its tokenized lines.
+ */
+struct Chunk {
+	qint64 begin;
+	qint64 end;
+
+	// pocet stlpcov, indexy mien (lokalne v ramci casti), cisla a texty kazdeho riadku
+	QVector<int> tokenCounts;
+	QVector<int> names;
+	QVector<double> values;
+	QVector<qint64> textOffsets;
+	QVector<int> textLengths;
+	QVector<QByteArray> escapedTexts;
+
+	// rozne mena casti v poradi ich prveho vyskytu
+	QVector<QByteArray> localNames;
+};
+
+inline bool isSpace (char c) {
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+/**
+ * \brief Copies the text of the quoted column, "" is replaced by ".
+ */
+QByteArray unescape (const char *start, const char *stop) {
+	QByteArray text;
+	text.reserve ((int) (stop - start));
+
+	for (const char *p = start; p < stop; p++) {
+		text.append (*p);
+		if (*p == '"' && p + 1 < stop && p[1] == '"')
+			p++;
+	}
+
+	return text;
+}
+
+/**
+ * \brief Scans one column separated by whitespace.
+ * \return False if there are no more columns on the line.
+ */
+bool scanSpaceColumn (const char *&p, const char *end, const char *&start, const char *&stop) {
+	while (p < end && isSpace (*p))
+		p++;
+	if (p == end || *p == '\n')
+		return false;
+
+	start = p;
+	while (p < end && *p != '\n' && !isSpace (*p))
+		p++;
+	stop = p;
+
+	return true;
+}
+
+/**
+ * \brief Scans one column ended by the delimiter or the line end, p is moved behind the delimiter.
+ * \return True if the delimiter follows (another column is on the line).
+ */
+bool scanDelimitedColumn (const char *&p, const char *end, char delimiter, const char *&start, const char *&stop, bool &escaped) {
+	escaped = false;
+
+	while (p < end && *p != delimiter && *p != '\n' && isSpace (*p))
+		p++;
+
+	if (p < end && *p == '"') {
+		// text v uvodzovkach, "" je uvodzovka
+		start = ++p;
+		while (p < end && *p != '\n') {
+			if (*p == '"') {
+				if (p + 1 < end && p[1] == '"') {
+					escaped = true;
+					p += 2;
+					continue;
+				}
+				break;
+			}
+			p++;
+		}
+		stop = p;
+
+		// zvysok stlpca za uvodzovkami ignorujeme
+		while (p < end && *p != delimiter && *p != '\n')
+			p++;
+	} else {
+		start = p;
+		while (p < end && *p != delimiter && *p != '\n')
+			p++;
+		stop = p;
+
+		while (stop > start && isSpace (stop[-1]))
+			stop--;
+	}
+
+	if (p < end && *p == delimiter) {
+		p++;
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * \brief Tokenizes the lines of one chunk and interns names into the table of the chunk.
+ */
+class ChunkTokenizer {
+
+public:
+
+	typedef void result_type;
+
+	ChunkTokenizer (
+		const char *data,
+		char delimiter,
+		const QVector<Importer::EdgeListParser::ColumnRole> &columns,
+		const QVector<int> &columnSlots,
+		int nameColumns,
+		int valueColumns,
+		int textColumns
+	) : data_ (data), delimiter_ (delimiter), columns_ (columns), columnSlots_ (columnSlots),
+		nameColumns_ (nameColumns), valueColumns_ (valueColumns), textColumns_ (textColumns)
+	{
+	}
+
+	void operator() (Chunk &chunk) const {
+		QHash<QByteArray, int> local;
+		const char *p = data_ + chunk.begin;
+		const char *end = data_ + chunk.end;
+
+		while (p < end) {
+			int tokens = 0;
+			const char *start;
+			const char *stop;
+
+			if (delimiter_ == 0) {
+				while (scanSpaceColumn (p, end, start, stop))
+					addToken (chunk, local, tokens++, start, stop, false);
+			} else {
+				// prazdne riadky vynechame, inak aj prazdny stlpec je stlpcom
+				const char *lineStart = p;
+				while (p < end && *p != delimiter_ && isSpace (*p))
+					p++;
+
+				if (p < end && *p != '\n') {
+					p = lineStart;
+
+					bool escaped;
+					bool more;
+					do {
+						more = scanDelimitedColumn (p, end, delimiter_, start, stop, escaped);
+						addToken (chunk, local, tokens++, start, stop, escaped);
+					} while (more);
+				}
+			}
+
+			while (p < end && *p != '\n')
+				p++;
+			if (p < end)
+				p++;
+
+			if (tokens > 0)
+				chunk.tokenCounts.append (tokens);
+		}
+	}
+
+private:
+
+	void addToken (Chunk &chunk, QHash<QByteArray, int> &local, int token, const char *start, const char *stop, bool escaped) const {
+		// miesta pre stlpce riadku pridame az pri jeho prvom slove, prazdne riadky vynechame
+		if (token == 0) {
+			for (int i = 0; i < nameColumns_; i++)
+				chunk.names.append (-1);
+			for (int i = 0; i < valueColumns_; i++)
+				chunk.values.append (0);
+			for (int i = 0; i < textColumns_; i++) {
+				chunk.textOffsets.append (0);
+				chunk.textLengths.append (-1);
+			}
+		}
+
+		if (token >= columns_.size ())
+			return;
+
+		int slot = columnSlots_.at (token);
+		switch (columns_.at (token)) {
+			case Importer::EdgeListParser::NAME_COLUMN: {
+				// kluc odkazuje priamo do dat, neskopiruje sa (okrem textu s "")
+				QByteArray name = escaped ? unescape (start, stop) : QByteArray::fromRawData (start, (int) (stop - start));
+				QHash<QByteArray, int>::const_iterator it = local.constFind (name);
+				int id;
+				if (it == local.constEnd ()) {
+					id = chunk.localNames.size ();
+					local.insert (name, id);
+					chunk.localNames.append (name);
+				} else {
+					id = it.value ();
+				}
+				chunk.names[chunk.names.size () - nameColumns_ + slot] = id;
+				break;
+			}
+			case Importer::EdgeListParser::VALUE_COLUMN:
+				chunk.values[chunk.values.size () - valueColumns_ + slot] = QByteArray::fromRawData (start, (int) (stop - start)).toDouble ();
+				break;
+			case Importer::EdgeListParser::TEXT_COLUMN: {
+				int i = chunk.textOffsets.size () - textColumns_ + slot;
+				if (escaped) {
+					chunk.escapedTexts.append (unescape (start, stop));
+					chunk.textOffsets[i] = -chunk.escapedTexts.size ();
+					chunk.textLengths[i] = 0;
+				} else {
+					chunk.textOffsets[i] = start - data_;
+					chunk.textLengths[i] = (int) (stop - start);
+				}
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	const char *data_;
+	char delimiter_;
+	QVector<Importer::EdgeListParser::ColumnRole> columns_;
+	QVector<int> columnSlots_;
+	int nameColumns_;
+	int valueColumns_;
+	int textColumns_;
+};
+
+} // namespace
+
+namespace Importer {
+
+const qint64 EdgeListParser::CHUNK_SIZE;
+const int EdgeListParser::CHUNKS_PER_THREAD;
+
+EdgeListParser::EdgeListParser (
+	QIODevice &stream,
+	int nameColumns,
+	int valueColumns
+) : stream_ (stream),
+	file_ (NULL),
+	mapped_ (NULL),
+	data_ (NULL),
+	size_ (0),
+	position_ (0),
+	delimiter_ (0)
+{
+	// mena v prvych stlpcoch, za nimi cisla
+	QVector<ColumnRole> columns;
+	for (int i = 0; i < nameColumns; i++)
+		columns.append (NAME_COLUMN);
+	for (int i = 0; i < valueColumns; i++)
+		columns.append (VALUE_COLUMN);
+
+	setColumns (columns);
+}
+
+EdgeListParser::~EdgeListParser (void) {
+	// kluce tabulky mien odkazuju do dat, uvolnime ju pred nimi
+	index_.clear ();
+
+	if (mapped_ != NULL)
+		(void)file_->unmap (mapped_);
+}
+
+void EdgeListParser::setColumns (
+	const QVector<ColumnRole> &columns
+) {
+	columns_ = columns;
+	columnSlots_.resize (columns.size ());
+	nameColumns_ = 0;
+	valueColumns_ = 0;
+	textColumns_ = 0;
+
+	for (int i = 0; i < columns.size (); i++) {
+		switch (columns.at (i)) {
+			case NAME_COLUMN: columnSlots_[i] = nameColumns_++; break;
+			case VALUE_COLUMN: columnSlots_[i] = valueColumns_++; break;
+			case TEXT_COLUMN: columnSlots_[i] = textColumns_++; break;
+			default: columnSlots_[i] = -1; break;
+		}
+	}
+}
+
+void EdgeListParser::setDelimiter (
+	char delimiter
+) {
+	delimiter_ = delimiter;
+}
+
+QList<QByteArray> EdgeListParser::splitLine (
+	const QByteArray &line
+) const {
+	QList<QByteArray> result;
+	const char *p = line.constData ();
+	const char *end = p + line.size ();
+	const char *start;
+	const char *stop;
+
+	if (delimiter_ == 0) {
+		while (scanSpaceColumn (p, end, start, stop))
+			result.append (QByteArray (start, (int) (stop - start)));
+	} else if (!line.trimmed ().isEmpty ()) {
+		bool escaped;
+		bool more;
+		do {
+			more = scanDelimitedColumn (p, end, delimiter_, start, stop, escaped);
+			result.append (escaped ? unescape (start, stop) : QByteArray (start, (int) (stop - start)));
+		} while (more);
+	}
+
+	return result;
+}
+
+QByteArray EdgeListParser::getText (
+	int line,
+	int column
+) const {
+	int i = line * textColumns_ + column;
+	qint64 offset = textOffsets_.at (i);
+
+	if (offset < 0)
+		return escapedTexts_.at ((int) (-offset - 1));
+
+	if (textLengths_.at (i) < 0)
+		return QByteArray ();
+
+	return QByteArray::fromRawData (data_ + offset, textLengths_.at (i));
+}
+
+bool EdgeListParser::open (void) {
+	qint64 start = stream_.pos ();
+
+	// subor namapujeme do pamate, ostatne zariadenia precitame naraz
+	file_ = qobject_cast<QFile *> (&stream_);
+	if (file_ != NULL && !file_->isSequential () && file_->size () > start) {
+		mapped_ = file_->map (0, file_->size ());
+	}
+
+	if (mapped_ != NULL) {
+		data_ = (const char *) mapped_ + start;
+		size_ = file_->size () - start;
+	} else {
+		buffer_ = stream_.readAll ();
+		data_ = buffer_.constData ();
+		size_ = buffer_.size ();
+	}
+
+	position_ = 0;
+
+	return data_ != NULL;
+}
+
+QByteArray EdgeListParser::readLine (void) {
+	if (atEnd ())
+		return QByteArray ();
+
+	const char *start = data_ + position_;
+	const char *lineEnd = (const char *) memchr (start, '\n', (size_t) (size_ - position_));
+	qint64 length = (lineEnd != NULL) ? lineEnd - start : size_ - position_;
+
+	position_ += (lineEnd != NULL) ? length + 1 : length;
+
+	if (length > 0 && start[length - 1] == '\r')
+		length--;
+
+	return QByteArray (start, (int) length);
+}
+
+bool EdgeListParser::atEnd (void) const {
+	return position_ >= size_;
+}
+
+bool EdgeListParser::parseNext (void) {
+	tokenCounts_.clear ();
+	lineNames_.clear ();
+	lineValues_.clear ();
+	textOffsets_.clear ();
+	textLengths_.clear ();
+	escapedTexts_.clear ();
+
+	if (atEnd ())
+		return false;
+
+	// okno casti zarovnanych na konce riadkov
+	QVector<Chunk> window;
+	int chunks = qMax (1, QThread::idealThreadCount ()) * CHUNKS_PER_THREAD;
+	qint64 chunkSize = CHUNK_SIZE;
+
+	for (int i = 0; i < chunks && position_ < size_; i++) {
+		Chunk chunk;
+		chunk.begin = position_;
+		chunk.end = qMin (position_ + chunkSize, size_);
+
+		if (chunk.end < size_) {
+			const char *lineEnd = (const char *) memchr (data_ + chunk.end, '\n', (size_t) (size_ - chunk.end));
+			chunk.end = (lineEnd != NULL) ? lineEnd - data_ + 1 : size_;
+		}
+
+		window.append (chunk);
+		position_ = chunk.end;
+	}
+
+	QtConcurrent::blockingMap (window, ChunkTokenizer (data_, delimiter_, columns_, columnSlots_, nameColumns_, valueColumns_, textColumns_));
+
+	// tabulky mien casti zlucime v poradi casti
+	for (int c = 0; c < window.size (); c++) {
+		Chunk &chunk = window[c];
+
+		QVector<int> globalIds (chunk.localNames.size ());
+		for (int i = 0; i < chunk.localNames.size (); i++) {
+			QHash<QByteArray, int>::const_iterator it = index_.constFind (chunk.localNames.at (i));
+			if (it == index_.constEnd ()) {
+				globalIds[i] = names_.size ();
+				index_.insert (chunk.localNames.at (i), names_.size ());
+				const QByteArray &name = chunk.localNames.at (i);
+				names_.append (delimiter_ != 0 ? QString::fromUtf8 (name.constData (), name.size ()) : QString::fromLocal8Bit (name.constData (), name.size ()));
+			} else {
+				globalIds[i] = it.value ();
+			}
+		}
+
+		for (int i = 0; i < chunk.names.size (); i++) {
+			if (chunk.names.at (i) >= 0)
+				chunk.names[i] = globalIds.at (chunk.names.at (i));
+		}
+
+		// kopie textov s "" cislujeme v ramci celeho okna
+		int escapedBase = escapedTexts_.size ();
+		for (int i = 0; i < chunk.textOffsets.size (); i++) {
+			if (chunk.textOffsets.at (i) < 0)
+				chunk.textOffsets[i] -= escapedBase;
+		}
+
+		tokenCounts_ += chunk.tokenCounts;
+		lineNames_ += chunk.names;
+		lineValues_ += chunk.values;
+		textOffsets_ += chunk.textOffsets;
+		textLengths_ += chunk.textLengths;
+		escapedTexts_ += chunk.escapedTexts;
+
+		// data casti uz nepotrebujeme
+		chunk = Chunk ();
+	}
+
+	return true;
+}
+
+} // namespace
@@ -12,7 +12,7 @@ bool GXLImporter::import (
 	// helpers
 	xml_.reset (new QXmlStreamReader (&(context_->getStream ())));
 	graphOp_.reset (new GraphOperations (context_->getGraph ()));
-	readNodes_.reset (new ReadNodesStore());
+	readNodes_.reset (new ReadNodesStore (*context_->getGraph ().getStringTable ()));
 
 	// default types
 	edgeType_ = NULL;
@@ -81,7 +81,12 @@ bool GXLImporter::import (
 	}
 
 	if (ok) {
+		// uzly a hrany vkladame hromadne, zoznamy grafu sa vytvoria az na konci
+		context_->getGraph ().beginBulkInsert ();
+
 		ok = parseGraph ();
+
+		context_->getGraph ().commitBulkInsert ();
 	}
 
 	xml_->clear ();
@@ -127,6 +132,11 @@ bool GXLImporter::parseGraph (void) {
 	bool inHyperedge = false;
 
 	while (ok && !xml_->atEnd ()) {
+		// import mohol byt zruseny
+		if (ok) {
+			ok = !context_->getInfoHandler ().isCancelled ();
+		}
+
 		QXmlStreamReader::TokenType token;
 		if (ok) {
 			token = xml_->readNext();
@@ -160,6 +170,32 @@ bool GXLImporter::parseGraph (void) {
 				}
 			}
 
+			// atribut uzla/hrany
+			if (
+				(token == QXmlStreamReader::StartElement)
+				&&
+				(xml_->name () == "attr")
+				&&
+				((bool)currentNode || (bool)currentEdge)
+			) {
+				QString attrName = xml_->attributes ().value ("name").toString ();
+
+				// hodnota je vo vnorenom elemente, ktoreho nazov urcuje typ (int, float, string, bool)
+				if (!attrName.isEmpty () && xml_->readNextStartElement ()) {
+					Data::AttributeColumn::ValueType valueType = Data::AttributeColumn::valueTypeFromName (xml_->name ().toString ());
+					QString value = xml_->readElementText (QXmlStreamReader::SkipChildElements);
+
+					Data::AttributeStore *attributes = (bool)currentNode
+						? context_->getGraph ().getNodeAttributes ()
+						: context_->getGraph ().getEdgeAttributes ();
+					qlonglong id = (bool)currentNode ? currentNode->getId () : currentEdge->getId ();
+
+					// atributy cita aj vlakno GUI (dopyty), zapisujeme ich pod zamkom grafu
+					QMutexLocker locker (context_->getGraph ().getStructureMutex ());
+					(void)attributes->addColumn (attrName, valueType)->setValue (attributes->addRow (id), value);
+				}
+			}
+
 			// parsovanie uzla
 			if (
 				(token == QXmlStreamReader::StartElement)
@@ -174,18 +210,21 @@ bool GXLImporter::parseGraph (void) {
 
 				QXmlStreamAttributes attrs = xml_->attributes();
 
-				QString nodeName;
+				int nodeName = -1;
 				if (ok) {
-					nodeName = attrs.value ("id").toString ();
-
-					ok = !(nodeName.isEmpty ());
+					ok = !(attrs.value ("id").isEmpty ());
 
 					context_->getInfoHandler ().reportError (ok, "Node ID can not be empty.");
 				}
 
+				if (ok) {
+					nodeName = readNodes_->intern (attrs.value ("id"));
+				}
+
 				osg::ref_ptr<Data::Node> node (NULL);
 				if (ok) {
-					node = context_->getGraph ().addNode (nodeName, nodeType_);
+					// meno uzla zdiela data s tabulkou retazcov grafu
+					node = context_->getGraph ().addNode (readNodes_->getName (nodeName), nodeType_);
 
 					ok = node.valid ();
 
@@ -265,25 +304,27 @@ bool GXLImporter::parseGraph (void) {
 				}
 
 				//cielovy a zdrojovy uzol hrany
-				QString nodeFromName;
+				int nodeFromName = -1;
 				if (ok) {
-					nodeFromName = attrs.value ("from").toString ();
-
-					ok = !(nodeFromName.isEmpty ());
+					ok = !(attrs.value ("from").isEmpty ());
 
 					context_->getInfoHandler ().reportError (ok, "Edge \"from\" attribute can not be empty.");
 				}
 
-				QString nodeToName;
 				if (ok) {
-					nodeToName = attrs.value ("to").toString ();
+					nodeFromName = readNodes_->intern (attrs.value ("from"));
+				}
 
-					ok = !(nodeToName.isEmpty ());
+				int nodeToName = -1;
+				if (ok) {
+					ok = !(attrs.value ("to").isEmpty ());
 
 					context_->getInfoHandler ().reportError (ok, "Edge \"to\" attribute can not be empty.");
 				}
 
-				QString edgeName = nodeFromName + nodeToName;
+				if (ok) {
+					nodeToName = readNodes_->intern (attrs.value ("to"));
+				}
 
 				if (ok) {
 					ok = readNodes_->contains (nodeFromName);
@@ -299,8 +340,9 @@ bool GXLImporter::parseGraph (void) {
 
 				osg::ref_ptr<Data::Edge> edge (NULL);
 				if (ok) {
+					// meno hrany sa odvodi z mien uzlov az ked bude potrebne
 					edge = context_->getGraph().addEdge(
-						edgeName,
+						QString (),
 						readNodes_->get (nodeFromName),
 						readNodes_->get (nodeToName),
 						edgeType_,
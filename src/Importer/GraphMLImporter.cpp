@@ -9,8 +9,9 @@ bool GraphMLImporter::import (
 	// context
 	context_ = &context;
 	// helpers
+	xml_.reset (new QXmlStreamReader (&(context_->getStream ())));
 	graphOp_.reset (new GraphOperations (context_->getGraph ()));
-	readNodes_.reset (new ReadNodesStore());
+	readNodes_.reset (new ReadNodesStore (*context_->getGraph ().getStringTable ()));
 
 	// default types
 	edgeType_ = NULL;
@@ -23,6 +24,7 @@ bool GraphMLImporter::import (
 	nodeTypeAttribute_ = appConf->getValue("GraphMLParser.nodeTypeAttribute");
 
 	// pole farieb FIXME oddelit farby hran od farieb uzlov
+	colors_.clear ();
 	colors_.push_back (ColorType (0, 1, 0, 1));
 	colors_.push_back (ColorType (0, 1, 1, 1));
 	colors_.push_back (ColorType (1, 0, 0, 1));
@@ -30,360 +32,433 @@ bool GraphMLImporter::import (
 	colors_.push_back (ColorType (1, 1, 0, 1));
 	colors_.push_back (ColorType (1, 1, 1, 1));
 
-	iColor_ = 0;
+	iNodeColor_ = 0;
+	iEdgeColor_ = 0;
+
+	nodeColumns_.clear ();
+	edgeColumns_.clear ();
+
+	// priebeh importu urcujeme podla pozicie v subore, pri komprimovanom subore podla pozicie v komprimovanych datach
+	compressedStream_ = qobject_cast<Util::CompressedInputDevice *> (&(context_->getStream ()));
+	if (compressedStream_ != NULL) {
+		streamSize_ = compressedStream_->getSourceSize ();
+	} else {
+		streamSize_ = context_->getStream ().isSequential () ? 0 : context_->getStream ().size ();
+	}
+	progress_ = 0;
 
 	bool ok = true;
 
-	// ziskame graph element
-	QDomElement graphElement;
-	if (ok) {
-		QDomNode graphNode;
-
-		QDomDocument doc("graphMLDocument");
-		if (doc.setContent(&(context_->getStream())))
-		{
-				QDomElement docElem = doc.documentElement();
-				if (!docElem.isNull() && docElem.nodeName() == "graphml")
-				{
-						QDomNodeList graphNodes = docElem.elementsByTagName("graph");
-						if (graphNodes.length() > 0)
-						{
-								graphNode = graphNodes.item(0);
-								if (!graphNode.isNull() && graphNode.parentNode() == docElem && graphNode.isElement())
-								{
-										graphElement = graphNode.toElement();
-								}
-						}
-				}
+	// najdeme korenovy element graphml a v nom prvy graf, kluce atributov su deklarovane pred nim
+	bool graphmlElementFound = false;
+	bool graphElementFound = false;
+	while (ok && !xml_->atEnd () && !graphElementFound) {
+		QXmlStreamReader::TokenType token = xml_->readNext ();
+
+		if (token == QXmlStreamReader::StartElement) {
+			if (!graphmlElementFound) {
+				graphmlElementFound = (xml_->name () == "graphml");
+				ok = graphmlElementFound;
+			} else if (xml_->name () == "key") {
+				processKey ();
+			} else if (xml_->name () == "graph") {
+				graphElementFound = true;
+			}
 		}
 
-		ok = !graphElement.isNull();
+		if (ok) {
+			ok = !xml_->hasError ();
+		}
+	}
 
-		context_->getInfoHandler ().reportError (ok, "Zvoleny subor nie je validny GraphML subor.");
+	if (ok) {
+		ok = graphElementFound;
 	}
 
+	context_->getInfoHandler ().reportError (ok, "Zvoleny subor nie je validny GraphML subor.");
+
 	if (ok) {
 		// graph name
-		QString graphname = "Graph "+graphElement.attribute("id");
+		QString graphname = "Graph " + xml_->attributes ().value ("id").toString ();
 		context_->getGraph ().setName (graphname);
 	}
 
 	if (ok) {
-		// for progress reporting
-		entitiesProcessed_ = 0;
-		entitiesCount_ = graphElement.elementsByTagName("node").size() + graphElement.elementsByTagName("edge").count();
-	}
+		// uzly a hrany vkladame hromadne, zoznamy grafu sa vytvoria az na konci
+		context_->getGraph ().beginBulkInsert ();
 
-	if (ok) {
-		ok = processGraph (graphElement);
+		ok = parseGraph ();
+
+		context_->getGraph ().commitBulkInsert ();
 	}
 
+	xml_->clear ();
+
 	return ok;
 }
 
-bool GraphMLImporter::processGraph (
-	QDomElement &graphElement
-) {
-	bool ok = true;
+void GraphMLImporter::processKey (void) {
+	QXmlStreamAttributes attrs = xml_->attributes ();
 
-	ok =
-		processGraph_Nodes (graphElement)
-		&&
-		processGraph_Edges (graphElement)
-		&&
-		processGraph_Hyperedges (graphElement)
-	;
+	QString keyId = attrs.value ("id").toString ();
+	QString keyFor = attrs.hasAttribute ("for") ? attrs.value ("for").toString () : QString ("all");
+	QString keyName = attrs.hasAttribute ("attr.name") ? attrs.value ("attr.name").toString () : keyId;
+	Data::AttributeColumn::ValueType valueType = Data::AttributeColumn::valueTypeFromName (
+		attrs.hasAttribute ("attr.type") ? attrs.value ("attr.type").toString () : QString ("string")
+	);
 
-	return ok;
+	if (keyId.isEmpty ())
+		return;
+
+	// atributy cita aj vlakno GUI (dopyty), menime ich pod zamkom grafu
+	QMutexLocker locker (context_->getGraph ().getStructureMutex ());
+
+	// deklarovany atribut - vytvorime stlpec s typom podla attr.type, typy uzlov a hran sa neukladaju ako atributy
+	if ((keyFor == "node" || keyFor == "all") && keyId != nodeTypeAttribute_)
+		nodeColumns_.insert (keyId, context_->getGraph ().getNodeAttributes ()->addColumn (keyName, valueType));
+
+	if ((keyFor == "edge" || keyFor == "all") && keyId != edgeTypeAttribute_)
+		edgeColumns_.insert (keyId, context_->getGraph ().getEdgeAttributes ()->addColumn (keyName, valueType));
 }
 
-bool GraphMLImporter::processGraph_Nodes (
-	QDomElement &graphElement
+void GraphMLImporter::storeData (
+	Data::AttributeStore &attributes,
+	ColumnsMapType &columns,
+	qlonglong id,
+	const DataListType &data
 ) {
-	bool ok = true;
+	QMutexLocker locker (context_->getGraph ().getStructureMutex ());
+	int row = attributes.addRow (id);
 
-	iColor_ = 0;
+	for (DataListType::const_iterator it = data.constBegin (); it != data.constEnd (); ++it) {
+		Data::AttributeColumn *column = columns.value (it->first, NULL);
 
-	// nodes
-	for (QDomElement nodeElement = graphElement.firstChildElement("node"); ok && !nodeElement.isNull(); nodeElement = nodeElement.nextSiblingElement("node"))
-	{
-		QString nameId = nodeElement.attribute("id");
-		QString name = NULL;
-		// pozerame sa na data ktore nesie
-		Data::Type *newNodeType;
-		newNodeType = NULL;
-		QDomNodeList nodeDataList = nodeElement.elementsByTagName("data");
-		for (unsigned int j = 0; j < nodeDataList.length(); j++){
-			QDomNode nodeData = nodeDataList.item(j);
-			if (!nodeData.isNull() && nodeData.isElement())
-			{
-					QDomElement nodeDataElement = nodeData.toElement();
-					QString dataName = nodeDataElement.attribute("key");
-					QString dataValue = nodeDataElement.text();
-					// rozpoznavame typy
-					if(dataName == nodeTypeAttribute_){
-						// overime ci uz dany typ existuje v grafe
-						QList<Data::Type*> types = context_->getGraph().getTypesByName(dataValue);
-						if(types.isEmpty()){
-							QMap<QString, QString> *settings = new QMap<QString, QString>;
-
-							settings->insert("color.R", QString::number(colors_[iColor_][0]));
-							settings->insert("color.G", QString::number(colors_[iColor_][1]));
-							settings->insert("color.B", QString::number(colors_[iColor_][2]));
-							settings->insert("color.A", QString::number(colors_[iColor_][3]));
-							settings->insert("scale",		Util::ApplicationConfig::get()->getValue("Viewer.Textures.DefaultNodeScale"));
-							settings->insert("textureFile", Util::ApplicationConfig::get()->getValue("Viewer.Textures.Node"));
-
-							newNodeType = context_->getGraph().addType(dataValue, settings);
-
-							iColor_++;
-							if(iColor_ == colors_.size ()){
-								iColor_ = 0;
-							};
-						} else {
-							newNodeType = types.first();
-						}
+		// nedeklarovany kluc ulozime ako retazec
+		if (column == NULL) {
+			column = attributes.addColumn (it->first, Data::AttributeColumn::STRING);
+			columns.insert (it->first, column);
+		}
+
+		(void)column->setValue (row, it->second);
+	}
+}
+
+bool GraphMLImporter::parseGraph (void) {
+	bool ok = true;
+
+	iNodeColor_ = 0;
+	iEdgeColor_ = 0;
 
+	// zakladna orientacia hran
+	bool defaultDirection = (xml_->attributes ().value ("edgedefault") == "directed");
+
+	// hrany na uzly deklarovane az za nimi a hyperhrany pridame na konci grafu
+	PendingEdgesListType pendingEdges;
+	PendingHyperedgesListType pendingHyperedges;
+
+	// rozpracovany uzol - vytvorime ho az ked pozname jeho typ (na konci uzla alebo pred vnorenym grafom)
+	bool inNode = false;
+	int nodeName = -1;
+	Data::Type *nodeType = NULL;
+	DataListType nodeData;
+	osg::ref_ptr<Data::Node> currentNode (NULL);
+
+	// rozpracovana hrana
+	bool inEdge = false;
+	PendingEdge edge;
+
+	// rozpracovana hyperhrana
+	bool inHyperedge = false;
+	EndpointsListType endpoints;
+
+	while (ok && !xml_->atEnd ()) {
+		QXmlStreamReader::TokenType token = xml_->readNext ();
+
+		if (token == QXmlStreamReader::StartElement) {
+			bool inEntity = inNode || inEdge || inHyperedge;
+
+			if (xml_->name () == "node" && !inEntity) {
+				inNode = true;
+				nodeName = readNodes_->intern (xml_->attributes ().value ("id"));
+				nodeType = nodeType_;
+				nodeData.clear ();
+				currentNode = NULL;
+			} else if (xml_->name () == "edge" && !inEntity) {
+				QXmlStreamAttributes attrs = xml_->attributes ();
+
+				inEdge = true;
+				edge.source = readNodes_->intern (attrs.value ("source"));
+				edge.target = readNodes_->intern (attrs.value ("target"));
+				edge.type = edgeType_;
+				edge.data.clear ();
+
+				QStringRef direction = attrs.value ("directed");
+				if (direction.isEmpty ()) {
+					edge.directed = defaultDirection;
+				} else {
+					edge.directed = (direction == "true");
+				}
+			} else if (xml_->name () == "hyperedge" && !inEntity) {
+				inHyperedge = true;
+				endpoints.clear ();
+			} else if (xml_->name () == "endpoint" && inHyperedge) {
+				QXmlStreamAttributes attrs = xml_->attributes ();
+
+				endpoints.append (qMakePair (attrs.value ("node").toString (), attrs.value ("type").toString ()));
+			} else if (xml_->name () == "data" && (inNode || inEdge)) {
+				QString dataName = xml_->attributes ().value ("key").toString ();
+				QString dataValue = xml_->readElementText (QXmlStreamReader::IncludeChildElements);
+
+				if (inNode) {
+					// rozpoznavame typy, typ uz vytvoreneho uzla nemenime
+					if (dataName == nodeTypeAttribute_) {
+						if (!currentNode.valid ())
+							nodeType = getNodeType (dataValue);
+					} else {
+						// kazde dalsie data ulozime do atributov uzlov grafu
+						nodeData.append (qMakePair (dataName, dataValue));
+					}
+				} else {
+					// rozpoznavame typy deklarovane atributom relation
+					if (dataName == edgeTypeAttribute_) {
+						edge.type = getEdgeType (dataValue, edge.directed);
 					} else {
-						// kazde dalsie data nacitame do nosica dat - Node.name
-						// FIXME potom prerobit cez Adamove Node.settings
-						if(name == NULL){
-							name = dataName+":"+dataValue;
-						} else {
-							name += " | "+dataName+":"+dataValue;
-						}
+						// kazde dalsie data ulozime do atributov hran grafu
+						edge.data.append (qMakePair (dataName, dataValue));
+					}
+				}
+			} else if (xml_->name () == "graph") {
+				if (inNode) {
+					// vnoreny graf patri uzlu, uzol preto vytvorime uz teraz
+					if (!currentNode.valid ())
+						currentNode = addNode (nodeName, nodeType);
+
+					context_->getGraph().createNestedGraph (currentNode);
+
+					ok = parseGraph ();
+
+					if (ok) {
+						context_->getGraph().closeNestedGraph ();
 					}
+				} else if (inEdge) {
+					// TODO: begin/end subgraph in edge
+					ok = parseGraph ();
+				} else {
+					xml_->skipCurrentElement ();
+				}
+			}
+		} else if (token == QXmlStreamReader::EndElement) {
+			if (xml_->name () == "node" && inNode) {
+				if (!currentNode.valid ())
+					currentNode = addNode (nodeName, nodeType);
+
+				// uzol ostava pomenovany podla ID, data su iba v ulozisku atributov
+				if (!nodeData.isEmpty ())
+					storeData (*context_->getGraph ().getNodeAttributes (), nodeColumns_, currentNode->getId (), nodeData);
+
+				currentNode = NULL;
+				inNode = false;
+
+				ok = reportProgress ();
+			} else if (xml_->name () == "edge" && inEdge) {
+				if (readNodes_->contains (edge.source) && readNodes_->contains (edge.target))
+					addEdge (edge);
+				else
+					pendingEdges.append (edge);
+
+				inEdge = false;
+
+				ok = reportProgress ();
+			} else if (xml_->name () == "hyperedge" && inHyperedge) {
+				pendingHyperedges.append (endpoints);
+				inHyperedge = false;
+			} else if (xml_->name () == "graph") {
+				// this graph end
+				break;
 			}
 		}
 
-		// ak sme nenasli name, tak ako name pouzijeme aspon ID
-		if(name == NULL){
-			name = nameId;
+		if (ok) {
+			ok = !xml_->hasError ();
+
+			context_->getInfoHandler ().reportError (ok, "XML format error.");
 		}
+	}
 
-		// ak nebol najdeny ziaden typ, tak pouzijeme defaultny typ
-		osg::ref_ptr<Data::Node> node;
-		if(newNodeType == NULL)
-			node = context_->getGraph().addNode(name, nodeType_);
-		else
-			node = context_->getGraph().addNode(name, newNodeType);
-		readNodes_->addNode (nameId, node);
-
-		// subgraphs
-		for (QDomElement subgraphElement = nodeElement.firstChildElement("graph"); ok && !subgraphElement.isNull(); subgraphElement = subgraphElement.nextSiblingElement("graph")) {
-			if (ok) {
-				context_->getGraph().createNestedGraph (node);
-			}
+	// hrany na uzly deklarovane az za hranou
+	for (PendingEdgesListType::const_iterator it = pendingEdges.constBegin (); ok && it != pendingEdges.constEnd (); ++it) {
+		ok = readNodes_->contains (it->source) && readNodes_->contains (it->target);
 
-			if (ok) {
-				ok = processGraph(subgraphElement);
-			}
+		context_->getInfoHandler ().reportError (ok, "Edge references invalid node.");
 
-			if (ok) {
-				context_->getGraph().closeNestedGraph ();
-			}
+		if (ok) {
+			addEdge (*it);
 		}
+	}
 
-		entitiesProcessed_++;
-		context_->getInfoHandler ().setProgress (entitiesProcessed_ * 100 / entitiesCount_);
+	// hyperedges
+	for (int i = 0; ok && i < pendingHyperedges.size (); i++) {
+		ok = addHyperedge (QString::number (i), pendingHyperedges.at (i));
 	}
 
 	return ok;
 }
 
-bool GraphMLImporter::processGraph_Edges (
-	QDomElement &graphElement
+Data::Type *GraphMLImporter::getNodeType (
+	const QString &name
 ) {
-	bool ok = true;
-
-	iColor_ = 0;
+	// overime ci uz dany typ existuje v grafe
+	QList<Data::Type*> types = context_->getGraph().getTypesByName(name);
+	if (!types.isEmpty ())
+		return types.first ();
+
+	QMap<QString, QString> *settings = new QMap<QString, QString>;
+
+	settings->insert("color.R", QString::number(colors_[iNodeColor_][0]));
+	settings->insert("color.G", QString::number(colors_[iNodeColor_][1]));
+	settings->insert("color.B", QString::number(colors_[iNodeColor_][2]));
+	settings->insert("color.A", QString::number(colors_[iNodeColor_][3]));
+	settings->insert("scale",		Util::ApplicationConfig::get()->getValue("Viewer.Textures.DefaultNodeScale"));
+	settings->insert("textureFile", Util::ApplicationConfig::get()->getValue("Viewer.Textures.Node"));
+
+	iNodeColor_++;
+	if(iNodeColor_ == colors_.size ()){
+		iNodeColor_ = 0;
+	};
+
+	return context_->getGraph().addType(name, settings);
+}
 
-	// zakladna orientacia hran
-	bool defaultDirection;
-	if(graphElement.attribute("edgedefault") == "directed"){
-		defaultDirection = true;
-	} else {
-		defaultDirection = false;
-	}
+Data::Type *GraphMLImporter::getEdgeType (
+	const QString &name,
+	bool directed
+) {
+	QString typeName = directed ? name + "_directed" : name;
 
-	// hrany
-	for (QDomElement edgeElement = graphElement.firstChildElement("edge"); ok && !edgeElement.isNull(); edgeElement = edgeElement.nextSiblingElement("edge"))
-	{
-		QString sourceId = edgeElement.attribute("source");
-		QString targetId = edgeElement.attribute("target");
-
-		QString direction = NULL;
-		bool directed = false;
-		direction = edgeElement.attribute("directed");
-		if(direction == NULL) {
-			directed = defaultDirection;
-			if(directed)
-				direction = "_directed";
-			else
-				direction = "";
-		} else {
-			if(direction == "true"){
-				direction = "_directed";
-				directed = true;
-			} else {
-				direction = "";
-				directed = false;
-			}
-		}
+	// overime ci uz dany typ existuje v grafe
+	QList<Data::Type*> types = context_->getGraph().getTypesByName(typeName);
+	if (!types.isEmpty ())
+		return types.first ();
 
-		// pozerame sa na data ktore hrana nesie
-		Data::Type *newEdgeType;
-		newEdgeType = NULL;
-		QDomNodeList edgeDataList = edgeElement.elementsByTagName("data");
-		for (unsigned int j = 0; j < edgeDataList.length(); j++){
-			QDomNode edgeData = edgeDataList.item(j);
-			if (!edgeData.isNull() && edgeData.isElement())
-			{
-					QDomElement edgeDataElement = edgeData.toElement();
-					QString dataName = edgeDataElement.attribute("key");
-					QString dataValue = edgeDataElement.text();
-					// rozpoznavame typy deklarovane atributom relation
-					if(dataName == edgeTypeAttribute_){
-						// overime ci uz dany typ existuje v grafe
-						QList<Data::Type*> types = context_->getGraph().getTypesByName(dataValue+direction);
-						if(types.isEmpty()){
-							QMap<QString, QString> *settings = new QMap<QString, QString>;
-
-							// FIXME spravit tak, aby to rotovalo po tom poli - palo az to budes prerabat tak pre hrany pouzi ine pole, take co ma alfu na 0.5.. a to sa tyka aj uzlov s defaultnym typom
-						   settings->insert("color.R", QString::number(colors_[iColor_][0]));
-						   settings->insert("color.G", QString::number(colors_[iColor_][1]));
-						   settings->insert("color.B", QString::number(colors_[iColor_][2]));
-						   settings->insert("color.A", QString::number(colors_[iColor_][3]));
-						   settings->insert("scale",		Util::ApplicationConfig::get()->getValue("Viewer.Textures.DefaultNodeScale"));
-
-						   if (!directed)
-								settings->insert("textureFile", Util::ApplicationConfig::get()->getValue("Viewer.Textures.Edge"));
-						   else
-						   {
-							   settings->insert("textureFile", Util::ApplicationConfig::get()->getValue("Viewer.Textures.OrientedEdgePrefix"));
-							   settings->insert("textureFile", Util::ApplicationConfig::get()->getValue("Viewer.Textures.OrientedEdgeSuffix"));
-						   }
-
-							newEdgeType = context_->getGraph().addType(dataValue+direction, settings);
-
-							iColor_++;
-							if(iColor_ == colors_.size ()){
-								iColor_ = 0;
-							};
-						} else {
-							newEdgeType = types.first();
-						}
+	QMap<QString, QString> *settings = new QMap<QString, QString>;
 
-					} else {
-						// kazde dalsie data nacitame do nosica dat - Edge.name
-						// FIXME potom prerobit cez Adamove Node.settings
-					}
-			}
-		}
+	// FIXME spravit tak, aby to rotovalo po tom poli - palo az to budes prerabat tak pre hrany pouzi ine pole, take co ma alfu na 0.5.. a to sa tyka aj uzlov s defaultnym typom
+	settings->insert("color.R", QString::number(colors_[iEdgeColor_][0]));
+	settings->insert("color.G", QString::number(colors_[iEdgeColor_][1]));
+	settings->insert("color.B", QString::number(colors_[iEdgeColor_][2]));
+	settings->insert("color.A", QString::number(colors_[iEdgeColor_][3]));
+	settings->insert("scale",		Util::ApplicationConfig::get()->getValue("Viewer.Textures.DefaultNodeScale"));
 
-		// ak nebol najdeny typ, tak pouzijeme defaulty
-		if(newEdgeType == NULL)
-			newEdgeType = edgeType_;
+	if (!directed)
+		settings->insert("textureFile", Util::ApplicationConfig::get()->getValue("Viewer.Textures.Edge"));
+	else
+	{
+		settings->insert("textureFile", Util::ApplicationConfig::get()->getValue("Viewer.Textures.OrientedEdgePrefix"));
+		settings->insert("textureFile", Util::ApplicationConfig::get()->getValue("Viewer.Textures.OrientedEdgeSuffix"));
+	}
 
-		context_->getGraph().addEdge(sourceId+targetId, readNodes_->get(sourceId), readNodes_->get(targetId), newEdgeType, directed);
+	iEdgeColor_++;
+	if(iEdgeColor_ == colors_.size ()){
+		iEdgeColor_ = 0;
+	};
 
-		// vnorene grafy
-		for (QDomElement subgraphElement = edgeElement.firstChildElement("graph"); ok && !subgraphElement.isNull(); subgraphElement = subgraphElement.nextSiblingElement("graph")) {
-			if (ok) {
-				// TODO: begin subgraph in edge
-			}
+	return context_->getGraph().addType(typeName, settings);
+}
 
-			if (ok) {
-				ok = processGraph(subgraphElement);
-			}
+osg::ref_ptr<Data::Node> GraphMLImporter::addNode (
+	int name,
+	Data::Type *type
+) {
+	// meno uzla zdiela data s tabulkou retazcov grafu
+	osg::ref_ptr<Data::Node> node = context_->getGraph().addNode(readNodes_->getName (name), type);
+	readNodes_->addNode (name, node);
 
-			if (ok) {
-				// TODO: end subgraph in edge
-			}
-		}
+	return node;
+}
 
-		entitiesProcessed_++;
-		context_->getInfoHandler ().setProgress (entitiesProcessed_ * 100 / entitiesCount_);
-	}
+void GraphMLImporter::addEdge (
+	const PendingEdge &edge
+) {
+	osg::ref_ptr<Data::Edge> newEdge = context_->getGraph().addEdge(QString (), readNodes_->get(edge.source), readNodes_->get(edge.target), edge.type, edge.directed);
 
-	return ok;
+	// multihrana nie je vratena, jej data sa neukladaju
+	if (newEdge.valid () && !edge.data.isEmpty ())
+		storeData (*context_->getGraph ().getEdgeAttributes (), edgeColumns_, newEdge->getId (), edge.data);
 }
 
-bool GraphMLImporter::processGraph_Hyperedges (
-	QDomElement &graphElement
+bool GraphMLImporter::addHyperedge (
+	const QString &name,
+	const EndpointsListType &endpoints
 ) {
 	bool ok = true;
-	osg::ref_ptr<Data::Node> hyperEdgeNode;
-	iColor_ = 0;
-	int count=0;
-	// hyperedges
-	for (QDomElement hyperedgeElement = graphElement.firstChildElement("hyperedge"); ok && !hyperedgeElement.isNull(); hyperedgeElement = hyperedgeElement.nextSiblingElement("hyperedge")) {
+
+	// pridanie hyperhrany
+	osg::ref_ptr<Data::Node> hyperEdgeNode = context_->getGraph ().addHyperEdge(name);
+
+	for (EndpointsListType::const_iterator it = endpoints.constBegin (); ok && it != endpoints.constEnd (); ++it) {
+		QString targetName = it->first;
 		if (ok) {
-			// pridanie hyperhrany
-			hyperEdgeNode = context_->getGraph ().addHyperEdge(QString::number(count));
+			ok = !(targetName.isEmpty ());
+
+			context_->getInfoHandler ().reportError (ok, "Hyperedge endpoint \"node\" attribute can not be empty.");
 		}
 
 		if (ok) {
-			for (QDomElement endpointElement = hyperedgeElement.firstChildElement("endpoint"); ok && !endpointElement.isNull(); endpointElement = endpointElement.nextSiblingElement("endpoint")) {
-				QString targetName;
-				if (ok) {
-					targetName = endpointElement.attribute("node");
-					ok = !(targetName.isEmpty ());
+			ok = readNodes_->contains (targetName);
 
-					context_->getInfoHandler ().reportError (ok, "Hyperedge endpoint \"node\" attribute can not be empty.");
-				}
-
-				if (ok) {
-					ok = readNodes_->contains (targetName);
+			context_->getInfoHandler ().reportError (ok, "Hyperedge endpoint references invalid target node.");
+		}
 
-					context_->getInfoHandler ().reportError (ok, "Hyperedge endpoint references invalid target node.");
-				}
+		osg::ref_ptr<Data::Node> target (NULL);
+		if (ok) {
+			target = readNodes_->get(targetName);
+		}
 
-				osg::ref_ptr<Data::Node> target (NULL);
-				if (ok) {
-					target = readNodes_->get(targetName);
-				}
+		QString direction;
+		if (ok) {
+			direction = it->second;
 
-				QString direction;
-				if (ok) {
-					direction = endpointElement.attribute("type");
+			if (direction == QString("undir")) {
+				direction = QString();
+			}
 
-					if (direction == QString("undir")) {
-						direction = QString();
-					}
+			ok =
+				direction.isEmpty()
+				||
+				(direction == QString("in"))
+				||
+				(direction == QString("out"))
+			;
 
-					ok =
-						direction.isEmpty()
-						||
-						(direction == QString("in"))
-						||
-						(direction == QString("out"))
-					;
+			context_->getInfoHandler ().reportError (ok, "Hyperedge endpoint - invalid direction.");
+		}
 
-					context_->getInfoHandler ().reportError (ok, "Hyperedge endpoint - invalid direction.");
-				}
+		if (ok) {
+			//orientovana hrana
+			if (direction==QString("in"))
+				context_->getGraph ().addEdge("", target, hyperEdgeNode, nodeType_, true);
+			else if (direction==QString("out"))
+				context_->getGraph ().addEdge("", hyperEdgeNode, target, nodeType_, true);
+			else
+				context_->getGraph ().addEdge("", hyperEdgeNode, target, nodeType_, false);
+		}
+	}
 
-				if (ok) {
-					if (direction.isEmpty()) {
-						direction = "none";
-					}
-				}
+	return ok;
+}
 
-				if (ok) {
-					//orientovana hrana
-					if (direction==QString("in"))
-						context_->getGraph ().addEdge("", readNodes_->get(targetName), hyperEdgeNode, nodeType_, true);
-					else if (direction==QString("out"))
-						context_->getGraph ().addEdge("", hyperEdgeNode, readNodes_->get(targetName), nodeType_, true);
-					else
-						context_->getGraph ().addEdge("", hyperEdgeNode, target, nodeType_, false);
-				}
-			}
+bool GraphMLImporter::reportProgress (void) {
+	if (streamSize_ > 0) {
+		// progress hlasime len pri zmene percenta
+		qint64 position = (compressedStream_ != NULL) ? compressedStream_->getSourcePosition () : context_->getStream ().pos ();
+		unsigned int progress = (unsigned int) qMin ((qint64) 100, position * 100 / streamSize_);
+		if (progress != progress_) {
+			progress_ = progress;
+			context_->getInfoHandler ().setProgress (progress_);
 		}
-		count++;
 	}
 
-	return ok;
+	return !context_->getInfoHandler ().isCancelled ();
 }
 
-}
\ No newline at end of file
+} // namespace
@@ -0,0 +1,333 @@
+#include "Importer/GraphMerger.h"
+//-----------------------------------------------------------------------------
+#include "Data/Edge.h"
+#include "Data/Node.h"
+#include "Data/Type.h"
+//-----------------------------------------------------------------------------
+#include <QSet>
+#include <QStringList>
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/**
+ * \brief Returns position near the neighbour, so the added nodes do not overlap.
+ */
+osg::Vec3f nearPosition (const osg::Vec3f &position) {
+	return position + osg::Vec3f (
+		(float) (qrand () % 11 - 5),
+		(float) (qrand () % 11 - 5),
+		(float) (qrand () % 11 - 5)
+	);
+}
+
+} // namespace
+
+namespace Importer {
+
+GraphMerger::GraphMerger (
+	Data::Graph &graph,
+	MatchMode matchMode,
+	const QString &deletedAttribute
+) : graph_ (graph),
+	matchMode_ (matchMode),
+	deletedAttribute_ (deletedAttribute),
+	nodes_ (*graph.getStringTable ()),
+	addedNodes_ (0),
+	updatedNodes_ (0),
+	removedNodes_ (0),
+	addedEdges_ (0),
+	updatedEdges_ (0),
+	removedEdges_ (0)
+{
+	// mena existujucich uzlov su uz vacsinou v tabulke retazcov grafu
+	if (matchMode_ == MATCH_BY_NAME) {
+		for (QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator it = graph_.getNodes ()->constBegin (); it != graph_.getNodes ()->constEnd (); ++it) {
+			int name = nodes_.intern (it.value ()->getName ());
+
+			// pri opakovanom mene plati prvy uzol
+			if (!nodes_.contains (name))
+				nodes_.addNode (name, it.value ());
+		}
+	}
+}
+
+QList<osg::ref_ptr<Data::Node> > GraphMerger::merge (
+	Data::Graph &delta
+) {
+	addedNodes_ = updatedNodes_ = removedNodes_ = 0;
+	addedEdges_ = updatedEdges_ = removedEdges_ = 0;
+
+	ColumnsListType nodeColumns = mapColumns (*delta.getNodeAttributes (), *graph_.getNodeAttributes ());
+	ColumnsListType edgeColumns = mapColumns (*delta.getEdgeAttributes (), *graph_.getEdgeAttributes ());
+
+	// uzly delty -> uzly grafu
+	QHash<Data::Node *, osg::ref_ptr<Data::Node> > mappedNodes;
+	QSet<Data::Node *> addedNodes;
+	QList<osg::ref_ptr<Data::Node> > nodesToRemove;
+	QList<osg::ref_ptr<Data::Edge> > edgesToRemove;
+
+	graph_.beginBulkInsert (delta.getNodes ()->size (), delta.getEdges ()->size ());
+
+	// meta uzly delty su len pomocne (napr. hyperhrany), nezlucujeme ich
+	for (QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator it = delta.getNodes ()->constBegin (); it != delta.getNodes ()->constEnd (); ++it) {
+		Data::Node *deltaNode = it.value ().get ();
+		osg::ref_ptr<Data::Node> node = findNode (deltaNode);
+
+		if (isDeleted (*delta.getNodeAttributes (), deltaNode->getId ())) {
+			if (node.valid ()) {
+				nodesToRemove.append (node);
+				removedNodes_++;
+			}
+			continue;
+		}
+
+		if (node.valid ()) {
+			updatedNodes_++;
+		} else {
+			node = graph_.addNode (deltaNode->getName (), mapType (deltaNode->getType ()));
+			addedNodes.insert (node.get ());
+			addedNodes_++;
+
+			// dalsie uzly delty s rovnakym menom sa zlucia s tymto
+			if (matchMode_ == MATCH_BY_NAME)
+				nodes_.addNode (deltaNode->getName (), node);
+		}
+
+		copyAttributes (*delta.getNodeAttributes (), deltaNode->getId (), *graph_.getNodeAttributes (), node->getId (), nodeColumns);
+		mappedNodes.insert (deltaNode, node);
+	}
+
+	// pridane uzly umiestnime k existujucemu susedovi
+	QHash<Data::Node *, osg::Vec3f> anchors;
+
+	for (QMap<qlonglong, osg::ref_ptr<Data::Edge> >::const_iterator it = delta.getEdges ()->constBegin (); it != delta.getEdges ()->constEnd (); ++it) {
+		Data::Edge *deltaEdge = it.value ().get ();
+		osg::ref_ptr<Data::Node> srcNode = mappedNodes.value (deltaEdge->getSrcNode ().get ());
+		osg::ref_ptr<Data::Node> dstNode = mappedNodes.value (deltaEdge->getDstNode ().get ());
+
+		// hrana k odstranenemu uzlu zanikne spolu s nim
+		if (!srcNode.valid () || !dstNode.valid ())
+			continue;
+
+		bool srcAdded = addedNodes.contains (srcNode.get ());
+		bool dstAdded = addedNodes.contains (dstNode.get ());
+
+		// hrany pridanych uzlov este nie su v zoznamoch uzlov, nemozu ani existovat
+		osg::ref_ptr<Data::Edge> edge;
+		if (!srcAdded && !dstAdded)
+			edge = findEdge (srcNode.get (), dstNode.get (), deltaEdge->isOriented ());
+
+		if (isDeleted (*delta.getEdgeAttributes (), deltaEdge->getId ())) {
+			if (edge.valid ()) {
+				edgesToRemove.append (edge);
+				removedEdges_++;
+			}
+			continue;
+		}
+
+		if (edge.valid ()) {
+			updatedEdges_++;
+		} else {
+			edge = graph_.addEdge (QString (), srcNode, dstNode, mapType (deltaEdge->getType ()), deltaEdge->isOriented ());
+			addedEdges_++;
+
+			if (srcAdded && !dstAdded && !anchors.contains (srcNode.get ()))
+				anchors.insert (srcNode.get (), dstNode->getTargetPosition ());
+			if (dstAdded && !srcAdded && !anchors.contains (dstNode.get ()))
+				anchors.insert (dstNode.get (), srcNode->getTargetPosition ());
+		}
+
+		// multihrana nie je vratena, jej data sa neukladaju
+		if (edge.valid ())
+			copyAttributes (*delta.getEdgeAttributes (), deltaEdge->getId (), *graph_.getEdgeAttributes (), edge->getId (), edgeColumns);
+	}
+
+	QList<osg::ref_ptr<Data::Node> > unplaced;
+	for (QSet<Data::Node *>::const_iterator it = addedNodes.constBegin (); it != addedNodes.constEnd (); ++it) {
+		QHash<Data::Node *, osg::Vec3f>::const_iterator anchor = anchors.constFind (*it);
+		if (anchor != anchors.constEnd ())
+			(*it)->setTargetPosition (nearPosition (anchor.value ()));
+		else
+			unplaced.append (osg::ref_ptr<Data::Node> (*it));
+	}
+
+	graph_.commitBulkInsert ();
+
+	// najprv hrany, hrany odstranenych uzlov odstrani removeNodes
+	if (!edgesToRemove.isEmpty ())
+		graph_.removeEdges (edgesToRemove);
+	if (!nodesToRemove.isEmpty ())
+		graph_.removeNodes (nodesToRemove);
+
+	return unplaced;
+}
+
+QString GraphMerger::getSummary (void) const {
+	return QString ("Uzly: %1 pridanych, %2 zmenenych, %3 odstranenych. Hrany: %4 pridanych, %5 zmenenych, %6 odstranenych.")
+		.arg (addedNodes_).arg (updatedNodes_).arg (removedNodes_)
+		.arg (addedEdges_).arg (updatedEdges_).arg (removedEdges_);
+}
+
+osg::ref_ptr<Data::Node> GraphMerger::findNode (
+	Data::Node *deltaNode
+) {
+	if (matchMode_ == MATCH_BY_ID)
+		return graph_.getNodes ()->value (deltaNode->getId ());
+
+	return nodes_.get (nodes_.intern (deltaNode->getName ()));
+}
+
+osg::ref_ptr<Data::Edge> GraphMerger::findEdge (
+	Data::Node *srcNode,
+	Data::Node *dstNode,
+	bool oriented
+) const {
+	QMap<qlonglong, osg::ref_ptr<Data::Edge> > *edges = srcNode->getEdges ();
+	if (edges == NULL)
+		return NULL;
+
+	for (QMap<qlonglong, osg::ref_ptr<Data::Edge> >::const_iterator it = edges->constBegin (); it != edges->constEnd (); ++it) {
+		Data::Edge *edge = it.value ().get ();
+
+		if (edge->getSrcNode ().get () == srcNode && edge->getDstNode ().get () == dstNode)
+			return it.value ();
+
+		// neorientovana hrana moze byt ulozena aj opacne
+		if (!oriented && !edge->isOriented () && edge->getSrcNode ().get () == dstNode && edge->getDstNode ().get () == srcNode)
+			return it.value ();
+	}
+
+	return NULL;
+}
+
+Data::Type *GraphMerger::mapType (
+	Data::Type *deltaType
+) {
+	if (deltaType == NULL)
+		return NULL;
+
+	QHash<Data::Type *, Data::Type *>::const_iterator it = types_.constFind (deltaType);
+	if (it != types_.constEnd ())
+		return it.value ();
+
+	Data::Type *type = NULL;
+
+	QList<Data::Type *> candidates = graph_.getTypesByName (deltaType->getName ());
+	for (int i = 0; type == NULL && i < candidates.size (); i++) {
+		if (!candidates.at (i)->isMeta ())
+			type = candidates.at (i);
+	}
+
+	// novy typ dostane kopiu nastaveni typu delty, delta sa po zluceni zmaze
+	if (type == NULL) {
+		QMap<QString, QString> *settings = NULL;
+		if (deltaType->getSettings () != NULL)
+			settings = new QMap<QString, QString> (*deltaType->getSettings ());
+
+		type = graph_.addType (deltaType->getName (), settings);
+	}
+
+	types_.insert (deltaType, type);
+
+	return type;
+}
+
+GraphMerger::ColumnsListType GraphMerger::mapColumns (
+	const Data::AttributeStore &from,
+	Data::AttributeStore &to
+) const {
+	ColumnsListType columns;
+	QStringList names = from.getColumnNames ();
+
+	for (int i = 0; i < names.size (); i++) {
+		// znacka odstranenia nie je atributom
+		if (names.at (i) == deletedAttribute_)
+			continue;
+
+		Data::AttributeColumn *column = from.getColumn (names.at (i));
+		columns.append (qMakePair (column, to.addColumn (names.at (i), column->getValueType ())));
+	}
+
+	return columns;
+}
+
+bool GraphMerger::isDeleted (
+	const Data::AttributeStore &store,
+	qlonglong id
+) const {
+	Data::AttributeColumn *column = store.getColumn (deletedAttribute_);
+	if (column == NULL)
+		return false;
+
+	// true, nenulove cislo alebo text iny ako "false" a "0"
+	return column->getValue (store.getRow (id)).toBool ();
+}
+
+void GraphMerger::copyAttributes (
+	const Data::AttributeStore &from,
+	qlonglong fromId,
+	Data::AttributeStore &to,
+	qlonglong toId,
+	const ColumnsListType &columns
+) const {
+	int fromRow = from.getRow (fromId);
+	if (fromRow < 0)
+		return;
+
+	int toRow = -1;
+
+	for (ColumnsListType::const_iterator it = columns.constBegin (); it != columns.constEnd (); ++it) {
+		// prazdna hodnota v delte existujucu hodnotu nemeni
+		if (it->first->isNull (fromRow))
+			continue;
+
+		if (toRow < 0)
+			toRow = to.addRow (toId);
+
+		QVariant value = it->first->getValue (fromRow);
+
+		// stlpec grafu moze mat iny typ ako stlpec delty - hodnotu inych typov prevedieme z textu
+		Data::AttributeColumn::ValueType fromType = it->first->getValueType ();
+		bool numeric = (fromType == Data::AttributeColumn::INT || fromType == Data::AttributeColumn::FLOAT || fromType == Data::AttributeColumn::DOUBLE);
+		bool stored = true;
+
+		switch (it->second->getValueType ()) {
+			case Data::AttributeColumn::INT:
+				if (fromType == Data::AttributeColumn::INT)
+					it->second->setInt (toRow, value.toLongLong ());
+				else
+					stored = it->second->setValue (toRow, value.toString ());
+				break;
+			case Data::AttributeColumn::FLOAT:
+				if (numeric)
+					it->second->setFloat (toRow, value.toFloat ());
+				else
+					stored = it->second->setValue (toRow, value.toString ());
+				break;
+			case Data::AttributeColumn::DOUBLE:
+				if (numeric)
+					it->second->setDouble (toRow, value.toDouble ());
+				else
+					stored = it->second->setValue (toRow, value.toString ());
+				break;
+			case Data::AttributeColumn::BOOL:
+				if (fromType == Data::AttributeColumn::BOOL)
+					it->second->setBool (toRow, value.toBool ());
+				else
+					stored = it->second->setValue (toRow, value.toString ());
+				break;
+			default:
+				it->second->setString (toRow, value.toString ());
+				break;
+		}
+
+		// hodnotu, ktora typu stlpca nezodpoveda, ulozime po rozsireni stlpca na retazce
+		if (!stored) {
+			it->second->convertToString ();
+			it->second->setString (toRow, value.toString ());
+		}
+	}
+}
+
+} // namespace
@@ -24,4 +24,14 @@ ImportInfoHandler &ImporterContext::getInfoHandler (void) {
 	return infoHandler_;
 }
 
+const QString &ImporterContext::getLayoutName (void) const {
+	return layoutName_;
+}
+
+void ImporterContext::setLayoutName (
+	const QString &layoutName
+) {
+	layoutName_ = layoutName;
+}
+
 } // namespace
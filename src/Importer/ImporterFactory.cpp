@@ -4,6 +4,9 @@
 #include "Importer/GXLImporter.h"
 #include "Importer/RSFImporter.h"
 #include "Importer/MTXImporter.h"
+#include "Importer/BinaryImporter.h"
+#include "Importer/CSVImporter.h"
+#include "Importer/DOTImporter.h"
 //-----------------------------------------------------------------------------
 
 namespace Importer {
@@ -37,6 +40,30 @@ bool ImporterFactory::createByFileExtension (
 		importerFound = true;
 	}
 
+	if (0 == fileExtension.compare ("3dv", Qt::CaseInsensitive)) {
+		importer.reset (new BinaryImporter);
+		importerFound = true;
+	}
+
+	if (0 == fileExtension.compare ("csv", Qt::CaseInsensitive)) {
+		importer.reset (new CSVImporter (','));
+		importerFound = true;
+	}
+
+	if (0 == fileExtension.compare ("tsv", Qt::CaseInsensitive)) {
+		importer.reset (new CSVImporter ('\t'));
+		importerFound = true;
+	}
+
+	if (
+		0 == fileExtension.compare ("dot", Qt::CaseInsensitive)
+		||
+		0 == fileExtension.compare ("gv", Qt::CaseInsensitive)
+	) {
+		importer.reset (new DOTImporter);
+		importerFound = true;
+	}
+
 	return ok;
 }
 
@@ -1,6 +1,6 @@
 #include "Importer/MTXImporter.h"
 #include "Importer/GraphOperations.h"
-#include "Importer/ReadNodesStore.h"
+#include "Importer/EdgeListParser.h"
 
 #include <string>
 #include <memory>
@@ -9,75 +9,95 @@ namespace Importer {
 bool MTXImporter::import (
 	ImporterContext &context
 ) {
-	QTextStream stream (&(context.getStream ()));
-	QString line, graphname="Graph";
+	QString graphname="Graph";
 
 	GraphOperations graphOp (context.getGraph ());
-	ReadNodesStore readNodes;
 	bool edgeOrientedDefault = false;
-	bool edgeOrientedDefaultForce = false;
 	Data::Type *edgeType = NULL;
 	Data::Type *nodeType = NULL;
 	context.getGraph ().setName (graphname);
 	(void)graphOp.addDefaultTypes (edgeType, nodeType);
 
+	//riadky citame paralelne po castiach: 2 mena uzlov a hodnota prvku matice
+	EdgeListParser parser (context.getStream (), 2, 1);
+	bool ok = parser.open ();
+
+	context.getInfoHandler ().reportError (ok, "Zvoleny subor nie je mozne precitat.");
+
 	//preskocenie hlavicky
+	QByteArray line;
 	do {
-		line = stream.readLine();
-	} while ( !stream.atEnd() && line.startsWith(QString("%")) );
+		line = parser.readLine();
+	} while ( !parser.atEnd() && line.startsWith('%') );
 	//v premenej line sa nachadzaju udaje o matici
+	QStringList sizes = QString::fromLocal8Bit (line).trimmed ().split (QRegExp (QString ("[ \t]+")));
+	qlonglong expectedNodes = 0;
+	qlonglong expectedEdges = 0;
+	if (sizes.size () >= 3) {
+		expectedNodes = qMax (sizes[0].toLongLong (), sizes[1].toLongLong ());
+		expectedEdges = sizes[2].toLongLong ();
+	}
 
-	int i = 0;
+	//uzly a hrany vkladame hromadne, zoznamy grafu sa vytvoria az na konci
+	context.getGraph ().beginBulkInsert (expectedNodes, expectedEdges);
+
+	Data::AttributeStore *edgeAttributes = context.getGraph ().getEdgeAttributes ();
+	Data::AttributeColumn *weightColumn = NULL;
+
+	//uzly podla indexu mena, vytvarame ich pri prvom vyskyte
+	QVector<osg::ref_ptr<Data::Node> > nodes;
 	
 	//citanie vstupneho suboru
-	while ( !stream.atEnd() ) {
-		line = stream.readLine();
-		QStringList words;
-		words = line.split (QRegExp (QString ("[ \t]+")));
-		int size = words.size ();
-		Data::Type *newNodeType = NULL;
-		osg::ref_ptr<Data::Node> node1, node2;
-		osg::ref_ptr<Data::Edge> edge;
-		if (size < 2){
-			printf("%d",size);
-			context.getInfoHandler ().reportError ("Zvoleny subor nie je validny Matrix Market subor.");
-			return false;
-		}
-		else{
-			QString srcNodeName = words[0];
-			QString dstNodeName = words[1];
-
-			// vytvorenie pociatocneho uzla
-			if (!readNodes.contains(srcNodeName))
-			{
-				node1 = context.getGraph().addNode(srcNodeName, nodeType);
-				readNodes.addNode(srcNodeName, node1);
-			} else {
-				node1=readNodes.get(srcNodeName);
+	while ( ok && parser.parseNext() ) {
+		nodes.resize (parser.getNameCount ());
+
+		for (int i = 0; ok && i < parser.getLineCount (); i++) {
+			osg::ref_ptr<Data::Edge> edge;
+			if (parser.getTokenCount (i) < 2){
+				context.getInfoHandler ().reportError ("Zvoleny subor nie je validny Matrix Market subor.");
+				ok = false;
 			}
+			else{
+				int srcNode = parser.getName (i, 0);
+				int dstNode = parser.getName (i, 1);
+
+				// vytvorenie pociatocneho a koncoveho uzla
+				if (!nodes[srcNode].valid ())
+					nodes[srcNode] = context.getGraph().addNode(parser.getNameText (srcNode), nodeType);
+				if (!nodes[dstNode].valid ())
+					nodes[dstNode] = context.getGraph().addNode(parser.getNameText (dstNode), nodeType);
+
+				//vytvorenie hrany, jej meno sa odvodi z mien uzlov az ked bude potrebne
+				edge = context.getGraph().addEdge(
+					QString (),
+					nodes[srcNode],
+					nodes[dstNode],
+					edgeType,
+					edgeOrientedDefault
+				);
 
-			//vytvorenie koncoveho uzla
-			if (!readNodes.contains(dstNodeName))
-			{
-				node2 = context.getGraph().addNode(dstNodeName, nodeType);
-				readNodes.addNode(dstNodeName, node2);
-			} else {
-				node2=readNodes.get(dstNodeName);
+				// hodnota prvku matice sa uklada ako vaha hrany
+				if (edge.valid () && parser.getTokenCount (i) >= 3) {
+					// atributy cita aj vlakno GUI (dopyty), zapisujeme ich pod zamkom grafu
+					QMutexLocker locker (context.getGraph ().getStructureMutex ());
+					if (weightColumn == NULL)
+						weightColumn = edgeAttributes->addColumn ("weight", Data::AttributeColumn::FLOAT);
+
+					weightColumn->setFloat (edgeAttributes->addRow (edge->getId ()), (float) parser.getValue (i, 0));
+				}
 			}
-			//vytvoreniez hrany
-			QString edgeName = srcNodeName + dstNodeName;
-			edge = context.getGraph().addEdge(
-				edgeName,
-				node1,
-				node2,
-				edgeType,
-				edgeOrientedDefault
-			);
 		}
 
+		if (parser.getSize () > 0)
+			context.getInfoHandler ().setProgress ((unsigned int) (parser.getPosition () * 100 / parser.getSize ()));
+
+		//import mohol byt zruseny
+		ok = ok && !context.getInfoHandler ().isCancelled ();
 	}
 
-	return true;
+	context.getGraph ().commitBulkInsert ();
+
+	return ok;
 }
 
 } // namespace
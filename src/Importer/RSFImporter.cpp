@@ -1,107 +1,94 @@
 #include "Importer/RSFImporter.h"
 #include "Importer/GraphOperations.h"
-#include "Importer/ReadNodesStore.h"
+#include "Importer/EdgeListParser.h"
+
+#include <QHash>
+#include <QPair>
 
 #include <string>
 #include <memory>
 namespace Importer {
 
-	osg::ref_ptr<Data::Node> RSFImporter::getHyperEdge(
-		QString srcNodeName,
-		QString edgeName,QMap<qlonglong, 
-		osg::ref_ptr<Data::Edge> > *mapa)
-	{
-		osg::ref_ptr<Data::Node> hyperEdgeNode1;
-		//zaciatocny bod hyperhrany
-		for (QMap<qlonglong, osg::ref_ptr<Data::Edge> >::iterator it = mapa->begin (); it != mapa->end (); ++it) {
-			osg::ref_ptr<Data::Edge> existingEdge = it.value ();
-			if (
-				existingEdge->getSrcNode ()->getName () == srcNodeName && 
-				existingEdge->getDstNode ()->getName () == edgeName
-			) {
-				hyperEdgeNode1 = existingEdge->getDstNode ();
-				break;
-			}
-		}
-		return hyperEdgeNode1;
-}
-
 bool RSFImporter::import (
 	ImporterContext &context
 ) {
-	QTextStream stream (&(context.getStream ()));
-	QString line, graphname="Graph";
+	QString graphname="Graph";
 
 	GraphOperations graphOp (context.getGraph ());
-	ReadNodesStore readNodes;
-	bool edgeOrientedDefault = false;
-	bool edgeOrientedDefaultForce = false;
 	Data::Type *edgeType = NULL;
 	Data::Type *nodeType = NULL;
 	context.getGraph ().setName (graphname);
 	(void)graphOp.addDefaultTypes (edgeType, nodeType);
+
+	//riadky citame paralelne po castiach: nazov relacie a 2 mena uzlov
+	EdgeListParser parser (context.getStream (), 3, 0);
+	bool ok = parser.open ();
+
+	context.getInfoHandler ().reportError (ok, "Zvoleny subor nie je mozne precitat.");
 	
-	int i = 0;
+	//uzly a hrany vkladame hromadne, zoznamy grafu sa vytvoria az na konci
+	context.getGraph ().beginBulkInsert ();
+
+	//hyperhrany podla indexu mena pociatocneho uzla a indexu nazvu relacie
+	QHash<QPair<int, int>, osg::ref_ptr<Data::Node> > hyperEdges;
+
+	//uzly podla indexu mena, vytvarame ich pri prvom vyskyte
+	QVector<osg::ref_ptr<Data::Node> > nodes;
 	
 	//citanie vstupneho suboru
-	while ( !stream.atEnd() ) {
-		line = stream.readLine();
-		QStringList words;
-		words = line.split (QRegExp (QString ("[ \t]+")));
-		int size = words.size ();
-		Data::Type *newNodeType = NULL;
-		osg::ref_ptr<Data::Node> node1, node2;
-		osg::ref_ptr<Data::Edge> edge;
-		if (size!=3){
-			printf("%d",size);
-			context.getInfoHandler ().reportError ("Zvoleny subor nie je validny RSF subor.");
-			return false;
-		}
-		else{
-			if (words[0]=="tagged")
-			{
-
-			}else
-			{
-				QString edgeName = words[0];
-				QString srcNodeName = words[1];
-				QString dstNodeName = words[2];
-
-				// vytvorenie pociatocneho uzla
-				if (!readNodes.contains(srcNodeName))
+	while ( ok && parser.parseNext() ) {
+		nodes.resize (parser.getNameCount ());
+
+		for (int i = 0; ok && i < parser.getLineCount (); i++) {
+			osg::ref_ptr<Data::Edge> edge;
+			if (parser.getTokenCount (i) != 3){
+				context.getInfoHandler ().reportError ("Zvoleny subor nie je validny RSF subor.");
+				ok = false;
+			}
+			else{
+				const QString &edgeName = parser.getNameText (parser.getName (i, 0));
+				if (edgeName=="tagged")
 				{
-					node1 = context.getGraph().addNode(srcNodeName, nodeType);
-					readNodes.addNode(srcNodeName, node1);
-				} else {
-					node1=readNodes.get(srcNodeName);
-				}
 
-				//vytvorenie koncoveho uzla
-				if (!readNodes.contains(dstNodeName))
+				}else
 				{
-					node2 = context.getGraph ().addNode(dstNodeName, nodeType);
-					readNodes.addNode(dstNodeName, node2);
-				} else {
-					node2=readNodes.get(dstNodeName);
-				}
-				//vytvorenie celej hyperhrany
-				osg::ref_ptr<Data::Node> hyperEdgeNode;
-				QMap<qlonglong, osg::ref_ptr<Data::Edge> > *mapa = context.getGraph().getEdges();
-
-				hyperEdgeNode=RSFImporter().getHyperEdge(srcNodeName,edgeName,mapa);
-				if (!hyperEdgeNode.valid ()) {
-					hyperEdgeNode = context.getGraph ().addHyperEdge (edgeName);
-					context.getGraph ().addEdge (QString (""), node1, hyperEdgeNode, edgeType, true);
+					int srcNode = parser.getName (i, 1);
+					int dstNode = parser.getName (i, 2);
+
+					// vytvorenie pociatocneho a koncoveho uzla
+					if (!nodes[srcNode].valid ())
+						nodes[srcNode] = context.getGraph().addNode(parser.getNameText (srcNode), nodeType);
+					if (!nodes[dstNode].valid ())
+						nodes[dstNode] = context.getGraph().addNode(parser.getNameText (dstNode), nodeType);
+
+					//vytvorenie celej hyperhrany
+					QPair<int, int> hyperEdgeKey (srcNode, parser.getName (i, 0));
+					osg::ref_ptr<Data::Node> hyperEdgeNode = hyperEdges.value (hyperEdgeKey);
+
+					if (!hyperEdgeNode.valid ()) {
+						hyperEdgeNode = context.getGraph ().addHyperEdge (edgeName);
+						edge = context.getGraph ().addEdge (QString (""), nodes[srcNode], hyperEdgeNode, edgeType, true);
+						if (edge.valid ()) {
+							hyperEdges.insert (hyperEdgeKey, hyperEdgeNode);
+						}
+					}
+					
+					//pridanie hyperhrany do grafu
+					context.getGraph ().addEdge (QString (""), hyperEdgeNode, nodes[dstNode], edgeType, true);
 				}
-				
-				//pridanie hyperhrany do grafu
-				context.getGraph ().addEdge (QString (""), hyperEdgeNode, node2, edgeType, true);
 			}
 		}
 
+		if (parser.getSize () > 0)
+			context.getInfoHandler ().setProgress ((unsigned int) (parser.getPosition () * 100 / parser.getSize ()));
+
+		//import mohol byt zruseny
+		ok = ok && !context.getInfoHandler ().isCancelled ();
 	}
 
-	return true;
+	context.getGraph ().commitBulkInsert ();
+
+	return ok;
 }
 
 } // namespace
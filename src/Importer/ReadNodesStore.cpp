@@ -2,28 +2,21 @@
 
 namespace Importer {
 
-void ReadNodesStore::addNode (
-	const QString &name,
-	osg::ref_ptr<Data::Node> node
-) {
-	nodes_[name] = node;
+ReadNodesStore::ReadNodesStore (
+	Data::StringTable &strings
+) : strings_ (strings)
+{
 }
 
-bool ReadNodesStore::contains (
-	const QString &name
+void ReadNodesStore::addNode (
+	int name,
+	osg::ref_ptr<Data::Node> node
 ) {
-	return nodes_.find (name) != nodes_.end ();
-}
+	// ID su husto cislovane, pole zvacsujeme podla tabulky retazcov
+	if (name >= nodes_.size ())
+		nodes_.resize (qMax (name + 1, strings_.size ()));
 
-osg::ref_ptr<Data::Node> ReadNodesStore::get (
-	const QString &name
-) {
-	NodesMapType::iterator it = nodes_.find (name);
-	if (it != nodes_.end ()) {
-		return it->second;
-	} else {
-		return NULL;
-	}
+	nodes_[name] = node;
 }
 
 } // namespace
@@ -26,6 +26,7 @@ FRAlgorithm::FRAlgorithm()
 	/* moznost odpudiveho posobenia limitovaneho vzdialenostou*/
 	useMaxDistance = false;
 	this->graph = NULL;
+	loadOrderingConfig();
 }
 FRAlgorithm::FRAlgorithm(Data::Graph *graph) 
 {
@@ -47,14 +48,34 @@ FRAlgorithm::FRAlgorithm(Data::Graph *graph)
 	/* moznost odpudiveho posobenia limitovaneho vzdialenostou*/
 	useMaxDistance = false;
 	this->graph = graph;
+	loadOrderingConfig();
 	this->Randomize();
 }
 
+void FRAlgorithm::loadOrderingConfig()
+{
+	Util::ApplicationConfig * appConf = Util::ApplicationConfig::get();
+
+	ordering = NodeOrdering::methodFromName(appConf->getValue("Layout.NodeOrdering"));
+	orderingInterval = (int) appConf->getNumericValue (
+		"Layout.NodeOrdering.Interval",
+		std::auto_ptr<long> (new long(1)),
+		std::auto_ptr<long> (NULL),
+		100
+	);
+	orderingAge = 0;
+}
+
 void FRAlgorithm::SetGraph(Data::Graph *graph)
 {
 	//pociatocne nahodne rozdelenie pozicii uzlov
 	notEnd = true;
 	this->graph = graph;
+	orderedSnapshot.clear();
+	orderedNodes.clear();
+	orderedEdges.clear();
+	orderedNodeSet.clear();
+	orderedEdgeSet.clear();
 	this->Randomize();
 }
 void FRAlgorithm::SetParameters(float sizeFactor,float flexibility,int animationSpeed,bool useMaxDistance) 
@@ -83,6 +104,11 @@ double FRAlgorithm::computeCalm() {
 /* Rozmiestni uzly na nahodne pozicie */
 void FRAlgorithm::Randomize() 
 {
+	if(graph == NULL)
+	{
+		return;
+	}
+
     QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator j;
 	j = graph->getNodes()->begin();
 
@@ -97,6 +123,37 @@ void FRAlgorithm::Randomize()
 	graph->setFrozen(false);
 }
 
+void FRAlgorithm::Randomize(const QList<osg::ref_ptr<Data::Node> > &nodes)
+{
+	if (nodes.isEmpty())
+	{
+		return;
+	}
+
+	// pozicie meni aj iteracia, nove uzly rozmiestnime az po jej skonceni
+	State previousState = state;
+	state = PAUSED;
+	isIterating_mutex.lock();
+	for (int i = 0; i < nodes.size(); i++)
+	{
+		if(!nodes.at(i)->isFixed())
+		{
+			nodes.at(i)->setTargetPosition(getRandomLocation());
+		}
+	}
+	isIterating_mutex.unlock();
+
+	if (previousState == RUNNING)
+	{
+		// pokojova dlzka zavisi od poctu uzlov
+		RunAlg();
+	}
+	else if(graph != NULL)
+	{
+		graph->setFrozen(false);
+	}
+}
+
 osg::Vec3f FRAlgorithm::getRandomLocation() 
 {
 	double l = getRandomDouble() * 300;	
@@ -127,6 +184,34 @@ void FRAlgorithm::WakeUpAlg()
 	}
 }
 
+bool FRAlgorithm::ApplyGraphCommands(Data::Graph *changedGraph)
+{
+	if (!changedGraph->hasQueuedCommands())
+	{
+		return false;
+	}
+	// graf, ktory algoritmus neprechadza, mozeme zmenit hned
+	if (changedGraph != graph)
+	{
+		return changedGraph->applyCommands();
+	}
+
+	// zmeny struktury aplikujeme az po skonceni aktualnej iteracie, iteracia ich nevidi v polovici
+	State previousState = state;
+	state = PAUSED;
+	isIterating_mutex.lock();
+	bool applied = graph->applyCommands();
+	isIterating_mutex.unlock();
+
+	if (previousState == RUNNING)
+	{
+		// pokojova dlzka zavisi od poctu uzlov
+		RunAlg();
+	}
+
+	return applied;
+}
+
 void FRAlgorithm::RunAlg()
 {
 	if(graph != NULL)
@@ -180,25 +265,34 @@ void FRAlgorithm::Run()
 bool FRAlgorithm::iterate()
 {	
 	bool changed = false;  		
+
+	// iterujeme nad snapshotom grafu, aby nas nerusili zmeny struktury grafu pocas iteracie
+	QSharedPointer<Data::GraphSnapshot> snapshot = graph->getSnapshot();
+	const QMap<qlonglong, osg::ref_ptr<Data::Node> > & metaNodes = snapshot->getMetaNodes();
+	const QMap<qlonglong, osg::ref_ptr<Data::Edge> > & metaEdges = snapshot->getMetaEdges();
+
+	// uzly a hrany prechadzame v poradi, v ktorom su susedne uzly vedla seba
+	updateOrdering(snapshot);
+	Data::Node * const * orderedNode = orderedNodes.constData();
+	Data::Edge * const * orderedEdge = orderedEdges.constData();
+	int nodeCount = orderedNodes.size();
+	int edgeCount = orderedEdges.size();
 	{			
-        QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator j;
-		j = graph->getNodes()->begin();
-		for (int i = 0; i < graph->getNodes()->count(); i++,++j)
+		for (int i = 0; i < nodeCount; i++)
 		{ // pre vsetky uzly..
-			Data::Node* node = j.value();
-			node->resetForce(); // vynulovanie posobiacej sily			
+			orderedNode[i]->resetForce(); // vynulovanie posobiacej sily			
 		}		
 	}
 	{//meta uzly
 		
-		QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator j;
-		QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator k;	
-		j = graph->getMetaNodes()->begin();
-		for (int i = 0; i < graph->getMetaNodes()->count(); i++,++j)
+		QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator j;
+		QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator k;	
+		j = metaNodes.constBegin();
+		for (int i = 0; i < metaNodes.count(); i++,++j)
 		{ // pre vsetky metauzly..
 			j.value()->resetForce(); // vynulovanie posobiacej sily
-			k = graph->getMetaNodes()->begin();
-			for (int h = 0; h < graph->getMetaNodes()->count(); h++,++k)
+			k = metaNodes.constBegin();
+			for (int h = 0; h < metaNodes.count(); h++,++k)
 			{ // pre vsetky metauzly..
 				if (!j.value()->equals(k.value())) 
 				{
@@ -210,12 +304,13 @@ bool FRAlgorithm::iterate()
 	}
 	{//meta hrany
 		
-		QMap<qlonglong, osg::ref_ptr<Data::Edge> >::iterator j;
-		j = graph->getMetaEdges()->begin();
-		for (int i = 0; i < graph->getMetaEdges()->count(); i++,++j)
+		QMap<qlonglong, osg::ref_ptr<Data::Edge> >::const_iterator j;
+		j = metaEdges.constBegin();
+		for (int i = 0; i < metaEdges.count(); i++,++j)
 		{ // pre vsetky metahrany..
-			Data::Node *u = j.value()->getSrcNode();
-			Data::Node *v = j.value()->getDstNode();
+			// uzly hrany citame raz, hrana ich drzi aj po odstraneni z grafu
+			osg::ref_ptr<Data::Node> u = j.value()->getSrcNode();
+			osg::ref_ptr<Data::Node> v = j.value()->getDstNode();
 			// [GrafIT][-] ignored value has not been used, so setting it here did not have any effect
 			// uzly nikdy nebudu ignorovane
 			/*
@@ -223,38 +318,35 @@ bool FRAlgorithm::iterate()
 			v->setIgnored(false);
 			*/
 			// [GrafIT]
-			if (graph->getMetaNodes()->contains(u->getId())) {
+			if (metaNodes.contains(u->getId())) {
 				// pritazliva sila, posobi na v
-				addMetaAttractive(v, u, Data::Graph::getMetaStrength());
+				addMetaAttractive(v.get(), u.get(), Data::Graph::getMetaStrength());
 			}
-			if (graph->getMetaNodes()->contains(v->getId())) {
+			if (metaNodes.contains(v->getId())) {
 				// pritazliva sila, posobi na u
-				addMetaAttractive(u, v, Data::Graph::getMetaStrength());
+				addMetaAttractive(u.get(), v.get(), Data::Graph::getMetaStrength());
 			}
 		}
 	}
 	{//uzly
-        QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator j;
-        QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator k;
-		j = graph->getNodes()->begin();
-		for (int i = 0; i < graph->getNodes()->count(); i++,++j) 
+		for (int i = 0; i < nodeCount; i++) 
 		{ // pre vsetky uzly..
-			k = graph->getNodes()->begin();
-			for (int h = 0; h < graph->getNodes()->count(); h++,++k) { // pre vsetky uzly..
-				if (!j.value()->equals(k.value())) {
+			for (int h = 0; h < nodeCount; h++) { // pre vsetky uzly..
+				if (!orderedNode[i]->equals(orderedNode[h])) {
 					// odpudiva sila beznej velkosti
-					addRepulsive(j.value(), k.value(), 1);
+					addRepulsive(orderedNode[i], orderedNode[h], 1);
 				}
 			}
 		}
 	}
 	{//hrany
-        QMap<qlonglong, osg::ref_ptr<Data::Edge> >::iterator j;
-		j = graph->getEdges()->begin();
-		for (int i = 0; i < graph->getEdges()->count(); i++,++j)
+		for (int i = 0; i < edgeCount; i++)
 		{ // pre vsetky hrany..
+			// uzly hrany citame raz, hrana ich drzi aj po odstraneni z grafu
+			osg::ref_ptr<Data::Node> u = orderedEdge[i]->getSrcNode();
+			osg::ref_ptr<Data::Node> v = orderedEdge[i]->getDstNode();
 			// pritazliva sila beznej velkosti
-			addAttractive(j.value(), 1);
+			addAttractive(u.get(), v.get(), 1);
 		}
 	}	
 	if(state == PAUSED) 
@@ -264,13 +356,11 @@ bool FRAlgorithm::iterate()
 	
 	// aplikuj sily na uzly
 	{	
-        QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator j;
-		j = graph->getNodes()->begin();
-		for (int i = 0; i < graph->getNodes()->count(); i++,++j)
+		for (int i = 0; i < nodeCount; i++)
 		{ // pre vsetky uzly..
-			if (!j.value()->isFixed()) {
-				last = j.value()->getTargetPosition();
-				bool fo = applyForces(j.value());
+			if (!orderedNode[i]->isFixed()) {
+				last = orderedNode[i]->getTargetPosition();
+				bool fo = applyForces(orderedNode[i]);
 				changed = changed || fo;
 			}
 			else
@@ -281,9 +371,9 @@ bool FRAlgorithm::iterate()
 	}
 	// aplikuj sily na metauzly
 	{
-		QMap<qlonglong, osg::ref_ptr<Data::Node> >::iterator j;
-		j = graph->getMetaNodes()->begin();
-		for (int i = 0; i < graph->getMetaNodes()->count(); i++,++j) 
+		QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator j;
+		j = metaNodes.constBegin();
+		for (int i = 0; i < metaNodes.count(); i++,++j) 
 		{ // pre vsetky metauzly..
 			if (!j.value()->isFixed()) {
 				bool fo = applyForces(j.value());
@@ -296,6 +386,68 @@ bool FRAlgorithm::iterate()
 	return changed;
 }
 
+void FRAlgorithm::updateOrdering(QSharedPointer<Data::GraphSnapshot> snapshot)
+{
+	// poradie obnovime po zmene struktury grafu a po urcitom pocte iteracii, ked sa uzly presunuli
+	if (snapshot == orderedSnapshot && (ordering == NodeOrdering::NONE || ++orderingAge < orderingInterval)) {
+		return;
+	}
+
+	// ak boli do grafu uzly a hrany len pridane, zaradime ich na koniec bez noveho usporiadania
+	if (snapshot != orderedSnapshot && !orderedSnapshot.isNull() && ordering != NodeOrdering::NONE && orderingAge < orderingInterval && appendOrdering(snapshot)) {
+		orderedSnapshot = snapshot;
+		return;
+	}
+
+	orderedSnapshot = snapshot;
+	orderedNodes = NodeOrdering::orderNodes(snapshot->getNodes(), snapshot->getEdges(), ordering);
+	orderedEdges = NodeOrdering::orderEdges(snapshot->getEdges(), orderedNodes);
+	orderedNodeSet = QSet<Data::Node *>::fromList(orderedNodes.toList());
+	orderedEdgeSet = QSet<Data::Edge *>::fromList(orderedEdges.toList());
+	orderingAge = 0;
+}
+
+bool FRAlgorithm::appendOrdering(QSharedPointer<Data::GraphSnapshot> snapshot)
+{
+	const QMap<qlonglong, osg::ref_ptr<Data::Node> > & nodes = snapshot->getNodes();
+	const QMap<qlonglong, osg::ref_ptr<Data::Edge> > & edges = snapshot->getEdges();
+
+	// uzly a hrany zo zoznamov len pribudaju, inak usporiadame cely snapshot
+	QVector<Data::Node *> addedNodes;
+	for (QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator it = nodes.constBegin(); it != nodes.constEnd(); ++it) {
+		if (!orderedNodeSet.contains(it.value().get())) {
+			addedNodes.append(it.value().get());
+		}
+	}
+	if (orderedNodes.size() + addedNodes.size() != nodes.size()) {
+		return false;
+	}
+
+	QMap<qlonglong, osg::ref_ptr<Data::Edge> > addedEdges;
+	for (QMap<qlonglong, osg::ref_ptr<Data::Edge> >::const_iterator it = edges.constBegin(); it != edges.constEnd(); ++it) {
+		if (!orderedEdgeSet.contains(it.value().get())) {
+			addedEdges.insert(it.key(), it.value());
+		}
+	}
+	if (orderedEdges.size() + addedEdges.size() != edges.size()) {
+		return false;
+	}
+
+	// nove uzly su v pamati za povodnymi, nove hrany zoradime podla ich uzlov
+	for (int i = 0; i < addedNodes.size(); i++) {
+		orderedNodes.append(addedNodes.at(i));
+		orderedNodeSet.insert(addedNodes.at(i));
+	}
+
+	QVector<Data::Edge *> ordered = NodeOrdering::orderEdges(addedEdges, orderedNodes);
+	for (int i = 0; i < ordered.size(); i++) {
+		orderedEdges.append(ordered.at(i));
+		orderedEdgeSet.insert(ordered.at(i));
+	}
+
+	return true;
+}
+
 bool FRAlgorithm::applyForces(Data::Node* node) 
 {
 	// nakumulovana sila
@@ -339,23 +491,23 @@ bool FRAlgorithm::applyForces(Data::Node* node)
 }
 
 /* Pricitanie pritazlivych sil */
-void FRAlgorithm::addAttractive(Data::Edge* edge, float factor) {
+void FRAlgorithm::addAttractive(Data::Node* u, Data::Node* v, float factor) {
 	// [GrafIT][+] forces are only between nodes which are in the same graph (or some of them is meta) AND are not ignored
-	if (!areForcesBetween (edge->getSrcNode(), edge->getDstNode())) {
+	if (!areForcesBetween (u, v)) {
 		return;
 	}
 	// [GrafIT]
-	up = edge->getSrcNode()->getTargetPosition();
-	vp = edge->getDstNode()->getTargetPosition();
+	up = u->getTargetPosition();
+	vp = v->getTargetPosition();
 	dist = distance(up,vp);
 	if (dist == 0)
 		return;
 	fv = vp - up; // smer sily
 	fv.normalize();
 	fv *= attr(dist) * factor;// velkost sily
-	edge->getSrcNode()->addForce(fv);
+	u->addForce(fv);
 	fv = center - fv;
-	edge->getDstNode()->addForce(fv);
+	v->addForce(fv);
 }
 
 /* Pricitanie pritazlivych sil od metazla */
@@ -6,6 +6,7 @@ LayoutThread::LayoutThread(Layout::FRAlgorithm* alg)
 {
 	this->alg = alg;
 	appConf = Util::ApplicationConfig::get();
+	startSleepTime = appConf->getValue("Layout.Thread.StartSleepTime").toLong();
 }
 
 LayoutThread::~LayoutThread(void)
@@ -14,7 +15,7 @@ LayoutThread::~LayoutThread(void)
 
 void LayoutThread::run()
 {
-	this->sleep(appConf->getValue("Layout.Thread.StartSleepTime").toLong());
+	this->sleep(startSleepTime);
 	alg->Run();
 }
 void LayoutThread::pause()
@@ -41,3 +42,7 @@ void LayoutThread::requestEnd()
 {
 	alg->RequestEnd();
 }
+void LayoutThread::setStartSleepTime(long seconds)
+{
+	startSleepTime = seconds;
+}
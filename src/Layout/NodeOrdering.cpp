@@ -0,0 +1,248 @@
+/*!
+ * NodeOrdering.cpp
+ * Projekt 3DVisual
+ */
+#include "Layout/NodeOrdering.h"
+#include "Data/Node.h"
+#include "Data/Edge.h"
+
+#include <QBitArray>
+#include <QHash>
+#include <QPair>
+#include <QtAlgorithms>
+
+Layout::NodeOrdering::Method Layout::NodeOrdering::methodFromName(QString name)
+{
+	name = name.trimmed().toLower();
+
+	if(name.isEmpty() || name == "hilbert")
+		return HILBERT;
+	if(name == "morton")
+		return MORTON;
+	if(name == "rcm" || name == "cuthill-mckee")
+		return CUTHILL_MCKEE;
+
+	return NONE;
+}
+
+quint64 Layout::NodeOrdering::curveKey(quint32 x, quint32 y, quint32 z, bool hilbert)
+{
+	quint32 coordinates[3] = { x, y, z };
+
+	if(hilbert) {
+		//Skillingova transformacia suradnic na transponovany Hilbertov index
+		quint32 m = 1u << (CURVE_BITS - 1);
+
+		for(quint32 q = m; q > 1; q >>= 1) {
+			quint32 p = q - 1;
+			for(int i = 0; i < 3; i++) {
+				if(coordinates[i] & q) {
+					coordinates[0] ^= p;
+				} else {
+					quint32 t = (coordinates[0] ^ coordinates[i]) & p;
+					coordinates[0] ^= t;
+					coordinates[i] ^= t;
+				}
+			}
+		}
+
+		for(int i = 1; i < 3; i++)
+			coordinates[i] ^= coordinates[i - 1];
+
+		quint32 t = 0;
+		for(quint32 q = m; q > 1; q >>= 1) {
+			if(coordinates[2] & q)
+				t ^= q - 1;
+		}
+
+		for(int i = 0; i < 3; i++)
+			coordinates[i] ^= t;
+	}
+
+	//prekladanie bitov suradnic od najvyssieho
+	quint64 key = 0;
+	for(int bit = CURVE_BITS - 1; bit >= 0; bit--) {
+		for(int i = 0; i < 3; i++)
+			key = (key << 1) | ((coordinates[i] >> bit) & 1);
+	}
+
+	return key;
+}
+
+QVector<int> Layout::NodeOrdering::spatialOrder(const QVector<osg::Vec3f> &positions, Method method)
+{
+	int n = positions.size();
+	QVector<int> order(n);
+
+	if(n == 0)
+		return order;
+
+	osg::Vec3f min = positions.at(0);
+	osg::Vec3f max = positions.at(0);
+	for(int i = 1; i < n; i++) {
+		for(int axis = 0; axis < 3; axis++) {
+			min[axis] = qMin(min[axis], positions.at(i)[axis]);
+			max[axis] = qMax(max[axis], positions.at(i)[axis]);
+		}
+	}
+
+	//rovnaka mierka vo vsetkych osiach, aby krivka nebola deformovana
+	float extent = qMax(max.x() - min.x(), qMax(max.y() - min.y(), max.z() - min.z()));
+	float scale = (extent > 0) ? ((1u << CURVE_BITS) - 1) / extent : 0;
+
+	QVector<QPair<quint64, int> > keys(n);
+	for(int i = 0; i < n; i++) {
+		osg::Vec3f p = (positions.at(i) - min) * scale;
+		keys[i] = qMakePair(curveKey((quint32) p.x(), (quint32) p.y(), (quint32) p.z(), method != MORTON), i);
+	}
+
+	qSort(keys.begin(), keys.end());
+
+	for(int i = 0; i < n; i++)
+		order[i] = keys.at(i).second;
+
+	return order;
+}
+
+QVector<int> Layout::NodeOrdering::cuthillMcKeeOrder(const QVector<int> &offsets, const QVector<int> &neighbours)
+{
+	int n = offsets.size() - 1;
+	QVector<int> order;
+
+	if(n <= 0)
+		return order;
+
+	order.reserve(n);
+
+	//komponenty zaciname od uzlov s najmensim stupnom
+	QVector<QPair<int, int> > byDegree(n);
+	for(int v = 0; v < n; v++)
+		byDegree[v] = qMakePair(offsets.at(v + 1) - offsets.at(v), v);
+	qSort(byDegree.begin(), byDegree.end());
+
+	QBitArray visited(n);
+	QVector<QPair<int, int> > next;
+
+	for(int s = 0; s < n; s++) {
+		int start = byDegree.at(s).second;
+		if(visited.testBit(start))
+			continue;
+
+		visited.setBit(start);
+		order.append(start);
+
+		//prehladavanie do sirky, susedov pridavame podla stupna
+		for(int head = order.size() - 1; head < order.size(); head++) {
+			int v = order.at(head);
+
+			next.clear();
+			for(int i = offsets.at(v); i < offsets.at(v + 1); i++) {
+				int w = neighbours.at(i);
+				if(!visited.testBit(w)) {
+					visited.setBit(w);
+					next.append(qMakePair(offsets.at(w + 1) - offsets.at(w), w));
+				}
+			}
+
+			qSort(next.begin(), next.end());
+			for(int i = 0; i < next.size(); i++)
+				order.append(next.at(i).second);
+		}
+	}
+
+	//obratene poradie zmensuje sirku pasu matice susednosti
+	for(int i = 0; i < n / 2; i++)
+		qSwap(order[i], order[n - 1 - i]);
+
+	return order;
+}
+
+QVector<Data::Node *> Layout::NodeOrdering::orderNodes(const QMap<qlonglong, osg::ref_ptr<Data::Node> > &nodes, const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &edges, Method method)
+{
+	QVector<Data::Node *> list;
+	list.reserve(nodes.size());
+
+	for(QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator it = nodes.constBegin(); it != nodes.constEnd(); ++it)
+		list.append(it.value().get());
+
+	int n = list.size();
+	if(method == NONE || n < 2)
+		return list;
+
+	QVector<int> order;
+
+	if(method == CUTHILL_MCKEE) {
+		QHash<Data::Node *, int> indexes;
+		indexes.reserve(n);
+		for(int i = 0; i < n; i++)
+			indexes.insert(list.at(i), i);
+
+		//susednost uzlov v tvare pola zaciatkov a pola susedov
+		QVector<int> offsets(n + 1, 0);
+		QVector<QPair<int, int> > pairs;
+		pairs.reserve(edges.size());
+
+		for(QMap<qlonglong, osg::ref_ptr<Data::Edge> >::const_iterator it = edges.constBegin(); it != edges.constEnd(); ++it) {
+			int src = indexes.value(it.value()->getSrcNode().get(), -1);
+			int dst = indexes.value(it.value()->getDstNode().get(), -1);
+			if(src < 0 || dst < 0 || src == dst)
+				continue;
+
+			pairs.append(qMakePair(src, dst));
+			offsets[src + 1]++;
+			offsets[dst + 1]++;
+		}
+
+		for(int i = 0; i < n; i++)
+			offsets[i + 1] += offsets.at(i);
+
+		QVector<int> neighbours(offsets.at(n));
+		QVector<int> position = offsets;
+		for(int e = 0; e < pairs.size(); e++) {
+			neighbours[position[pairs.at(e).first]++] = pairs.at(e).second;
+			neighbours[position[pairs.at(e).second]++] = pairs.at(e).first;
+		}
+
+		order = cuthillMcKeeOrder(offsets, neighbours);
+	} else {
+		QVector<osg::Vec3f> positions(n);
+		for(int i = 0; i < n; i++)
+			positions[i] = list.at(i)->getTargetPosition();
+
+		order = spatialOrder(positions, method);
+	}
+
+	QVector<Data::Node *> result(n);
+	for(int i = 0; i < n; i++)
+		result[i] = list.at(order.at(i));
+
+	return result;
+}
+
+QVector<Data::Edge *> Layout::NodeOrdering::orderEdges(const QMap<qlonglong, osg::ref_ptr<Data::Edge> > &edges, const QVector<Data::Node *> &nodes)
+{
+	int n = nodes.size();
+	QHash<Data::Node *, int> ranks;
+	ranks.reserve(n);
+	for(int i = 0; i < n; i++)
+		ranks.insert(nodes.at(i), i);
+
+	//hrany zoradime podla skorsieho z ich uzlov, hrany bez uzlov nakoniec
+	QVector<QPair<quint64, Data::Edge *> > keys;
+	keys.reserve(edges.size());
+
+	for(QMap<qlonglong, osg::ref_ptr<Data::Edge> >::const_iterator it = edges.constBegin(); it != edges.constEnd(); ++it) {
+		quint64 src = ranks.value(it.value()->getSrcNode().get(), n);
+		quint64 dst = ranks.value(it.value()->getDstNode().get(), n);
+
+		keys.append(qMakePair(qMin(src, dst) * (n + 1) + qMax(src, dst), it.value().get()));
+	}
+
+	qSort(keys.begin(), keys.end());
+
+	QVector<Data::Edge *> result(keys.size());
+	for(int i = 0; i < keys.size(); i++)
+		result[i] = keys.at(i).second;
+
+	return result;
+}
@@ -0,0 +1,127 @@
+#include "Manager/ExportThread.h"
+//-----------------------------------------------------------------------------
+#include "Core/Core.h"
+#include "Manager/Manager.h"
+#include "Util/ApplicationConfig.h"
+//-----------------------------------------------------------------------------
+#include <QMutexLocker>
+
+namespace Manager {
+
+ExportThread::ExportThread (
+	std::auto_ptr<Exporter::StreamExporter> exporter,
+	std::auto_ptr<QFile> stream,
+	Data::Graph &graph
+) : exporter_ (exporter),
+	stream_ (stream),
+	progress_ (0),
+	cancelled_ (0),
+	ok_ (false)
+{
+	// snimka grafu vznika tu, este na vlakne GUI
+	context_.reset (new Exporter::ExporterContext (*stream_, graph, *this));
+
+	// priebeh zobrazujeme obmedzene casto, nie pri kazdej zmene
+	timer_.setInterval ((int) Util::ApplicationConfig::get ()->getNumericValue (
+		"Importer.ProgressInterval",
+		std::auto_ptr<long> (new long(10)),
+		std::auto_ptr<long> (NULL),
+		200
+	));
+
+	connect (&timer_, SIGNAL (timeout ()), this, SLOT (update ()));
+	connect (this, SIGNAL (finished ()), this, SLOT (finish ()));
+}
+
+ExportThread::~ExportThread (void) {
+	wait ();
+}
+
+void ExportThread::startExport (void) {
+	timer_.start ();
+	start ();
+}
+
+void ExportThread::cancel (void) {
+	cancelled_ = 1;
+}
+
+bool ExportThread::isExported (void) const {
+	return ok_ && !isCancelled ();
+}
+
+void ExportThread::removeFile (void) {
+	stream_->close ();
+	stream_->remove ();
+}
+
+void ExportThread::showMessages (void) {
+	QStringList errors;
+	QStringList messages;
+	{
+		QMutexLocker locker (&messagesMutex_);
+		errors.swap (errors_);
+		messages.swap (messages_);
+	}
+
+	// chyby po zruseni exportu su len jeho dosledkom, nezobrazujeme ich
+	if (!isCancelled ()) {
+		foreach (const QString &text, errors) {
+			AppCore::Core::getInstance ()->messageWindows->showMessageBox ("Chyba", text, true);
+		}
+	}
+
+	foreach (const QString &text, messages) {
+		AppCore::Core::getInstance ()->messageWindows->showMessageBox ("Informacia", text, false);
+	}
+}
+
+void ExportThread::addMessage (
+	const QString &text
+) {
+	QMutexLocker locker (&messagesMutex_);
+	messages_.append (text);
+}
+
+void ExportThread::reportError (
+	const QString &text
+) {
+	QMutexLocker locker (&messagesMutex_);
+	errors_.append (text);
+}
+
+void ExportThread::setProgress (
+	const unsigned int value
+) {
+	progress_ = (int) value;
+}
+
+bool ExportThread::isCancelled (void) const {
+	return (int) cancelled_ != 0;
+}
+
+void ExportThread::run (void) {
+	ok_ = exporter_->exportGraph (*context_);
+
+	// data zapisane do vyrovnavacej pamate suboru zapiseme este na tomto vlakne
+	ok_ = stream_->flush () && ok_;
+}
+
+void ExportThread::update (void) {
+	QOSG::MessageWindows *messageWindows = AppCore::Core::getInstance ()->messageWindows;
+
+	if (messageWindows->isProgressBarCanceled ())
+		cancel ();
+
+	messageWindows->setProgressBarValue ((int) progress_);
+}
+
+void ExportThread::finish (void) {
+	timer_.stop ();
+
+	stream_->close ();
+
+	GraphManager::getInstance ()->finishExport (this);
+}
+
+} // namespace
@@ -0,0 +1,130 @@
+#include "Manager/ImportThread.h"
+//-----------------------------------------------------------------------------
+#include "Core/Core.h"
+#include "Manager/Manager.h"
+#include "Util/ApplicationConfig.h"
+//-----------------------------------------------------------------------------
+#include <QMutexLocker>
+
+namespace Manager {
+
+ImportThread::ImportThread (
+	std::auto_ptr<Importer::StreamImporter> importer,
+	std::auto_ptr<QIODevice> stream,
+	Data::Graph &graph
+) : importer_ (importer),
+	stream_ (stream),
+	graph_ (graph),
+	progress_ (0),
+	cancelled_ (0),
+	ok_ (false)
+{
+	context_.reset (new Importer::ImporterContext (*stream_, graph_, *this));
+
+	// priebeh zobrazujeme obmedzene casto, nie pri kazdej zmene
+	timer_.setInterval ((int) Util::ApplicationConfig::get ()->getNumericValue (
+		"Importer.ProgressInterval",
+		std::auto_ptr<long> (new long(10)),
+		std::auto_ptr<long> (NULL),
+		200
+	));
+
+	connect (&timer_, SIGNAL (timeout ()), this, SLOT (update ()));
+	connect (this, SIGNAL (finished ()), this, SLOT (finish ()));
+}
+
+ImportThread::~ImportThread (void) {
+	wait ();
+}
+
+void ImportThread::startImport (void) {
+	timer_.start ();
+	start ();
+}
+
+void ImportThread::cancel (void) {
+	cancelled_ = 1;
+}
+
+bool ImportThread::isImported (void) const {
+	return ok_ && !isCancelled ();
+}
+
+Data::Graph &ImportThread::getGraph (void) {
+	return graph_;
+}
+
+QString ImportThread::getLayoutName (void) const {
+	return context_->getLayoutName ();
+}
+
+void ImportThread::showMessages (void) {
+	QStringList errors;
+	QStringList messages;
+	{
+		QMutexLocker locker (&messagesMutex_);
+		errors.swap (errors_);
+		messages.swap (messages_);
+	}
+
+	// chyby po zruseni importu su len jeho dosledkom, nezobrazujeme ich
+	if (!isCancelled ()) {
+		foreach (const QString &text, errors) {
+			AppCore::Core::getInstance ()->messageWindows->showMessageBox ("Chyba", text, true);
+		}
+	}
+
+	foreach (const QString &text, messages) {
+		AppCore::Core::getInstance ()->messageWindows->showMessageBox ("Informacia", text, false);
+	}
+}
+
+void ImportThread::addMessage (
+	const QString &text
+) {
+	QMutexLocker locker (&messagesMutex_);
+	messages_.append (text);
+}
+
+void ImportThread::reportError (
+	const QString &text
+) {
+	QMutexLocker locker (&messagesMutex_);
+	errors_.append (text);
+}
+
+void ImportThread::setProgress (
+	const unsigned int value
+) {
+	progress_ = (int) value;
+}
+
+bool ImportThread::isCancelled (void) const {
+	return (int) cancelled_ != 0;
+}
+
+void ImportThread::run (void) {
+	ok_ = importer_->import (*context_);
+}
+
+void ImportThread::update (void) {
+	QOSG::MessageWindows *messageWindows = AppCore::Core::getInstance ()->messageWindows;
+
+	if (messageWindows->isProgressBarCanceled ())
+		cancel ();
+
+	messageWindows->setProgressBarValue ((int) progress_);
+
+	// uz nacitane uzly a hrany zobrazime, nove uzly rozmiestnime nahodne
+	AppCore::Core::getInstance ()->getLayoutAlgorithm ()->Randomize (graph_.flushBulkInsert ());
+}
+
+void ImportThread::finish (void) {
+	timer_.stop ();
+
+	stream_->close ();
+
+	GraphManager::getInstance ()->finishImport (this);
+}
+
+} // namespace
@@ -10,8 +10,18 @@
 #include "Importer/ImporterContext.h"
 #include "Importer/ImporterFactory.h"
 #include "Importer/StreamImporter.h"
+#include "Importer/GraphMerger.h"
+
+#include "Exporter/ExporterContext.h"
+#include "Exporter/ExporterFactory.h"
+#include "Exporter/StreamExporter.h"
 
 #include "Manager/ImportInfoHandlerImpl.h"
+#include "Manager/ImportThread.h"
+#include "Manager/ExportThread.h"
+#include "Manager/SaveLayoutThread.h"
+
+#include "Util/CompressedInputDevice.h"
 
 #include <memory>
 
@@ -23,6 +33,12 @@ Manager::GraphManager::GraphManager()
 
 	//konfiguracia/vytvorenie DB
     this->activeGraph = NULL;
+    this->importThread = NULL;
+    this->exportThread = NULL;
+    this->saveLayoutThread = NULL;
+    this->mergeTarget = NULL;
+    this->previousGraph = NULL;
+    this->pipelinedLayout = false;
     this->db = new Model::DB();
     bool error;
     this->graphs = Model::GraphDAO::getGraphs(db->tmpGetConn(), &error);
@@ -32,36 +48,42 @@ Manager::GraphManager::GraphManager()
 
 Manager::GraphManager::~GraphManager()
 {
+    //pockame na dokoncenie ukladania layoutu, layouty cakajuce na ulozenie sa uz neulozia
+    delete this->saveLayoutThread;
+    this->saveLayoutThread = NULL;
+    qDeleteAll(this->pendingSaveLayoutThreads);
+    this->pendingSaveLayoutThreads.clear();
+
     delete this->db;
     this->db = NULL;
 }
 
-Data::Graph* Manager::GraphManager::loadGraph(QString filepath)
+bool Manager::GraphManager::openImport(QString filepath, std::auto_ptr<Importer::StreamImporter> &importer, std::auto_ptr<QIODevice> &stream)
 {
-	//otvaranie suboru
 	bool ok = true;
 
-    AppCore::Core::getInstance()->thr->pause();
-    AppCore::Core::getInstance()->messageWindows->showProgressBar();
-
     // vytvorenie infoHandler
 	std::auto_ptr<Importer::ImportInfoHandler> infoHandler (NULL);
 	if (ok) {
 		infoHandler.reset (new ImportInfoHandlerImpl);
 	}
 
-	// meno a pripona
-	QString name;
+	// pripona
 	QString extension;
+	Util::CompressedInputDevice::Format compression = Util::CompressedInputDevice::NONE;
 
 	if (ok) {
 		QFileInfo fileInfo (filepath);
-		name = fileInfo.fileName ();
 		extension = fileInfo.suffix ();
+
+		// pri komprimovanom subore (napr. graf.graphml.gz) urcuje importer predchadzajuca pripona
+		compression = Util::CompressedInputDevice::formatFromSuffix (extension);
+		if (compression != Util::CompressedInputDevice::NONE) {
+			extension = QFileInfo (fileInfo.completeBaseName ()).suffix ();
+		}
 	}
 
 	// nastavenie importera
-	std::auto_ptr<Importer::StreamImporter> importer (NULL);
 	if (ok) {
 		bool importerFound;
 
@@ -79,17 +101,50 @@ Data::Graph* Manager::GraphManager::loadGraph(QString filepath)
 	}
 
     // vytvorenie nacitavaneho streamu
-    std::auto_ptr<QIODevice> stream (NULL);
     if (ok) {
     	stream.reset (new QFile (filepath));
     }
 
+    if (ok && compression != Util::CompressedInputDevice::NONE) {
+    	ok = Util::CompressedInputDevice::isSupported (compression);
+
+    	infoHandler->reportError(ok, "The compression format of the file is not supported by this build.");
+
+    	if (ok) {
+    		stream.reset (new Util::CompressedInputDevice (stream, compression));
+    	}
+    }
+
     if (ok) {
     	ok = (stream->open (QIODevice::ReadOnly));
 
     	infoHandler->reportError(ok, "Unable to open the input file.");
     }
 
+    return ok;
+}
+
+Data::Graph* Manager::GraphManager::loadGraph(QString filepath)
+{
+	//otvaranie suboru
+	bool ok = true;
+
+    // kym sa predchadzajuci subor nenacita, dalsi nenacitavame
+    if (this->importThread != NULL || this->exportThread != NULL) {
+    	AppCore::Core::getInstance()->messageWindows->showMessageBox("Chyba", "Predchadzajuci subor sa este nacitava alebo zapisuje.", true);
+    	return NULL;
+    }
+
+    AppCore::Core::getInstance()->thr->pause();
+
+	// meno suboru
+	QString name = QFileInfo (filepath).fileName ();
+
+	// importer podla pripony a otvoreny stream suboru
+	std::auto_ptr<Importer::StreamImporter> importer (NULL);
+	std::auto_ptr<QIODevice> stream (NULL);
+	ok = this->openImport (filepath, importer, stream);
+
     // vytvorenie noveho grafu
     std::auto_ptr<Data::Graph> newGraph (NULL);
     if (ok) {
@@ -97,72 +152,193 @@ Data::Graph* Manager::GraphManager::loadGraph(QString filepath)
 		ok = (newGraph.get () != NULL);
     }
 
-
-
-    // vytvorenie kontextu
-    std::auto_ptr<Importer::ImporterContext> context (NULL);
+    // pridanie rozlozenia este pred importom (vlakno importu nepristupuje k DB)
     if (ok) {
-    	context.reset (
-    		new Importer::ImporterContext (
-				*stream,
-				*newGraph,
-				*infoHandler
-			)
-    	);
-    }
+		Data::GraphLayout* gLay = newGraph->addLayout ("new Layout");
+		newGraph->selectLayout (gLay);
+	}
 
-    // spustenie importera
-    if (ok) {
-    	ok = importer->import (*context);
+    if (!ok) {
+    	if (newGraph.get () != NULL) {
+    		this->graphs.remove (newGraph->getId ());
+    	}
+    	return NULL;
     }
 
-    // ukoncenie stramu
-    if (stream.get() != NULL) {
-    	stream->close ();
+    // nastavenie aktivneho grafu, uzly a hrany sa zobrazuju uz pocas importu
+    this->previousGraph = this->activeGraph;
+	if(this->activeGraph != NULL){
+		this->closeGraph(this->activeGraph);
+	}
+	this->activeGraph = newGraph.release ();
+	this->importFileName = name;
+
+	// rozlozenie spustime hned nad ciastocnym grafom, alebo az nad celym grafom
+	this->pipelinedLayout = (Util::ApplicationConfig::get()->getNumericValue (
+		"Importer.PipelinedLayout",
+		std::auto_ptr<long> (new long(0)),
+		std::auto_ptr<long> (new long(1)),
+		1
+	) != 0);
+
+	AppCore::Core::getInstance()->restartLayout(this->pipelinedLayout);
+	if (!this->pipelinedLayout) {
+		AppCore::Core::getInstance()->thr->pause();
+	}
+
+	AppCore::Core::getInstance()->messageWindows->showProgressBar(true);
+
+    // spustenie importera v samostatnom vlakne, nacitane uzly a hrany zaraduje do zoznamov grafu casovac vlakna
+    this->activeGraph->beginBulkInsert ();
+    this->importThread = new ImportThread (importer, stream, *this->activeGraph);
+    this->importThread->startImport ();
+
+    return this->activeGraph;
+}
+
+void Manager::GraphManager::mergeGraph(QString filepath)
+{
+	bool ok = (this->activeGraph != NULL);
+
+    // kym sa predchadzajuci subor nenacita, dalsi nenacitavame
+    if (this->importThread != NULL || this->exportThread != NULL) {
+    	AppCore::Core::getInstance()->messageWindows->showMessageBox("Chyba", "Predchadzajuci subor sa este nacitava alebo zapisuje.", true);
+    	return;
     }
 
-    // pridanie obmedzovaca
-    if (ok) {
-		Data::GraphLayout* gLay = newGraph->addLayout ("new Layout");
-		newGraph->selectLayout (gLay);
+	// importer podla pripony a otvoreny stream suboru
+	std::auto_ptr<Importer::StreamImporter> importer (NULL);
+	std::auto_ptr<QIODevice> stream (NULL);
+	if (ok) {
+		ok = this->openImport (filepath, importer, stream);
 	}
 
-    // ukoncenie stramu
-    if (stream.get() != NULL) {
-    	stream->close ();
+    if (!ok) {
+    	return;
     }
 
-    // nastavenie aktivneho grafu
-    if (ok) {
-    	// ak uz nejaky graf mame, tak ho najprv sejvneme a zavrieme
-		if(this->activeGraph != NULL){
-			//this->saveGraph(this->activeGraph);
-			this->closeGraph(this->activeGraph);
+    // delta sa nacita do pomocneho grafu mimo DB, aktivny graf sa zatial nemeni a layout bezi dalej
+    Data::Graph* delta = this->emptyGraph();
+    delta->selectLayout (delta->addLayout ("new Layout"));
+    this->mergeTarget = this->activeGraph;
+
+	AppCore::Core::getInstance()->messageWindows->showProgressBar(true);
+
+    delta->beginBulkInsert ();
+    this->importThread = new ImportThread (importer, stream, *delta);
+    this->importThread->startImport ();
+}
+
+void Manager::GraphManager::finishMerge(ImportThread* thread)
+{
+	Data::Graph* delta = &thread->getGraph ();
+	bool ok = thread->isImported ();
+
+	delta->commitBulkInsert ();
+
+	AppCore::Core::getInstance()->messageWindows->closeProgressBar();
+	thread->showMessages ();
+
+	this->importThread = NULL;
+	thread->deleteLater ();
+
+	// cielovy graf mohol byt medzicasom zavrety
+	if (ok && this->mergeTarget == this->activeGraph) {
+		QString matchBy = Util::ApplicationConfig::get()->getValue("Importer.DeltaMatchBy");
+		QString deletedAttribute = Util::ApplicationConfig::get()->getValue("Importer.DeltaDeletedAttribute");
+
+		Importer::GraphMerger merger (
+			*this->mergeTarget,
+			(matchBy.compare ("id", Qt::CaseInsensitive) == 0) ? Importer::GraphMerger::MATCH_BY_ID : Importer::GraphMerger::MATCH_BY_NAME,
+			deletedAttribute.isEmpty () ? QString ("deleted") : deletedAttribute
+		);
+
+		// uzly a hrany menime mimo iteracie layoutu, layout pozastavime az do konca zlucenia
+		Layout::FRAlgorithm* layout = AppCore::Core::getInstance()->getLayoutAlgorithm();
+		bool running = layout->IsRunning();
+		layout->PauseAlg();
+
+		// pozicie existujucich uzlov ostavaju, layout pokracuje len so zmenenou castou grafu
+		layout->Randomize(merger.merge (*delta));
+
+		if (running) {
+			layout->RunAlg();
 		}
-		this->activeGraph = newGraph.release ();
-    }
 
-	//ked uz mame graf nacitany zo suboru, ulozime ho aj do databazy
-	if(db->tmpGetConn() != NULL && db->tmpGetConn()->open()) { 
-		//ulozime obycajne uzly a hrany
-		this->activeGraph->saveGraphToDB(db->tmpGetConn(), this->activeGraph);
-		//nastavime meno grafu podla nazvu suboru
-		Model::GraphDAO::setGraphName(this->activeGraph->getId(), name, db->tmpGetConn());
-		//ulozime a nastavime default layout
-		Data::GraphLayout* layout = Model::GraphLayoutDAO::addLayout("original layout", this->activeGraph, db->tmpGetConn());
-		this->activeGraph->selectLayout(layout);
-		//este ulozit meta uzly, hrany a pozicie vsetkych uzlov
-		this->activeGraph->saveLayoutToDB(db->tmpGetConn(), this->activeGraph);
-    }
+		AppCore::Core::getInstance()->messageWindows->showMessageBox("Informacia", merger.getSummary (), false);
+	}
 
-    if (ok) {
-    	// robime zakladnu proceduru pre restartovanie layoutu
-    	AppCore::Core::getInstance()->restartLayout();
-    }
+	// vlakno uz delte nepristupuje
+	thread->wait ();
+	delete delta;
+
+	this->mergeTarget = NULL;
+}
+
+void Manager::GraphManager::finishImport(ImportThread* thread)
+{
+	if (this->mergeTarget != NULL) {
+		this->finishMerge (thread);
+		return;
+	}
+
+	Data::Graph* graph = &thread->getGraph ();
+	bool ok = thread->isImported ();
+
+	// zvysne uzly a hrany zaradime do zoznamov grafu
+	AppCore::Core::getInstance()->getLayoutAlgorithm()->Randomize(graph->flushBulkInsert ());
+	graph->commitBulkInsert ();
 
 	AppCore::Core::getInstance()->messageWindows->closeProgressBar();
+	thread->showMessages ();
 
-    return (ok ? this->activeGraph : NULL);
+	this->importThread = NULL;
+	thread->deleteLater ();
+
+	if (ok) {
+		//ked uz mame graf nacitany zo suboru, ulozime ho aj do databazy
+		if(db->tmpGetConn() != NULL && db->tmpGetConn()->open()) { 
+			//ulozime obycajne uzly a hrany
+			graph->saveGraphToDB(db->tmpGetConn(), graph);
+			//nastavime meno grafu podla nazvu suboru
+			Model::GraphDAO::setGraphName(graph->getId(), this->importFileName, db->tmpGetConn());
+			//ulozime a nastavime default layout, pomenovany podla rozlozenia zo suboru, ak ho subor obsahuje
+			QString layoutName = thread->getLayoutName();
+			Data::GraphLayout* layout = Model::GraphLayoutDAO::addLayout(layoutName.isEmpty() ? QString("original layout") : layoutName, graph, db->tmpGetConn());
+			graph->selectLayout(layout);
+			//este ulozit meta uzly, hrany a pozicie vsetkych uzlov (na pozadi, pripadne po skonceni predchadzajuceho ukladania)
+			if (!this->saveLayout(graph)) {
+				AppCore::Core::getInstance()->messageWindows->showMessageBox("Chyba", "Layout nacitaneho grafu sa nepodarilo ulozit do databazy.", true);
+			}
+		}
+
+		if (!this->pipelinedLayout && this->activeGraph == graph) {
+			AppCore::Core::getInstance()->thr->play();
+		}
+
+		// pocas importu mohol byt otvoreny iny graf, nacitany graf je uz len v DB
+		if (this->activeGraph != graph) {
+			thread->wait();
+			delete graph;
+		}
+	} else {
+		// nacitanie zlyhalo alebo bolo zrusene, predchadzajuci graf vratime len ak medzicasom nebol otvoreny iny
+		this->graphs.remove(graph->getId());
+		if (this->activeGraph == graph) {
+			this->activeGraph = this->previousGraph;
+			if (this->activeGraph != NULL) {
+				this->graphs.insert(this->activeGraph->getId(), this->activeGraph);
+			}
+
+			AppCore::Core::getInstance()->restartLayout();
+		}
+
+		// vlakno uz grafu nepristupuje, layout a zobrazenie uz pracuju s inym grafom
+		thread->wait();
+		delete graph;
+	}
+
+	this->previousGraph = NULL;
 }
 
 Data::Graph* Manager::GraphManager::createNewGraph(QString name)
@@ -246,7 +422,108 @@ Data::Graph* Manager::GraphManager::loadGraphFromDB(qlonglong graphID, qlonglong
 
 void Manager::GraphManager::exportGraph(Data::Graph* graph, QString filepath)
 {
-    // TODO export do GraphML
+	bool ok = (graph != NULL);
+
+    // progress bar je jeden, subory zapisujeme a nacitavame po jednom
+    if (this->importThread != NULL || this->exportThread != NULL) {
+    	AppCore::Core::getInstance()->messageWindows->showMessageBox("Chyba", "Predchadzajuci subor sa este nacitava alebo zapisuje.", true);
+    	return;
+    }
+
+    // vytvorenie infoHandler
+	std::auto_ptr<Importer::ImportInfoHandler> infoHandler (NULL);
+	if (ok) {
+		infoHandler.reset (new ImportInfoHandlerImpl);
+	}
+
+	// nastavenie exportera podla pripony
+	std::auto_ptr<Exporter::StreamExporter> exporter (NULL);
+	if (ok) {
+		bool exporterFound;
+
+		ok =
+			Exporter::ExporterFactory::createByFileExtension (
+				exporter,
+				exporterFound,
+				QFileInfo (filepath).suffix ()
+			)
+			&&
+			exporterFound
+		;
+
+		infoHandler->reportError(ok, "No suitable exporter has been found for the file extension.");
+	}
+
+    // vytvorenie zapisovaneho streamu
+    std::auto_ptr<QFile> stream (NULL);
+    if (ok) {
+    	stream.reset (new QFile (filepath));
+    	ok = (stream->open (QIODevice::WriteOnly | QIODevice::Truncate));
+
+    	infoHandler->reportError(ok, "Unable to open the output file.");
+    }
+
+    if (!ok) {
+    	return;
+    }
+
+	AppCore::Core::getInstance()->messageWindows->showProgressBar(true);
+
+    // spustenie exportera v samostatnom vlakne, snimka grafu vznika este teraz
+    this->exportThread = new ExportThread (exporter, stream, *graph);
+    this->exportThread->startExport ();
+}
+
+void Manager::GraphManager::finishExport(ExportThread* thread)
+{
+	AppCore::Core::getInstance()->messageWindows->closeProgressBar();
+	thread->showMessages ();
+
+	// neuplny subor nenechavame
+	if (!thread->isExported ()) {
+		thread->removeFile ();
+	}
+
+	this->exportThread = NULL;
+	thread->deleteLater ();
+}
+
+bool Manager::GraphManager::saveLayout(Data::Graph* graph)
+{
+	if(graph == NULL || graph->getSelectedLayout() == NULL || db->tmpGetConn() == NULL || !db->tmpGetConn()->isOpen()) {
+		qDebug() << "[Manager::GraphManager::saveLayout] There is no layout to save or connection to DB not opened.";
+		return false;
+	}
+
+	// data layoutu skopirujeme hned, graf sa medzitym moze zmenit alebo zavriet
+	SaveLayoutThread* thread = new SaveLayoutThread(graph, graph->getSelectedLayout(), *db->tmpGetConn());
+
+	// meta uzly dostavaju nove ID podla DB, layouty ukladame po jednom - dalsi sa ulozi po skonceni predchadzajuceho
+	if (this->saveLayoutThread != NULL) {
+		this->pendingSaveLayoutThreads.enqueue(thread);
+		return true;
+	}
+
+	this->saveLayoutThread = thread;
+	this->saveLayoutThread->start();
+
+	return true;
+}
+
+void Manager::GraphManager::finishSaveLayout(SaveLayoutThread* thread)
+{
+	if (!thread->isSaved()) {
+		AppCore::Core::getInstance()->messageWindows->showMessageBox("Chyba", "Layout sa nepodarilo ulozit do databazy.", true);
+	}
+
+	this->saveLayoutThread = NULL;
+	thread->deleteLater();
+
+	// ulozime dalsi layout, ktory cakal na skoncenie tohto
+	if (!this->pendingSaveLayoutThreads.isEmpty()) {
+		this->saveLayoutThread = this->pendingSaveLayoutThreads.dequeue();
+		this->saveLayoutThread->start();
+	}
 }
 
 Data::Graph* Manager::GraphManager::createGraph(QString graphname)
@@ -0,0 +1,64 @@
+#include "Manager/SaveLayoutThread.h"
+//-----------------------------------------------------------------------------
+#include "Manager/Manager.h"
+//-----------------------------------------------------------------------------
+
+namespace Manager {
+
+SaveLayoutThread::SaveLayoutThread (
+	Data::Graph *graph,
+	Data::GraphLayout *layout,
+	const QSqlDatabase &conn
+) : driverName_ (conn.driverName ()),
+	hostName_ (conn.hostName ()),
+	databaseName_ (conn.databaseName ()),
+	userName_ (conn.userName ()),
+	password_ (conn.password ()),
+	port_ (conn.port ()),
+	connectOptions_ (conn.connectOptions ()),
+	ok_ (false)
+{
+	// data layoutu kopirujeme tu, este na vlakne GUI
+	writer_.reset (new Model::GraphLayoutWriter (graph, layout));
+
+	connect (this, SIGNAL (finished ()), this, SLOT (finish ()));
+}
+
+SaveLayoutThread::~SaveLayoutThread (void) {
+	wait ();
+}
+
+bool SaveLayoutThread::isSaved (void) const {
+	return ok_;
+}
+
+void SaveLayoutThread::run (void) {
+	// spojenie moze pouzivat len vlakno, ktore ho otvorilo - vytvorime vlastne
+	QString connectionName = QString ("SaveLayoutThread_%1").arg ((quintptr) this);
+
+	{
+		QSqlDatabase conn = QSqlDatabase::addDatabase (driverName_, connectionName);
+		conn.setHostName (hostName_);
+		conn.setDatabaseName (databaseName_);
+		conn.setUserName (userName_);
+		conn.setPassword (password_);
+		conn.setPort (port_);
+		conn.setConnectOptions (connectOptions_);
+
+		if (conn.open ()) {
+			ok_ = writer_->write (&conn);
+			conn.close ();
+		} else {
+			qDebug () << "[Manager::SaveLayoutThread::run] Could not open connection: " << conn.lastError ().databaseText ();
+		}
+	}
+
+	// spojenie sa da odstranit az ked ho uz nic nepouziva
+	QSqlDatabase::removeDatabase (connectionName);
+}
+
+void SaveLayoutThread::finish (void) {
+	GraphManager::getInstance ()->finishSaveLayout (this);
+}
+
+} // namespace
@@ -0,0 +1,93 @@
+/*!
+ * BatchInsert.cpp
+ * Projekt 3DVisual
+ */
+#include "Model/BatchInsert.h"
+
+Model::BatchInsert::BatchInsert(QSqlDatabase* conn, QString table, QStringList columns, int rowsPerQuery)
+	: conn(conn),
+	table(table),
+	columns(columns),
+	rowsPerQuery(qMax(rowsPerQuery, 1)),
+	fullQuery(conn != NULL ? *conn : QSqlDatabase()),
+	fullQueryPrepared(false),
+	pendingRows(0),
+	rowCount(0)
+{
+	pending.reserve(this->rowsPerQuery * columns.size());
+}
+
+bool Model::BatchInsert::addRow(const QVariantList& values)
+{
+	pending << values;
+	pendingRows++;
+	rowCount++;
+
+	//plny blok riadkov zapiseme jednym prikazom
+	if(pendingRows >= rowsPerQuery)
+		return execPending();
+
+	return true;
+}
+
+bool Model::BatchInsert::finish()
+{
+	return execPending();
+}
+
+bool Model::BatchInsert::execPending()
+{
+	if(pendingRows == 0)
+		return true;
+
+	//prikaz pre plny blok pripravime len raz, posledny kratsi blok zvlast
+	QSqlQuery partialQuery(conn != NULL ? *conn : QSqlDatabase());
+	QSqlQuery* query = &fullQuery;
+
+	if(pendingRows < rowsPerQuery)
+	{
+		query = &partialQuery;
+		if(!query->prepare(insertStatement(pendingRows)))
+		{
+			error = query->lastError().databaseText();
+			return false;
+		}
+	}
+	else if(!fullQueryPrepared)
+	{
+		if(!query->prepare(insertStatement(rowsPerQuery)))
+		{
+			error = query->lastError().databaseText();
+			return false;
+		}
+		fullQueryPrepared = true;
+	}
+
+	for(int i = 0; i < pending.size(); i++)
+		query->bindValue(i, pending.at(i));
+
+	bool ok = query->exec();
+	if(!ok)
+		error = query->lastError().databaseText();
+
+	pending.clear();
+	pendingRows = 0;
+
+	return ok;
+}
+
+QString Model::BatchInsert::insertStatement(int rows) const
+{
+	//INSERT INTO table (a, b) VALUES (?, ?), (?, ?), ...
+	QStringList placeholders;
+	for(int i = 0; i < columns.size(); i++)
+		placeholders << "?";
+
+	QString row = "(" + placeholders.join(", ") + ")";
+
+	QStringList values;
+	for(int i = 0; i < rows; i++)
+		values << row;
+
+	return "INSERT INTO " + table + " (" + columns.join(", ") + ") VALUES " + values.join(", ");
+}
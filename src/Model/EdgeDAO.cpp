@@ -25,7 +25,7 @@ bool Model::EdgeDAO::addEdgesToDB(QSqlDatabase* conn, QMap<qlonglong, osg::ref_p
 
 	QMap< qlonglong,osg::ref_ptr<Data::Edge> >::const_iterator iEdges =	edges->constBegin();
 
-	QSqlQuery* query = new QSqlQuery(*conn);
+	Model::BatchInsert insert(conn, "edges", QStringList() << "edge_id" << "name" << "type_id" << "n1" << "n2" << "oriented" << "meta" << "graph_id" << "nested");
  
 	//pridavame hrany do query
 	while(iEdges != edges->constEnd()) 
@@ -34,24 +34,28 @@ bool Model::EdgeDAO::addEdgesToDB(QSqlDatabase* conn, QMap<qlonglong, osg::ref_p
 		if(iEdges.value()->getType() == iEdges.value()->getGraph()->getNestedEdgeType())
 			isNested = true;
 
-		query->prepare("INSERT INTO edges (edge_id, name, type_id, n1, n2, oriented, meta, graph_id, nested) VALUES (:edge_id, :name, :type_id, :n1, :n2, :oriented, :meta, :graph_id, :nested) RETURNING  edge_id");
-		query->bindValue(":edge_id", iEdges.value()->getId());
-		query->bindValue(":name", iEdges.value()->getName());
-		query->bindValue(":type_id", iEdges.value()->getType()->getId());
-		query->bindValue(":n1", iEdges.value()->getSrcNode()->getId()); 
-		query->bindValue(":n2", iEdges.value()->getDstNode()->getId());
-		query->bindValue(":oriented", iEdges.value()->isOriented());
-		query->bindValue(":meta", false);
-		query->bindValue(":graph_id", iEdges.value()->getGraph()->getId());
-		query->bindValue(":nested", isNested);
-
-		if(!query->exec()) {
-			qDebug() << "[Model::EdgeDAO::addEdgesToDB] Could not perform query on DB: " << query->lastError().databaseText();
+		if(!insert.addRow(QVariantList()
+			<< iEdges.value()->getId()
+			<< iEdges.value()->getName()
+			<< iEdges.value()->getType()->getId()
+			<< iEdges.value()->getSrcNode()->getId()
+			<< iEdges.value()->getDstNode()->getId()
+			<< iEdges.value()->isOriented()
+			<< false
+			<< iEdges.value()->getGraph()->getId()
+			<< isNested))
+		{
+			qDebug() << "[Model::EdgeDAO::addEdgesToDB] Could not perform query on DB: " << insert.lastError();
 			return false;
 		}
 		++iEdges;
 	}
 
+	if(!insert.finish()) {
+		qDebug() << "[Model::EdgeDAO::addEdgesToDB] Could not perform query on DB: " << insert.lastError();
+		return false;
+	}
+
 	qDebug() << "[Model::EdgeDAO::addEdgesToDB] " << edges->count() << " edges were saved to DB.";
 
 	return true;
@@ -70,40 +74,17 @@ bool Model::EdgeDAO::addMetaEdgesToDB(QSqlDatabase* conn, QMap<qlonglong, osg::r
 
 	QMap< qlonglong,osg::ref_ptr<Data::Edge> >::const_iterator iEdges =	edges->constBegin();
 
-	QSqlQuery* query = new QSqlQuery(*conn);
-	qlonglong nodeID1, nodeID2, edgeID;
-	QMap<qlonglong, qlonglong>::iterator nodeIdIter;
-	QMap<qlonglong, qlonglong>::iterator edgeIdIter;
+	Model::BatchInsert insert(conn, "edges", QStringList() << "edge_id" << "name" << "type_id" << "n1" << "n2" << "oriented" << "meta" << "graph_id" << "layout_id" << "nested");
+	qlonglong nodeID1, nodeID2, edgeID = -1;
  
 	//pridavame meta-uzly do query DB
 	while(iEdges != edges->constEnd()) 
 	{
-		if(newMetaNodeID.contains(iEdges.value()->getSrcNode()->getId()))
-		{
-			nodeIdIter = newMetaNodeID.find(iEdges.value()->getSrcNode()->getId());
-			nodeID1 = nodeIdIter.value();
-		}
-		else	
-		{
-			nodeID1 = iEdges.value()->getSrcNode()->getId();
-		}
-
-		if(newMetaNodeID.contains(iEdges.value()->getDstNode()->getId()))
-		{
-			nodeIdIter = newMetaNodeID.find(iEdges.value()->getDstNode()->getId());
-			nodeID2 = nodeIdIter.value();
-		}
-		else	
-		{
-			nodeID2 = iEdges.value()->getDstNode()->getId();
-		}
+		//uzly, ktore nie su meta, maju povodne ID
+		nodeID1 = newMetaNodeID.value(iEdges.value()->getSrcNode()->getId(), iEdges.value()->getSrcNode()->getId());
+		nodeID2 = newMetaNodeID.value(iEdges.value()->getDstNode()->getId(), iEdges.value()->getDstNode()->getId());
 				
-		if(newMetaEdgeID.contains(iEdges.value()->getId()))
-		{
-			edgeIdIter = newMetaEdgeID.find(iEdges.value()->getId());
-			edgeID = edgeIdIter.value();
-		}
-		else
+		if(!getEdgeID(iEdges.value(), newMetaEdgeID, true, &edgeID))
 		{
 			qDebug() << "[Model::NodeDAO::addMetaEdgesToDB] Edge ID: " << iEdges.value()->getId() <<  " mismatch";
 		}
@@ -112,25 +93,29 @@ bool Model::EdgeDAO::addMetaEdgesToDB(QSqlDatabase* conn, QMap<qlonglong, osg::r
 		if(iEdges.value()->getType() == iEdges.value()->getGraph()->getNestedEdgeType())
 			isNested = true;
 
-		query->prepare("INSERT INTO edges (edge_id, name, type_id, n1, n2, oriented, meta, graph_id, layout_id, nested) VALUES (:edge_id, :name, :type_id, :n1, :n2, :oriented, :meta, :graph_id, :layout_id, :nested) RETURNING  edge_id");
-		query->bindValue(":edge_id", edgeID);
-		query->bindValue(":name", iEdges.value()->getName());
-		query->bindValue(":type_id", iEdges.value()->getType()->getId());
-		query->bindValue(":n1", nodeID1); 
-		query->bindValue(":n2", nodeID2);
-		query->bindValue(":oriented", iEdges.value()->isOriented());
-		query->bindValue(":meta", true);
-		query->bindValue(":graph_id", iEdges.value()->getGraph()->getId());
-		query->bindValue(":layout_id", layout->getId());
-		query->bindValue(":nested", isNested);
-
-		if(!query->exec()) {
-			qDebug() << "[Model::EdgeDAO::addMetaEdgesToDB] Could not perform query on DB: " << query->lastError().databaseText();
+		if(!insert.addRow(QVariantList()
+			<< edgeID
+			<< iEdges.value()->getName()
+			<< iEdges.value()->getType()->getId()
+			<< nodeID1
+			<< nodeID2
+			<< iEdges.value()->isOriented()
+			<< true
+			<< iEdges.value()->getGraph()->getId()
+			<< layout->getId()
+			<< isNested))
+		{
+			qDebug() << "[Model::EdgeDAO::addMetaEdgesToDB] Could not perform query on DB: " << insert.lastError();
 			return false;
 		}
 		++iEdges;
 	}
 
+	if(!insert.finish()) {
+		qDebug() << "[Model::EdgeDAO::addMetaEdgesToDB] Could not perform query on DB: " << insert.lastError();
+		return false;
+	}
+
 	qDebug() << "[Model::EdgeDAO::addMetaEdgesToDB] " << edges->count() << " meta edges were saved to DB.";
 
 	return true;
@@ -138,81 +123,109 @@ bool Model::EdgeDAO::addMetaEdgesToDB(QSqlDatabase* conn, QMap<qlonglong, osg::r
 
 bool Model::EdgeDAO::addEdgesColorToDB(QSqlDatabase* conn, QMap<qlonglong, osg::ref_ptr<Data::Edge> >* edges, Data::GraphLayout* layout, QMap<qlonglong, qlonglong> newMetaNodeID, QMap<qlonglong, qlonglong> newMetaEdgeID, bool meta)
 {
+	//check if we have connection
+	if(conn==NULL || !conn->isOpen()) 
+	{ 
+        qDebug() << "[Model::EdgeDAO::addEdgesColorToDB] Connection to DB not opened.";
+        return false;
+    }
+
 	QMap< qlonglong,osg::ref_ptr<Data::Edge> >::const_iterator iEdges = edges->constBegin();
-	qlonglong edgeID;
-	QMap<qlonglong, qlonglong>::iterator edgeIdIter;
+	Model::BatchInsert insert(conn, "edge_settings", settingsColumns());
+	qlonglong edgeID = -1;
+	bool ok = true;
 	
-	while(iEdges != edges->constEnd()) 
+	while(ok && iEdges != edges->constEnd()) 
 	{
 		//ulozime farbu len hranam, ktore maju farbu inu nez default
 		if(iEdges.value()->getEdgeColor().r() != 1 || iEdges.value()->getEdgeColor().g() != 1 ||iEdges.value()->getEdgeColor().b() != 1 ||iEdges.value()->getEdgeColor().a() != 1)
 		{
-			if(meta)	
+			if(!getEdgeID(iEdges.value(), newMetaEdgeID, meta, &edgeID))
 			{
-				if(newMetaEdgeID.contains(iEdges.value()->getId()))
-				{
-					edgeIdIter = newMetaEdgeID.find(iEdges.value()->getId());
-					edgeID = edgeIdIter.value();
-				}
-				else
-				{
-					qDebug() << "[Model::NodeDAO::addEdgesColorToDB] Edge ID: " << iEdges.value()->getId() <<  " mismatch";
-				}
-			}
-			else
-			{
-				edgeID = iEdges.value()->getId();
+				qDebug() << "[Model::NodeDAO::addEdgesColorToDB] Edge ID: " << iEdges.value()->getId() <<  " mismatch";
 			}
 
-			addSetings(conn, iEdges.value()->getGraph()->getId(), layout->getId(), edgeID, "color_r", iEdges.value()->getEdgeColor().r());
-			addSetings(conn, iEdges.value()->getGraph()->getId(), layout->getId(), edgeID, "color_g", iEdges.value()->getEdgeColor().g());
-			addSetings(conn, iEdges.value()->getGraph()->getId(), layout->getId(), edgeID, "color_b", iEdges.value()->getEdgeColor().b());
-			addSetings(conn, iEdges.value()->getGraph()->getId(), layout->getId(), edgeID, "color_a", iEdges.value()->getEdgeColor().a());
+			qlonglong graphID = iEdges.value()->getGraph()->getId();
+			ok = insert.addRow(QVariantList() << graphID << edgeID << "color_r" << iEdges.value()->getEdgeColor().r() << layout->getId())
+				&& insert.addRow(QVariantList() << graphID << edgeID << "color_g" << iEdges.value()->getEdgeColor().g() << layout->getId())
+				&& insert.addRow(QVariantList() << graphID << edgeID << "color_b" << iEdges.value()->getEdgeColor().b() << layout->getId())
+				&& insert.addRow(QVariantList() << graphID << edgeID << "color_a" << iEdges.value()->getEdgeColor().a() << layout->getId());
 		}
 
 		++iEdges;
 	}
+
+	if(!ok || !insert.finish()) {
+		qDebug() << "[Model::EdgeDAO::addEdgesColorToDB] Could not perform query on DB: " << insert.lastError();
+		return false;
+	}
 	
 	return true;
 }
 
 bool Model::EdgeDAO::addEdgesScaleToDB(QSqlDatabase* conn, QMap<qlonglong, osg::ref_ptr<Data::Edge> >* edges, Data::GraphLayout* layout, QMap<qlonglong, qlonglong> newMetaNodeID, QMap<qlonglong, qlonglong> newMetaEdgeID, bool meta, float defaultScale)
 {
+	//check if we have connection
+	if(conn==NULL || !conn->isOpen()) 
+	{ 
+        qDebug() << "[Model::EdgeDAO::addEdgesScaleToDB] Connection to DB not opened.";
+        return false;
+    }
+
 	QMap< qlonglong,osg::ref_ptr<Data::Edge> >::const_iterator iEdges = edges->constBegin();
-	qlonglong edgeID;
-	QMap<qlonglong, qlonglong>::iterator edgeIdIter;
+	Model::BatchInsert insert(conn, "edge_settings", settingsColumns());
+	qlonglong edgeID = -1;
 	
 	while(iEdges != edges->constEnd()) 
 	{
 		//ulozime scale len hranam, ktore maju scale ine nez default
 		if(iEdges.value()->getScale() != defaultScale)
 		{
-			if(meta)	
+			if(!getEdgeID(iEdges.value(), newMetaEdgeID, meta, &edgeID))
 			{
-				if(newMetaEdgeID.contains(iEdges.value()->getId()))
-				{
-					edgeIdIter = newMetaEdgeID.find(iEdges.value()->getId());
-					edgeID = edgeIdIter.value();
-				}
-				else
-				{
-					qDebug() << "[Model::NodeDAO::addEdgesScaleToDB] Edge ID: " << iEdges.value()->getId() <<  " mismatch";
-				}
+				qDebug() << "[Model::NodeDAO::addEdgesScaleToDB] Edge ID: " << iEdges.value()->getId() <<  " mismatch";
 			}
-			else
+
+			if(!insert.addRow(QVariantList() << iEdges.value()->getGraph()->getId() << edgeID << "scale" << iEdges.value()->getScale() << layout->getId()))
 			{
-				edgeID = iEdges.value()->getId();
+				qDebug() << "[Model::EdgeDAO::addEdgesScaleToDB] Could not perform query on DB: " << insert.lastError();
+				return false;
 			}
-
-			addSetings(conn, iEdges.value()->getGraph()->getId(), layout->getId(), edgeID, "scale", iEdges.value()->getScale());
 		}
 
 		++iEdges;
 	}
+
+	if(!insert.finish()) {
+		qDebug() << "[Model::EdgeDAO::addEdgesScaleToDB] Could not perform query on DB: " << insert.lastError();
+		return false;
+	}
 	
 	return true;
 }
 
+bool Model::EdgeDAO::getEdgeID(osg::ref_ptr<Data::Edge> edge, const QMap<qlonglong, qlonglong>& newMetaEdgeID, bool meta, qlonglong* edgeID)
+{
+	if(!meta)
+	{
+		*edgeID = edge->getId();
+		return true;
+	}
+
+	//meta hrany maju v DB nove ID
+	QMap<qlonglong, qlonglong>::const_iterator edgeIdIter = newMetaEdgeID.constFind(edge->getId());
+	if(edgeIdIter == newMetaEdgeID.constEnd())
+		return false;
+
+	*edgeID = edgeIdIter.value();
+	return true;
+}
+
+QStringList Model::EdgeDAO::settingsColumns()
+{
+	return QStringList() << "graph_id" << "edge_id" << "val_name" << "val" << "layout_id";
+}
+
 QSqlQuery* Model::EdgeDAO::getEdgesQuery(QSqlDatabase* conn, bool* error, qlonglong graphID, qlonglong layoutID)
 {
 	*error = FALSE;
@@ -334,6 +347,51 @@ bool Model::EdgeDAO::removeEdge( Data::Edge* edge, QSqlDatabase* conn )
     return true;
 }
 
+bool Model::EdgeDAO::removeEdges(qlonglong graphID, QSet<qlonglong> edgeIDs, QSqlDatabase* conn)
+{
+    if(conn==NULL || !conn->isOpen()) { //check if we have connection
+        qDebug() << "[Model::EdgeDAO::removeEdges] Connection to DB not opened.";
+        return false;
+    }
+
+    if(edgeIDs.isEmpty()) {
+        return true;
+    }
+
+	//odstranujeme hrany z databazy po castiach v jednej transakcii
+	const int chunkSize = 1000;
+	QList<qlonglong> ids = edgeIDs.toList();
+
+    if(!conn->transaction()) {
+        qDebug() << "[Model::EdgeDAO::removeEdges] Could not start transaction: " << conn->lastError().databaseText();
+        return false;
+    }
+
+    QSqlQuery query(*conn);
+	for(int i = 0; i < ids.size(); i += chunkSize) {
+		QStringList chunk;
+		for(int j = i; j < ids.size() && j < i + chunkSize; j++) {
+			chunk << QString::number(ids.at(j));
+		}
+
+		query.prepare("DELETE FROM edges WHERE graph_id = :graph_id AND edge_id IN (" + chunk.join(",") + ")");
+		query.bindValue(":graph_id", graphID);
+		if(!query.exec()) {
+			qDebug() << "[Model::EdgeDAO::removeEdges] Could not perform query on DB: " << query.lastError().databaseText();
+			conn->rollback();
+			return false;
+		}
+	}
+
+    if(!conn->commit()) {
+        qDebug() << "[Model::EdgeDAO::removeEdges] Could not commit transaction: " << conn->lastError().databaseText();
+        conn->rollback();
+        return false;
+    }
+
+    return true;
+}
+
 bool Model::EdgeDAO::removeEdges(qlonglong graphID, QSqlDatabase* conn)
 {
     if(conn==NULL || !conn->isOpen()) { 
@@ -577,18 +635,18 @@ bool Model::EdgeDAO::addSetings(QSqlDatabase* conn, qlonglong graphID, qlonglong
         return false;
     }
 
-	QSqlQuery* query = new QSqlQuery(*conn);
+	QSqlQuery query(*conn);
 	
-	query->prepare("INSERT INTO edge_settings (graph_id, edge_id, val_name, val, layout_id) VALUES (:graph_id, :edge_id, :val_name, :val, :layout_id)");
-	query->bindValue(":graph_id", graphID); 
-	query->bindValue(":edge_id", edgeID);
-	query->bindValue(":val_name", valName);
-	query->bindValue(":val", val);
-	query->bindValue(":layout_id", layoutID);
+	query.prepare("INSERT INTO edge_settings (graph_id, edge_id, val_name, val, layout_id) VALUES (:graph_id, :edge_id, :val_name, :val, :layout_id)");
+	query.bindValue(":graph_id", graphID); 
+	query.bindValue(":edge_id", edgeID);
+	query.bindValue(":val_name", valName);
+	query.bindValue(":val", val);
+	query.bindValue(":layout_id", layoutID);
 
 	//ukladame jednotlive atributy do databazy
-	if(!query->exec()) {
-		qDebug() << "[Model::EdgeDAO::addSettings] Could not perform query on DB: " << query->lastError().databaseText();
+	if(!query.exec()) {
+		qDebug() << "[Model::EdgeDAO::addSettings] Could not perform query on DB: " << query.lastError().databaseText();
 		return false;
 	}
 
@@ -603,18 +661,18 @@ bool Model::EdgeDAO::addSetings(QSqlDatabase* conn, qlonglong graphID, qlonglong
         return false;
     }
 
-	QSqlQuery* query = new QSqlQuery(*conn);
+	QSqlQuery query(*conn);
 	
-	query->prepare("INSERT INTO edge_settings (graph_id, edge_id, val_name, val, layout_id) VALUES (:graph_id, :edge_id, :val_name, :val, :layout_id)");
-	query->bindValue(":graph_id", graphID); 
-	query->bindValue(":edge_id", edgeID);
-	query->bindValue(":val_name", valName);
-	query->bindValue(":val", val);
-	query->bindValue(":layout_id", layoutID);
+	query.prepare("INSERT INTO edge_settings (graph_id, edge_id, val_name, val, layout_id) VALUES (:graph_id, :edge_id, :val_name, :val, :layout_id)");
+	query.bindValue(":graph_id", graphID); 
+	query.bindValue(":edge_id", edgeID);
+	query.bindValue(":val_name", valName);
+	query.bindValue(":val", val);
+	query.bindValue(":layout_id", layoutID);
 
 	//ukladame jednotlive atributy do databazy
-	if(!query->exec()) {
-		qDebug() << "[Model::EdgeDAO::addSettings] Could not perform query on DB: " << query->lastError().databaseText();
+	if(!query.exec()) {
+		qDebug() << "[Model::EdgeDAO::addSettings] Could not perform query on DB: " << query.lastError().databaseText();
 		return false;
 	}
 
@@ -108,6 +108,8 @@ Data::Graph* Model::GraphDAO::getGraph(QSqlDatabase* conn, bool* error2, qlonglo
 	QMap<qlonglong, Data::Node*>::iterator iNodes1;
 	QMap<qlonglong, Data::Node*>::iterator iNodes2;
 	Data::Node* newNode; 
+	osg::ref_ptr<Data::Edge> newEdge;
+	QList<osg::ref_ptr<Data::Edge> > loadedEdges;
 	osg::Vec3f position;
 	QMap<qlonglong, osg::Vec3f> positions;
 	QMap<qlonglong, osg::Vec4> nodeColors;
@@ -116,6 +118,8 @@ Data::Graph* Model::GraphDAO::getGraph(QSqlDatabase* conn, bool* error2, qlonglo
 	QMap<qlonglong, float> edgeScales;
 	QMap<qlonglong, int> nodeMasks;
 	QList<qlonglong> parentNodes;
+	QMap<qlonglong, qlonglong> mergedInto;
+	bool mergedError = false;
 
 	graphName = Model::GraphDAO::getName(graphID, &error, conn);
 	layoutName = Model::GraphLayoutDAO::getName(conn, &error, graphID, layoutID);
@@ -128,6 +132,8 @@ Data::Graph* Model::GraphDAO::getGraph(QSqlDatabase* conn, bool* error2, qlonglo
 	edgeScales = Model::EdgeDAO::getScales(conn, &error, graphID, layoutID);
 	nodeMasks = Model::NodeDAO::getMasks(conn, &error, graphID, layoutID);
 	parentNodes = Model::NodeDAO::getParents(conn, &error, graphID, layoutID);
+	mergedInto = Model::NodeDAO::getMergedInto(conn, &mergedError, graphID, layoutID);
+	error = error || mergedError;
 		
 	if(!error)
 	{
@@ -142,6 +148,9 @@ Data::Graph* Model::GraphDAO::getGraph(QSqlDatabase* conn, bool* error2, qlonglo
 		Data::Type *typeMetaNode = newGraph->getNodeMetaType();
 		Data::Type *typeMetaEdge = newGraph->getEdgeMetaType();
 
+		//uzly a hrany vkladame hromadne, zoznamy grafu sa vytvoria az po nacitani
+		newGraph->beginBulkInsert(queryNodes->size() > 0 ? queryNodes->size() : 0, queryEdges->size() > 0 ? queryEdges->size() : 0);
+
 		//nacitavame vrcholy grafu z databazy
 		while(queryNodes->next()) 
 		{
@@ -207,24 +216,49 @@ Data::Graph* Model::GraphDAO::getGraph(QSqlDatabase* conn, bool* error2, qlonglo
 			iNodes1 = nodes.find(nodeID1);
 			iNodes2 = nodes.find(nodeID2);
 
-			newGraph->addEdge(edgeID, edgeName, iNodes1.value(), iNodes2.value(), type, isOriented);
+			newEdge = newGraph->addEdge(edgeID, edgeName, iNodes1.value(), iNodes2.value(), type, isOriented);
+
+			//paralelna hrana bola nahradena multihranou
+			if(newEdge != NULL)
+				loadedEdges.append(newEdge);
+		}
+
+		newGraph->commitBulkInsert();
+
+		//nastavenia hran az po vytvoreni zoznamov, hranu mohla neskor nahradit multihrana
+		for(int i = 0; i < loadedEdges.size(); i++)
+		{
+			newEdge = loadedEdges.at(i);
+			edgeID = newEdge->getId();
+
+			if(newGraph->getEdges()->value(edgeID) != newEdge && newGraph->getMetaEdges()->value(edgeID) != newEdge)
+				continue;
 
 			if(edgeColors.contains(edgeID))
 			{
-				if(newGraph->getEdges()->contains(edgeID))
-					newGraph->getEdges()->find(edgeID).value()->setEdgeColor(edgeColors.value(edgeID));
-				else
-					newGraph->getMetaEdges()->find(edgeID).value()->setEdgeColor(edgeColors.value(edgeID));
+				newEdge->setEdgeColor(edgeColors.value(edgeID));
 			}
 
 			if(edgeScales.contains(edgeID))
 			{
-				if(newGraph->getEdges()->contains(edgeID))
-					newGraph->getEdges()->find(edgeID).value()->setScale(edgeScales.value(edgeID));
-				else
-					newGraph->getMetaEdges()->find(edgeID).value()->setScale(edgeScales.value(edgeID));
+				newEdge->setScale(edgeScales.value(edgeID));
 			}
 		}
+
+		//skupiny zlucenych uzlov, aby sa zlucene uzly dali znovu oddelit
+		QHash<qlonglong, QList<osg::ref_ptr<Data::Node> > > mergedGroups;
+		QMap<qlonglong, qlonglong>::const_iterator iMerged;
+		for(iMerged = mergedInto.constBegin(); iMerged != mergedInto.constEnd(); ++iMerged)
+		{
+			if(nodes.contains(iMerged.key()))
+				mergedGroups[iMerged.value()].append(nodes.value(iMerged.key()));
+		}
+
+		QHash<qlonglong, QList<osg::ref_ptr<Data::Node> > >::const_iterator iGroups;
+		for(iGroups = mergedGroups.constBegin(); iGroups != mergedGroups.constEnd(); ++iGroups)
+		{
+			newGraph->restoreMergedGroup(iGroups.key(), iGroups.value());
+		}
 	}
 	else 
 	{
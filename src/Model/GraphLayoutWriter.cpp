@@ -0,0 +1,270 @@
+/*!
+ * GraphLayoutWriter.cpp
+ * Projekt 3DVisual
+ */
+#include "Model/GraphLayoutWriter.h"
+#include "Data/GraphSnapshot.h"
+#include "Data/Node.h"
+#include "Data/Edge.h"
+#include "Data/Type.h"
+
+Model::GraphLayoutWriter::GraphLayoutWriter(Data::Graph* graph, Data::GraphLayout* layout)
+{
+	graphId = graph->getId();
+	layoutId = layout->getId();
+	nodeScale = graph->getNodeScale();
+	edgeScale = graph->getEdgeScale();
+
+	//ukladame konzistentnu verziu grafu, graf sa medzitym moze menit
+	QSharedPointer<Data::GraphSnapshot> snapshot = graph->getSnapshot();
+
+	nodes.reserve(snapshot->getMetaNodes().size() + snapshot->getNodes().size());
+	edges.reserve(snapshot->getMetaEdges().size() + snapshot->getEdges().size());
+
+	//zlucene uzly si pamataju svoj zluceny uzol, aby sa dali po nacitani z DB znovu oddelit
+	QHash<qlonglong, qlonglong> mergedInto;
+	QHash<qlonglong, QList<osg::ref_ptr<Data::Node> > > mergedGroups = graph->getMergedGroups();
+	QHash<qlonglong, QList<osg::ref_ptr<Data::Node> > >::const_iterator iGroups;
+	for(iGroups = mergedGroups.constBegin(); iGroups != mergedGroups.constEnd(); ++iGroups)
+	{
+		for(int i = 0; i < iGroups.value().size(); i++)
+			mergedInto.insert(iGroups.value().at(i)->getId(), iGroups.key());
+	}
+
+	//meta uzly a hrany ako prve, dostanu nove ID v rovnakom poradi ako pri povodnom ukladani
+	QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator iNodes;
+	for(iNodes = snapshot->getMetaNodes().constBegin(); iNodes != snapshot->getMetaNodes().constEnd(); ++iNodes)
+		addNode(iNodes.value().get(), true, mergedInto);
+	for(iNodes = snapshot->getNodes().constBegin(); iNodes != snapshot->getNodes().constEnd(); ++iNodes)
+		addNode(iNodes.value().get(), false, mergedInto);
+
+	//typ vnorenej hrany len hladame, ukladanie nema graf menit (getNestedEdgeType by chybajuci typ vytvoril)
+	Data::Type* nestedEdgeType = NULL;
+	QList<Data::Type*> nestedEdgeTypes = graph->getTypesByName(Data::GraphLayout::NESTED_EDGE_TYPE);
+	if(!nestedEdgeTypes.isEmpty())
+		nestedEdgeType = nestedEdgeTypes.first();
+
+	QMap<qlonglong, osg::ref_ptr<Data::Edge> >::const_iterator iEdges;
+	for(iEdges = snapshot->getMetaEdges().constBegin(); iEdges != snapshot->getMetaEdges().constEnd(); ++iEdges)
+		addEdge(iEdges.value().get(), true, nestedEdgeType);
+	for(iEdges = snapshot->getEdges().constBegin(); iEdges != snapshot->getEdges().constEnd(); ++iEdges)
+		addEdge(iEdges.value().get(), false, nestedEdgeType);
+}
+
+void Model::GraphLayoutWriter::addNode(Data::Node* node, bool meta, const QHash<qlonglong, qlonglong>& mergedInto)
+{
+	NodeRecord record;
+	record.id = node->getId();
+	record.typeId = node->getType()->getId();
+	record.parentId = (node->getParentNode() != NULL) ? node->getParentNode()->getId() : -1;
+	record.mergedInto = mergedInto.value(node->getId(), -1);
+	if(meta)
+		record.name = node->getName();
+	record.position = node->getCurrentPosition();
+	record.color = node->getColor();
+	record.scale = node->getScale();
+	record.meta = meta;
+	record.fixed = node->isFixed();
+	record.masked = (node->getNodeMask() == 0);
+	record.parent = node->isParentNode();
+
+	nodes.append(record);
+}
+
+void Model::GraphLayoutWriter::addEdge(Data::Edge* edge, bool meta, Data::Type* nestedEdgeType)
+{
+	EdgeRecord record;
+	record.id = edge->getId();
+	record.typeId = edge->getType()->getId();
+	record.srcId = edge->getSrcNode()->getId();
+	record.dstId = edge->getDstNode()->getId();
+	if(meta)
+		record.name = edge->getName();
+	record.color = edge->getEdgeColor();
+	record.scale = edge->getScale();
+	record.meta = meta;
+	record.oriented = edge->isOriented();
+	record.nested = (nestedEdgeType != NULL && edge->getType() == nestedEdgeType);
+
+	edges.append(record);
+}
+
+bool Model::GraphLayoutWriter::write(QSqlDatabase* conn)
+{
+	//check if we have connection
+	if(conn==NULL || !conn->isOpen())
+	{
+        qDebug() << "[Model::GraphLayoutWriter::write] Connection to DB not opened.";
+        return false;
+    }
+
+	//cely layout ukladame v jednej transakcii
+	if(!conn->transaction()) {
+		qDebug() << "[Model::GraphLayoutWriter::write] Could not start transaction: " << conn->lastError().databaseText();
+		return false;
+	}
+
+	if(!writeRows(conn) || !conn->commit()) {
+		qDebug() << "[Model::GraphLayoutWriter::write] Layout wasn't saved to DB.";
+		conn->rollback();
+		return false;
+	}
+
+	qDebug() << "[Model::GraphLayoutWriter::write] Layout of " << nodes.size() << " nodes and " << edges.size() << " edges was saved to DB.";
+
+	return true;
+}
+
+bool Model::GraphLayoutWriter::writeRows(QSqlDatabase* conn)
+{
+	bool error = false;
+	qlonglong maxNodeId = maxId(conn, "nodes", "node_id", &error);
+	qlonglong maxEdgeId = maxId(conn, "edges", "edge_id", &error);
+	if(error)
+		return false;
+
+	//nove ID meta uzlov a hran (v DB musia byt jedinecne)
+	QHash<qlonglong, qlonglong> newMetaNodeID;
+	QHash<qlonglong, qlonglong> newMetaEdgeID;
+
+	for(int i = 0; i < nodes.size() && nodes.at(i).meta; i++)
+		newMetaNodeID.insert(nodes.at(i).id, ++maxNodeId);
+	for(int i = 0; i < edges.size() && edges.at(i).meta; i++)
+		newMetaEdgeID.insert(edges.at(i).id, ++maxEdgeId);
+
+	//meta uzly a hrany zapiseme ako prve, ostatne tabulky sa na ne odkazuju
+	Model::BatchInsert metaNodesInsert(conn, "nodes", QStringList() << "node_id" << "name" << "type_id" << "graph_id" << "meta" << "fixed" << "layout_id" << "parent_id");
+	for(int i = 0; i < nodes.size() && nodes.at(i).meta; i++)
+	{
+		const NodeRecord& node = nodes.at(i);
+
+		if(!metaNodesInsert.addRow(QVariantList()
+			<< newMetaNodeID.value(node.id)
+			<< node.name
+			<< node.typeId
+			<< graphId
+			<< true
+			<< node.fixed
+			<< layoutId
+			<< newMetaNodeID.value(node.parentId, -1)))
+		{
+			qDebug() << "[Model::GraphLayoutWriter::writeRows] Could not perform query on DB: " << metaNodesInsert.lastError();
+			return false;
+		}
+	}
+
+	if(!metaNodesInsert.finish()) {
+		qDebug() << "[Model::GraphLayoutWriter::writeRows] Could not perform query on DB: " << metaNodesInsert.lastError();
+		return false;
+	}
+
+	Model::BatchInsert metaEdgesInsert(conn, "edges", QStringList() << "edge_id" << "name" << "type_id" << "n1" << "n2" << "oriented" << "meta" << "graph_id" << "layout_id" << "nested");
+	for(int i = 0; i < edges.size() && edges.at(i).meta; i++)
+	{
+		const EdgeRecord& edge = edges.at(i);
+
+		//uzly, ktore nie su meta, maju povodne ID
+		if(!metaEdgesInsert.addRow(QVariantList()
+			<< newMetaEdgeID.value(edge.id)
+			<< edge.name
+			<< edge.typeId
+			<< newMetaNodeID.value(edge.srcId, edge.srcId)
+			<< newMetaNodeID.value(edge.dstId, edge.dstId)
+			<< edge.oriented
+			<< true
+			<< graphId
+			<< layoutId
+			<< edge.nested))
+		{
+			qDebug() << "[Model::GraphLayoutWriter::writeRows] Could not perform query on DB: " << metaEdgesInsert.lastError();
+			return false;
+		}
+	}
+
+	if(!metaEdgesInsert.finish()) {
+		qDebug() << "[Model::GraphLayoutWriter::writeRows] Could not perform query on DB: " << metaEdgesInsert.lastError();
+		return false;
+	}
+
+	//jeden prechod cez vsetky uzly - pozicie a nastavenia, ktore nie su default
+	Model::BatchInsert positionsInsert(conn, "positions", QStringList() << "layout_id" << "node_id" << "pos_x" << "pos_y" << "pos_z" << "graph_id");
+	Model::BatchInsert nodeSettingsInsert(conn, "node_settings", QStringList() << "graph_id" << "node_id" << "val_name" << "val" << "layout_id");
+	bool ok = true;
+
+	for(int i = 0; ok && i < nodes.size(); i++)
+	{
+		const NodeRecord& node = nodes.at(i);
+		qlonglong nodeID = node.meta ? newMetaNodeID.value(node.id) : node.id;
+
+		ok = positionsInsert.addRow(QVariantList() << layoutId << nodeID << node.position.x() << node.position.y() << node.position.z() << graphId);
+
+		if(ok && (node.color.r() != 1 || node.color.g() != 1 || node.color.b() != 1 || node.color.a() != 1))
+		{
+			ok = nodeSettingsInsert.addRow(QVariantList() << graphId << nodeID << "color_r" << node.color.r() << layoutId)
+				&& nodeSettingsInsert.addRow(QVariantList() << graphId << nodeID << "color_g" << node.color.g() << layoutId)
+				&& nodeSettingsInsert.addRow(QVariantList() << graphId << nodeID << "color_b" << node.color.b() << layoutId)
+				&& nodeSettingsInsert.addRow(QVariantList() << graphId << nodeID << "color_a" << node.color.a() << layoutId);
+		}
+
+		if(ok && node.scale != nodeScale)
+			ok = nodeSettingsInsert.addRow(QVariantList() << graphId << nodeID << "scale" << node.scale << layoutId);
+
+		if(ok && node.masked)
+			ok = nodeSettingsInsert.addRow(QVariantList() << graphId << nodeID << "mask" << 0.0f << layoutId);
+
+		if(ok && node.parent)
+			ok = nodeSettingsInsert.addRow(QVariantList() << graphId << nodeID << "is_parent" << true << layoutId);
+
+		//zluceny uzol je vzdy meta uzol, ma nove ID
+		if(ok && node.mergedInto >= 0)
+			ok = nodeSettingsInsert.addRow(QVariantList() << graphId << nodeID << "merged_into" << newMetaNodeID.value(node.mergedInto, node.mergedInto) << layoutId);
+	}
+
+	ok = ok && positionsInsert.finish() && nodeSettingsInsert.finish();
+	if(!ok) {
+		qDebug() << "[Model::GraphLayoutWriter::writeRows] Could not perform query on DB: " << positionsInsert.lastError() << nodeSettingsInsert.lastError();
+		return false;
+	}
+
+	//jeden prechod cez vsetky hrany
+	Model::BatchInsert edgeSettingsInsert(conn, "edge_settings", QStringList() << "graph_id" << "edge_id" << "val_name" << "val" << "layout_id");
+
+	for(int i = 0; ok && i < edges.size(); i++)
+	{
+		const EdgeRecord& edge = edges.at(i);
+		qlonglong edgeID = edge.meta ? newMetaEdgeID.value(edge.id) : edge.id;
+
+		if(edge.color.r() != 1 || edge.color.g() != 1 || edge.color.b() != 1 || edge.color.a() != 1)
+		{
+			ok = edgeSettingsInsert.addRow(QVariantList() << graphId << edgeID << "color_r" << edge.color.r() << layoutId)
+				&& edgeSettingsInsert.addRow(QVariantList() << graphId << edgeID << "color_g" << edge.color.g() << layoutId)
+				&& edgeSettingsInsert.addRow(QVariantList() << graphId << edgeID << "color_b" << edge.color.b() << layoutId)
+				&& edgeSettingsInsert.addRow(QVariantList() << graphId << edgeID << "color_a" << edge.color.a() << layoutId);
+		}
+
+		if(ok && edge.scale != edgeScale)
+			ok = edgeSettingsInsert.addRow(QVariantList() << graphId << edgeID << "scale" << edge.scale << layoutId);
+	}
+
+	if(!ok || !edgeSettingsInsert.finish()) {
+		qDebug() << "[Model::GraphLayoutWriter::writeRows] Could not perform query on DB: " << edgeSettingsInsert.lastError();
+		return false;
+	}
+
+	return true;
+}
+
+qlonglong Model::GraphLayoutWriter::maxId(QSqlDatabase* conn, QString table, QString column, bool* error)
+{
+	QSqlQuery query(*conn);
+	query.prepare("SELECT MAX(" + column + ") FROM " + table + " WHERE graph_id = :graph_id");
+	query.bindValue(":graph_id", graphId);
+
+	if(!query.exec()) {
+		qDebug() << "[Model::GraphLayoutWriter::maxId] Could not perform query on DB: " << query.lastError().databaseText();
+		*error = true;
+		return 0;
+	}
+
+	return query.next() ? query.value(0).toLongLong() : 0;
+}
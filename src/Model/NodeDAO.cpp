@@ -25,7 +25,7 @@ bool Model::NodeDAO::addNodesToDB(QSqlDatabase* conn, QMap<qlonglong, osg::ref_p
 
 	QMap< qlonglong,osg::ref_ptr<Data::Node> >::const_iterator iNodes = nodes->constBegin();
 
-	QSqlQuery* query = new QSqlQuery(*conn);
+	Model::BatchInsert insert(conn, "nodes", QStringList() << "node_id" << "name" << "type_id" << "graph_id" << "meta" << "fixed" << "parent_id");
 	
 	//ukladame vsetky uzly do databazy
 	while(iNodes != nodes->constEnd()) 
@@ -34,23 +34,27 @@ bool Model::NodeDAO::addNodesToDB(QSqlDatabase* conn, QMap<qlonglong, osg::ref_p
 		if(iNodes.value()->getParentNode() != NULL)
 			parentId = iNodes.value()->getParentNode()->getId();
 
-		query->prepare("INSERT INTO nodes (node_id, name, type_id, graph_id, meta, fixed, parent_id) VALUES (:node_id, :name, :type_id, :graph_id, :meta, :fixed, :parent_id)");
-		query->bindValue(":node_id", iNodes.value()->getId());
-		query->bindValue(":name", iNodes.value()->getName());
-		query->bindValue(":type_id", iNodes.value()->getType()->getId()); 
-		query->bindValue(":graph_id", iNodes.value()->getGraph()->getId());
-		query->bindValue(":meta", false);
-		query->bindValue(":fixed", iNodes.value()->isFixed());
-		query->bindValue(":parent_id", parentId);
-
-		if(!query->exec()) {
-			qDebug() << "[Model::NodeDAO::addNodesToDB] Could not perform query on DB: " << query->lastError().databaseText();
+		if(!insert.addRow(QVariantList()
+			<< iNodes.value()->getId()
+			<< iNodes.value()->getName()
+			<< iNodes.value()->getType()->getId()
+			<< iNodes.value()->getGraph()->getId()
+			<< false
+			<< iNodes.value()->isFixed()
+			<< parentId))
+		{
+			qDebug() << "[Model::NodeDAO::addNodesToDB] Could not perform query on DB: " << insert.lastError();
 			return false;
 		}
 
 		++iNodes;
 	}
 
+	if(!insert.finish()) {
+		qDebug() << "[Model::NodeDAO::addNodesToDB] Could not perform query on DB: " << insert.lastError();
+		return false;
+	}
+
 	qDebug() << "[Model::NodeDAO::addNodesToDB] " << nodes->count() << " nodes were saved to DB.";
 
 	return true;
@@ -69,17 +73,15 @@ bool Model::NodeDAO::addMetaNodesToDB(QSqlDatabase* conn, QMap<qlonglong, osg::r
 
 	QMap< qlonglong,osg::ref_ptr<Data::Node> >::const_iterator iNodes = nodes->constBegin();
 
-	QSqlQuery* query = new QSqlQuery(*conn);
-	qlonglong nodeID;
-	QMap<qlonglong, qlonglong>::iterator nodeIdIter;
+	Model::BatchInsert insert(conn, "nodes", QStringList() << "node_id" << "name" << "type_id" << "graph_id" << "meta" << "fixed" << "layout_id" << "parent_id");
+	qlonglong nodeID = -1;
 	
 	//ukladame vsetky meta-uzly do databazy
 	while(iNodes != nodes->constEnd()) 
 	{
 		if(newMetaNodeID.contains(iNodes.value()->getId()))
 		{
-			nodeIdIter = newMetaNodeID.find(iNodes.value()->getId());
-			nodeID = nodeIdIter.value();
+			nodeID = newMetaNodeID.value(iNodes.value()->getId());
 		}
 		else
 		{
@@ -91,8 +93,7 @@ bool Model::NodeDAO::addMetaNodesToDB(QSqlDatabase* conn, QMap<qlonglong, osg::r
 		{
 			if(newMetaNodeID.contains(iNodes.value()->getParentNode()->getId()))
 			{
-				nodeIdIter = newMetaNodeID.find(iNodes.value()->getParentNode()->getId());
-				parentId = nodeIdIter.value();
+				parentId = newMetaNodeID.value(iNodes.value()->getParentNode()->getId());
 			}
 			else
 			{
@@ -100,24 +101,28 @@ bool Model::NodeDAO::addMetaNodesToDB(QSqlDatabase* conn, QMap<qlonglong, osg::r
 			}
 		}
 
-		query->prepare("INSERT INTO nodes (node_id, name, type_id, graph_id, meta, fixed, layout_id, parent_id) VALUES (:node_id, :name, :type_id, :graph_id, :meta, :fixed, :layout_id, :parent_id)");
-		query->bindValue(":node_id", nodeID);
-		query->bindValue(":name", iNodes.value()->getName());
-		query->bindValue(":type_id", iNodes.value()->getType()->getId()); 
-		query->bindValue(":graph_id", iNodes.value()->getGraph()->getId());
-		query->bindValue(":meta", true);
-		query->bindValue(":fixed", iNodes.value()->isFixed());
-		query->bindValue(":layout_id", layout->getId());
-		query->bindValue(":parent_id", parentId);
-
-		if(!query->exec()) {
-			qDebug() << "[Model::NodeDAO::addMetaNodesToDB] Could not perform query on DB: " << query->lastError().databaseText();
+		if(!insert.addRow(QVariantList()
+			<< nodeID
+			<< iNodes.value()->getName()
+			<< iNodes.value()->getType()->getId()
+			<< iNodes.value()->getGraph()->getId()
+			<< true
+			<< iNodes.value()->isFixed()
+			<< layout->getId()
+			<< parentId))
+		{
+			qDebug() << "[Model::NodeDAO::addMetaNodesToDB] Could not perform query on DB: " << insert.lastError();
 			return false;
 		}
 
 		++iNodes;
 	}
 
+	if(!insert.finish()) {
+		qDebug() << "[Model::NodeDAO::addMetaNodesToDB] Could not perform query on DB: " << insert.lastError();
+		return false;
+	}
+
 	qDebug() << "[Model::NodeDAO::addMetaNodesToDB] " << nodes->count() << " meta nodes were saved to DB.";
 
 	return true;
@@ -134,95 +139,95 @@ bool Model::NodeDAO::addNodesPositionsToDB(QSqlDatabase* conn, QMap<qlonglong, o
 
 	QMap< qlonglong,osg::ref_ptr<Data::Node> >::const_iterator iNodes = nodes->constBegin();
 
-	QSqlQuery* query = new QSqlQuery(*conn);
-	qlonglong nodeID;
-	QMap<qlonglong, qlonglong>::iterator nodeIdIter;
+	Model::BatchInsert insert(conn, "positions", QStringList() << "layout_id" << "node_id" << "pos_x" << "pos_y" << "pos_z" << "graph_id");
+	qlonglong nodeID = -1;
 	
 	//ukladame pozicie uzlov pre vsetky uzly
 	while(iNodes != nodes->constEnd()) 
 	{
-		if(meta)	
+		if(!getNodeID(iNodes.value(), newMetaNodeID, meta, &nodeID))
 		{
-			if(newMetaNodeID.contains(iNodes.value()->getId()))
-			{
-				nodeIdIter = newMetaNodeID.find(iNodes.value()->getId());
-				nodeID = nodeIdIter.value();
-			}
-			else
-			{
-				qDebug() << "[Model::NodeDAO::addNodesPositionsToDB] Node ID: " << iNodes.value()->getId() <<  " mismatch";
-			}
+			qDebug() << "[Model::NodeDAO::addNodesPositionsToDB] Node ID: " << iNodes.value()->getId() <<  " mismatch";
 		}
-		else
-		{
-			nodeID = iNodes.value()->getId();
-		}
-
-		query->prepare("INSERT INTO positions (layout_id, node_id, pos_x, pos_y, pos_z, graph_id) VALUES (:layout_id, :node_id, :pos_x, :pos_y, :pos_z, :graph_id) RETURNING  node_id");
-		query->bindValue(":layout_id", layout->getId()); 
-		query->bindValue(":node_id", nodeID);
-		query->bindValue(":pos_x", iNodes.value()->getCurrentPosition().x());
-		query->bindValue(":pos_y", iNodes.value()->getCurrentPosition().y());
-		query->bindValue(":pos_z", iNodes.value()->getCurrentPosition().z());
-		query->bindValue(":graph_id", iNodes.value()->getGraph()->getId());
 
-		if(!query->exec()) {
-			qDebug() << "[Model::NodeDAO::addNodesPositionsToDB] Could not perform query on DB: " << query->lastError().databaseText();
+		if(!insert.addRow(QVariantList()
+			<< layout->getId()
+			<< nodeID
+			<< iNodes.value()->getCurrentPosition().x()
+			<< iNodes.value()->getCurrentPosition().y()
+			<< iNodes.value()->getCurrentPosition().z()
+			<< iNodes.value()->getGraph()->getId()))
+		{
+			qDebug() << "[Model::NodeDAO::addNodesPositionsToDB] Could not perform query on DB: " << insert.lastError();
 			return false;
 		}
 
 		++iNodes;
 	}
 
+	if(!insert.finish()) {
+		qDebug() << "[Model::NodeDAO::addNodesPositionsToDB] Could not perform query on DB: " << insert.lastError();
+		return false;
+	}
+
 	return true;
 }
 
 bool Model::NodeDAO::addNodesColorToDB(QSqlDatabase* conn, QMap<qlonglong, osg::ref_ptr<Data::Node> >* nodes, Data::GraphLayout* layout, QMap<qlonglong, qlonglong> newMetaNodeID, bool meta)
 {
+	//check if we have connection
+	if(conn==NULL || !conn->isOpen()) 
+	{ 
+        qDebug() << "[Model::NodeDAO::addNodesColorToDB] Connection to DB not opened.";
+        return false;
+    }
+
 	QMap< qlonglong,osg::ref_ptr<Data::Node> >::const_iterator iNodes = nodes->constBegin();
-	qlonglong nodeID;
-	QMap<qlonglong, qlonglong>::iterator nodeIdIter;
+	Model::BatchInsert insert(conn, "node_settings", settingsColumns());
+	qlonglong nodeID = -1;
+	bool ok = true;
 	
 	//ukladame vsetky farby uzlov do databazy
-	while(iNodes != nodes->constEnd()) 
+	while(ok && iNodes != nodes->constEnd()) 
 	{
 		//ulozime farbu len nodom, ktore maju farbu inu nez default
 		if(iNodes.value()->getColor().r() != 1 || iNodes.value()->getColor().g() != 1 ||iNodes.value()->getColor().b() != 1 ||iNodes.value()->getColor().a() != 1)
 		{
-			if(meta)	
-			{
-				if(newMetaNodeID.contains(iNodes.value()->getId()))
-				{
-					nodeIdIter = newMetaNodeID.find(iNodes.value()->getId());
-					nodeID = nodeIdIter.value();
-				}
-				else
-				{
-					qDebug() << "[Model::NodeDAO::addNodesColorToDB] Node ID: " << iNodes.value()->getId() <<  " mismatch";
-				}
-			}
-			else
+			if(!getNodeID(iNodes.value(), newMetaNodeID, meta, &nodeID))
 			{
-				nodeID = iNodes.value()->getId();
+				qDebug() << "[Model::NodeDAO::addNodesColorToDB] Node ID: " << iNodes.value()->getId() <<  " mismatch";
 			}
 
-			addSettings(conn, iNodes.value()->getGraph()->getId(), layout->getId(), nodeID, "color_r", iNodes.value()->getColor().r());
-			addSettings(conn, iNodes.value()->getGraph()->getId(), layout->getId(), nodeID, "color_g", iNodes.value()->getColor().g());
-			addSettings(conn, iNodes.value()->getGraph()->getId(), layout->getId(), nodeID, "color_b", iNodes.value()->getColor().b());
-			addSettings(conn, iNodes.value()->getGraph()->getId(), layout->getId(), nodeID, "color_a", iNodes.value()->getColor().a());
+			qlonglong graphID = iNodes.value()->getGraph()->getId();
+			ok = insert.addRow(QVariantList() << graphID << nodeID << "color_r" << iNodes.value()->getColor().r() << layout->getId())
+				&& insert.addRow(QVariantList() << graphID << nodeID << "color_g" << iNodes.value()->getColor().g() << layout->getId())
+				&& insert.addRow(QVariantList() << graphID << nodeID << "color_b" << iNodes.value()->getColor().b() << layout->getId())
+				&& insert.addRow(QVariantList() << graphID << nodeID << "color_a" << iNodes.value()->getColor().a() << layout->getId());
 		}
 
 		++iNodes;
 	}
+
+	if(!ok || !insert.finish()) {
+		qDebug() << "[Model::NodeDAO::addNodesColorToDB] Could not perform query on DB: " << insert.lastError();
+		return false;
+	}
 	
 	return true;
 }
 
 bool Model::NodeDAO::addNodesScaleToDB(QSqlDatabase* conn, QMap<qlonglong, osg::ref_ptr<Data::Node> >* nodes, Data::GraphLayout* layout, QMap<qlonglong, qlonglong> newMetaNodeID, bool meta, float defaultScale)
 {
+	//check if we have connection
+	if(conn==NULL || !conn->isOpen()) 
+	{ 
+        qDebug() << "[Model::NodeDAO::addNodesScaleToDB] Connection to DB not opened.";
+        return false;
+    }
+
 	QMap< qlonglong,osg::ref_ptr<Data::Node> >::const_iterator iNodes = nodes->constBegin();
-	qlonglong nodeID;
-	QMap<qlonglong, qlonglong>::iterator nodeIdIter;
+	Model::BatchInsert insert(conn, "node_settings", settingsColumns());
+	qlonglong nodeID = -1;
 	
 	//ukladame velkosti jednotlivym uzlom, ktore ju nemaju Default
 	while(iNodes != nodes->constEnd()) 
@@ -230,37 +235,41 @@ bool Model::NodeDAO::addNodesScaleToDB(QSqlDatabase* conn, QMap<qlonglong, osg::
 		//ulozime scale len nodom, ktore maju velkost inu nez default
 		if(iNodes.value()->getScale() != defaultScale)
 		{
-			if(meta)	
+			if(!getNodeID(iNodes.value(), newMetaNodeID, meta, &nodeID))
 			{
-				if(newMetaNodeID.contains(iNodes.value()->getId()))
-				{
-					nodeIdIter = newMetaNodeID.find(iNodes.value()->getId());
-					nodeID = nodeIdIter.value();
-				}
-				else
-				{
-					qDebug() << "[Model::NodeDAO::addNodesScaleToDB] Node ID: " << iNodes.value()->getId() <<  " mismatch";
-				}
+				qDebug() << "[Model::NodeDAO::addNodesScaleToDB] Node ID: " << iNodes.value()->getId() <<  " mismatch";
 			}
-			else
+
+			if(!insert.addRow(QVariantList() << iNodes.value()->getGraph()->getId() << nodeID << "scale" << iNodes.value()->getScale() << layout->getId()))
 			{
-				nodeID = iNodes.value()->getId();
+				qDebug() << "[Model::NodeDAO::addNodesScaleToDB] Could not perform query on DB: " << insert.lastError();
+				return false;
 			}
-
-			addSettings(conn, iNodes.value()->getGraph()->getId(), layout->getId(), nodeID, "scale", iNodes.value()->getScale());
 		}
 
 		++iNodes;
 	}
+
+	if(!insert.finish()) {
+		qDebug() << "[Model::NodeDAO::addNodesScaleToDB] Could not perform query on DB: " << insert.lastError();
+		return false;
+	}
 	
 	return true;
 }
 
 bool Model::NodeDAO::addNodesMaskToDB(QSqlDatabase* conn, QMap<qlonglong, osg::ref_ptr<Data::Node> >* nodes, Data::GraphLayout* layout, QMap<qlonglong, qlonglong> newMetaNodeID, bool meta)
 {
+	//check if we have connection
+	if(conn==NULL || !conn->isOpen()) 
+	{ 
+        qDebug() << "[Model::NodeDAO::addNodesMaskToDB] Connection to DB not opened.";
+        return false;
+    }
+
 	QMap< qlonglong,osg::ref_ptr<Data::Node> >::const_iterator iNodes = nodes->constBegin();
-	qlonglong nodeID;
-	QMap<qlonglong, qlonglong>::iterator nodeIdIter;
+	Model::BatchInsert insert(conn, "node_settings", settingsColumns());
+	qlonglong nodeID = -1;
 	float scale = 0;
 	
 	//ukladame zobrazovanu masku pre uzly, ktore ju nemaju Default
@@ -269,69 +278,92 @@ bool Model::NodeDAO::addNodesMaskToDB(QSqlDatabase* conn, QMap<qlonglong, osg::r
 		//ulozime masku len nodom, ktore ju maju nastavenu, t. j. je rovna 0
 		if(iNodes.value()->getNodeMask() == 0)
 		{
-			if(meta)	
+			if(!getNodeID(iNodes.value(), newMetaNodeID, meta, &nodeID))
 			{
-				if(newMetaNodeID.contains(iNodes.value()->getId()))
-				{
-					nodeIdIter = newMetaNodeID.find(iNodes.value()->getId());
-					nodeID = nodeIdIter.value();
-				}
-				else
-				{
-					qDebug() << "[Model::NodeDAO::addNodesMaskToDB] Node ID: " << iNodes.value()->getId() <<  " mismatch";
-				}
+				qDebug() << "[Model::NodeDAO::addNodesMaskToDB] Node ID: " << iNodes.value()->getId() <<  " mismatch";
 			}
-			else
+
+			if(!insert.addRow(QVariantList() << iNodes.value()->getGraph()->getId() << nodeID << "mask" << scale << layout->getId()))
 			{
-				nodeID = iNodes.value()->getId();
+				qDebug() << "[Model::NodeDAO::addNodesMaskToDB] Could not perform query on DB: " << insert.lastError();
+				return false;
 			}
-
-			addSettings(conn, iNodes.value()->getGraph()->getId(), layout->getId(), nodeID, "mask", scale);
 		}
 
 		++iNodes;
 	}
+
+	if(!insert.finish()) {
+		qDebug() << "[Model::NodeDAO::addNodesMaskToDB] Could not perform query on DB: " << insert.lastError();
+		return false;
+	}
 	
 	return true;
 }
 
 bool Model::NodeDAO::addNodesParentToDB(QSqlDatabase* conn, QMap<qlonglong, osg::ref_ptr<Data::Node> >* nodes, Data::GraphLayout* layout, QMap<qlonglong, qlonglong> newMetaNodeID, bool meta)
 {
+	//check if we have connection
+	if(conn==NULL || !conn->isOpen()) 
+	{ 
+        qDebug() << "[Model::NodeDAO::addNodesParentToDB] Connection to DB not opened.";
+        return false;
+    }
+
 	QMap< qlonglong,osg::ref_ptr<Data::Node> >::const_iterator iNodes = nodes->constBegin();
-	qlonglong nodeID;
-	QMap<qlonglong, qlonglong>::iterator nodeIdIter;
+	Model::BatchInsert insert(conn, "node_settings", settingsColumns());
+	qlonglong nodeID = -1;
 	
 	//ukladame nadradene uzly k danym uzlom do databazy
 	while(iNodes != nodes->constEnd()) 
 	{
 		if(iNodes.value()->isParentNode())
 		{
-			if(meta)	
+			if(!getNodeID(iNodes.value(), newMetaNodeID, meta, &nodeID))
 			{
-				if(newMetaNodeID.contains(iNodes.value()->getId()))
-				{
-					nodeIdIter = newMetaNodeID.find(iNodes.value()->getId());
-					nodeID = nodeIdIter.value();
-				}
-				else
-				{
-					qDebug() << "[Model::NodeDAO::addNodesScaleToDB] Node ID: " << iNodes.value()->getId() <<  " mismatch";
-				}
+				qDebug() << "[Model::NodeDAO::addNodesParentToDB] Node ID: " << iNodes.value()->getId() <<  " mismatch";
 			}
-			else
+
+			if(!insert.addRow(QVariantList() << iNodes.value()->getGraph()->getId() << nodeID << "is_parent" << true << layout->getId()))
 			{
-				nodeID = iNodes.value()->getId();
+				qDebug() << "[Model::NodeDAO::addNodesParentToDB] Could not perform query on DB: " << insert.lastError();
+				return false;
 			}
-
-			addSettings(conn, iNodes.value()->getGraph()->getId(), layout->getId(), nodeID, "is_parent", true);
 		}
 
 		++iNodes;
 	}
+
+	if(!insert.finish()) {
+		qDebug() << "[Model::NodeDAO::addNodesParentToDB] Could not perform query on DB: " << insert.lastError();
+		return false;
+	}
 	
 	return true;
 }
 
+bool Model::NodeDAO::getNodeID(osg::ref_ptr<Data::Node> node, const QMap<qlonglong, qlonglong>& newMetaNodeID, bool meta, qlonglong* nodeID)
+{
+	if(!meta)
+	{
+		*nodeID = node->getId();
+		return true;
+	}
+
+	//meta uzly maju v DB nove ID
+	QMap<qlonglong, qlonglong>::const_iterator nodeIdIter = newMetaNodeID.constFind(node->getId());
+	if(nodeIdIter == newMetaNodeID.constEnd())
+		return false;
+
+	*nodeID = nodeIdIter.value();
+	return true;
+}
+
+QStringList Model::NodeDAO::settingsColumns()
+{
+	return QStringList() << "graph_id" << "node_id" << "val_name" << "val" << "layout_id";
+}
+
 QSqlQuery* Model::NodeDAO::getNodesQuery(QSqlDatabase* conn, bool* error, qlonglong graphID, qlonglong layoutID, qlonglong parentID)
 {
     *error = FALSE;
@@ -497,6 +529,51 @@ bool Model::NodeDAO::removeNode( Data::Node* node, QSqlDatabase* conn )
     return true;
 }
 
+bool Model::NodeDAO::removeNodes(qlonglong graphID, QSet<qlonglong> nodeIDs, QSqlDatabase* conn)
+{
+    if(conn==NULL || !conn->isOpen()) { //check if we have connection
+        qDebug() << "[Model::NodeDAO::removeNodes] Connection to DB not opened.";
+        return false;
+    }
+
+    if(nodeIDs.isEmpty()) {
+        return true;
+    }
+
+	//odstranujeme uzly z databazy po castiach v jednej transakcii
+	const int chunkSize = 1000;
+	QList<qlonglong> ids = nodeIDs.toList();
+
+    if(!conn->transaction()) {
+        qDebug() << "[Model::NodeDAO::removeNodes] Could not start transaction: " << conn->lastError().databaseText();
+        return false;
+    }
+
+    QSqlQuery query(*conn);
+	for(int i = 0; i < ids.size(); i += chunkSize) {
+		QStringList chunk;
+		for(int j = i; j < ids.size() && j < i + chunkSize; j++) {
+			chunk << QString::number(ids.at(j));
+		}
+
+		query.prepare("DELETE FROM nodes WHERE graph_id = :graph_id AND node_id IN (" + chunk.join(",") + ")");
+		query.bindValue(":graph_id", graphID);
+		if(!query.exec()) {
+			qDebug() << "[Model::NodeDAO::removeNodes] Could not perform query on DB: " << query.lastError().databaseText();
+			conn->rollback();
+			return false;
+		}
+	}
+
+    if(!conn->commit()) {
+        qDebug() << "[Model::NodeDAO::removeNodes] Could not commit transaction: " << conn->lastError().databaseText();
+        conn->rollback();
+        return false;
+    }
+
+    return true;
+}
+
 bool Model::NodeDAO::removeNodes(qlonglong graphID, QSqlDatabase* conn)
 {
     if(conn==NULL || !conn->isOpen()) { 
@@ -748,6 +825,27 @@ QList<qlonglong> Model::NodeDAO::getParents(QSqlDatabase* conn, bool* error, qlo
 	return parents;
 }
 
+QMap<qlonglong, qlonglong> Model::NodeDAO::getMergedInto(QSqlDatabase* conn, bool* error, qlonglong graphID, qlonglong layoutID)
+{
+	bool error2 = false;
+	QMap<qlonglong, qlonglong> mergedInto;
+
+	QMap<qlonglong, QString> nodeMergedInto;
+	QMap<qlonglong, QString>::iterator iter;
+
+	nodeMergedInto = getSettings(conn, &error2, graphID, layoutID, "merged_into");
+
+	//nacitavame z databazy zlucene uzly, ku kazdemu jeho zluceny uzol
+	for(iter = nodeMergedInto.begin(); iter != nodeMergedInto.end(); iter++) 
+	{
+		mergedInto.insert(iter.key(), iter.value().toLongLong());
+	}
+
+	*error = error2;
+
+	return mergedInto;
+}
+
 QMap<qlonglong, qlonglong> Model::NodeDAO::getNewMetaNodesId(QSqlDatabase* conn, qlonglong graphID, QMap<qlonglong, osg::ref_ptr<Data::Node> >* nodes)
 {
 	QMap<qlonglong, qlonglong> newId;
@@ -795,18 +893,18 @@ bool Model::NodeDAO::addSettings(QSqlDatabase* conn, qlonglong graphID, qlonglon
         return false;
     }
 
-	QSqlQuery* query = new QSqlQuery(*conn);
+	QSqlQuery query(*conn);
 	
 	//ukladame do databazy nazvy nastaveni
-	query->prepare("INSERT INTO node_settings (graph_id, node_id, val_name, val, layout_id) VALUES (:graph_id, :node_id, :val_name, :val, :layout_id)");
-	query->bindValue(":graph_id", graphID); 
-	query->bindValue(":node_id", nodeID);
-	query->bindValue(":val_name", valName);
-	query->bindValue(":val", val);
-	query->bindValue(":layout_id", layoutID);
-
-	if(!query->exec()) {
-		qDebug() << "[Model::NodeDAO::addSettings] Could not perform query on DB: " << query->lastError().databaseText();
+	query.prepare("INSERT INTO node_settings (graph_id, node_id, val_name, val, layout_id) VALUES (:graph_id, :node_id, :val_name, :val, :layout_id)");
+	query.bindValue(":graph_id", graphID); 
+	query.bindValue(":node_id", nodeID);
+	query.bindValue(":val_name", valName);
+	query.bindValue(":val", val);
+	query.bindValue(":layout_id", layoutID);
+
+	if(!query.exec()) {
+		qDebug() << "[Model::NodeDAO::addSettings] Could not perform query on DB: " << query.lastError().databaseText();
 		return false;
 	}
 
@@ -821,18 +919,18 @@ bool Model::NodeDAO::addSettings(QSqlDatabase* conn, qlonglong graphID, qlonglon
         return false;
     }
 
-	QSqlQuery* query = new QSqlQuery(*conn);
+	QSqlQuery query(*conn);
 	
 	//ukladame do databazy jednotlive nastavenia
-	query->prepare("INSERT INTO node_settings (graph_id, node_id, val_name, val, layout_id) VALUES (:graph_id, :node_id, :val_name, :val, :layout_id)");
-	query->bindValue(":graph_id", graphID); 
-	query->bindValue(":node_id", nodeID);
-	query->bindValue(":val_name", valName);
-	query->bindValue(":val", val);
-	query->bindValue(":layout_id", layoutID);
-
-	if(!query->exec()) {
-		qDebug() << "[Model::NodeDAO::addSettings] Could not perform query on DB: " << query->lastError().databaseText();
+	query.prepare("INSERT INTO node_settings (graph_id, node_id, val_name, val, layout_id) VALUES (:graph_id, :node_id, :val_name, :val, :layout_id)");
+	query.bindValue(":graph_id", graphID); 
+	query.bindValue(":node_id", nodeID);
+	query.bindValue(":val_name", valName);
+	query.bindValue(":val", val);
+	query.bindValue(":layout_id", layoutID);
+
+	if(!query.exec()) {
+		qDebug() << "[Model::NodeDAO::addSettings] Could not perform query on DB: " << query.lastError().databaseText();
 		return false;
 	}
 
@@ -847,18 +945,18 @@ bool Model::NodeDAO::addSettings(QSqlDatabase* conn, qlonglong graphID, qlonglon
         return false;
     }
 
-	QSqlQuery* query = new QSqlQuery(*conn);
+	QSqlQuery query(*conn);
 	
 	//pridavame nastavenie do databazy
-	query->prepare("INSERT INTO node_settings (graph_id, node_id, val_name, val, layout_id) VALUES (:graph_id, :node_id, :val_name, :val, :layout_id)");
-	query->bindValue(":graph_id", graphID); 
-	query->bindValue(":node_id", nodeID);
-	query->bindValue(":val_name", valName);
-	query->bindValue(":val", val);
-	query->bindValue(":layout_id", layoutID);
-
-	if(!query->exec()) {
-		qDebug() << "[Model::NodeDAO::addSettings] Could not perform query on DB: " << query->lastError().databaseText();
+	query.prepare("INSERT INTO node_settings (graph_id, node_id, val_name, val, layout_id) VALUES (:graph_id, :node_id, :val_name, :val, :layout_id)");
+	query.bindValue(":graph_id", graphID); 
+	query.bindValue(":node_id", nodeID);
+	query.bindValue(":val_name", valName);
+	query.bindValue(":val", val);
+	query.bindValue(":layout_id", layoutID);
+
+	if(!query.exec()) {
+		qDebug() << "[Model::NodeDAO::addSettings] Could not perform query on DB: " << query.lastError().databaseText();
 		return false;
 	}
 
@@ -9,20 +9,33 @@
 
 #include "QOSG/CoreWindow.h"
 #include "Util/Cleaner.h"
+#include "Data/GraphCommand.h"
+#include "Data/GraphQuery.h"
+#include "Analysis/GraphMetrics.h"
 
 #include "Layout/ShapeGetter_SphereSurface_ByTwoNodes.h"
 #include "Layout/ShapeGetter_Sphere_ByTwoNodes.h"
 #include "Layout/ShapeGetter_Plane_ByThreeNodes.h"
 #include "Layout/RestrictionRemovalHandler_RestrictionNodesRemover.h"
 
+#include <QtConcurrentRun>
+
 using namespace QOSG;
 
+//subory, ktore vie nacitat niektory z importerov
+static const char * IMPORT_FILE_FILTER = "GraphML files (*.graphml *.graphml.gz *.graphml.zst);;GXL files (*.gxl *.gxl.gz *.gxl.zst);;RSF files (*.rsf *.rsf.gz *.rsf.zst);;Matrix Market files (*.mtx *.mtx.gz *.mtx.zst);;CSV/TSV edge lists (*.csv *.tsv *.csv.gz *.tsv.gz *.csv.zst *.tsv.zst);;Graphviz DOT files (*.dot *.gv *.dot.gz *.gv.gz);;3DVisual binary files (*.3dv)";
+
 CoreWindow::CoreWindow(QWidget *parent, Vwr::CoreGraph* coreGraph, QApplication* app, Layout::LayoutThread * thread ) : QMainWindow(parent)
 {		
 	//inicializacia premennych
     isPlaying = true;
 	application = app;
+	traversal = NULL;
+	metricsGraph = NULL;
 	layout = thread;
+
+	metricsWatcher = new QFutureWatcher<Analysis::GraphMetrics::Result>(this);
+	connect(metricsWatcher, SIGNAL(finished()), this, SLOT(metricsComputed()));
 	
 	//vytvorenie menu a toolbar-ov
 	createActions();
@@ -66,12 +79,36 @@ void CoreWindow::createActions()
 	load = new QAction(QIcon("img/gui/open.png"),"&Load graph from file", this);
 	connect(load, SIGNAL(triggered()), this, SLOT(loadFile()));
 
+	mergeFromFile = new QAction("&Merge changes from file", this);
+	connect(mergeFromFile, SIGNAL(triggered()), this, SLOT(mergeFile()));
+
+	exportToFile = new QAction("&Export graph to file", this);
+	connect(exportToFile, SIGNAL(triggered()), this, SLOT(exportFile()));
+
 	loadGraph = new QAction(QIcon("img/gui/loadFromDB.png"),"&Load graph from database", this);
 	connect(loadGraph, SIGNAL(triggered()), this, SLOT(showLoadGraph()));
 
 	saveGraph = new QAction(QIcon("img/gui/saveToDB.png"),"&Save graph layout", this);
 	connect(saveGraph, SIGNAL(triggered()), this, SLOT(saveLayoutToDB()));
 
+	metrics = new QAction("Compute graph metrics", this);
+	connect(metrics, SIGNAL(triggered()), this, SLOT(computeMetrics()));
+
+	collapse = new QAction("Collapse communities", this);
+	connect(collapse, SIGNAL(triggered()), this, SLOT(collapseCommunities()));
+
+	expand = new QAction("Expand communities", this);
+	connect(expand, SIGNAL(triggered()), this, SLOT(expandCommunities()));
+
+	shortestPath = new QAction("Select shortest path", this);
+	connect(shortestPath, SIGNAL(triggered()), this, SLOT(selectShortestPath()));
+
+	geometricPath = new QAction("Select shortest path in space", this);
+	connect(geometricPath, SIGNAL(triggered()), this, SLOT(selectGeometricPath()));
+
+	neighbourhood = new QAction("Expand selection by hops", this);
+	connect(neighbourhood, SIGNAL(triggered()), this, SLOT(expandSelection()));
+
 	play = new QPushButton();
 	play->setIcon(QIcon("img/gui/pause.png"));
 	play->setToolTip("&Play");
@@ -206,14 +243,24 @@ void CoreWindow::createMenus()
 {
 	file = menuBar()->addMenu("File");	
 	file->addAction(load);
+	file->addAction(mergeFromFile);
 	file->addAction(loadGraph);
 	file->addSeparator();
 	file->addAction(saveGraph);
+	file->addAction(exportToFile);
 	file->addSeparator();
 	file->addAction(quit);
 	
 	edit = menuBar()->addMenu("Edit");
 	edit->addAction(options);	
+	edit->addAction(metrics);
+	edit->addSeparator();
+	edit->addAction(collapse);
+	edit->addAction(expand);
+	edit->addSeparator();
+	edit->addAction(shortestPath);
+	edit->addAction(geometricPath);
+	edit->addAction(neighbourhood);
 }
 
 void CoreWindow::createToolBar()
@@ -362,7 +409,8 @@ void CoreWindow::saveLayoutToDB()
 				Data::GraphLayout* layout = Model::GraphLayoutDAO::addLayout(layout_name, currentGraph, conn);
 				currentGraph->selectLayout(layout);
 
-				currentGraph->saveLayoutToDB(conn, currentGraph);
+				//layout sa uklada na pozadi, GUI medzitym reaguje
+				Manager::GraphManager::getInstance()->saveLayout(currentGraph);
 			}
 			else
 			{
@@ -382,7 +430,261 @@ void CoreWindow::saveLayoutToDB()
 
 void CoreWindow::sqlQuery()
 {
-	cout << lineEdit->text().toStdString() << endl;
+	//dotaz sa vyhodnoti nad indexami grafu a vysledne uzly sa oznacia
+	Data::Graph * currentGraph = Manager::GraphManager::getInstance()->getActiveGraph();
+	Data::GraphQuery query(currentGraph, lineEdit->text());
+
+	if (!query.isValid())
+	{
+		AppCore::Core::getInstance()->messageWindows->showMessageBox("Upozornenie", query.getError(), false);
+		return;
+	}
+
+	QList<osg::ref_ptr<Data::Node> > nodes = query.getNodes();
+	viewerWidget->getPickHandler()->selectNodes(nodes);
+
+	qDebug() << "[QOSG::CoreWindow::sqlQuery] Selected nodes: " << nodes.size();
+}
+
+void CoreWindow::computeMetrics()
+{
+	Data::Graph * currentGraph = Manager::GraphManager::getInstance()->getActiveGraph();
+
+	if (currentGraph == NULL)
+	{
+		qDebug() << "[QOSG::CoreWindow::computeMetrics] There is no active graph loaded";
+		return;
+	}
+
+	if (metricsWatcher->isRunning())
+	{
+		AppCore::Core::getInstance()->messageWindows->showMessageBox("Upozornenie", "Metriky grafu sa este pocitaju", false);
+		return;
+	}
+
+	//susednost sa skopiruje na vlakne GUI, samotny vypocet bezi na pozadi a graf necita
+	metricsGraph = currentGraph;
+	metricsWatcher->setFuture(QtConcurrent::run(&Analysis::GraphMetrics::compute, Analysis::AdjacencyGraph(currentGraph)));
+}
+
+void CoreWindow::metricsComputed()
+{
+	Data::Graph * currentGraph = Manager::GraphManager::getInstance()->getActiveGraph();
+
+	//medzicasom mohol byt nacitany iny graf
+	if (metricsGraph == NULL || metricsGraph != currentGraph)
+	{
+		qDebug() << "[QOSG::CoreWindow::metricsComputed] Active graph was changed, metrics are dropped";
+		metricsGraph = NULL;
+		return;
+	}
+
+	metricsGraph = NULL;
+
+	//metriky sa ulozia ako atributy uzlov, dalej sa s nimi pracuje cez dotazy
+	int components = Analysis::GraphMetrics::storeResult(currentGraph, metricsWatcher->result());
+	Analysis::GraphMetrics::mapToNodes(currentGraph, "pagerank", "coreness");
+
+	AppCore::Core::getInstance()->messageWindows->showMessageBox("Metriky grafu",
+		QString("Pocet komponentov: %1\nAtributy uzlov: degree, component, coreness, pagerank, betweenness\nVelkost uzlov podla pagerank, farba podla coreness").arg(components), false);
+}
+
+void CoreWindow::activeGraphChanged()
+{
+	//vysledok metrik predchadzajuceho grafu sa uz neulozi
+	metricsGraph = NULL;
+
+	//komunity a susednost patria predchadzajucemu grafu, novy graf moze mat aj rovnaku adresu
+	communities.clear();
+	delete traversal;
+	traversal = NULL;
+}
+
+void CoreWindow::collapseCommunities()
+{
+	Data::Graph * currentGraph = Manager::GraphManager::getInstance()->getActiveGraph();
+
+	if (currentGraph == NULL)
+	{
+		qDebug() << "[QOSG::CoreWindow::collapseCommunities] There is no active graph loaded";
+		return;
+	}
+
+	//komunity pocitame znovu, ak sa graf medzitym zmenil
+	if (!communities.isNull() && !communities->isCurrent(currentGraph))
+		communities.clear();
+
+	if (communities.isNull())
+		communities = QSharedPointer<Analysis::CommunityHierarchy>(new Analysis::CommunityHierarchy(currentGraph));
+
+	int level = communities->getLevel() + 1;
+
+	if (level >= communities->getLevelCount())
+	{
+		AppCore::Core::getInstance()->messageWindows->showMessageBox("Upozornenie", "Graf nema dalsiu uroven komunit", false);
+		return;
+	}
+
+	viewerWidget->getPickHandler()->unselectPickedEdges(0);
+	viewerWidget->getPickHandler()->unselectPickedNodes(0);
+
+	//zlucovanie meni strukturu grafu, prebehne az medzi iteraciami layoutu
+	currentGraph->enqueueCommand(new Analysis::CommunityCommand(communities, 1));
+
+	qDebug() << "[QOSG::CoreWindow::collapseCommunities] Level " << level << ", communities: " << communities->getCommunityCount(level);
+}
+
+void CoreWindow::expandCommunities()
+{
+	Data::Graph * currentGraph = Manager::GraphManager::getInstance()->getActiveGraph();
+
+	if (communities.isNull() || !communities->isCurrent(currentGraph) || communities->getLevel() < 0)
+	{
+		qDebug() << "[QOSG::CoreWindow::expandCommunities] There are no collapsed communities";
+		return;
+	}
+
+	viewerWidget->getPickHandler()->unselectPickedEdges(0);
+	viewerWidget->getPickHandler()->unselectPickedNodes(0);
+
+	currentGraph->enqueueCommand(new Analysis::CommunityCommand(communities, -1));
+}
+
+Analysis::GraphTraversal * CoreWindow::getTraversal(Data::Graph * graph)
+{
+	//susednost grafu sa stavia znovu len po zmene grafu
+	if (traversal != NULL && !traversal->isCurrent(graph))
+	{
+		delete traversal;
+		traversal = NULL;
+	}
+
+	if (traversal == NULL)
+		traversal = new Analysis::GraphTraversal(graph);
+
+	return traversal;
+}
+
+void CoreWindow::selectShortestPath()
+{
+	selectPath(false);
+}
+
+void CoreWindow::selectGeometricPath()
+{
+	selectPath(true);
+}
+
+void CoreWindow::selectPath(bool geometric)
+{
+	Data::Graph * currentGraph = Manager::GraphManager::getInstance()->getActiveGraph();
+
+	if (currentGraph == NULL)
+	{
+		qDebug() << "[QOSG::CoreWindow::selectPath] There is no active graph loaded";
+		return;
+	}
+
+	QLinkedList<osg::ref_ptr<Data::Node> > * selectedNodes = viewerWidget->getPickHandler()->getSelectedNodes();
+
+	if (selectedNodes->count() != 2)
+	{
+		AppCore::Core::getInstance()->messageWindows->showMessageBox("Upozornenie","Musite vybrat prve 2 vrcholy",false);
+		return;
+	}
+
+	Analysis::GraphTraversal * pathTraversal = getTraversal(currentGraph);
+	const Analysis::AdjacencyGraph & adjacency = pathTraversal->getAdjacency();
+	int source = adjacency.getNodeIndex(selectedNodes->first()->getId());
+	int target = adjacency.getNodeIndex(selectedNodes->last()->getId());
+
+	QVector<float> weights;
+	QVector<int> path;
+
+	if (geometric)
+	{
+		path = pathTraversal->geometricPath(source, target);
+	}
+	else
+	{
+		//ak maju hrany vahu, hladame najlahsiu cestu
+		weights = pathTraversal->getEdgeWeights("weight");
+		path = weights.isEmpty() ? pathTraversal->shortestPath(source, target) : pathTraversal->weightedPath(source, target, weights);
+	}
+
+	if (path.isEmpty())
+	{
+		AppCore::Core::getInstance()->messageWindows->showMessageBox("Upozornenie","Medzi vrcholmi neexistuje cesta",false);
+		return;
+	}
+
+	QList<osg::ref_ptr<Data::Node> > nodes;
+	for (int i = 0; i < path.size(); i++)
+	{
+		osg::ref_ptr<Data::Node> node = currentGraph->getNodes()->value(adjacency.getNodeId(path.at(i)));
+		if (node != NULL)
+			nodes.append(node);
+	}
+
+	QList<osg::ref_ptr<Data::Edge> > edges;
+	QList<qlonglong> edgeIds = pathTraversal->getPathEdges(path, weights);
+	for (int i = 0; i < edgeIds.size(); i++)
+	{
+		osg::ref_ptr<Data::Edge> edge = currentGraph->getEdges()->value(edgeIds.at(i));
+		if (edge != NULL)
+			edges.append(edge);
+	}
+
+	viewerWidget->getPickHandler()->selectNodes(nodes);
+	viewerWidget->getPickHandler()->selectEdges(edges);
+
+	qDebug() << "[QOSG::CoreWindow::selectPath] Path length: " << edges.size();
+}
+
+void CoreWindow::expandSelection()
+{
+	Data::Graph * currentGraph = Manager::GraphManager::getInstance()->getActiveGraph();
+
+	if (currentGraph == NULL)
+	{
+		qDebug() << "[QOSG::CoreWindow::expandSelection] There is no active graph loaded";
+		return;
+	}
+
+	bool ok;
+	int hops = QInputDialog::getInt(this, "Expand selection", "Count of hops:", 1, 1, 100, 1, &ok);
+
+	if (!ok)
+		return;
+
+	Analysis::GraphTraversal * hopTraversal = getTraversal(currentGraph);
+	const Analysis::AdjacencyGraph & adjacency = hopTraversal->getAdjacency();
+
+	QVector<int> sources;
+	QLinkedList<osg::ref_ptr<Data::Node> > * selectedNodes = viewerWidget->getPickHandler()->getSelectedNodes();
+	QLinkedList<osg::ref_ptr<Data::Node> >::const_iterator i = selectedNodes->constBegin();
+
+	while (i != selectedNodes->constEnd()) 
+	{
+		int index = adjacency.getNodeIndex((*i)->getId());
+		if (index >= 0)
+			sources.append(index);
+		++i;
+	}
+
+	QVector<int> found = hopTraversal->neighbourhood(sources, hops);
+
+	QList<osg::ref_ptr<Data::Node> > nodes;
+	for (int j = 0; j < found.size(); j++)
+	{
+		osg::ref_ptr<Data::Node> node = currentGraph->getNodes()->value(adjacency.getNodeId(found.at(j)));
+		if (node != NULL)
+			nodes.append(node);
+	}
+
+	viewerWidget->getPickHandler()->selectNodes(nodes);
+
+	qDebug() << "[QOSG::CoreWindow::expandSelection] Selected nodes: " << nodes.size();
 }
 
 void CoreWindow::playPause()
@@ -449,17 +751,10 @@ void CoreWindow::addMetaNode()
 	{
 		osg::Vec3 position = viewerWidget->getPickHandler()->getSelectionCenter(true); 
 
-		osg::ref_ptr<Data::Node> metaNode = currentGraph->addNode("metaNode", currentGraph->getNodeMetaType(), position);	
 		QLinkedList<osg::ref_ptr<Data::Node> > * selectedNodes = viewerWidget->getPickHandler()->getSelectedNodes();
 
-		QLinkedList<osg::ref_ptr<Data::Node> >::const_iterator i = selectedNodes->constBegin();
-
-		while (i != selectedNodes->constEnd()) 
-		{
-			Data::Edge * e = currentGraph->addEdge("metaEdge", (*i), metaNode, currentGraph->getEdgeMetaType(), true);
-			e->setCamera(viewerWidget->getCamera());
-			++i;
-		}
+		//meta uzol s hranami sa prida az medzi iteraciami layoutu
+		currentGraph->enqueueCommand(new Data::AddMetaNodeCommand(*selectedNodes, position, viewerWidget->getCamera()));
 
 		if (isPlaying)
             LAYOUT_PLAY;
@@ -489,7 +784,7 @@ void CoreWindow::mergeNodes()
 		QLinkedList<osg::ref_ptr<Data::Node> > * selectedNodes = viewerWidget->getPickHandler()->getSelectedNodes();
 
 		if(selectedNodes->count() > 0) {
-			currentGraph->mergeNodes(selectedNodes, position);
+			currentGraph->enqueueCommand(new Data::MergeNodesCommand(*selectedNodes, position));
 		}
 		else {
 			qDebug() << "[QOSG::CoreWindow::mergeNodes] There are no nodes selected";
@@ -512,7 +807,7 @@ void CoreWindow::separateNodes()
 		QLinkedList<osg::ref_ptr<Data::Node> > * selectedNodes = viewerWidget->getPickHandler()->getSelectedNodes();
 
 		if(selectedNodes->count() > 0) {
-			currentGraph->separateNodes(selectedNodes);
+			currentGraph->enqueueCommand(new Data::SeparateNodesCommand(*selectedNodes));
 		}
 		else {
 			qDebug() << "[QOSG::CoreWindow::separateNodes] There are no nodes selected";
@@ -528,16 +823,23 @@ void CoreWindow::removeMetaNodes()
 	QLinkedList<osg::ref_ptr<Data::Node> > * selectedNodes = viewerWidget->getPickHandler()->getSelectedNodes();
 	Data::Graph * currentGraph = Manager::GraphManager::getInstance()->getActiveGraph();
 
+	QList<osg::ref_ptr<Data::Node> > removedNodes;
+
 	QLinkedList<osg::ref_ptr<Data::Node> >::const_iterator i = selectedNodes->constBegin();
 
 	while (i != selectedNodes->constEnd()) 
 	{
-		//treba este opravit - zatial kontrolujeme ci to nie je mergedNode len podla mena
-		if ((*i)->getType()->isMeta() && (*i)->getName() != "mergedNode")
-			currentGraph->removeNode((*i));
+		//zlucene uzly sa neodstranuju, treba ich rozdelit
+		if ((*i)->getType()->isMeta() && !currentGraph->isMergedNode((*i)->getId()))
+			removedNodes.append((*i));
 		++i;
 	}
 
+	if (removedNodes.isEmpty())
+		return;
+
+	currentGraph->enqueueCommand(new Data::RemoveCommand(removedNodes, QList<osg::ref_ptr<Data::Edge> >()));
+
 	if (isPlaying)
         LAYOUT_PLAY;
 }
@@ -547,21 +849,59 @@ void CoreWindow::loadFile()
 	LAYOUT_PAUSE;
 	coreGraph->setNodesFreezed(true);
 	QString fileName = QFileDialog::getOpenFileName(this,
-		tr("Open file"), ".", tr("GraphML files (*.graphml);;GXL files (*.gxl);;RSF files (*.rsf);;Matrix Market files (*.mtx)"));
+		tr("Open file"), ".", tr(IMPORT_FILE_FILTER));
+
+	bool loading = false;
 
 	if (fileName != "") {
-		Manager::GraphManager::getInstance()->loadGraph(fileName);
+		loading = (Manager::GraphManager::getInstance()->loadGraph(fileName) != NULL);
 
 		viewerWidget->getCameraManipulator()->home();
 	}
 
 	if (isPlaying)
 	{
-		LAYOUT_PLAY;
+		//rozlozenie nacitavaneho grafu spusti GraphManager po skonceni nacitania
+		if (!loading)
+		{
+			LAYOUT_PLAY;
+		}
 		coreGraph->setNodesFreezed(false);
 	}
 }
 
+void CoreWindow::mergeFile()
+{
+	if(Manager::GraphManager::getInstance()->getActiveGraph() == NULL)
+		return;
+
+	QString fileName = QFileDialog::getOpenFileName(this,
+		tr("Merge changes from file"), ".", tr(IMPORT_FILE_FILTER));
+
+	//zmeny sa zlucia s aktivnym grafom po nacitani, layout medzitym bezi dalej
+	if (fileName != "")
+		Manager::GraphManager::getInstance()->mergeGraph(fileName);
+}
+
+void CoreWindow::exportFile()
+{
+	Data::Graph * currentGraph = Manager::GraphManager::getInstance()->getActiveGraph();
+
+	if(currentGraph == NULL)
+		return;
+
+	QString fileName = QFileDialog::getSaveFileName(this,
+		tr("Export graph"), ".", tr("3DVisual binary files (*.3dv);;GraphML files (*.graphml);;Node positions (*.pos)"));
+
+	if (fileName != "") {
+		if (QFileInfo(fileName).suffix().isEmpty())
+			fileName += ".3dv";
+
+		//zapisuje sa snimka grafu v samostatnom vlakne, layout moze bezat dalej
+		Manager::GraphManager::getInstance()->exportGraph(currentGraph, fileName);
+	}
+}
+
 void CoreWindow::labelOnOff(bool)
 {
 	if (viewerWidget->getPickHandler()->getSelectionType() == Vwr::PickHandler::SelectionType::EDGE)
@@ -835,7 +1175,7 @@ bool CoreWindow::add_EdgeClick()
 		}
 
 	
-	currentGraph->addEdge("GUI_edge", node1, node2, type, false);
+	currentGraph->enqueueCommand(new Data::AddEdgeCommand("GUI_edge", node1, node2, type, false));
 	if (isPlaying)
 		LAYOUT_PLAY;
 	QString nodename1 = QString(node1->getName());
@@ -855,7 +1195,7 @@ bool CoreWindow::add_NodeClick()
 	{
 		osg::Vec3 position = viewerWidget->getPickHandler()->getSelectionCenter(true); 
 
-		osg::ref_ptr<Data::Node> node1 = currentGraph->addNode("newNode", currentGraph->getNodeMetaType(), position);	
+		currentGraph->enqueueCommand(new Data::AddNodeCommand("newNode", currentGraph->getNodeMetaType(), position));
 
 		if (isPlaying)
             LAYOUT_PLAY;
@@ -876,24 +1216,31 @@ bool CoreWindow::removeClick()
 {	
 	Data::Graph * currentGraph = Manager::GraphManager::getInstance()->getActiveGraph();
 	QLinkedList<osg::ref_ptr<Data::Edge> > * selectedEdges = viewerWidget->getPickHandler()->getSelectedEdges();
+	QList<osg::ref_ptr<Data::Edge> > removedEdges;
 	
 	while (selectedEdges->size () > 0) {
 		osg::ref_ptr<Data::Edge> existingEdge1 = (* (selectedEdges->constBegin()));
-		currentGraph->removeEdge(existingEdge1);
+		removedEdges.append(existingEdge1);
 		selectedEdges->removeFirst ();
 	}
 	currentGraph = Manager::GraphManager::getInstance()->getActiveGraph();
 	QLinkedList<osg::ref_ptr<Data::Node> > * selectedNodes = viewerWidget->getPickHandler()->getSelectedNodes();
+	QList<osg::ref_ptr<Data::Node> > removedNodes;
 
 	while (selectedNodes->size () > 0) {
 		osg::ref_ptr<Data::Node> existingNode1 = (* (selectedNodes->constBegin()));
 		if (existingNode1->isRemovableByUser())
-			currentGraph->removeNode(existingNode1);
+			removedNodes.append(existingNode1);
 		selectedNodes->removeFirst ();
 	}
 
-	int NodesCount=currentGraph->getNodes()->size();
-	cout<<NodesCount;
+	//prazdny prikaz by zbytocne zastavil layout
+	if (removedNodes.isEmpty() && removedEdges.isEmpty())
+		return true;
+
+	//hrany a uzly sa odstrania naraz az medzi iteraciami layoutu
+	currentGraph->enqueueCommand(new Data::RemoveCommand(removedNodes, removedEdges));
+
 	if (isPlaying)
         LAYOUT_PLAY;
 
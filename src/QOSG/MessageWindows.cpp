@@ -12,14 +12,16 @@ MessageWindows::~MessageWindows(void)
 {
 }
 
-void MessageWindows::showProgressBar()
+void MessageWindows::showProgressBar(bool cancelable)
 {
 	if (progressBar == NULL)
 	{
 		progressBar = new QProgressDialog("Loading","",0,100,NULL,Qt::Dialog);
-		progressBar->setModal(true);
-		progressBar->setCancelButton(NULL);
 	}
+		//zrusitelny progress bar neblokuje aplikaciu
+		progressBar->setModal(!cancelable);
+		progressBar->setCancelButtonText(cancelable ? "Cancel" : QString());
+		progressBar->reset();
 		progressBar->setValue(0);
 		progressBar->show();	
 }
@@ -41,6 +43,11 @@ void MessageWindows::setProgressBarValue(int value)
 	}
 }
 
+bool MessageWindows::isProgressBarCanceled()
+{
+	return (progressBar != NULL) && progressBar->wasCanceled();
+}
+
 void MessageWindows::showMessageBox(QString title, const QString &message, bool isError)
 {
 	QMessageBox msgBox;
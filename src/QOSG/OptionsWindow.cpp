@@ -186,6 +186,8 @@ OptionsWindow::OptionsWindow(Vwr::CoreGraph *cg, QOSG::ViewerQT * viewer)
 	//nacitanie typov grafu
 	Manager::GraphManager * manager = Manager::GraphManager::getInstance();
 	QMap<qlonglong, Data::Type*> * types = manager->getActiveGraph()->getTypes();
+	//typy moze zaroven pridavat import
+	QMutexLocker locker(manager->getActiveGraph()->getStructureMutex());
 
 	for (int i=0; i < index->childCount(); i++)
 	{		
@@ -251,6 +251,8 @@ void TreeModel::addNodesToList(QList<TreeItem*> * parents)
 	//nacita sa zoznam typov uzlov
 	Manager::GraphManager * manager = Manager::GraphManager::getInstance();
 	QMap<qlonglong, Data::Type*> * nodes = manager->getActiveGraph()->getTypes();
+	//typy moze zaroven pridavat import
+	QMutexLocker locker(manager->getActiveGraph()->getStructureMutex());
 
 	QMap<qlonglong, Data::Type*>::iterator iterator;	
 
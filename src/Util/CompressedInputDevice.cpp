@@ -0,0 +1,307 @@
+#include "Util/CompressedInputDevice.h"
+//-----------------------------------------------------------------------------
+#include <QtConcurrentRun>
+//-----------------------------------------------------------------------------
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+//-----------------------------------------------------------------------------
+#include <string.h>
+
+namespace Util {
+
+const int CompressedInputDevice::BLOCK_SIZE;
+const int CompressedInputDevice::INPUT_SIZE;
+
+CompressedInputDevice::Format CompressedInputDevice::formatFromSuffix (
+	const QString &suffix
+) {
+	if (0 == suffix.compare ("gz", Qt::CaseInsensitive) || 0 == suffix.compare ("gzip", Qt::CaseInsensitive))
+		return GZIP;
+
+	if (0 == suffix.compare ("zst", Qt::CaseInsensitive) || 0 == suffix.compare ("zstd", Qt::CaseInsensitive))
+		return ZSTD;
+
+	return NONE;
+}
+
+bool CompressedInputDevice::isSupported (
+	Format format
+) {
+	switch (format) {
+#ifdef HAVE_ZLIB
+		case GZIP:
+			return true;
+#endif
+#ifdef HAVE_ZSTD
+		case ZSTD:
+			return true;
+#endif
+		default:
+			return false;
+	}
+}
+
+CompressedInputDevice::CompressedInputDevice (
+	std::auto_ptr<QIODevice> source,
+	Format format
+) : source_ (source),
+	format_ (format),
+	stream_ (NULL),
+	inputPosition_ (0),
+	sourceRead_ (0),
+	sourceEnd_ (false),
+	end_ (false),
+	error_ (false),
+	blockPosition_ (0),
+	sourcePosition_ (0),
+	pending_ (false)
+{
+}
+
+CompressedInputDevice::~CompressedInputDevice (void) {
+	close ();
+}
+
+bool CompressedInputDevice::open (
+	OpenMode mode
+) {
+	if ((mode & WriteOnly) || !isSupported (format_))
+		return false;
+
+	if (!source_->isOpen () && !source_->open (ReadOnly))
+		return false;
+
+	// stav dekompresie
+	bool ok = false;
+#ifdef HAVE_ZLIB
+	if (format_ == GZIP) {
+		z_stream *z = new z_stream;
+		memset (z, 0, sizeof (z_stream));
+
+		// 16 + MAX_WBITS - data maju hlavicku gzip
+		ok = (inflateInit2 (z, 16 + MAX_WBITS) == Z_OK);
+		stream_ = z;
+	}
+#endif
+#ifdef HAVE_ZSTD
+	if (format_ == ZSTD) {
+		ZSTD_DStream *zstd = ZSTD_createDStream ();
+		ok = (zstd != NULL && !ZSTD_isError (ZSTD_initDStream (zstd)));
+		stream_ = zstd;
+	}
+#endif
+
+	if (!ok)
+		return false;
+
+	input_.clear ();
+	inputPosition_ = 0;
+	sourceRead_ = source_->pos ();
+	sourceEnd_ = false;
+	end_ = false;
+	error_ = false;
+
+	block_.clear ();
+	blockPosition_ = 0;
+	sourcePosition_ = sourceRead_;
+
+	// prvy blok dekomprimujeme uz pocas otvarania
+	next_ = QtConcurrent::run (this, &CompressedInputDevice::decompressBlock);
+	pending_ = true;
+
+	return QIODevice::open (ReadOnly);
+}
+
+void CompressedInputDevice::close (void) {
+	if (pending_) {
+		next_.waitForFinished ();
+		pending_ = false;
+	}
+
+	if (stream_ != NULL) {
+#ifdef HAVE_ZLIB
+		if (format_ == GZIP) {
+			(void)inflateEnd ((z_stream *) stream_);
+			delete (z_stream *) stream_;
+		}
+#endif
+#ifdef HAVE_ZSTD
+		if (format_ == ZSTD)
+			(void)ZSTD_freeDStream ((ZSTD_DStream *) stream_);
+#endif
+		stream_ = NULL;
+	}
+
+	block_.clear ();
+	blockPosition_ = 0;
+	input_.clear ();
+
+	if (source_->isOpen ())
+		source_->close ();
+
+	QIODevice::close ();
+}
+
+bool CompressedInputDevice::atEnd (void) const {
+	if (!isOpen ())
+		return true;
+
+	if (QIODevice::bytesAvailable () > 0)
+		return false;
+
+	// na dalsi blok pockame, inak by sme nevedeli, ci este nejake data budu
+	return !const_cast<CompressedInputDevice *> (this)->fetchBlock ();
+}
+
+qint64 CompressedInputDevice::bytesAvailable (void) const {
+	return (block_.size () - blockPosition_) + QIODevice::bytesAvailable ();
+}
+
+qint64 CompressedInputDevice::getSourceSize (void) const {
+	return source_->isSequential () ? 0 : source_->size ();
+}
+
+qint64 CompressedInputDevice::readData (
+	char *data,
+	qint64 maxSize
+) {
+	qint64 read = 0;
+
+	while (read < maxSize && fetchBlock ()) {
+		int count = (int) qMin (maxSize - read, (qint64) (block_.size () - blockPosition_));
+		memcpy (data + read, block_.constData () + blockPosition_, count);
+
+		blockPosition_ += count;
+		read += count;
+	}
+
+	// chybu hlasime az ked uz nie su ziadne platne data
+	if (read == 0 && !pending_ && error_)
+		return -1;
+
+	return read;
+}
+
+qint64 CompressedInputDevice::writeData (
+	const char *data,
+	qint64 maxSize
+) {
+	return -1;
+}
+
+bool CompressedInputDevice::fetchBlock (void) {
+	while (blockPosition_ == block_.size ()) {
+		if (!pending_)
+			return false;
+
+		Block block = next_.result ();
+		pending_ = false;
+
+		block_ = block.data;
+		blockPosition_ = 0;
+		sourcePosition_ = block.sourcePosition;
+
+		// dalsi blok dekomprimujeme pocas citania tohto
+		if (!end_ && !error_) {
+			next_ = QtConcurrent::run (this, &CompressedInputDevice::decompressBlock);
+			pending_ = true;
+		}
+	}
+
+	return true;
+}
+
+CompressedInputDevice::Block CompressedInputDevice::decompressBlock (void) {
+	Block block;
+	block.data.resize (BLOCK_SIZE);
+
+	int produced = 0;
+	while (produced < BLOCK_SIZE && !end_ && !error_) {
+		if (inputPosition_ == input_.size ())
+			(void)readInput ();
+
+		bool streamEnd = false;
+		if (!decompressStep (block.data.data (), BLOCK_SIZE, produced, streamEnd)) {
+			error_ = true;
+		} else if (streamEnd) {
+			// za koncom clena gzip alebo ramca zstd moze nasledovat dalsi
+			if (inputPosition_ == input_.size () && !readInput ()) {
+				end_ = true;
+			}
+#ifdef HAVE_ZLIB
+			else if (format_ == GZIP) {
+				error_ = (inflateReset ((z_stream *) stream_) != Z_OK);
+			}
+#endif
+		} else if (produced < BLOCK_SIZE && inputPosition_ == input_.size () && sourceEnd_) {
+			// subor skoncil uprostred komprimovanych dat
+			error_ = true;
+		}
+	}
+
+	block.data.resize (produced);
+	block.sourcePosition = sourceRead_ - (input_.size () - inputPosition_);
+
+	return block;
+}
+
+bool CompressedInputDevice::decompressStep (
+	char *output,
+	int size,
+	int &produced,
+	bool &streamEnd
+) {
+#ifdef HAVE_ZLIB
+	if (format_ == GZIP) {
+		z_stream *z = (z_stream *) stream_;
+
+		z->next_in = (Bytef *) input_.data () + inputPosition_;
+		z->avail_in = (uInt) (input_.size () - inputPosition_);
+		z->next_out = (Bytef *) output + produced;
+		z->avail_out = (uInt) (size - produced);
+
+		int result = inflate (z, Z_NO_FLUSH);
+
+		inputPosition_ = input_.size () - (int) z->avail_in;
+		produced = size - (int) z->avail_out;
+		streamEnd = (result == Z_STREAM_END);
+
+		// Z_BUF_ERROR znamena len, ze nebolo mozne pokracovat bez dalsich dat
+		return result == Z_OK || result == Z_STREAM_END || result == Z_BUF_ERROR;
+	}
+#endif
+#ifdef HAVE_ZSTD
+	if (format_ == ZSTD) {
+		ZSTD_inBuffer in = { input_.constData (), (size_t) input_.size (), (size_t) inputPosition_ };
+		ZSTD_outBuffer out = { output, (size_t) size, (size_t) produced };
+
+		size_t result = ZSTD_decompressStream ((ZSTD_DStream *) stream_, &out, &in);
+
+		inputPosition_ = (int) in.pos;
+		produced = (int) out.pos;
+		streamEnd = (result == 0);
+
+		return !ZSTD_isError (result);
+	}
+#endif
+
+	return false;
+}
+
+bool CompressedInputDevice::readInput (void) {
+	if (sourceEnd_)
+		return false;
+
+	input_ = source_->read (INPUT_SIZE);
+	inputPosition_ = 0;
+	sourceRead_ += input_.size ();
+	sourceEnd_ = input_.isEmpty ();
+
+	return !sourceEnd_;
+}
+
+} // namespace
@@ -1,4 +1,5 @@
 #include "Viewer/CoreGraph.h"
+#include "Core/Core.h"
 #include <osgUtil/Optimizer>
 
 #ifdef HAVE_CUDA
@@ -55,20 +56,15 @@ void CoreGraph::reload(Data::Graph * graph)
 
 	this->graph = graph;
 
+	//skupiny uzlov a hran citaju vlastne kopie zoznamov grafu, graf sa moze menit aj z ineho vlakna (napr. pocas nacitavania)
+	this->in_nodes = new QMap<qlonglong, osg::ref_ptr<Data::Node> >;
+	this->in_edges = new QMap<qlonglong, osg::ref_ptr<Data::Edge> >;
+	this->qmetaNodes = new QMap<qlonglong, osg::ref_ptr<Data::Node> >;
+	this->qmetaEdges = new QMap<qlonglong, osg::ref_ptr<Data::Edge> >;
+
+	this->graphVersion = 0;
 	if (graph != NULL)
-	{
-		this->in_nodes = graph->getNodes();
-		this->in_edges = graph->getEdges();
-		this->qmetaNodes = graph->getMetaNodes();
-		this->qmetaEdges = graph->getMetaEdges();
-	}
-	else
-	{
-		this->in_nodes = new QMap<qlonglong, osg::ref_ptr<Data::Node> >;
-		this->in_edges = new QMap<qlonglong, osg::ref_ptr<Data::Edge> >;
-		this->qmetaNodes = new QMap<qlonglong, osg::ref_ptr<Data::Node> >;
-		this->qmetaEdges = new QMap<qlonglong, osg::ref_ptr<Data::Edge> >;
-	}
+		copySnapshot(graph->getSnapshot());
 
 	QMapIterator<qlonglong, osg::ref_ptr<Data::Edge> > i(*in_edges);
 
@@ -127,16 +123,20 @@ void CoreGraph::reload(Data::Graph * graph)
 
 void CoreGraph::cleanUp()
 {
-	if (this->graph == NULL)
+	if (this->graph != NULL)
 	{
-		delete in_nodes;
-		delete in_edges;
-		delete qmetaNodes;
-		delete qmetaEdges;
-		} else {
 		graph->getRestrictionsManager ().resetObserver ();
 	}
 
+	delete in_nodes;
+	delete in_edges;
+	delete qmetaNodes;
+	delete qmetaEdges;
+	in_nodes = NULL;
+	in_edges = NULL;
+	qmetaNodes = NULL;
+	qmetaEdges = NULL;
+
 	delete qmetaEdgesGroup;
 	delete edgesGroup;
 
@@ -234,7 +234,16 @@ void CoreGraph::update()
 {
 	root->removeChildren(customNodesPosition,1);
 
-	synchronize();
+	//zmeny zaradene z GUI aplikujeme naraz, raz za snimok a medzi iteraciami layoutu
+	if (graph != NULL)
+		AppCore::Core::getInstance()->getLayoutAlgorithm()->ApplyGraphCommands(graph);
+
+	//skupiny uzlov a hran synchronizujeme len ak sa zmenila struktura grafu
+	if (graph != NULL && graph->getVersion() != this->graphVersion)
+	{
+		copySnapshot(graph->getSnapshot());
+		synchronize();
+	}
 
 	nodesGroup->updateNodeCoordinates(this->nodesFreezed);
 	qmetaNodesGroup->updateNodeCoordinates(this->nodesFreezed);
@@ -244,6 +253,16 @@ void CoreGraph::update()
 	root->addChild(initCustomNodes());
 }
 
+void CoreGraph::copySnapshot(QSharedPointer<Data::GraphSnapshot> snapshot)
+{
+	//zoznamy su zdielane so snapshotom, graf si ich pri dalsej zmene skopiruje
+	this->graphVersion = snapshot->getVersion();
+	*in_nodes = snapshot->getNodes();
+	*in_edges = snapshot->getEdges();
+	*qmetaNodes = snapshot->getMetaNodes();
+	*qmetaEdges = snapshot->getMetaEdges();
+}
+
 #ifdef HAVE_CUDA
 void CoreGraph::synchronize()
 {
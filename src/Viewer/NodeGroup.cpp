@@ -9,6 +9,18 @@ NodeGroup::NodeGroup(QMap<qlonglong, osg::ref_ptr<Data::Node> > *nodes)
 	this->appConf = Util::ApplicationConfig::get();
 	this->nodeTransforms = new QMap<qlonglong, osg::ref_ptr<osg::AutoTransform> >;
 
+	//poradie podla susednosti v grafe nema pre vykreslovanie vyznam, pouzijeme poradie v priestore
+	this->ordering = Layout::NodeOrdering::methodFromName(appConf->getValue("Layout.NodeOrdering"));
+	if (this->ordering == Layout::NodeOrdering::CUTHILL_MCKEE)
+		this->ordering = Layout::NodeOrdering::HILBERT;
+	this->orderingInterval = (int) appConf->getNumericValue (
+		"Layout.NodeOrdering.Interval",
+		std::auto_ptr<long> (new long(1)),
+		std::auto_ptr<long> (NULL),
+		100
+	);
+	this->orderingAge = 0;
+
 	initNodes();
 }
 
@@ -148,6 +160,9 @@ bool NodeGroup::synchronizeNodes()
 
 	QSet<qlonglong>::const_iterator i = result.constBegin();
 
+	//ak uzly len pribudli (napr. pocas nacitavania grafu), usporiadane uzly len doplnime
+	bool removed = result.size() > 0;
+
 	while (i != result.constEnd()) 
 	{	
 		bool res = group->removeChild(nodeTransforms->value(*i));
@@ -163,31 +178,65 @@ bool NodeGroup::synchronizeNodes()
 
 	float graphScale = appConf->getValue("Viewer.Display.NodeDistanceScale").toFloat(); 
 
+	if (removed)
+	{
+		//usporiadane uzly obnovime pri najblizsej aktualizacii pozicii
+		orderedNodes.clear();
+		orderedTransforms.clear();
+	}
+
 	while (i != result.constEnd()) 
 	{
-		group->addChild(wrapChild(nodes->value(*i), graphScale));
+		osg::ref_ptr<osg::AutoTransform> at = wrapChild(nodes->value(*i), graphScale);
+		group->addChild(at);
+
+		if (!removed)
+		{
+			orderedNodes.append(nodes->value(*i));
+			orderedTransforms.append(at);
+		}
 		++i;
 	}
 
     return changed;
 }
 
+void NodeGroup::updateOrdering()
+{
+	QMap<qlonglong, osg::ref_ptr<Data::Edge> > noEdges;
+	QVector<Data::Node *> ordered = Layout::NodeOrdering::orderNodes(*nodes, noEdges, ordering);
+
+	orderedNodes.resize(ordered.size());
+	orderedTransforms.resize(ordered.size());
+
+	for (int i = 0; i < ordered.size(); i++)
+	{
+		orderedNodes[i] = ordered.at(i);
+		orderedTransforms[i] = nodeTransforms->value(ordered.at(i)->getId());
+	}
+
+	orderingAge = 0;
+}
+
 void NodeGroup::updateNodeCoordinates(bool nodesFreezed)
 {
-	QMap<qlonglong, osg::ref_ptr<Data::Node> >::const_iterator i = nodes->constBegin();
+	//poradie obnovime po zmene uzlov a po urcitom pocte snimkov, ked sa uzly presunuli
+	if (orderedNodes.size() != nodes->size() || (ordering != Layout::NodeOrdering::NONE && ++orderingAge >= orderingInterval))
+		updateOrdering();
 
-	while (i != nodes->constEnd()) 
+	for (int i = 0; i < orderedNodes.size(); i++) 
 	{
-		nodeTransforms->value(i.key())->setPosition((*i)->getCurrentPosition(true, nodesFreezed));
+		Data::Node * node = orderedNodes.at(i).get();
+
+		if (orderedTransforms.at(i) != NULL)
+			orderedTransforms.at(i)->setPosition(node->getCurrentPosition(true, nodesFreezed));
 
 		osg::ref_ptr<osg::AutoTransform> at = NULL;
-		at = i.value()->getOutBall();
+		at = node->getOutBall();
 		if(at!=NULL)
 		{
-			i.value()->getOutBall()->setPosition((*i)->getCurrentPosition(true, nodesFreezed));
+			at->setPosition(node->getCurrentPosition(true, nodesFreezed));
 		}
-
-		++i;
 	}
 }
 
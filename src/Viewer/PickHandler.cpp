@@ -549,6 +549,37 @@ void PickHandler::unselectPickedNodes(osg::ref_ptr<Data::Node> node)
 	}
 }
 
+void PickHandler::selectNodes(QList<osg::ref_ptr<Data::Node> > nodes)
+{
+	unselectPickedEdges();
+	unselectPickedNodes();
+
+	//zoznam je prazdny, uzly netreba kontrolovat na duplicity
+	QList<osg::ref_ptr<Data::Node> >::const_iterator i = nodes.constBegin();
+
+	while (i != nodes.constEnd()) 
+	{
+		pickedNodes.append(*i);
+		(*i)->setSelected(true);
+		++i;
+	}
+}
+
+void PickHandler::selectEdges(QList<osg::ref_ptr<Data::Edge> > edges)
+{
+	QList<osg::ref_ptr<Data::Edge> >::const_iterator i = edges.constBegin();
+
+	while (i != edges.constEnd()) 
+	{
+		if (!pickedEdges.contains(*i))
+		{
+			pickedEdges.append(*i);
+			(*i)->setSelected(true);
+		}
+		++i;
+	}
+}
+
 void PickHandler::unselectPickedEdges(osg::ref_ptr<Data::Edge> edge)
 {
 	if (edge == NULL)